@@ -0,0 +1,60 @@
+#include "dh/filter.h"
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+/**
+ * Measures the time per value of an IIR filter after the input became silent, with and without flushing the denormals.
+ * Without the option, the past outputs decay into subnormal numbers and the filter becomes much slower.
+ *
+ * This source code is licensed under the MIT license. See file "LICENSE" at the root of the repository.
+ */
+
+static std::vector<double> measure(bool flush_denormals, size_t windows, size_t window_length)
+{
+    dh_filter_parameters opts{};
+    opts.filter_type = DH_IIR_BUTTERWORTH_LOWPASS;
+    opts.filter_order = 4;
+    opts.cutoff_frequency_low = 5.0;
+    opts.sampling_frequency = 1000.0;
+    opts.flush_denormals = flush_denormals;
+    dh_filter_data filter;
+    std::vector<double> times;
+    if (dh_create_filter(&filter, &opts) != DH_FILTER_OK) {
+        return times;
+    }
+    dh_initialize_filter(&filter, 1.0);
+    double sum = 0.0;
+    for (size_t w=0; w<windows; ++w) {
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t i=0; i<window_length; ++i) {
+            double output = 0.0;
+            dh_filter(&filter, 0.0, &output);
+            sum += output;
+        }
+        const auto end = std::chrono::steady_clock::now();
+        times.push_back(std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(window_length));
+    }
+    dh_free_filter(&filter);
+    if (sum < 0.0) {
+        std::printf("%g\n", sum);
+    }
+    return times;
+}
+
+int main()
+{
+    const size_t windows = 20;
+    const size_t window_length = 10000;
+    const auto plain = measure(false, windows, window_length);
+    const auto flushed = measure(true, windows, window_length);
+    if (plain.size() != windows || flushed.size() != windows) {
+        std::printf("Could not create the filters\n");
+        return 1;
+    }
+    std::printf("%16s %16s %16s\n", "values", "plain ns", "flushed ns");
+    for (size_t w=0; w<windows; ++w) {
+        std::printf("%16zu %16.2f %16.2f\n", (w + 1) * window_length, plain[w], flushed[w]);
+    }
+    return 0;
+}
@@ -0,0 +1,88 @@
+#include "dh/filter.h"
+#include "dh/filter_arena.h"
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+/**
+ * Measures the time to create many small filters with dh_create_filter() and in an arena, and the time to filter
+ * one value with every filter afterwards. The filters in the arena are stored next to each other.
+ *
+ * This source code is licensed under the MIT license. See file "LICENSE" at the root of the repository.
+ */
+
+static dh_filter_parameters benchmark_parameters()
+{
+    dh_filter_parameters opts{};
+    opts.filter_type = DH_IIR_BUTTERWORTH_LOWPASS;
+    opts.filter_order = 2;
+    opts.cutoff_frequency_low = 5.0;
+    opts.sampling_frequency = 1000.0;
+    return opts;
+}
+
+/** Returns the time per filter in ns to filter [rounds] values with every filter. */
+static double filter_all(std::vector<dh_filter_data>& filters, size_t rounds)
+{
+    double sum = 0.0;
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t r=0; r<rounds; ++r) {
+        for (auto& filter : filters) {
+            double output = 0.0;
+            dh_filter(&filter, 1.0, &output);
+            sum += output;
+        }
+    }
+    const auto end = std::chrono::steady_clock::now();
+    if (sum < 0.0) {
+        std::printf("%g\n", sum);
+    }
+    return std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(rounds * filters.size());
+}
+
+int main()
+{
+    const size_t number_filters = 100000;
+    const size_t rounds = 20;
+    auto opts = benchmark_parameters();
+    std::vector<dh_filter_data> filters(number_filters);
+
+    auto start = std::chrono::steady_clock::now();
+    for (auto& filter : filters) {
+        if (dh_create_filter(&filter, &opts) != DH_FILTER_OK) {
+            std::printf("Could not create the filters\n");
+            return 1;
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    const double create_malloc = std::chrono::duration<double, std::milli>(end - start).count();
+    const double filter_malloc = filter_all(filters, rounds);
+    for (auto& filter : filters) {
+        dh_free_filter(&filter);
+    }
+
+    start = std::chrono::steady_clock::now();
+    size_t size = 0;
+    dh_filter_arena arena;
+    if (dh_filter_arena_required_size(&opts, number_filters, &size) != DH_FILTER_OK || dh_create_filter_arena(&arena, size) != DH_FILTER_OK) {
+        std::printf("Could not create the arena\n");
+        return 1;
+    }
+    for (auto& filter : filters) {
+        if (dh_filter_arena_create_filter(&arena, &filter, &opts) != DH_FILTER_OK) {
+            std::printf("Could not create the filters\n");
+            return 1;
+        }
+    }
+    end = std::chrono::steady_clock::now();
+    const double create_arena = std::chrono::duration<double, std::milli>(end - start).count();
+    const double filter_arena = filter_all(filters, rounds);
+    const size_t used = arena.used;
+    dh_free_filter_arena(&arena);
+
+    std::printf("%16s %16s %16s\n", "", "create ms", "filter ns");
+    std::printf("%16s %16.2f %16.2f\n", "malloc", create_malloc, filter_malloc);
+    std::printf("%16s %16.2f %16.2f\n", "arena", create_arena, filter_arena);
+    std::printf("arena uses %zu bytes for %zu filters\n", used, number_filters);
+    return 0;
+}
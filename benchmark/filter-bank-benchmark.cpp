@@ -0,0 +1,87 @@
+#include "dh/filter.h"
+#include "dh/filter_bank.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+/**
+ * Compares one filter per channel with a filter bank that computes all channels in one pass.
+ *
+ * This source code is licensed under the MIT license. See file "LICENSE" at the root of the repository.
+ */
+
+int main()
+{
+    const size_t number_channels = 20000;
+    const size_t ticks = 200;
+    dh_filter_parameters opts{};
+    opts.filter_type = DH_IIR_BUTTERWORTH_LOWPASS;
+    opts.filter_order = 4;
+    opts.cutoff_frequency_low = 10.0;
+    opts.sampling_frequency = 100.0;
+    opts.realization = DH_REALIZATION_SECOND_ORDER_SECTIONS;
+
+    std::vector<double> input(number_channels);
+    for (size_t c=0; c<number_channels; ++c) {
+        input[c] = std::sin(0.01 * static_cast<double>(c));
+    }
+    std::vector<double> output(number_channels);
+
+    std::vector<dh_filter_data> filters(number_channels);
+    for (auto& filter : filters) {
+        if (dh_create_filter(&filter, &opts) != DH_FILTER_OK) {
+            std::printf("Could not create the filters\n");
+            return 1;
+        }
+    }
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i=0; i<ticks; ++i) {
+        for (size_t c=0; c<number_channels; ++c) {
+            dh_filter(&filters[c], input[c], &output[c]);
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    const double single = std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(ticks * number_channels);
+    for (auto& filter : filters) {
+        dh_free_filter(&filter);
+    }
+
+    dh_filter_bank bank;
+    if (dh_create_filter_bank(&bank, &opts, number_channels) != DH_FILTER_OK) {
+        std::printf("Could not create the filter bank\n");
+        return 1;
+    }
+    start = std::chrono::steady_clock::now();
+    for (size_t i=0; i<ticks; ++i) {
+        dh_filter_bank_tick(&bank, input.data(), output.data());
+    }
+    end = std::chrono::steady_clock::now();
+    const double bank_time = std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(ticks * number_channels);
+
+    // the same values stored as one block per channel and as interleaved frames
+    std::vector<double> blocks(number_channels * ticks);
+    for (size_t c=0; c<number_channels; ++c) {
+        for (size_t i=0; i<ticks; ++i) {
+            blocks[c*ticks + i] = input[c];
+        }
+    }
+    start = std::chrono::steady_clock::now();
+    dh_filter_bank_block(&bank, blocks.data(), blocks.data(), ticks);
+    end = std::chrono::steady_clock::now();
+    const double block_time = std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(ticks * number_channels);
+    std::vector<double> frames(number_channels * ticks);
+    for (size_t i=0; i<ticks; ++i) {
+        std::copy(input.begin(), input.end(), frames.begin() + i*number_channels);
+    }
+    start = std::chrono::steady_clock::now();
+    dh_filter_bank_frames(&bank, frames.data(), frames.data(), ticks);
+    end = std::chrono::steady_clock::now();
+    const double frames_time = std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(ticks * number_channels);
+    dh_free_filter_bank(&bank);
+
+    std::printf("%12s %16s %16s %16s %16s\n", "channels", "filters ns", "tick ns", "block ns", "frames ns");
+    std::printf("%12zu %16.2f %16.2f %16.2f %16.2f\n", number_channels, single, bank_time, block_time, frames_time);
+    return 0;
+}
@@ -0,0 +1,75 @@
+#include "dh/filter.h"
+#include "dh/overlap_save.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+/**
+ * Compares the direct convolution of FIR filters with the overlap-save convolution for different numbers
+ * of coefficients. The overlap-save convolution is also forced for short filters to show where both
+ * kernels cross over.
+ *
+ * This source code is licensed under the MIT license. See file "LICENSE" at the root of the repository.
+ */
+
+static double measure_nanoseconds_per_value(dh_filter_data* filter, const std::vector<double>& input, std::vector<double>& output)
+{
+    const size_t repetitions = 5;
+    double best = 0.0;
+    for (size_t i=0; i<repetitions; ++i) {
+        const auto start = std::chrono::steady_clock::now();
+        dh_filter_block(filter, input.data(), output.data(), input.size());
+        const auto end = std::chrono::steady_clock::now();
+        const double elapsed = std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(input.size());
+        if (i == 0 || elapsed < best) {
+            best = elapsed;
+        }
+    }
+    return best;
+}
+
+int main()
+{
+    std::vector<double> input(1 << 16);
+    for (size_t i=0; i<input.size(); ++i) {
+        input[i] = std::sin(0.01 * static_cast<double>(i)) + 0.25 * std::sin(1.7 * static_cast<double>(i));
+    }
+    std::vector<double> output(input.size());
+
+    std::printf("# DH_REALIZATION_OVERLAP_SAVE uses the overlap-save convolution for filters with at least %d coefficients\n", DH_FILTER_FFT_MIN_COEFFICIENTS);
+    std::printf("%12s %12s %12s %12s\n", "taps", "fft length", "direct ns", "fft ns");
+    for (size_t taps=4; taps<=8192; taps*=2) {
+        dh_filter_parameters opts{};
+        opts.filter_type = DH_FIR_BRICKWALL_LOWPASS;
+        opts.filter_order = taps - 1;
+        opts.cutoff_frequency_low = 10.0;
+        opts.sampling_frequency = 100.0;
+        opts.realization = DH_REALIZATION_OVERLAP_SAVE;
+        dh_filter_data filter;
+        if (dh_create_filter(&filter, &opts) != DH_FILTER_OK) {
+            std::printf("Could not create a filter with %zu coefficients\n", taps);
+            return 1;
+        }
+
+        // the same buffer layout as used by dh_create_filter(), but independent of the threshold
+        size_t fft_length = 4;
+        while (fft_length < 4 * taps) {
+            fft_length *= 2;
+        }
+        std::vector<double> buffer(dh_overlap_save_buffer_length(fft_length));
+        const dh_overlap_save_data original = filter.overlap_save;
+
+        dh_overlap_save_assign_buffer(&filter.overlap_save, nullptr, 0);
+        const double direct = measure_nanoseconds_per_value(&filter, input, output);
+
+        dh_overlap_save_assign_buffer(&filter.overlap_save, buffer.data(), fft_length);
+        dh_overlap_save_prepare(&filter);
+        const double fft = measure_nanoseconds_per_value(&filter, input, output);
+
+        std::printf("%12zu %12zu %12.2f %12.2f\n", taps, fft_length, direct, fft);
+        filter.overlap_save = original;
+        dh_free_filter(&filter);
+    }
+    return 0;
+}
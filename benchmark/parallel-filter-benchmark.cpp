@@ -0,0 +1,58 @@
+#include "dh/filter.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+/**
+ * Compares filtering a long signal on one thread with dh_filter_block_parallel() for several numbers of threads.
+ *
+ * This source code is licensed under the MIT license. See file "LICENSE" at the root of the repository.
+ */
+
+int main()
+{
+    const size_t count = 50000000;
+    dh_filter_parameters opts{};
+    opts.filter_type = DH_IIR_BUTTERWORTH_LOWPASS;
+    opts.filter_order = 8;
+    opts.cutoff_frequency_low = 10.0;
+    opts.sampling_frequency = 100.0;
+    opts.realization = DH_REALIZATION_SECOND_ORDER_SECTIONS;
+
+    std::vector<double> input(count);
+    for (size_t i=0; i<count; ++i) {
+        input[i] = std::sin(0.001 * static_cast<double>(i)) + ((i % 1000) < 500 ? 1.0 : -1.0);
+    }
+    std::vector<double> expected(count);
+    std::vector<double> output(count);
+
+    dh_filter_data filter;
+    if (dh_create_filter(&filter, &opts) != DH_FILTER_OK) {
+        std::printf("Could not create the filter\n");
+        return 1;
+    }
+    auto start = std::chrono::steady_clock::now();
+    dh_filter_block(&filter, input.data(), expected.data(), count);
+    auto end = std::chrono::steady_clock::now();
+    const double serial = std::chrono::duration<double, std::milli>(end - start).count();
+
+    std::printf("%12s %16s %12s %16s\n", "threads", "time ms", "speedup", "max difference");
+    std::printf("%12s %16.2f %12.2f %16s\n", "serial", serial, 1.0, "-");
+    const size_t thread_counts[] = {1, 2, 4, 8, 16};
+    for (size_t threads : thread_counts) {
+        dh_initialize_filter(&filter, 0.0);
+        filter.initialized = false;
+        start = std::chrono::steady_clock::now();
+        dh_filter_block_parallel(&filter, input.data(), output.data(), count, threads);
+        end = std::chrono::steady_clock::now();
+        const double parallel = std::chrono::duration<double, std::milli>(end - start).count();
+        double max_difference = 0.0;
+        for (size_t i=0; i<count; ++i) {
+            max_difference = std::fmax(max_difference, std::fabs(output[i] - expected[i]));
+        }
+        std::printf("%12zu %16.2f %12.2f %16.3g\n", threads, parallel, serial / parallel, max_difference);
+    }
+    dh_free_filter(&filter);
+    return 0;
+}
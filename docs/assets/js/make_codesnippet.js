@@ -38,7 +38,7 @@ function generate_c_lib(options) {
 // https://github.com/domohuhn/filter
 // Returns 0 on success, -1 on error.</span>
 <span class="keyword">inline</span> <span class="type">int</span> initialize_filter(<span class="type">dh_filter_data</span>* filter_data) {
-    <span class="type">dh_filter_parameters</span> opts;
+    <span class="type">dh_filter_parameters</span> opts = {<span class="number">0</span>};
     opts.filter_type = <span class="enum">${convert_type_to_enum(options.filterType.value)}</span>;
     opts.cutoff_frequency_low = <span class="number">${options.cutoffFrequencyLow}</span>;
     opts.cutoff_frequency_high = <span class="number">${options.cutoffFrequencyHigh}</span>;
@@ -66,7 +66,7 @@ function generate_cpp_lib(options) {
 // https://github.com/domohuhn/filter
 // Returns the instantiated filter or throws an exception on error.</span>
 <span class="keyword">inline</span> <span class="type">dh::filter</span> initialize_filter() {
-    <span class="type">dh_filter_parameters</span> opts;
+    <span class="type">dh_filter_parameters</span> opts{};
     opts.filter_type = <span class="enum">${convert_type_to_enum(options.filterType.value)}</span>;
     opts.cutoff_frequency_low = <span class="number">${options.cutoffFrequencyLow}</span>;
     opts.cutoff_frequency_high = <span class="number">${options.cutoffFrequencyHigh}</span>;
@@ -75,6 +75,49 @@ function generate_cpp_lib(options) {
     opts.filter_order = <span class="number">${options.filterOrder}</span>;
     <span class="keyword">return</span> <span class="type">dh::filter</span>(opts);
 }
+</pre>` + generate_cpp_constexpr_lib(options);
+}
+
+// Returns the number of feedforward and feedback coefficients in direct form 1 if the filter can be designed
+// at compile time with dh::design(), or null otherwise. Must match design_number_feedforward() in dh/cpp/design.hpp.
+function constexpr_coefficient_counts(type, order) {
+    if(type>=4 && type<=7) {
+        return [type===6 ? 2*order+1 : order+1, 1];
+    }
+    if(type>=9 && type<=20) {
+        var count = (type-9)%4 < 2 ? order+1 : 2*order+1;
+        return [count, count];
+    }
+    return null;
+}
+
+function generate_cpp_constexpr_lib(options) {
+    var order = parseInt(options.filterOrder);
+    var counts = constexpr_coefficient_counts(options.filterType.value, order);
+    if(counts === null) {
+        return '';
+    }
+    var enu = convert_type_to_enum(options.filterType.value);
+    return `<pre class="code">
+<span class="preprocessor">#include</span> <span class="string">"dh/cpp/design.hpp"</span>
+
+<span class="comment">// With C++20, the coefficients can also be computed by the compiler.
+// The filter does not allocate memory and the coefficients are constants in the binary.</span>
+<span class="keyword">constexpr</span> <span class="type">dh_filter_parameters</span> filter_parameters() {
+    <span class="type">dh_filter_parameters</span> opts{};
+    opts.filter_type = <span class="enum">${enu}</span>;
+    opts.cutoff_frequency_low = <span class="number">${options.cutoffFrequencyLow}</span>;
+    opts.cutoff_frequency_high = <span class="number">${options.cutoffFrequencyHigh}</span>;
+    opts.sampling_frequency = <span class="number">${options.samplingFrequency}</span>;
+    opts.ripple = <span class="number">${options.ripple}</span>;
+    opts.filter_order = <span class="number">${order}</span>;
+    <span class="keyword">return</span> opts;
+}
+
+<span class="keyword">inline</span> <span class="type">dh::static_filter</span>&lt;<span class="number">${counts[0]}</span>, <span class="number">${counts[1]}</span>&gt; initialize_static_filter() {
+    <span class="keyword">static constexpr auto</span> coefficients = <span class="type">dh::design</span>&lt;<span class="enum">${enu}</span>, <span class="number">${order}</span>&gt;(filter_parameters());
+    <span class="keyword">return</span> <span class="type">dh::static_filter</span>&lt;<span class="number">${counts[0]}</span>, <span class="number">${counts[1]}</span>&gt;(coefficients);
+}
 </pre>`;
 }
 
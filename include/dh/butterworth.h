@@ -16,14 +16,15 @@ extern "C" {
 /**
  * @brief Computes all coefficients for a butterworth filter.
  * 
- * This function will allocate temporary buffers.
+ * This function will allocate temporary buffers unless [workspace] is given.
  * 
  * @param filter The data structure with the filter parameters. It will be modified in place (the coefficient arrays are initialized).
  * @param options The selected options for the filter.
  * @param characteristic The type of butterworth filter that will be created.
+ * @param workspace Optional scratch memory with dh_transfer_function_workspace_size() bytes. May be NULL.
  * @return DH_FILTER_RETURN_VALUE 
  */
-DH_FILTER_RETURN_VALUE dh_compute_butterworth_filter_coefficients(dh_filter_data* filter, dh_filter_parameters* options, DH_FILTER_CHARACTERISTIC characteristic);
+DH_FILTER_RETURN_VALUE dh_compute_butterworth_filter_coefficients(dh_filter_data* filter, dh_filter_parameters* options, DH_FILTER_CHARACTERISTIC characteristic, void* workspace);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,177 @@
+#ifndef DH_CIC_H_INCLUDED
+#define DH_CIC_H_INCLUDED
+
+/** @file
+ * @brief Cascaded integrator-comb (CIC) decimators and interpolators.
+ *
+ * A CIC filter with N stages, the rate change R and the differential delay M has the transfer function
+ * H(z) = ((1 - z^(-R*M)) / (1 - z^(-1)))^N at the high sampling rate. This is N moving sums of length R*M,
+ * but it is computed with N integrators at the high rate and N combs at the low rate, so every value costs
+ * only 2*N additions and no multiplications.
+ *
+ * The samples are 32 bit integers. The integrators and combs use unsigned 64 bit registers with wrap around:
+ * the integrators overflow, but the combs subtract the same overflow again. The outputs are exact as long as
+ * they fit into the registers, which is checked when the filter is created. The outputs are not scaled,
+ * the gain at 0 Hz is dh_cic_data::gain.
+ *
+ * The droop of the passband can be corrected with a FIR filter at the low rate designed by dh_cic_compensation_fir().
+ *
+ * This source code is licensed under the MIT license. See file "LICENSE" at the root of the repository.
+ */
+
+#include "dh/filter-types.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * The parameters for a CIC filter that will be created with dh_create_cic().
+ * @ingroup C-API
+ */
+typedef struct {
+    /** Number of integrator and comb stages N. Valid range: [1, inf] */
+    size_t stages;
+    /** Rate change R. A decimator keeps every R-th value, an interpolator computes R outputs per input. Valid range: [1, inf] */
+    size_t rate;
+    /** Differential delay M of the combs in values at the low rate. Usually 1 or 2. Valid range: [1, inf] */
+    size_t differential_delay;
+    /** If true, the filter is an interpolator. Otherwise it is a decimator. */
+    bool interpolator;
+} dh_cic_parameters;
+
+/**
+ * The data of a CIC filter. Create it with dh_create_cic() and free it with dh_free_cic().
+ * @ingroup C-API
+ */
+typedef struct {
+    /** Pointer to the allocated buffer for the registers. */
+    char* buffer;
+    /** Size of the buffer in bytes. */
+    size_t buffer_length;
+    /** The registers of the N integrators. */
+    uint64_t* integrators;
+    /** The delay lines of the N combs. The past values of comb k are stored at k*differential_delay. */
+    uint64_t* combs;
+    /** Number of stages N. */
+    size_t stages;
+    /** Rate change R. */
+    size_t rate;
+    /** Differential delay M. */
+    size_t differential_delay;
+    /** Index of the oldest value in the delay lines of the combs. */
+    size_t comb_index;
+    /** Number of inputs of a decimator since the last output. */
+    size_t phase;
+    /** Number of bits the outputs can be larger than the inputs. */
+    unsigned bit_growth;
+    /** The gain at 0 Hz: (R*M)^N for decimators and (R*M)^N/R for interpolators. */
+    double gain;
+    /** If true, the filter is an interpolator. */
+    bool interpolator;
+} dh_cic_data;
+
+/**
+ * @brief Allocates the registers of the CIC filter and sets them to zero.
+ *
+ * @param[out] cic The structure that will be initialized.
+ * @param[in] options The number of stages, the rate change and the differential delay.
+ * @return An enum with the result of the operation.
+ * @retval DH_FILTER_OK Operation was successfull
+ * @retval DH_FILTER_NO_DATA_STRUCTURE You gave NULL as argument.
+ * @retval DH_FILTER_ERROR A parameter was outside of its valid range, or the outputs would need more than 64 bits.
+ * @retval DH_FILTER_ALLOCATION_FAILED Not enough memory could be allocated.
+ * @ingroup C-API
+ */
+DH_FILTER_RETURN_VALUE dh_create_cic(dh_cic_data* cic, const dh_cic_parameters* options);
+
+/**
+ * @brief Computes how many outputs the next call of dh_cic_filter() with [input_count] values will write.
+ *
+ * @param[in] cic An initialized CIC filter.
+ * @param[in] input_count Number of input values.
+ * @return The number of output values.
+ * @ingroup C-API
+ */
+size_t dh_cic_output_count(const dh_cic_data* cic, size_t input_count);
+
+/**
+ * @brief Filters a block of values and changes the rate.
+ *
+ * The state is kept across calls, so a signal can be split into blocks of arbitrary length.
+ * The outputs are identical to filtering the whole signal at once.
+ *
+ * @param[in] cic An initialized CIC filter.
+ * @param[in] input Array with [input_count] values.
+ * @param[in] input_count Number of input values.
+ * @param[out] output Array with at least dh_cic_output_count() entries.
+ * @param[out] output_count The number of values written to [output]. Parameter is optional.
+ * @return An enum with the result of the operation.
+ * @retval DH_FILTER_OK Operation was successfull
+ * @retval DH_FILTER_NO_DATA_STRUCTURE You gave NULL as cic, input or output argument.
+ * @retval DH_FILTER_DATA_STRUCTURE_NOT_INITIALIZED The CIC filter was not correctly initialized.
+ * @ingroup C-API
+ */
+DH_FILTER_RETURN_VALUE dh_cic_filter(dh_cic_data* cic, const int32_t* input, size_t input_count, int64_t* output, size_t* output_count);
+
+/**
+ * @brief Computes the frequency response of the CIC filter divided by its gain at 0 Hz.
+ *
+ * @param[in] cic An initialized CIC filter.
+ * @param[in] frequency frequency/sampling_frequency at the high rate where the gain is computed. Range: [0,0.5]
+ * @param[out] gain pointer to output
+ * @return An enum with the result of the operation.
+ * @retval DH_FILTER_OK Operation was successfull
+ * @retval DH_FILTER_NO_DATA_STRUCTURE You gave NULL as argument.
+ * @retval DH_FILTER_DATA_STRUCTURE_NOT_INITIALIZED The CIC filter was not correctly initialized.
+ * @ingroup C-API
+ */
+DH_FILTER_RETURN_VALUE dh_cic_get_gain_at(const dh_cic_data* cic, double frequency, dh_frequency_response_t* gain);
+
+/**
+ * @brief Computes the coefficients of a FIR filter at the low rate that corrects the passband droop of the CIC filter.
+ *
+ * The desired response is 1/|H(f)| of the normalized CIC filter up to [cutoff] and 0 above. The coefficients are
+ * the coefficients of dh_fill_array_fir_sinc() plus the inverse Fourier transform of the difference between the desired
+ * response and the ideal lowpass, multiplied with a hamming window. The gain at 0 Hz is normalized to 1.
+ *
+ * @param[in] cic An initialized CIC filter.
+ * @param[out] coefficients Output array with [count] entries.
+ * @param[in] count Number of coefficients.
+ * @param[in] cutoff Cutoff frequency divided by the sampling frequency at the low rate. Range: (0,0.5]
+ * @return An enum with the result of the operation.
+ * @retval DH_FILTER_OK Operation was successfull
+ * @retval DH_FILTER_NO_DATA_STRUCTURE You gave NULL as argument.
+ * @retval DH_FILTER_DATA_STRUCTURE_NOT_INITIALIZED The CIC filter was not correctly initialized.
+ * @retval DH_FILTER_ERROR [count] is 0 or [cutoff] is outside of its valid range.
+ * @ingroup C-API
+ */
+DH_FILTER_RETURN_VALUE dh_cic_compensation_fir(const dh_cic_data* cic, double* coefficients, size_t count, double cutoff);
+
+/**
+ * @brief Sets all registers of the CIC filter to zero.
+ *
+ * @param[in] cic An initialized CIC filter.
+ * @return An enum with the result of the operation.
+ * @retval DH_FILTER_OK Operation was successfull
+ * @retval DH_FILTER_NO_DATA_STRUCTURE You gave NULL as first argument.
+ * @ingroup C-API
+ */
+DH_FILTER_RETURN_VALUE dh_reset_cic(dh_cic_data* cic);
+
+/**
+ * @brief Frees the buffers of a CIC filter created with dh_create_cic().
+ *
+ * @param[in] cic The CIC filter that will be freed.
+ * @return An enum with the result of the operation.
+ * @retval DH_FILTER_OK Operation was successfull
+ * @ingroup C-API
+ */
+DH_FILTER_RETURN_VALUE dh_free_cic(dh_cic_data* cic);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DH_CIC_H_INCLUDED */
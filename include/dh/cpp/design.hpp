@@ -0,0 +1,499 @@
+#ifndef DH_FILTER_DESIGN_CPP_INCLUDED
+#define DH_FILTER_DESIGN_CPP_INCLUDED
+
+/** @file
+ * @brief Filter design that can be evaluated at compile time (C++20).
+ *
+ * dh::design() computes the same coefficients as dh_create_filter() with DH_REALIZATION_DIRECT_FORM_1, but every
+ * function is constexpr. If the result is stored in a constexpr variable, the design costs nothing at runtime
+ * and the coefficients can be placed in read-only memory:
+ *
+ * ```C++
+ * constexpr dh_filter_parameters parameters{10.0, 0.0, 100.0, -3.0, 4, DH_IIR_BUTTERWORTH_LOWPASS, DH_REALIZATION_DEFAULT};
+ * static constexpr auto coefficients = dh::design<DH_IIR_BUTTERWORTH_LOWPASS, 4>(parameters);
+ * dh::static_filter<5, 5> filter(coefficients);
+ * ```
+ *
+ * The standard library has no constexpr versions of the transcendental functions and of std::complex before C++26,
+ * so this header contains its own implementations. They are accurate to a few units in the last place,
+ * so the coefficients differ from the ones computed at runtime only by rounding errors.
+ *
+ * This source code is licensed under the MIT license. See file "LICENSE" at the root of the repository.
+ */
+
+#if !(__cplusplus >= 202002L || (defined(_MSVC_LANG) && _MSVC_LANG >= 202002L))
+#error "dh/cpp/design.hpp requires C++20"
+#endif
+
+#include "dh/cpp/static_filter.hpp"
+#include "dh/filter-types.h"
+#include <array>
+#include <cstddef>
+#include <limits>
+
+namespace dh {
+
+namespace detail {
+
+/** Pi with double precision. */
+inline constexpr double pi = 3.14159265358979323846;
+
+/** Returns the absolute value of [x]. */
+constexpr double cx_abs(double x) noexcept {
+    return x < 0.0 ? -x : x;
+}
+
+/** Rounds [x] to the nearest integer. */
+constexpr long long cx_round(double x) noexcept {
+    return static_cast<long long>(x >= 0.0 ? x + 0.5 : x - 0.5);
+}
+
+/** Computes sin(r) for r in [-pi/4, pi/4] with a Taylor series. */
+constexpr double cx_sin_reduced(double r) noexcept {
+    const double r2 = r * r;
+    double term = r;
+    double sum = r;
+    for (int k=1; k<14; ++k) {
+        term *= -r2 / static_cast<double>((2*k) * (2*k + 1));
+        sum += term;
+    }
+    return sum;
+}
+
+/** Computes cos(r) for r in [-pi/4, pi/4] with a Taylor series. */
+constexpr double cx_cos_reduced(double r) noexcept {
+    const double r2 = r * r;
+    double term = 1.0;
+    double sum = 1.0;
+    for (int k=1; k<14; ++k) {
+        term *= -r2 / static_cast<double>((2*k - 1) * (2*k));
+        sum += term;
+    }
+    return sum;
+}
+
+/** Computes sin(x) (cosine == false) or cos(x) (cosine == true). x is reduced to [-pi/4, pi/4] with a two part pi/2 (Cody-Waite). */
+constexpr double cx_sin_cos(double x, bool cosine) noexcept {
+    constexpr double pio2_high = 1.57079632673412561417e+00;
+    constexpr double pio2_low = 6.07710050650619224932e-11;
+    const long long n = cx_round(x / (pi / 2.0));
+    const double r = (x - static_cast<double>(n) * pio2_high) - static_cast<double>(n) * pio2_low;
+    const long long quadrant = ((n % 4) + 4 + (cosine ? 1 : 0)) % 4;
+    switch (quadrant) {
+        case 0: return cx_sin_reduced(r);
+        case 1: return cx_cos_reduced(r);
+        case 2: return -cx_sin_reduced(r);
+        default: return -cx_cos_reduced(r);
+    }
+}
+
+/** Computes sin(x). */
+constexpr double cx_sin(double x) noexcept {
+    return cx_sin_cos(x, false);
+}
+
+/** Computes cos(x). */
+constexpr double cx_cos(double x) noexcept {
+    return cx_sin_cos(x, true);
+}
+
+/** Computes tan(x). */
+constexpr double cx_tan(double x) noexcept {
+    return cx_sin(x) / cx_cos(x);
+}
+
+/** Computes the square root of [x] >= 0 with Newton's method after scaling [x] to [0.25, 1). */
+constexpr double cx_sqrt(double x) noexcept {
+    if (!(x > 0.0)) {
+        return x == 0.0 ? 0.0 : std::numeric_limits<double>::quiet_NaN();
+    }
+    double scale = 1.0;
+    while (x >= 1.0) {
+        x *= 0.25;
+        scale *= 2.0;
+    }
+    while (x < 0.25) {
+        x *= 4.0;
+        scale *= 0.5;
+    }
+    double y = 0.5 * (1.0 + x);
+    for (int i=0; i<8; ++i) {
+        y = 0.5 * (y + x / y);
+    }
+    return y * scale;
+}
+
+/** Computes exp(x). x is reduced by multiples of ln(2) with a two part constant (Cody-Waite). */
+constexpr double cx_exp(double x) noexcept {
+    constexpr double ln2_high = 6.93147180369123816490e-01;
+    constexpr double ln2_low = 1.90821492927058770002e-10;
+    const long long n = cx_round(x / (ln2_high + ln2_low));
+    const double r = (x - static_cast<double>(n) * ln2_high) - static_cast<double>(n) * ln2_low;
+    double term = 1.0;
+    double sum = 1.0;
+    for (int k=1; k<25; ++k) {
+        term *= r / static_cast<double>(k);
+        sum += term;
+    }
+    for (long long i=0; i<n; ++i) {
+        sum *= 2.0;
+    }
+    for (long long i=0; i>n; --i) {
+        sum *= 0.5;
+    }
+    return sum;
+}
+
+/** Computes the natural logarithm of [x] > 0. The mantissa m in [sqrt(0.5), sqrt(2)) uses the series of 2*atanh((m-1)/(m+1)). */
+constexpr double cx_log(double x) noexcept {
+    constexpr double ln2_high = 6.93147180369123816490e-01;
+    constexpr double ln2_low = 1.90821492927058770002e-10;
+    constexpr double sqrt2 = 1.41421356237309504880;
+    if (!(x > 0.0)) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    long long exponent = 0;
+    while (x >= sqrt2) {
+        x *= 0.5;
+        ++exponent;
+    }
+    while (x < sqrt2 * 0.5) {
+        x *= 2.0;
+        --exponent;
+    }
+    const double s = (x - 1.0) / (x + 1.0);
+    const double s2 = s * s;
+    double power = s;
+    double sum = 0.0;
+    for (int k=0; k<30; ++k) {
+        sum += power / static_cast<double>(2*k + 1);
+        power *= s2;
+    }
+    const double e = static_cast<double>(exponent);
+    return (2.0 * sum + e * ln2_low) + e * ln2_high;
+}
+
+/** Computes sinh(x). */
+constexpr double cx_sinh(double x) noexcept {
+    const double e = cx_exp(x);
+    return 0.5 * (e - 1.0 / e);
+}
+
+/** Computes cosh(x). */
+constexpr double cx_cosh(double x) noexcept {
+    const double e = cx_exp(x);
+    return 0.5 * (e + 1.0 / e);
+}
+
+/** Computes asinh(x). */
+constexpr double cx_asinh(double x) noexcept {
+    const double a = cx_abs(x);
+    const double rv = cx_log(a + cx_sqrt(a * a + 1.0));
+    return x < 0.0 ? -rv : rv;
+}
+
+/** A complex number with constexpr arithmetic. */
+struct cx_complex {
+    /** Real part. */
+    double re = 0.0;
+    /** Imaginary part. */
+    double im = 0.0;
+};
+
+/** Addition. */
+constexpr cx_complex operator+(cx_complex a, cx_complex b) noexcept {
+    return {a.re + b.re, a.im + b.im};
+}
+
+/** Subtraction. */
+constexpr cx_complex operator-(cx_complex a, cx_complex b) noexcept {
+    return {a.re - b.re, a.im - b.im};
+}
+
+/** Negation. */
+constexpr cx_complex operator-(cx_complex a) noexcept {
+    return {-a.re, -a.im};
+}
+
+/** Multiplication. */
+constexpr cx_complex operator*(cx_complex a, cx_complex b) noexcept {
+    return {a.re * b.re - a.im * b.im, a.re * b.im + a.im * b.re};
+}
+
+/** Division with scaling by the larger part of the denominator (Smith's algorithm). */
+constexpr cx_complex operator/(cx_complex a, cx_complex b) noexcept {
+    if (cx_abs(b.re) >= cx_abs(b.im)) {
+        const double ratio = b.im / b.re;
+        const double denominator = b.re + b.im * ratio;
+        return {(a.re + a.im * ratio) / denominator, (a.im - a.re * ratio) / denominator};
+    }
+    const double ratio = b.re / b.im;
+    const double denominator = b.re * ratio + b.im;
+    return {(a.re * ratio + a.im) / denominator, (a.im * ratio - a.re) / denominator};
+}
+
+/** Computes the absolute value of [a]. */
+constexpr double cx_cabs(cx_complex a) noexcept {
+    return cx_sqrt(a.re * a.re + a.im * a.im);
+}
+
+/** Computes the principal square root of [a]. */
+constexpr cx_complex cx_csqrt(cx_complex a) noexcept {
+    const double magnitude = cx_cabs(a);
+    const double re = cx_sqrt(0.5 * (magnitude + a.re));
+    const double im = cx_sqrt(0.5 * (magnitude - a.re));
+    return {re, a.im < 0.0 ? -im : im};
+}
+
+/** Returns a point on the unit circle with the angle [phi]. */
+constexpr cx_complex cx_unit_circle(double phi) noexcept {
+    return {cx_cos(phi), cx_sin(phi)};
+}
+
+/** Returns true for all filter types that dh::design() supports. */
+constexpr bool design_is_supported(DH_FILTER_TYPE type) noexcept {
+    return (type >= DH_FIR_BRICKWALL_LOWPASS && type <= DH_FIR_BRICKWALL_BANDSTOP) ||
+        (type >= DH_IIR_BUTTERWORTH_LOWPASS && type <= DH_IIR_CHEBYSHEV2_BANDSTOP);
+}
+
+/** Returns the characteristic of an IIR filter type. */
+constexpr DH_FILTER_CHARACTERISTIC design_characteristic(DH_FILTER_TYPE type) noexcept {
+    if (type >= DH_IIR_BUTTERWORTH_LOWPASS) {
+        return static_cast<DH_FILTER_CHARACTERISTIC>((type - DH_IIR_BUTTERWORTH_LOWPASS) % 4);
+    }
+    return static_cast<DH_FILTER_CHARACTERISTIC>(type - DH_FIR_BRICKWALL_LOWPASS);
+}
+
+/** Computes the transfer function polynomial from the roots of an analog lowpass on the s-plane. Same as the C function compute_transferfunction_polynomial().
+ *
+ * @param roots Array with the roots. Needs at least 2*target_count entries.
+ * @param count Number of roots in the array.
+ * @param output Array where the polynomial is written to, index 0 is the coefficient of the highest power.
+ * @return Number of coefficients in [output].
+ */
+template<std::size_t Length, std::size_t OutputLength>
+constexpr std::size_t design_polynomial(DH_FILTER_CHARACTERISTIC type, std::array<cx_complex, Length>& roots, std::size_t count,
+                                        double center, double width, std::array<double, OutputLength>& output, std::size_t target_count) noexcept {
+    const cx_complex halfwidth{0.5 * width, 0.0};
+    const cx_complex center_squared = cx_complex{center, 0.0} * cx_complex{center, 0.0};
+    switch (type) {
+    case DH_LOWPASS:
+        for (std::size_t i=0; i<count; ++i) {
+            roots[i] = roots[i] * cx_complex{center, 0.0};
+        }
+        break;
+    case DH_HIGHPASS:
+        for (std::size_t i=0; i<count; ++i) {
+            roots[i] = cx_complex{center, 0.0} / roots[i];
+        }
+        for (; count<target_count; ++count) {
+            roots[count] = cx_complex{0.0, 0.0};
+        }
+        break;
+    case DH_BANDPASS:
+    case DH_BANDSTOP: {
+        const std::size_t number_roots = count;
+        for (std::size_t i=0; i<number_roots; ++i) {
+            const cx_complex current = type == DH_BANDPASS ? halfwidth * roots[i] : halfwidth / roots[i];
+            const cx_complex shift = cx_csqrt(current * current - center_squared);
+            roots[i] = current + shift;
+            roots[i + number_roots] = current - shift;
+        }
+        count = 2 * number_roots;
+        const std::size_t append = target_count - number_roots;
+        for (std::size_t i=0; i<append; ++i) {
+            roots[count++] = type == DH_BANDPASS ? cx_complex{0.0, 0.0} : cx_complex{0.0, center};
+        }
+        if (type == DH_BANDSTOP) {
+            for (std::size_t i=0; i<append; ++i) {
+                roots[count++] = cx_complex{0.0, -center};
+            }
+        }
+        target_count = 2 * target_count;
+        break;
+    }
+    }
+    // bilinear z-transform with the normalized sampling frequency 2.0
+    const cx_complex sampling{4.0, 0.0};
+    for (std::size_t i=0; i<count; ++i) {
+        roots[i] = (sampling + roots[i]) / (sampling - roots[i]);
+    }
+    for (; count<target_count; ++count) {
+        roots[count] = cx_complex{-1.0, 0.0};
+    }
+
+    const std::size_t length = count + 1;
+    std::array<cx_complex, Length + 1> polynomial{};
+    polynomial[0] = -roots[0];
+    polynomial[1] = cx_complex{1.0, 0.0};
+    for (std::size_t i=2; i<length; ++i) {
+        polynomial[i] = polynomial[i-1];
+        for (std::size_t k=i-1; k>=1; --k) {
+            polynomial[k] = polynomial[k-1] - polynomial[k] * roots[i-1];
+        }
+        polynomial[0] = (-polynomial[0]) * roots[i-1];
+    }
+    for (std::size_t i=0; i<length; ++i) {
+        output[length-1-i] = polynomial[i].re;
+    }
+    return length;
+}
+
+/** Evaluates a polynomial with the coefficient of the highest power at index 0. */
+template<std::size_t N>
+constexpr cx_complex design_evaluate(const std::array<double, N>& coefficients, std::size_t count, cx_complex x) noexcept {
+    cx_complex rv{0.0, 0.0};
+    for (std::size_t i=0; i<count; ++i) {
+        rv = rv * x + cx_complex{coefficients[i], 0.0};
+    }
+    return rv;
+}
+
+/** Scales the numerator so that the gain at the normalized frequency [frequency] is 1. */
+template<std::size_t NumIn, std::size_t NumOut>
+constexpr void design_normalize(std::array<double, NumIn>& numerator, std::size_t count_numerator,
+                                const std::array<double, NumOut>& denominator, std::size_t count_denominator, double frequency) noexcept {
+    const cx_complex x = cx_unit_circle(2.0 * pi * frequency);
+    const cx_complex gain = design_evaluate(numerator, count_numerator, x) / design_evaluate(denominator, count_denominator, x);
+    const double scale = cx_cabs(cx_complex{1.0, 0.0} / gain);
+    for (std::size_t i=0; i<count_numerator; ++i) {
+        numerator[i] *= scale;
+    }
+}
+
+/** Computes the sinc lowpass or highpass with [N] coefficients. Same as the C function dh_fill_array_fir_sinc(). */
+template<std::size_t N>
+constexpr std::array<double, N> design_sinc(double cutoff, bool highpass) noexcept {
+    std::array<double, N> data{};
+    const int shift = static_cast<int>(N) / 2;
+    for (std::size_t i=0; i<N; ++i) {
+        const double x = 2.0 * pi * cutoff * static_cast<double>(static_cast<int>(i) - shift);
+        data[i] = x != 0.0 ? cx_sin(x) / x : 1.0;
+    }
+    const std::array<double, 1> one{1.0};
+    design_normalize(data, N, one, 1, 0.0);
+    if (highpass) {
+        for (std::size_t i=0; i<N; ++i) {
+            data[i] = i != static_cast<std::size_t>(shift) ? -data[i] : 1.0 - data[i];
+        }
+    }
+    return data;
+}
+
+}
+
+/** Number of feedforward coefficients of a filter computed by dh::design().
+ * @ingroup cpp-API
+ */
+constexpr std::size_t design_number_feedforward(DH_FILTER_TYPE type, std::size_t order) noexcept {
+    return type == DH_FIR_BRICKWALL_LOWPASS || type == DH_FIR_BRICKWALL_HIGHPASS || type == DH_FIR_BRICKWALL_BANDSTOP ? order + 1 :
+        type == DH_FIR_BRICKWALL_BANDPASS ? 2 * order + 1 :
+        detail::design_characteristic(type) == DH_LOWPASS || detail::design_characteristic(type) == DH_HIGHPASS ? order + 1 : 2 * order + 1;
+}
+
+/** Number of feedback coefficients of a filter computed by dh::design().
+ * @ingroup cpp-API
+ */
+constexpr std::size_t design_number_feedback(DH_FILTER_TYPE type, std::size_t order) noexcept {
+    return type >= DH_IIR_BUTTERWORTH_LOWPASS ? design_number_feedforward(type, order) : 1;
+}
+
+/**
+ * @brief Designs the filter [Type] with the order [Order] at compile time.
+ *
+ * Supported are the Butterworth, Chebyshev type 1 and 2 filters and the sinc FIR filters (DH_FIR_BRICKWALL_*).
+ * The coefficients are the same as the ones of dh_create_filter() with DH_REALIZATION_DIRECT_FORM_1 up to rounding errors.
+ * The type and order are template parameters, because they determine the number of coefficients. They must
+ * match filter_type and filter_order in [parameters], otherwise the design fails at compile time
+ * (or throws dh::filter_error at runtime).
+ *
+ * @param[in] parameters The parameters of the filter. The realization is ignored.
+ * @return The coefficients. Use them to construct a dh::static_filter.
+ * @ingroup cpp-API
+ */
+template<DH_FILTER_TYPE Type, std::size_t Order>
+constexpr design_coefficients<design_number_feedforward(Type, Order), design_number_feedback(Type, Order)> design(const dh_filter_parameters& parameters)
+{
+    static_assert(detail::design_is_supported(Type), "dh::design() supports Butterworth, Chebyshev and sinc FIR filters");
+    static_assert(Order > 0, "The order of the filter must be at least 1");
+    if (parameters.filter_type != Type || parameters.filter_order != Order) {
+        throw filter_error("The filter type or order does not match the template parameters");
+    }
+    constexpr std::size_t number_in = design_number_feedforward(Type, Order);
+    constexpr std::size_t number_out = design_number_feedback(Type, Order);
+    design_coefficients<number_in, number_out> rv{};
+    const DH_FILTER_CHARACTERISTIC characteristic = detail::design_characteristic(Type);
+    const double low = parameters.cutoff_frequency_low / parameters.sampling_frequency;
+    const double high = parameters.cutoff_frequency_high / parameters.sampling_frequency;
+
+    if (Type <= DH_FIR_BRICKWALL_BANDSTOP) {
+        rv.feedback[0] = 1.0;
+        rv.initialized = Type != DH_FIR_BRICKWALL_LOWPASS;
+        if (Type == DH_FIR_BRICKWALL_LOWPASS || Type == DH_FIR_BRICKWALL_HIGHPASS) {
+            const auto sinc = detail::design_sinc<Order + 1>(low, Type == DH_FIR_BRICKWALL_HIGHPASS);
+            for (std::size_t i=0; i<number_in; ++i) {
+                rv.feedforward[i] = sinc[i];
+            }
+            return rv;
+        }
+        const bool bandpass = Type == DH_FIR_BRICKWALL_BANDPASS;
+        const auto first = detail::design_sinc<Order + 1>(low, bandpass);
+        const auto second = detail::design_sinc<Order + 1>(high, !bandpass);
+        for (std::size_t i=0; i<Order + 1; ++i) {
+            if (bandpass) {
+                for (std::size_t k=0; k<Order + 1; ++k) {
+                    rv.feedforward[i + k] += first[i] * second[k];
+                }
+            } else {
+                rv.feedforward[i] = first[i] + second[i];
+            }
+        }
+        return rv;
+    }
+
+    const double warped_low = 4.0 * detail::cx_tan(low * detail::pi);
+    const double warped_high = 4.0 * detail::cx_tan(high * detail::pi);
+    const bool band = characteristic == DH_BANDPASS || characteristic == DH_BANDSTOP;
+    const double center = band ? detail::cx_sqrt(warped_low * warped_high) : warped_low;
+    const double width = band ? warped_high - warped_low : 0.0;
+    const bool chebyshev = Type >= DH_IIR_CHEBYSHEV_LOWPASS;
+    const bool type2 = Type >= DH_IIR_CHEBYSHEV2_LOWPASS;
+
+    std::array<detail::cx_complex, 2 * Order> roots{};
+    std::size_t number_zeros = 0;
+    if (type2) {
+        for (std::size_t i=0; i<Order; ++i) {
+            const double phi = static_cast<double>(2*i + 1) * detail::pi / static_cast<double>(2 * Order);
+            roots[i] = detail::cx_complex{0.0, 1.0 / detail::cx_cos(phi)};
+        }
+        number_zeros = Order;
+    }
+    number_zeros = detail::design_polynomial(characteristic, roots, number_zeros, center, width, rv.feedforward, Order);
+
+    for (std::size_t i=0; i<Order; ++i) {
+        const double phi = static_cast<double>(2*i + 1) * detail::pi / static_cast<double>(2 * Order) + detail::pi / 2.0;
+        roots[i] = detail::cx_unit_circle(phi);
+    }
+    if (chebyshev) {
+        const double ripple_power = detail::cx_exp(-parameters.ripple / 10.0 * detail::cx_log(10.0));
+        const double arg = detail::cx_asinh(1.0 / detail::cx_sqrt(ripple_power - 1.0)) / static_cast<double>(Order);
+        const double sinh_arg = detail::cx_sinh(arg);
+        const double cosh_arg = detail::cx_cosh(arg);
+        for (std::size_t i=0; i<Order; ++i) {
+            roots[i] = detail::cx_complex{roots[i].re * sinh_arg, roots[i].im * cosh_arg};
+            if (type2) {
+                roots[i] = detail::cx_complex{1.0, 0.0} / roots[i];
+            }
+        }
+    }
+    const std::size_t number_poles = detail::design_polynomial(characteristic, roots, Order, center, width, rv.feedback, Order);
+
+    const double frequency = characteristic == DH_HIGHPASS ? 0.5 : characteristic == DH_BANDPASS ? 0.5 * (low + high) : 0.0;
+    detail::design_normalize(rv.feedforward, number_zeros, rv.feedback, number_poles, frequency);
+    rv.initialized = characteristic != DH_LOWPASS;
+    return rv;
+}
+
+}
+
+#endif /* DH_FILTER_DESIGN_CPP_INCLUDED */
@@ -23,7 +23,7 @@
  * 
  * Here is an example for the basic usage of the API:
  * ```C
- * dh::filter::parameters_t parameters;
+ * dh::filter::parameters_t parameters{};
  * // set values in parameters to create your desired filter
  * auto filter = dh::filter(parameters);
  * // the filter is ready to be used
@@ -32,10 +32,50 @@
  *     // use output
  * }
  * ```
+ * 
+ * dh::filter computes with double precision. Use dh::basic_filter<float> (or dh::filter_f32) for
+ * single precision. See dh_create_filter_f32() for the supported filters.
  */
 
 namespace dh {
 
+/** Maps the sample type of a filter to the data structure of the C-API.
+ * @ingroup cpp-API
+ */
+template<typename T>
+struct filter_data;
+
+/** Double precision filters use dh_filter_data. */
+template<>
+struct filter_data<double> {
+    /** The data structure. */
+    using type = dh_filter_data;
+};
+
+/** Single precision filters use dh_filter_data_f32. */
+template<>
+struct filter_data<float> {
+    /** The data structure. */
+    using type = dh_filter_data_f32;
+};
+
+/** This class is thrown in case of errors.
+ * @ingroup cpp-API
+ */
+class filter_error {
+public:
+    /** Constructor that sets the error message. */
+    filter_error(const char* str) : str_(str) {}
+
+    /** Returns a string describing what went wrong. */
+    const char* what() const noexcept {
+        return str_;
+    }
+
+private:
+    const char* str_;
+};
+
 /**
  * @brief This class holds the C++ bindings to the filter library.
  * 
@@ -44,35 +84,44 @@ namespace dh {
  * the given parameters are invalid, you are out of memory or if the filter
  * structure was moved from.
  * 
+ * The template parameter is the type of the samples: double or float.
+ * 
  * @throws dh::filter::error in case something goes wrong.
  * @ingroup cpp-API
  */
-class filter {
+template<typename T>
+class basic_filter {
 public:
     /** Typedef to the parameter structure */
     using parameters_t = dh_filter_parameters;
 
+    /** The type of the inputs and outputs. */
+    using sample_t = T;
+
+    /** This class is thrown in case of errors. */
+    using error = filter_error;
+
     /** @brief Constructs a filter with the given options.
      * @throws dh::filter::error in case something goes wrong.
      * @see dh_filter_parameters
      */
-    filter(parameters_t options);
+    basic_filter(parameters_t options);
 
     /** @brief Deep copy. */
-    filter(const filter&);
+    basic_filter(const basic_filter&);
 
     /** @brief Deep copy. */
-    filter& operator=(const filter&);
+    basic_filter& operator=(const basic_filter&);
 
     /** @brief Move constructor. 
      * @warning The other filter object becomes invalid and can no longer be used. */
-    filter(filter&&);
+    basic_filter(basic_filter&&);
 
     /** @brief Move assignment. 
      * @warning The other filter object becomes invalid and can no longer be used. */
-    filter& operator=(filter&&);
+    basic_filter& operator=(basic_filter&&);
 
-    ~filter();
+    ~basic_filter();
 
     /**
      * @brief Updates the internal state of the filter with a new input value
@@ -81,14 +130,27 @@ public:
      * @param[in] in The next input value.
      * @return The current output value of the filter.
      */
-    double update(double in);
+    T update(T in);
+
+    /**
+     * @brief Updates the internal state of the filter with [count] input values
+     * and writes the filtered values to [out].
+     * 
+     * The result is identical to calling update() for each value, except for filters with the realization
+     * DH_REALIZATION_OVERLAP_SAVE. They are equal up to rounding errors, see dh_filter_block().
+     * 
+     * @param[in] in Array with the next input values.
+     * @param[out] out Array where the output values are written to. May be the same array as [in].
+     * @param[in] count Number of values to filter.
+     */
+    void update(const T* in, T* out, size_t count);
 
     /**
      * @brief Returns the filtered value without changing the state of the filter.
      * 
      * @return The last output of update().
      */
-    double current_value() const noexcept {
+    T current_value() const noexcept {
         return data_.current_value;
     }
 
@@ -100,10 +162,10 @@ public:
     /** Sets the current gain of the filter.
      * @param[in] gain The desired gain.
      **/
-    void set_gain(double gain);
+    void set_gain(T gain);
 
     /** Gets the current gain of the filter. */
-    double gain() const;
+    T gain() const;
 
     /**
      * @brief Computes the frequency response of the filter and returns
@@ -111,6 +173,7 @@ public:
      * 
      * The response is computed in the range of [0,sampling_frequency/2].
      * The distance between the entries will be half of sampling_frequency/count. 
+     * Single precision filters return the response of the filter that was designed with double precision.
      * 
      * @param[in] count Number values to compute
      * @return Frequency response curve. 
@@ -141,21 +204,6 @@ public:
      */
     std::vector<graph_point> compute_impulse_response() const;
 
-    /** This class is thrown in case of errors. */
-    class error {
-    public:
-        /** Constructor that sets the error message. */
-        error(const char* str) : str_(str) {}
-
-        /** Returns a string describing what went wrong. */
-        const char* what() const noexcept {
-            return str_;
-        }
-
-    private:
-        const char* str_;
-    };
-
     /** checks if the filter is usable. (False if object was moved from) */
     bool good() const noexcept;
 
@@ -163,15 +211,15 @@ public:
     class span {
         public:
             /** Constructor that sets the range. */
-            span(double* begin,size_t size) : begin_(begin), end_(begin+size) {}
+            span(const T* begin,size_t size) : begin_(begin), end_(begin+size) {}
 
             /** Start of the range. */
-            const double* begin() const noexcept {
+            const T* begin() const noexcept {
                 return begin_;
             }
             
             /** End of the range. */
-            const double* end() const noexcept {
+            const T* end() const noexcept {
                 return end_;
             }
 
@@ -181,35 +229,47 @@ public:
             }
 
             /** Random access operator. */
-            double operator[](size_t i) const noexcept {
+            T operator[](size_t i) const noexcept {
                 return begin_[i];
             }
 
         private:
-            const double* begin_;
-            const double* end_;
+            const T* begin_;
+            const T* end_;
     };
 
     /** Returns a range of the input coefficients of the filter.
      * 
-     * @note May return an empty range!
+     * @note May return an empty range! Single precision IIR filters only have second order sections.
      */
     span feedforward_coefficients() const noexcept;
 
     /** Returns a range of the output coefficients. 
      * 
-     * @note May return an empty range!
+     * @note May return an empty range! Always empty for single precision filters.
      */
     span feedback_coefficients() const noexcept;
 
 private:
     dh_filter_parameters options_{};
-    dh_filter_data data_{};
+    typename filter_data<T>::type data_{};
 
     void create_internal_data();
-    void deep_copy(const dh_filter_data& other);
+    void deep_copy(const typename filter_data<T>::type& other);
 };
 
+/** A filter that computes with double precision.
+ * @ingroup cpp-API
+ */
+using filter = basic_filter<double>;
+
+/** A filter that computes with single precision.
+ * @ingroup cpp-API
+ */
+using filter_f32 = basic_filter<float>;
+
+extern template class basic_filter<double>;
+extern template class basic_filter<float>;
 
 }
 
@@ -0,0 +1,258 @@
+#ifndef DH_FILTER_STATIC_FILTER_CPP_INCLUDED
+#define DH_FILTER_STATIC_FILTER_CPP_INCLUDED
+
+/** @file
+ * @brief A header-only C++ filter whose number of coefficients is fixed at compile time.
+ *
+ * This source code is licensed under the MIT license. See file "LICENSE" at the root of the repository.
+ */
+
+#include "dh/cpp/filter.hpp"
+#include "dh/filter.h"
+#include <array>
+#include <cstddef>
+
+namespace dh {
+
+namespace detail {
+
+/** Computes the sum of coefficients[k]*values[k] for k in [First, Last) in ascending order. Every step is a separate template instance, so the loop is always unrolled. */
+template<std::size_t First, std::size_t Last>
+struct unrolled_dot_product {
+    /** Adds the products to [sum] and returns the result. */
+    template<std::size_t N>
+    static inline double run(const std::array<double, N>& coefficients, const std::array<double, N>& values, double sum) noexcept {
+        return unrolled_dot_product<First + 1, Last>::run(coefficients, values, sum + coefficients[First] * values[First]);
+    }
+};
+
+/** End of the recursion. */
+template<std::size_t Last>
+struct unrolled_dot_product<Last, Last> {
+    /** Returns [sum]. */
+    template<std::size_t N>
+    static inline double run(const std::array<double, N>&, const std::array<double, N>&, double sum) noexcept {
+        return sum;
+    }
+};
+
+/** Moves values[k-1] to values[k] for k in [1, Count), starting with the oldest value. */
+template<std::size_t Count>
+struct unrolled_shift {
+    /** Shifts the values by one position. */
+    template<std::size_t N>
+    static inline void run(std::array<double, N>& values) noexcept {
+        values[Count - 1] = values[Count - 2];
+        unrolled_shift<Count - 1>::run(values);
+    }
+};
+
+/** End of the recursion. */
+template<>
+struct unrolled_shift<1> {
+    /** Nothing to shift. */
+    template<std::size_t N>
+    static inline void run(std::array<double, N>&) noexcept {}
+};
+
+}
+
+/**
+ * @brief The coefficients of a filter in direct form 1 with [NumIn] feedforward and [NumOut] feedback coefficients.
+ *
+ * The layout is the same as in dh_filter_data: feedback[0] is the gain. Computed by dh::design().
+ * @ingroup cpp-API
+ */
+template<std::size_t NumIn, std::size_t NumOut>
+struct design_coefficients {
+    /** The feedforward coefficients. */
+    std::array<double, NumIn> feedforward;
+    /** The feedback coefficients. The first entry is the gain. */
+    std::array<double, NumOut> feedback;
+    /** If true, the filter starts with zeros. Otherwise the first input sets the steady state. */
+    bool initialized;
+};
+
+/**
+ * @brief A filter in direct form 1 with [NumIn] feedforward and [NumOut] feedback coefficients.
+ *
+ * The coefficients and the past values are stored in std::array members, so the object never allocates memory
+ * after it was constructed and is trivially copyable. update() and process() are defined in the header and the
+ * loops over the coefficients are unrolled at compile time.
+ *
+ * The filter is designed from the same dh_filter_parameters as dh::filter. The realization in the parameters is
+ * ignored, the filter is always computed in direct form 1. Its outputs are identical to dh::filter with
+ * DH_REALIZATION_DIRECT_FORM_1 for IIR filters and for FIR filters with fewer than DH_FILTER_SIMD_MIN_COEFFICIENTS
+ * coefficients. Longer FIR filters in dh::filter use a vectorized dot product with a different summation order,
+ * so the outputs are only equal up to rounding. The numbers of coefficients depend on the filter type and order:
+ *
+ * - FIR filters of order N: static_filter<N+1, 1>
+ * - IIR lowpass and highpass filters of order N: static_filter<N+1, N+1>
+ * - IIR bandpass and bandstop filters of order N: static_filter<2*N+1, 2*N+1>
+ * - DH_IIR_EXPONENTIAL_LOWPASS: static_filter<1, 2>
+ *
+ * As for the C-API, the first value that is filtered sets lowpass filters to their steady state
+ * unless initialize() was called. All other filters start with zeros.
+ *
+ * @throws dh::filter_error if the filter cannot be designed or the numbers of coefficients do not match.
+ * @ingroup cpp-API
+ */
+template<std::size_t NumIn, std::size_t NumOut>
+class static_filter {
+    static_assert(NumIn > 0, "A filter needs at least one feedforward coefficient");
+    static_assert(NumOut > 0, "A filter needs at least the gain as feedback coefficient");
+public:
+    /** Typedef to the parameter structure */
+    using parameters_t = dh_filter_parameters;
+
+    /** This class is thrown in case of errors. */
+    using error = filter_error;
+
+    /** @brief Designs the filter with the given options.
+     *
+     * The design uses dh_create_filter(), so the constructor allocates and frees temporary memory.
+     * @throws dh::filter_error in case something goes wrong.
+     */
+    explicit static_filter(parameters_t options) : options_(options) {
+        options.realization = DH_REALIZATION_DIRECT_FORM_1;
+        dh_filter_data data{};
+        switch (dh_create_filter(&data, &options)) {
+        case DH_FILTER_OK:
+            break;
+        case DH_FILTER_UNKNOWN_FILTER_TYPE:
+            throw error("Unkown filter type");
+        case DH_FILTER_ALLOCATION_FAILED:
+            throw error("Allocation of filter failed");
+        case DH_FILTER_UNSUPPORTED_REALIZATION:
+            throw error("Unsupported realization");
+        default:
+            throw error("Unspecified error");
+        }
+        if (data.number_coefficients_in != NumIn || data.number_coefficients_out != NumOut) {
+            dh_free_filter(&data);
+            throw error("The number of coefficients does not match the template parameters");
+        }
+        for (std::size_t k=0; k<NumIn; ++k) {
+            coefficients_in_[k] = data.coefficients_in[k];
+        }
+        for (std::size_t k=0; k<NumOut; ++k) {
+            coefficients_out_[k] = data.coefficients_out[k];
+        }
+        // filters that must not start in the steady state of the first input (e.g. highpass) start with zeros
+        const bool initialized = data.initialized;
+        dh_free_filter(&data);
+        initialize(0.0);
+        initialized_ = initialized;
+    }
+
+    /** @brief Creates the filter from coefficients that were computed before, e.g. with dh::design() at compile time.
+     *
+     * The options() of the filter are all zero.
+     */
+    explicit static_filter(const design_coefficients<NumIn, NumOut>& coefficients) noexcept
+        : options_(), coefficients_in_(coefficients.feedforward), coefficients_out_(coefficients.feedback) {
+        initialize(0.0);
+        initialized_ = coefficients.initialized;
+    }
+
+    /**
+     * @brief Updates the internal state of the filter with a new input value
+     * and returns the updated filtered value.
+     *
+     * @param[in] in The next input value.
+     * @return The current output value of the filter.
+     */
+    double update(double in) noexcept {
+        if (!initialized_) {
+            initialize(in);
+        }
+        detail::unrolled_shift<NumIn>::run(inputs_);
+        inputs_[0] = in;
+        double value = detail::unrolled_dot_product<0, NumIn>::run(coefficients_in_, inputs_, 0.0);
+        if (NumOut > 1) {
+            detail::unrolled_shift<NumOut>::run(outputs_);
+            value -= detail::unrolled_dot_product<1, NumOut>::run(coefficients_out_, outputs_, 0.0);
+            outputs_[0] = value;
+        }
+        current_value_ = value * coefficients_out_[0];
+        return current_value_;
+    }
+
+    /**
+     * @brief Filters [count] values and writes the filtered values to [out].
+     *
+     * The result is identical to calling update() for each value.
+     *
+     * @param[in] in Array with the next input values.
+     * @param[out] out Array where the output values are written to. May be the same array as [in].
+     * @param[in] count Number of values to filter.
+     */
+    void process(const double* in, double* out, std::size_t count) noexcept {
+        for (std::size_t i=0; i<count; ++i) {
+            out[i] = update(in[i]);
+        }
+    }
+
+    /**
+     * @brief Forces the filter to the steady state by setting all past inputs and outputs to [value].
+     *
+     * Same as dh_initialize_filter().
+     * @param[in] value the desired steady state
+     */
+    void initialize(double value) noexcept {
+        inputs_.fill(value);
+        outputs_.fill(value);
+        current_value_ = value;
+        initialized_ = true;
+    }
+
+    /**
+     * @brief Returns the filtered value without changing the state of the filter.
+     *
+     * @return The last output of update().
+     */
+    double current_value() const noexcept {
+        return current_value_;
+    }
+
+    /** Returns the configuration of the filter. */
+    const parameters_t& options() const noexcept {
+        return options_;
+    }
+
+    /** Sets the current gain of the filter.
+     * @param[in] gain The desired gain.
+     **/
+    void set_gain(double gain) noexcept {
+        current_value_ *= gain / coefficients_out_[0];
+        coefficients_out_[0] = gain;
+    }
+
+    /** Gets the current gain of the filter. */
+    double gain() const noexcept {
+        return coefficients_out_[0];
+    }
+
+    /** Returns the feedforward coefficients. */
+    const std::array<double, NumIn>& feedforward_coefficients() const noexcept {
+        return coefficients_in_;
+    }
+
+    /** Returns the feedback coefficients. The first entry is the gain. */
+    const std::array<double, NumOut>& feedback_coefficients() const noexcept {
+        return coefficients_out_;
+    }
+
+private:
+    parameters_t options_;
+    std::array<double, NumIn> coefficients_in_{};
+    std::array<double, NumOut> coefficients_out_{};
+    std::array<double, NumIn> inputs_{};
+    std::array<double, NumOut> outputs_{};
+    double current_value_ = 0.0;
+    bool initialized_ = false;
+};
+
+}
+
+#endif /* DH_FILTER_STATIC_FILTER_CPP_INCLUDED */
@@ -0,0 +1,137 @@
+#ifndef DH_DOT_PRODUCT_H_INCLUDED
+#define DH_DOT_PRODUCT_H_INCLUDED
+
+/** @file
+ * @brief Vectorized dot products that are used to compute the outputs of FIR filters.
+ *
+ * The instruction set is detected at runtime, so the library can be compiled once and used on
+ * all x86 processors. On other architectures, only the scalar version is available.
+ *
+ * This source code is licensed under the MIT license. See file "LICENSE" at the root of the repository.
+ */
+
+#include "dh/filter-types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** The instruction sets that can be used to compute dot products.
+ * Higher values are faster, and every processor supporting a value also supports all lower values.
+ */
+typedef enum {
+    /** Plain C code. Always available. */
+    DH_SIMD_NONE,
+    /** 128 bit vectors. */
+    DH_SIMD_SSE2,
+    /** 256 bit vectors and fused multiply add. */
+    DH_SIMD_AVX2,
+    /** 512 bit vectors and fused multiply add. */
+    DH_SIMD_AVX512
+} DH_SIMD_INSTRUCTION_SET;
+
+/** The minimum number of coefficients of a FIR filter before a vectorized dot product is used. */
+#define DH_FILTER_SIMD_MIN_COEFFICIENTS 16
+
+/**
+ * @brief Detects the best instruction set that is supported by the processor and the operating system.
+ *
+ * Always returns DH_SIMD_NONE if the library was compiled without SIMD support or for a different architecture than x86.
+ * @return The best supported instruction set.
+ */
+DH_SIMD_INSTRUCTION_SET dh_detect_simd_instruction_set(void);
+
+/**
+ * @brief Returns the dot product function for the given instruction set.
+ *
+ * @param set The requested instruction set.
+ * @return Pointer to the function or NULL if the instruction set is not supported on this machine.
+ */
+dh_dot_product_function dh_get_dot_product_function(DH_SIMD_INSTRUCTION_SET set);
+
+/**
+ * @brief Selects the dot product function for a FIR filter with the given number of coefficients.
+ *
+ * @param number_coefficients Number of feedforward coefficients of the filter.
+ * @return Pointer to the fastest supported function, or NULL if the filter should use the plain loops.
+ */
+dh_dot_product_function dh_select_dot_product_function(size_t number_coefficients);
+
+/**
+ * @brief Computes the dot product of the given arrays with a simple loop.
+ *
+ * @param coefficients Array with [count] entries.
+ * @param data Array with [count] entries.
+ * @param count Number of entries in both arrays.
+ * @return The sum of coefficients[i]*data[i].
+ */
+double dh_dot_product_scalar(const double* coefficients, const double* data, size_t count);
+
+/**
+ * @brief Returns the folded dot product function for the given instruction set and symmetry.
+ *
+ * A folded dot product reads only the first (count+1)/2 coefficients. The inputs that are multiplied with
+ * the same coefficient are added (or subtracted for antisymmetric coefficients) first.
+ * The data array must hold all [count] inputs in one contiguous range.
+ *
+ * @param set The requested instruction set.
+ * @param symmetry The symmetry of the coefficients.
+ * @return Pointer to the function or NULL if the instruction set is not supported on this machine or the coefficients are not symmetric.
+ */
+dh_dot_product_function dh_get_folded_dot_product_function(DH_SIMD_INSTRUCTION_SET set, DH_FIR_SYMMETRY symmetry);
+
+/**
+ * @brief Selects the folded dot product function for a FIR filter with the given number of coefficients.
+ *
+ * Unlike dh_select_dot_product_function(), short filters use the scalar folded version instead of NULL.
+ * @param number_coefficients Number of feedforward coefficients of the filter.
+ * @param symmetry The symmetry of the coefficients.
+ * @return Pointer to the fastest supported function or NULL if the coefficients are not symmetric.
+ */
+dh_dot_product_function dh_select_folded_dot_product_function(size_t number_coefficients, DH_FIR_SYMMETRY symmetry);
+
+/**
+ * @brief Checks if FIR coefficients are symmetric or antisymmetric.
+ *
+ * Designed coefficients can differ in the last bits, so the pairs are compared relative to the
+ * largest coefficient. If a symmetry is detected, the second half is overwritten with the (negated) first half,
+ * so that the folded dot products compute exactly the same filter as the coefficients.
+ *
+ * @param coefficients Array with [count] entries. Modified if a symmetry is detected.
+ * @param count Number of coefficients.
+ * @return The detected symmetry.
+ */
+DH_FIR_SYMMETRY dh_detect_fir_symmetry(double* coefficients, size_t count);
+
+/**
+ * @brief Returns the single precision dot product function for the given instruction set.
+ *
+ * @param set The requested instruction set.
+ * @return Pointer to the function or NULL if the instruction set is not supported on this machine.
+ */
+dh_dot_product_function_f32 dh_get_dot_product_function_f32(DH_SIMD_INSTRUCTION_SET set);
+
+/**
+ * @brief Selects the single precision dot product function for a FIR filter with the given number of coefficients.
+ *
+ * Unlike dh_select_dot_product_function(), this function never returns NULL: short filters use dh_dot_product_scalar_f32().
+ * @param number_coefficients Number of feedforward coefficients of the filter.
+ * @return Pointer to the fastest supported function.
+ */
+dh_dot_product_function_f32 dh_select_dot_product_function_f32(size_t number_coefficients);
+
+/**
+ * @brief Computes the single precision dot product of the given arrays with a simple loop.
+ *
+ * @param coefficients Array with [count] entries.
+ * @param data Array with [count] entries.
+ * @param count Number of entries in both arrays.
+ * @return The sum of coefficients[i]*data[i].
+ */
+float dh_dot_product_scalar_f32(const float* coefficients, const float* data, size_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DH_DOT_PRODUCT_H_INCLUDED */
@@ -0,0 +1,58 @@
+#ifndef DH_FFT_H_INCLUDED
+#define DH_FFT_H_INCLUDED
+
+/** @file
+ * @brief A small radix-2 fast fourier transform for real valued signals.
+ *
+ * Complex numbers are stored as interleaved arrays: the real part at even and the imaginary part at odd indices.
+ * A real signal with [length] values is transformed with a complex transform of half the length.
+ * The spectrum is stored in place as length/2+1 complex values, so the arrays need length+2 entries.
+ *
+ * This source code is licensed under the MIT license. See file "LICENSE" at the root of the repository.
+ */
+
+#include "dh/filter-types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Checks if the length can be used for the transforms in this file.
+ *
+ * @param length Number of real values.
+ * @return true if the length is a power of two and at least 4.
+ */
+bool dh_fft_is_valid_length(size_t length);
+
+/**
+ * @brief Computes the twiddle factors exp(-2*pi*i*k/length) for k in [0, length/2).
+ *
+ * @param twiddles Output array with [length] entries (length/2 complex values).
+ * @param length Number of real values of the transform.
+ */
+void dh_fft_compute_twiddles(double* twiddles, size_t length);
+
+/**
+ * @brief Transforms [length] real values into the spectrum with length/2+1 complex values.
+ *
+ * @param data Array with length+2 entries. The first [length] entries are the input. Overwritten with the spectrum.
+ * @param length Number of real values. Must be valid according to dh_fft_is_valid_length().
+ * @param twiddles The twiddle factors computed with dh_fft_compute_twiddles() for the same length.
+ */
+void dh_fft_real_forward(double* data, size_t length, const double* twiddles);
+
+/**
+ * @brief Inverse of dh_fft_real_forward(). The result is not normalized: it is scaled by length/2.
+ *
+ * @param data Array with the spectrum (length/2+1 complex values). Overwritten with [length] real values.
+ * @param length Number of real values. Must be valid according to dh_fft_is_valid_length().
+ * @param twiddles The twiddle factors computed with dh_fft_compute_twiddles() for the same length.
+ */
+void dh_fft_real_inverse(double* data, size_t length, const double* twiddles);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DH_FFT_H_INCLUDED */
@@ -15,6 +15,16 @@ extern "C" {
 #include <stddef.h>
 #include <stdbool.h>
 
+/** Past outputs and state variables with a smaller magnitude are set to zero if dh_filter_parameters::flush_denormals is set.
+ * The value is far above the smallest normal double (about 2.2e-308), so a slowly decaying state needs many values to reach the subnormal range. */
+#define DH_FILTER_DENORMAL_THRESHOLD 1e-200
+
+/** Largest number of values between two checks of the state if dh_filter_parameters::flush_denormals is set.
+ * Filters with fast decaying poles are checked more often, see dh_filter_data::denormal_check_interval. */
+#define DH_FILTER_DENORMAL_CHECK_INTERVAL 64
+
+/** Alignment in bytes of the buffers given to dh_create_filter_in_buffer(). It is sufficient for doubles and complex numbers. */
+#define DH_FILTER_BUFFER_ALIGNMENT 16
 
 /** The filter types supported by this library.
  * @ingroup C-API
@@ -65,6 +75,48 @@ typedef enum {
 } DH_FILTER_TYPE;
 
 
+/** The structures that can be used to compute the outputs of a filter at runtime.
+ * 
+ * All realizations compute the same transfer function, but they differ in the layout of the buffers,
+ * the memory usage and the number of operations per filter cycle.
+ * @ingroup C-API
+ */
+typedef enum {
+    /** The library selects the realization. Currently this is DH_REALIZATION_RUNNING_SUM for moving averages,
+     * DH_REALIZATION_RECURSIVE_EXPONENTIAL for FIR exponential moving averages, DH_REALIZATION_DIRECT_FORM_1_MIRRORED for the
+     * brickwall filters, whose symmetric coefficients use the folded dot products, and DH_REALIZATION_DIRECT_FORM_1 for all other filters. */
+    DH_REALIZATION_DEFAULT,
+    /** Direct form 1: The past inputs and outputs are stored in two circular buffers with the same length as the coefficient arrays. */
+    DH_REALIZATION_DIRECT_FORM_1,
+    /** Direct form 1 with mirrored buffers: Every value is written twice into buffers with double length, so that
+     * the last inputs and outputs are always stored in a contiguous range. Uses more memory, but the loops in a
+     * filter cycle are not split and can be vectorized by the compiler. Useful for filters with many coefficients. */
+    DH_REALIZATION_DIRECT_FORM_1_MIRRORED,
+    /** Cascade of second order sections (biquads) in transposed direct form 2. The conjugate poles and zeros
+     * are paired into sections, so the filter stays stable and accurate for high orders and narrow bands.
+     * Only supported by the Butterworth and Chebyshev filters. */
+    DH_REALIZATION_SECOND_ORDER_SECTIONS,
+    /** Transposed direct form 2: A single state array with max(M,N)-1 values replaces the buffers for the past
+     * inputs and outputs. No ring buffer indices are needed, so there are about half as many memory accesses per value. */
+    DH_REALIZATION_TRANSPOSED_DIRECT_FORM_2,
+    /** Running sum: The sum of the inputs in the window is updated with one addition and one subtraction per value.
+     * The sum is recomputed from the inputs whenever the circular buffer wraps around, so rounding errors cannot
+     * accumulate for longer than one window. Only supported by the moving average filters. */
+    DH_REALIZATION_RUNNING_SUM,
+    /** Recursive exponential: The truncated geometric series is computed as a one-pole recursion minus the input
+     * that leaves the window. Needs a constant number of operations per value, independent of the filter order.
+     * The recursion is restarted in the same way as DH_REALIZATION_RUNNING_SUM.
+     * Only supported by DH_FIR_EXPONENTIAL_MOVING_AVERAGE_LOWPASS. */
+    DH_REALIZATION_RECURSIVE_EXPONENTIAL,
+    /** Direct form 1 with an additional buffer for the overlap-save convolution: dh_filter_block() convolves long
+     * blocks with a fast fourier transform if the filter has at least DH_FILTER_FFT_MIN_COEFFICIENTS coefficients.
+     * The outputs of the blocks are equal to the direct form 1 up to rounding errors, single values are computed
+     * exactly like in direct form 1. The realization of the created filter is DH_REALIZATION_DIRECT_FORM_1.
+     * Only supported by FIR filters. */
+    DH_REALIZATION_OVERLAP_SAVE
+} DH_FILTER_REALIZATION;
+
+
 /** The filter characteristics supported by this library */
 typedef enum {
     DH_LOWPASS,
@@ -76,6 +128,10 @@ typedef enum {
 
 /**
  * The structure defining the parameters for a filter that will be created with dh_create_filter().
+ * 
+ * @note Initialize all members of the structure with dh_filter_parameters_init() or with zero (e.g. "dh_filter_parameters opts = {0};")
+ * before you set the values. This selects the default for all options that you do not set. Code that leaves the structure
+ * uninitialized and only sets the members that existed in older versions reads indeterminate values for the newer members.
  * @ingroup C-API
  */
 typedef struct {
@@ -180,6 +236,31 @@ typedef struct {
 
     /** What filter to generate. Valid values are defined in the enum DH_FILTER_TYPE. */
     DH_FILTER_TYPE filter_type;
+
+    /** The realization of the filter at runtime.
+     * 
+     * This value selects the structure that is used to compute the outputs of the filter.
+     * Set it to DH_REALIZATION_DEFAULT if you have no special requirements.
+     * 
+     * This parameter is used by every filter.
+     *  
+     * <b>Valid Range:</b><br>
+     *   - Values defined in the enum DH_FILTER_REALIZATION.
+     **/
+    DH_FILTER_REALIZATION realization;
+
+    /** If true, the state of recursive filters does not decay into subnormal numbers.
+     * 
+     * When the input of an IIR filter becomes zero, the past outputs decay into subnormal numbers, which are 10 to 100 times
+     * slower on many processors. With this option, all past outputs (or state variables) with a magnitude below
+     * DH_FILTER_DENORMAL_THRESHOLD are set to zero after every call and after every dh_filter_data::denormal_check_interval
+     * values of a block. The interval is at most DH_FILTER_DENORMAL_CHECK_INTERVAL and is shortened for filters with fast decaying
+     * poles, so that a value above the threshold cannot become subnormal before the next check.
+     * The outputs only change by values in the order of the threshold.
+     * 
+     * This parameter is used by all IIR filters.
+     **/
+    bool flush_denormals;
 } dh_filter_parameters;
 
 /** The return value for the public API of the library.
@@ -197,41 +278,174 @@ typedef enum {
     /** The requested filter type does not exist. */
     DH_FILTER_UNKNOWN_FILTER_TYPE,
     /** Allocation of the buffers failed or there was not enough space in the provided buffer. */
-    DH_FILTER_ALLOCATION_FAILED
+    DH_FILTER_ALLOCATION_FAILED,
+    /** The requested realization does not exist or cannot be used with the requested filter type. */
+    DH_FILTER_UNSUPPORTED_REALIZATION
 } DH_FILTER_RETURN_VALUE;
 
+/** The symmetry of the feedforward coefficients of a FIR filter.
+ * Symmetric and antisymmetric filters have a linear phase. Their dot products can add (or subtract) the two inputs
+ * that are multiplied with the same coefficient first, so that only half of the multiplications are needed.
+ * @see dh_detect_fir_symmetry()
+ */
+typedef enum {
+    /** The coefficients have no symmetry. */
+    DH_FIR_NOT_SYMMETRIC,
+    /** coefficients[k] == coefficients[N-1-k] */
+    DH_FIR_SYMMETRIC,
+    /** coefficients[k] == -coefficients[N-1-k] */
+    DH_FIR_ANTISYMMETRIC
+} DH_FIR_SYMMETRY;
+
+/** Signature of a function that computes the dot product of two arrays with the given number of elements.
+ * @see dh_select_dot_product_function()
+ */
+typedef double (*dh_dot_product_function)(const double*, const double*, size_t);
+
+/** Signature of a function that computes the single precision dot product of two arrays with the given number of elements.
+ * @see dh_select_dot_product_function_f32()
+ */
+typedef float (*dh_dot_product_function_f32)(const float*, const float*, size_t);
+
+/** The data for the overlap-save convolution of long FIR filters.
+ * All pointers point into the buffer of the filter.
+ * @see dh_overlap_save_run()
+ */
+typedef struct {
+    /** Twiddle factors of the FFT (fft_length values). */
+    double* twiddles;
+    /** Spectrum of the feedforward coefficients, scaled for the inverse transform (fft_length+2 values). */
+    double* spectrum;
+    /** Work buffer for one block (fft_length+2 values). */
+    double* frame;
+    /** Length of the FFT. 0 if the overlap-save convolution was not requested or the filter is too short. */
+    size_t fft_length;
+} dh_overlap_save_data;
+
+struct dh_filter_data_s;
+
+/** Signature of a kernel that filters [count] values of [input] and writes the results to [output].
+ * The buffers of the filter must be valid and the filter must be initialized.
+ * @see dh_select_filter_kernel()
+ */
+typedef void (*dh_filter_kernel_function)(struct dh_filter_data_s* filter, const double* input, double* output, size_t count);
+
 /** The interal data for a filter.
+ * 
+ * @note If you fill the structure manually, initialize all members with zero first.
  * @ingroup C-API
  **/
-typedef struct {
-    /** Pointer to the array of the last inputs. Used as circular buffer. */
+typedef struct dh_filter_data_s {
+    /** Pointer to the array of the last inputs. Used as circular buffer.
+     * Has twice the length of coefficients_in if the realization is DH_REALIZATION_DIRECT_FORM_1_MIRRORED.
+     * NULL if the realization does not use the direct form 1. */
     double* inputs;
     /** Pointer to the array with the feedforward coefficients. */
     double* coefficients_in;
-    /** Pointer to the array of the last outputs. Used as circular buffer. */
+    /** Pointer to the array of the last outputs. Used as circular buffer.
+     * Has twice the length of coefficients_out if the realization is DH_REALIZATION_DIRECT_FORM_1_MIRRORED.
+     * NULL if the realization does not use the direct form 1. */
     double* outputs;
     /** Pointer to the array with the feedback coefficients. */
     double* coefficients_out;
+    /** Pointer to the array with the coefficients of the second order sections. Each section has the
+     * 5 coefficients b0, b1, b2, a1, a2 (a0 is always 1). NULL if the realization does not use sections. */
+    double* sections;
+    /** Pointer to the internal state of the realization. NULL for the direct form 1 realizations.
+     * Has 2 values per section for DH_REALIZATION_SECOND_ORDER_SECTIONS and max(M,N)-1 values for DH_REALIZATION_TRANSPOSED_DIRECT_FORM_2. */
+    double* state;
     /** Pointer to the allocated buffer. */
     char* buffer;
     /** Current output value. */
     double current_value;
+    /** Sum of all inputs in the window. Only used by DH_REALIZATION_RUNNING_SUM and DH_REALIZATION_RECURSIVE_EXPONENTIAL
+     * (weighted with the coefficients). */
+    double accumulator;
+    /** Sum of the inputs since the circular input buffer wrapped around the last time.
+     * Replaces the accumulator when the buffer wraps around. Only used by DH_REALIZATION_RUNNING_SUM and DH_REALIZATION_RECURSIVE_EXPONENTIAL. */
+    double accumulator_partial;
     /** Size of the buffer. */
     size_t buffer_length;
     /** Number of elements in inputs and coefficients_in. */
     size_t number_coefficients_in;
     /** Number of elements in outputs and coefficients_out. */
     size_t number_coefficients_out;
+    /** Number of second order sections. */
+    size_t number_sections;
+    /** Number of elements in state. */
+    size_t state_length;
     /** Start index for the circular input buffer. */
     size_t current_input_index;
     /** Start index for the circular output buffer. */
     size_t current_output_index;
+    /** Number of inputs that dh_filter_decimate() drops before the next output is kept. */
+    size_t decimation_phase;
     /** If the filter was initialized. Relevant for low pass filters. */
     bool initialized;
     /** If the buffer needs to be freed during free. */
     bool buffer_needs_cleanup;
+    /** The realization that is used to compute the outputs. DH_REALIZATION_DEFAULT is handled like DH_REALIZATION_DIRECT_FORM_1. */
+    DH_FILTER_REALIZATION realization;
+    /** Vectorized function to compute the feedforward part of FIR filters. If NULL, the plain loops are used.
+     * Is a folded dot product if the realization is DH_REALIZATION_DIRECT_FORM_1_MIRRORED and the coefficients are symmetric. */
+    dh_dot_product_function dot_product;
+    /** The symmetry of the feedforward coefficients. Only detected for DH_REALIZATION_DIRECT_FORM_1_MIRRORED. */
+    DH_FIR_SYMMETRY symmetry;
+    /** Kernel that is specialized for the structure of the filter. Selected by dh_create_filter() with dh_select_filter_kernel().
+     * If NULL, the kernel is chosen for every call from the realization. Structures that are filled manually must set it
+     * to NULL or to the result of dh_select_filter_kernel(), because it is called after the buffer checks without validation. */
+    dh_filter_kernel_function kernel;
+    /** Overlap-save convolution that is used by dh_filter_block() for long FIR filters created with DH_REALIZATION_OVERLAP_SAVE. */
+    dh_overlap_save_data overlap_save;
+    /** If true, past outputs and state variables below DH_FILTER_DENORMAL_THRESHOLD are set to zero. See dh_filter_parameters::flush_denormals. */
+    bool flush_denormals;
+    /** Number of values between two checks of the state if flush_denormals is set. Computed by dh_create_filter() from the
+     * fastest possible decay of the poles. If 0, the state is checked after every value. */
+    size_t denormal_check_interval;
 } dh_filter_data;
 
+/** The interal data for a filter that computes with single precision floats.
+ * 
+ * The coefficients are designed with double precision and converted when the filter is created with dh_create_filter_f32().
+ * Only realizations that are numerically safe with single precision are supported: FIR filters use the
+ * DH_REALIZATION_DIRECT_FORM_1_MIRRORED and IIR filters use DH_REALIZATION_SECOND_ORDER_SECTIONS.
+ * @note If you fill the structure manually, initialize all members with zero first.
+ * @ingroup C-API
+ **/
+typedef struct {
+    /** Pointer to the array of the last inputs. Used as mirrored circular buffer with twice the length of coefficients_in.
+     * NULL if the realization uses sections. */
+    float* inputs;
+    /** Pointer to the array with the feedforward coefficients. NULL if the realization uses sections. */
+    float* coefficients_in;
+    /** Pointer to the array with the coefficients of the second order sections (b0, b1, b2, a1, a2). NULL for FIR filters. */
+    float* sections;
+    /** Pointer to the state of the second order sections (2 values per section). NULL for FIR filters. */
+    float* state;
+    /** Pointer to the allocated buffer. */
+    char* buffer;
+    /** Current output value. */
+    float current_value;
+    /** The gain that is applied to the output. */
+    float gain;
+    /** Size of the buffer. */
+    size_t buffer_length;
+    /** Number of elements in coefficients_in. */
+    size_t number_coefficients_in;
+    /** Number of second order sections. */
+    size_t number_sections;
+    /** Start index for the circular input buffer. */
+    size_t current_input_index;
+    /** If the filter was initialized. Relevant for low pass filters. */
+    bool initialized;
+    /** If the buffer needs to be freed during free. */
+    bool buffer_needs_cleanup;
+    /** The realization that is used to compute the outputs. */
+    DH_FILTER_REALIZATION realization;
+    /** Function to compute the feedforward part of FIR filters. */
+    dh_dot_product_function_f32 dot_product;
+} dh_filter_data_f32;
+
 /** Return structure for the frequrency response. */
 typedef struct{
     /** Current position (x value) */
@@ -40,6 +40,8 @@ extern "C" {
  * DH_CFILTER_BUILD_TESTS  | ON  |  If the tests should be built. Will fetch Catch2.
  * DH_CFILTER_BUILD_EXAMPLES  | ON  | If the examples should be built. Will fetch CXXopts.
  * DH_CFILTER_COVERAGE | OFF | If the binary should be instrumented to collect coverage information. (Only active if you compile with gcc)
+ * DH_CFILTER_USE_SIMD | ON | If vectorized dot products (SSE2, AVX2 or AVX-512, selected at runtime) should be used for FIR filters on x86 processors.
+ * DH_CFILTER_BUILD_BENCHMARKS | OFF | If the benchmarks in the folder "benchmark" should be built.
  * 
  * @section pak CMake package
  * 
@@ -88,6 +90,7 @@ extern "C" {
  * Here is an example for the basic usage of the API:
  * ```C
  * dh_filter_parameters parameters;
+ * dh_filter_parameters_init(&parameters);
  * // set values in parameters to create your desired filter
  * dh_filter_data filter;
  * if (dh_create_filter(&filter, &parameters) != DH_FILTER_OK) {
@@ -129,6 +132,182 @@ extern "C" {
  */
 DH_FILTER_RETURN_VALUE dh_filter(dh_filter_data* filter, double input, double* output);
 
+/**
+ * @brief Runs the filter for a block of input values.
+ * 
+ * The result is identical to calling dh_filter() for every value in [input], but the filter structure is
+ * only validated once per call and the state of the ring buffers is kept in local variables for the whole block.
+ * Use this function if you process many values at once.
+ * @note Filters created with DH_REALIZATION_OVERLAP_SAVE convolve long blocks with a fast fourier transform.
+ * Their outputs are only equal to dh_filter() up to rounding errors.
+ * @note If the initialized property of the filter structure is set to false, then the filter is initialized with the first input value.
+ * See dh_filter() for details.
+ * 
+ * @param[in] filter The data structure of the filter. Must be initialized (the buffers/coefficients must be set).
+ * @param[in] input Array with [count] input values.
+ * @param[out] output Array where the [count] output values are written to. May be the same array as [input].
+ * @param[in] count Number of values to filter.
+ * @return An enum with the result of the operation.
+ * @retval DH_FILTER_OK Operation was successfull
+ * @retval DH_FILTER_NO_DATA_STRUCTURE You gave NULL as filter, input or output argument.
+ * @retval DH_FILTER_DATA_STRUCTURE_NOT_INITIALIZED The filter data structure was not correctly initialized.
+ * @ingroup C-API
+ */
+DH_FILTER_RETURN_VALUE dh_filter_block(dh_filter_data* filter, const double* input, double* output, size_t count);
+
+/**
+ * @brief Runs the filter for a block of values and replaces each value in [data] with the filtered value.
+ * 
+ * Same as calling dh_filter_block() with [data] as input and output.
+ * 
+ * @param[in] filter The data structure of the filter. Must be initialized (the buffers/coefficients must be set).
+ * @param[in,out] data Array with [count] values that are filtered in place.
+ * @param[in] count Number of values to filter.
+ * @return An enum with the result of the operation.
+ * @retval DH_FILTER_OK Operation was successfull
+ * @retval DH_FILTER_NO_DATA_STRUCTURE You gave NULL as filter or data argument.
+ * @retval DH_FILTER_DATA_STRUCTURE_NOT_INITIALIZED The filter data structure was not correctly initialized.
+ * @ingroup C-API
+ */
+DH_FILTER_RETURN_VALUE dh_filter_block_inplace(dh_filter_data* filter, double* data, size_t count);
+
+/**
+ * @brief Runs the filter for a block of values that are stored with a constant distance in memory.
+ * 
+ * Value i is read from input[i*input_stride] and written to output[i*output_stride]. The values are copied in chunks
+ * to a contiguous array and filtered with dh_filter_block(), so the outputs are identical to filtering the
+ * same values stored without gaps. The chunks may be shorter than the blocks of the overlap-save convolution,
+ * so for filters created with DH_REALIZATION_OVERLAP_SAVE the outputs are only equal up to rounding errors.
+ * 
+ * @param[in] filter The data structure of the filter. Must be initialized (the buffers/coefficients must be set).
+ * @param[in] input Array with the input values.
+ * @param[in] input_stride Distance between two input values in elements. Valid range: [1, inf]
+ * @param[out] output Array where the output values are written to. May be the same array as [input] if the strides are equal.
+ * @param[in] output_stride Distance between two output values in elements. Valid range: [1, inf]
+ * @param[in] count Number of values to filter.
+ * @return An enum with the result of the operation.
+ * @retval DH_FILTER_OK Operation was successfull
+ * @retval DH_FILTER_NO_DATA_STRUCTURE You gave NULL as filter, input or output argument.
+ * @retval DH_FILTER_DATA_STRUCTURE_NOT_INITIALIZED The filter data structure was not correctly initialized.
+ * @retval DH_FILTER_ERROR A stride is 0.
+ * @ingroup C-API
+ */
+DH_FILTER_RETURN_VALUE dh_filter_block_strided(dh_filter_data* filter, const double* input, size_t input_stride, double* output, size_t output_stride, size_t count);
+
+/**
+ * @brief Filters interleaved frames with one filter per channel.
+ * 
+ * A frame holds one value of every channel: value c of frame i is stored at i*number_channels + c and is filtered
+ * with filters[c]. The frames are processed in groups that fit into the first level cache, so every frame is
+ * loaded from memory only once.
+ * 
+ * @param[in] filters Array with [number_channels] filters. Each filter must be initialized.
+ * @param[in] number_channels Number of channels in every frame.
+ * @param[in,out] data Array with [number_frames] frames that are filtered in place.
+ * @param[in] number_frames Number of frames to filter.
+ * @return An enum with the result of the operation.
+ * @retval DH_FILTER_OK Operation was successfull
+ * @retval DH_FILTER_NO_DATA_STRUCTURE You gave NULL as filters or data argument.
+ * @retval DH_FILTER_DATA_STRUCTURE_NOT_INITIALIZED One of the filters was not correctly initialized. No value was changed.
+ * @ingroup C-API
+ */
+DH_FILTER_RETURN_VALUE dh_filter_frames_inplace(dh_filter_data* filters, size_t number_channels, double* data, size_t number_frames);
+
+/**
+ * @brief Filters [count] values and keeps only every [factor]-th output.
+ * 
+ * The outputs are exactly the same as filtering all values with dh_filter() and dropping the other outputs.
+ * The first kept output is the output for the first input after the filter was created. The number of dropped
+ * values is stored in the filter, so a signal can be split into blocks of arbitrary length.
+ * 
+ * FIR filters in direct form 1 only write the dropped inputs to the history and compute the dot product for the
+ * kept outputs, so they need about 1/[factor] of the operations. The fast convolution is not used for them. Recursive filters need every output for the feedback,
+ * so they compute all outputs, but the dropped outputs are never written to memory.
+ * 
+ * @param[in] filter The data structure of the filter. Must be created with dh_create_filter().
+ * @param[in] input Array with [count] input values.
+ * @param[in] count Number of input values.
+ * @param[in] factor Decimation factor. Valid range: [1, inf]
+ * @param[out] output Array for the kept outputs. Needs at least (count + factor - 1) / factor entries. Must not overlap with [input].
+ * @param[out] output_count The number of values written to [output]. Parameter is optional.
+ * @return An enum with the result of the operation.
+ * @retval DH_FILTER_OK Operation was successfull
+ * @retval DH_FILTER_NO_DATA_STRUCTURE You gave NULL as filter, input or output argument.
+ * @retval DH_FILTER_DATA_STRUCTURE_NOT_INITIALIZED The filter data structure was not correctly initialized.
+ * @retval DH_FILTER_ERROR The factor is 0.
+ * @ingroup C-API
+ */
+DH_FILTER_RETURN_VALUE dh_filter_decimate(dh_filter_data* filter, const double* input, size_t count, size_t factor, double* output, size_t* output_count);
+
+/**
+ * @brief Filters a complete signal forwards and backwards, so that the output has no phase shift (zero-phase filtering).
+ * 
+ * The magnitude response is the square of the magnitude response of the filter. Both ends of the signal are extended
+ * by an odd reflection with 3*(order+1) values, and the filter is set to the steady state for the first value at the
+ * start of each pass. Unlike dh_initialize_filter(), the past outputs are scaled with the gain at 0 Hz, so highpass and
+ * bandpass filters start in their steady state, too. This suppresses the transients at the edges. The signal is filtered in place with the
+ * block kernels, only the two extensions are allocated.
+ * 
+ * Any filter created with dh_create_filter() can be used. The state of the filter is overwritten.
+ * 
+ * @param[in] filter The data structure of the filter. Must be created with dh_create_filter().
+ * @param[in,out] data Array with the complete signal of [count] values that is filtered in place.
+ * @param[in] count Number of values in the signal.
+ * @return An enum with the result of the operation.
+ * @retval DH_FILTER_OK Operation was successfull
+ * @retval DH_FILTER_NO_DATA_STRUCTURE You gave NULL as filter or data argument.
+ * @retval DH_FILTER_DATA_STRUCTURE_NOT_INITIALIZED The filter data structure was not correctly initialized.
+ * @retval DH_FILTER_ALLOCATION_FAILED The extensions of the signal could not be allocated.
+ * @ingroup C-API
+ */
+DH_FILTER_RETURN_VALUE dh_filtfilt(dh_filter_data* filter, double* data, size_t count);
+
+/**
+ * @brief Filters a long signal with up to [number_threads] threads. The outputs are the same as for dh_filter_block() up to rounding errors.
+ * 
+ * The signal is split into one chunk per thread. The first chunk is filtered with the current state of the filter,
+ * all other chunks are filtered in parallel starting with a state of zeros. The filter is linear, so the correct output
+ * of a chunk is the sum of this output and the response to the true state at the start of the chunk with zero inputs.
+ * The true states are propagated from chunk to chunk with the state transition matrix of a whole chunk, which is computed
+ * by repeated squaring. Then the zero-input responses are added in parallel. They are only computed until they
+ * decayed below the rounding errors, so the total work is not much larger than for a single thread.
+ * 
+ * The state vector of second order sections and the transposed direct form 2 are their state variables. The direct form 1
+ * (also mirrored) keeps the past inputs and outputs: the past inputs at the start of a chunk are taken from the signal, so only
+ * the past outputs are propagated. The running sum and the recursive exponential are not supported, because their sums are
+ * not restored from the past inputs of a chunk. Signals that are too short to be split are filtered with dh_filter_block().
+ * The threads are only used if the library was built with threads, otherwise the chunks are filtered one after another.
+ * 
+ * @param[in] filter The data structure of the filter. Its state is updated as if all values were filtered with dh_filter_block().
+ * @param[in] input Array with [count] input values.
+ * @param[out] output Array where the [count] output values are written to. May be the same array as [input].
+ * @param[in] count Number of values to filter.
+ * @param[in] number_threads Maximum number of threads. 0 and 1 filter the signal on the calling thread.
+ * @return An enum with the result of the operation.
+ * @retval DH_FILTER_OK Operation was successfull
+ * @retval DH_FILTER_NO_DATA_STRUCTURE You gave NULL as filter, input or output argument.
+ * @retval DH_FILTER_DATA_STRUCTURE_NOT_INITIALIZED The filter data structure was not correctly initialized.
+ * @retval DH_FILTER_UNSUPPORTED_REALIZATION The filter uses DH_REALIZATION_RUNNING_SUM or DH_REALIZATION_RECURSIVE_EXPONENTIAL.
+ * @retval DH_FILTER_ALLOCATION_FAILED The states of the chunks could not be allocated.
+ * @ingroup C-API
+ */
+DH_FILTER_RETURN_VALUE dh_filter_block_parallel(dh_filter_data* filter, const double* input, double* output, size_t count, size_t number_threads);
+
+/**
+ * @brief Sets all members of [options] to their default values.
+ * 
+ * Call this function before you set the values of a parameter structure that is not zero initialized
+ * (e.g. "dh_filter_parameters opts;"). Options that were added in later versions of the library, like the realization,
+ * are then set to values that keep the behavior of older versions.
+ * 
+ * @param[out] options the structure that will be initialized.
+ * @return An enum with the result of the operation.
+ * @retval DH_FILTER_OK Operation was successfull
+ * @retval DH_FILTER_NO_DATA_STRUCTURE You gave NULL as argument.
+ * @ingroup C-API
+ */
+DH_FILTER_RETURN_VALUE dh_filter_parameters_init(dh_filter_parameters* options);
+
 /**
  * @brief Allocates the buffers and initializes the filter.
  * 
@@ -143,14 +322,111 @@ DH_FILTER_RETURN_VALUE dh_filter(dh_filter_data* filter, double input, double* o
  * @retval DH_FILTER_NO_DATA_STRUCTURE You gave NULL as first argument.
  * @retval DH_FILTER_UNKNOWN_FILTER_TYPE An unknown filter was requested in the options.
  * @retval DH_FILTER_ALLOCATION_FAILED Not enough memory for the filter could be allocated.
+ * @retval DH_FILTER_UNSUPPORTED_REALIZATION The requested realization cannot be used with the filter type.
  * @see dh_filter_parameters for the possible options.
  * @ingroup C-API
  */
 DH_FILTER_RETURN_VALUE dh_create_filter(dh_filter_data* filter, dh_filter_parameters* options);
 
+/**
+ * @brief Computes the size and the alignment of the buffer that dh_create_filter_in_buffer() needs for the given options.
+ *
+ * The size includes the scratch memory for the design of the coefficients.
+ *
+ * @param[in] options the desired filter type.
+ * @param[out] size the number of bytes.
+ * @param[out] alignment the required alignment of the buffer in bytes (DH_FILTER_BUFFER_ALIGNMENT). Parameter is optional.
+ * @return DH_FILTER_RETURN_VALUE
+ * @retval DH_FILTER_OK Operation was successfull
+ * @retval DH_FILTER_NO_DATA_STRUCTURE You gave NULL as options or size.
+ * @retval DH_FILTER_UNKNOWN_FILTER_TYPE An unknown filter was requested in the options.
+ * @retval DH_FILTER_UNSUPPORTED_REALIZATION The requested realization cannot be used with the filter type.
+ * @ingroup C-API
+ */
+DH_FILTER_RETURN_VALUE dh_filter_required_size(const dh_filter_parameters* options, size_t* size, size_t* alignment);
+
+/**
+ * @brief Initializes the filter in a buffer that is provided by the caller. No memory is allocated.
+ *
+ * The filter is the same as the one created by dh_create_filter(). The buffer must have at least the size returned by
+ * dh_filter_required_size() and be aligned to DH_FILTER_BUFFER_ALIGNMENT bytes. The filter does not own the buffer:
+ * dh_free_filter() resets the filter but does not free the buffer, and the buffer must live as long as the filter is used.
+ * The memory behind dh_filter_data::buffer_length bytes is only used during the design and can be reused afterwards.
+ *
+ * @param[out] filter pointer to the filter structure that will be initialized.
+ * @param[in] options the desired filter type.
+ * @param[in] buffer the memory for the filter.
+ * @param[in] buffer_length the size of [buffer] in bytes.
+ * @return DH_FILTER_RETURN_VALUE
+ * @retval DH_FILTER_OK Operation was successfull
+ * @retval DH_FILTER_NO_DATA_STRUCTURE You gave NULL as filter, options or buffer.
+ * @retval DH_FILTER_UNKNOWN_FILTER_TYPE An unknown filter was requested in the options.
+ * @retval DH_FILTER_ALLOCATION_FAILED The buffer is too small or not aligned.
+ * @retval DH_FILTER_UNSUPPORTED_REALIZATION The requested realization cannot be used with the filter type.
+ * @ingroup C-API
+ */
+DH_FILTER_RETURN_VALUE dh_create_filter_in_buffer(dh_filter_data* filter, dh_filter_parameters* options, void* buffer, size_t buffer_length);
+
+/**
+ * @brief Computes the size of the scratch memory that dh_filter_retune() needs for the given options.
+ *
+ * @param[in] options the new filter options.
+ * @return Size in bytes. May be 0, then no workspace is needed.
+ * @ingroup C-API
+ */
+size_t dh_filter_retune_workspace_size(const dh_filter_parameters* options);
+
+/**
+ * @brief Computes new coefficients for a filter created with dh_create_filter() without allocating memory.
+ *
+ * Use this function to change the cutoff frequencies or the ripple of a running filter, e.g. in a realtime thread.
+ * The coefficients are written into the existing buffer. The past inputs and outputs (or the state variables)
+ * are kept, so the output continues smoothly with the new coefficients. The gain is reset to 1. The sums of
+ * DH_REALIZATION_RUNNING_SUM and DH_REALIZATION_RECURSIVE_EXPONENTIAL are recomputed from the past inputs, so these
+ * filters continue like a new filter that has seen the same inputs.
+ *
+ * The new options must result in the same number of coefficients and the same realization, i.e. the filter order
+ * and the characteristic must not change. The filter type may change, e.g. from a butterworth to a chebyshev lowpass.
+ * All temporary values are computed in [workspace], which must be aligned like memory returned by malloc() and have
+ * at least dh_filter_retune_workspace_size() bytes.
+ *
+ * @param[in] filter the filter that will be changed.
+ * @param[in] options the new filter options.
+ * @param[in] workspace scratch memory for the design. May be NULL if the required size is 0.
+ * @param[in] workspace_size size of [workspace] in bytes.
+ * @return DH_FILTER_RETURN_VALUE
+ * @retval DH_FILTER_OK Operation was successfull
+ * @retval DH_FILTER_NO_DATA_STRUCTURE You gave NULL as filter or options.
+ * @retval DH_FILTER_DATA_STRUCTURE_NOT_INITIALIZED The filter has no buffer.
+ * @retval DH_FILTER_UNKNOWN_FILTER_TYPE An unknown filter was requested in the options.
+ * @retval DH_FILTER_UNSUPPORTED_REALIZATION The options select a different realization than the one of the filter.
+ * @retval DH_FILTER_ERROR The number of coefficients would change.
+ * @retval DH_FILTER_ALLOCATION_FAILED The workspace is too small.
+ * @ingroup C-API
+ */
+DH_FILTER_RETURN_VALUE dh_filter_retune(dh_filter_data* filter, const dh_filter_parameters* options, void* workspace, size_t workspace_size);
+
+/**
+ * @brief Selects the kernel that is specialized for the realization and the structure of the filter.
+ * 
+ * Pure FIR filters skip the feedback and (for unity gain) the multiplication with the gain, the first order IIR
+ * lowpass keeps its last output in a register, and IIR filters in direct form 1 with the orders 1 to 8 run fully unrolled loops.
+ * All other filters use the general kernel of their realization. The outputs of all kernels are identical to the general kernels.
+ * 
+ * dh_create_filter() and dh_filter_set_gain() store the result in the member kernel. Call this function again if you
+ * fill the structure manually or change the coefficients yourself.
+ * 
+ * @param[in] filter The filter with valid buffers and coefficients.
+ * @return The kernel function or NULL if the buffers of the filter are not valid.
+ * @ingroup C-API
+ */
+dh_filter_kernel_function dh_select_filter_kernel(const dh_filter_data* filter);
+
 /**
  * @brief Forces the filter to the steady state with output value by setting all pasts inputs and outputs to the given [value].
  * 
+ * If the filter uses second order sections, the state of every section is set to its steady state for the constant input [value].
+ * 
  * @note Call this function only with low-pass or band-stop filters! Usually, you do no not have to call this yourself if you use dh_create_filter().
  * 
  * @param[in] filter the filter structure
@@ -210,6 +486,114 @@ DH_FILTER_RETURN_VALUE dh_filter_get_gain(const dh_filter_data* filter, double*
 DH_FILTER_RETURN_VALUE dh_filter_get_gain_at(const dh_filter_data* filter, double frequency, dh_frequency_response_t* gain);
 
 
+
+/**
+ * @brief Allocates the buffers and initializes a filter that computes with single precision floats.
+ * 
+ * The coefficients are designed with double precision (see dh_create_filter()) and then converted.
+ * Single precision is only allowed where it is numerically safe: FIR filters are computed with the
+ * DH_REALIZATION_DIRECT_FORM_1_MIRRORED and the Butterworth and Chebyshev filters with DH_REALIZATION_SECOND_ORDER_SECTIONS.
+ * 
+ * @param[out] filter pointer to the filter structure that will be initialized.
+ * @param[in] options the desired filter type. The realization must be DH_REALIZATION_DEFAULT or one of the realizations listed above.
+ * @return DH_FILTER_RETURN_VALUE 
+ * @retval DH_FILTER_OK Operation was successfull
+ * @retval DH_FILTER_NO_DATA_STRUCTURE You gave NULL as first argument.
+ * @retval DH_FILTER_UNKNOWN_FILTER_TYPE An unknown filter was requested in the options.
+ * @retval DH_FILTER_ALLOCATION_FAILED Not enough memory for the filter could be allocated.
+ * @retval DH_FILTER_UNSUPPORTED_REALIZATION The filter type cannot be computed safely with single precision or the realization is not supported.
+ * @ingroup C-API
+ */
+DH_FILTER_RETURN_VALUE dh_create_filter_f32(dh_filter_data_f32* filter, dh_filter_parameters* options);
+
+/**
+ * @brief Runs an iteration of a single precision filter. See dh_filter() for details.
+ * 
+ * @param[in] filter The data structure of the filter. Must be created with dh_create_filter_f32().
+ * @param[in] input The next input value to the filter.
+ * @param[out] output The current output value. Parameter is optional.
+ * @return An enum with the result of the operation.
+ * @retval DH_FILTER_OK Operation was successfull
+ * @retval DH_FILTER_NO_DATA_STRUCTURE You gave NULL as first argument.
+ * @retval DH_FILTER_DATA_STRUCTURE_NOT_INITIALIZED The filter data structure was not correctly initialized.
+ * @ingroup C-API
+ */
+DH_FILTER_RETURN_VALUE dh_filter_f32(dh_filter_data_f32* filter, float input, float* output);
+
+/**
+ * @brief Runs a single precision filter for a block of input values. See dh_filter_block() for details.
+ * 
+ * @param[in] filter The data structure of the filter. Must be created with dh_create_filter_f32().
+ * @param[in] input Array with [count] input values.
+ * @param[out] output Array where the [count] output values are written to. May be the same array as [input].
+ * @param[in] count Number of values to filter.
+ * @return An enum with the result of the operation.
+ * @retval DH_FILTER_OK Operation was successfull
+ * @retval DH_FILTER_NO_DATA_STRUCTURE You gave NULL as filter, input or output argument.
+ * @retval DH_FILTER_DATA_STRUCTURE_NOT_INITIALIZED The filter data structure was not correctly initialized.
+ * @ingroup C-API
+ */
+DH_FILTER_RETURN_VALUE dh_filter_block_f32(dh_filter_data_f32* filter, const float* input, float* output, size_t count);
+
+/**
+ * @brief Runs a single precision filter for a block of values and replaces each value in [data] with the filtered value.
+ * 
+ * @param[in] filter The data structure of the filter. Must be created with dh_create_filter_f32().
+ * @param[in,out] data Array with [count] values that are filtered in place.
+ * @param[in] count Number of values to filter.
+ * @return An enum with the result of the operation.
+ * @retval DH_FILTER_OK Operation was successfull
+ * @retval DH_FILTER_NO_DATA_STRUCTURE You gave NULL as filter or data argument.
+ * @retval DH_FILTER_DATA_STRUCTURE_NOT_INITIALIZED The filter data structure was not correctly initialized.
+ * @ingroup C-API
+ */
+DH_FILTER_RETURN_VALUE dh_filter_block_inplace_f32(dh_filter_data_f32* filter, float* data, size_t count);
+
+/**
+ * @brief Forces a single precision filter to the steady state with output value. See dh_initialize_filter() for details.
+ * 
+ * @param[in] filter the filter structure
+ * @param[in] value the desired steady state
+ * @return An enum with the result of the operation.
+ * @retval DH_FILTER_OK Operation was successfull
+ * @retval DH_FILTER_NO_DATA_STRUCTURE You gave NULL as first argument.
+ * @ingroup C-API
+ */
+DH_FILTER_RETURN_VALUE dh_initialize_filter_f32(dh_filter_data_f32* filter, float value);
+
+/** Frees the filter created with dh_create_filter_f32().
+ * 
+ * @param[in] filter the filter structure that will be freed.
+ * @return An enum with the result of the operation.
+ * @retval DH_FILTER_OK Operation was successfull
+ * @ingroup C-API
+ */
+DH_FILTER_RETURN_VALUE dh_free_filter_f32(dh_filter_data_f32* filter);
+
+/** Sets the gain of a single precision filter to the given value.
+ * 
+ * @param[in] filter the filter structure
+ * @param[in] gain the desired gain
+ * @return An enum with the result of the operation.
+ * @retval DH_FILTER_OK Operation was successfull
+ * @retval DH_FILTER_NO_DATA_STRUCTURE You gave NULL as first argument.
+ * @retval DH_FILTER_DATA_STRUCTURE_NOT_INITIALIZED The filter data structure was not correctly initialized.
+ * @ingroup C-API
+ */
+DH_FILTER_RETURN_VALUE dh_filter_set_gain_f32(dh_filter_data_f32* filter, float gain);
+
+/** Gets the gain of a single precision filter.
+ * 
+ * @param[in] filter the filter structure
+ * @param[out] gain pointer to output
+ * @return An enum with the result of the operation.
+ * @retval DH_FILTER_OK Operation was successfull
+ * @retval DH_FILTER_NO_DATA_STRUCTURE You gave NULL as first argument.
+ * @retval DH_FILTER_DATA_STRUCTURE_NOT_INITIALIZED The filter data structure was not correctly initialized.
+ * @ingroup C-API
+ */
+DH_FILTER_RETURN_VALUE dh_filter_get_gain_f32(const dh_filter_data_f32* filter, float* gain);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,119 @@
+#ifndef DH_FILTER_ARENA_H_INCLUDED
+#define DH_FILTER_ARENA_H_INCLUDED
+
+/** @file
+ * @brief An arena that creates many filters in one contiguous block of memory.
+ *
+ * Every filter created with dh_create_filter() allocates its own buffer. An arena allocates a single slab once
+ * and places the buffers of the filters one after another in the slab, each one starting at a new cache line.
+ * Creating a filter only moves an offset, filters that are created together are stored next to each other,
+ * and all filters are released at once with dh_reset_filter_arena() or dh_free_filter_arena().
+ *
+ * This source code is licensed under the MIT license. See file "LICENSE" at the root of the repository.
+ */
+
+#include "dh/filter-types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Alignment in bytes of the buffers of the filters in an arena. This is the size of a cache line on most processors. */
+#define DH_FILTER_ARENA_ALIGNMENT 64
+
+/**
+ * The data of a filter arena. Create it with dh_create_filter_arena() and free it with dh_free_filter_arena().
+ * @ingroup C-API
+ */
+typedef struct {
+    /** Pointer to the allocated memory. */
+    char* memory;
+    /** Start of the slab. Aligned to DH_FILTER_ARENA_ALIGNMENT bytes. */
+    char* buffer;
+    /** Size of the slab in bytes. */
+    size_t buffer_length;
+    /** Number of bytes at the start of the slab that are used by filters, including the padding between them. */
+    size_t used;
+    /** Number of filters that were created in the arena. */
+    size_t number_filters;
+} dh_filter_arena;
+
+/**
+ * @brief Allocates a slab with [buffer_length] bytes for the filters.
+ *
+ * @param[out] arena The structure that will be initialized.
+ * @param[in] buffer_length Size of the slab in bytes. Use dh_filter_arena_required_size() to compute it.
+ * @return An enum with the result of the operation.
+ * @retval DH_FILTER_OK Operation was successfull
+ * @retval DH_FILTER_NO_DATA_STRUCTURE You gave NULL as argument.
+ * @retval DH_FILTER_ALLOCATION_FAILED Not enough memory could be allocated.
+ * @ingroup C-API
+ */
+DH_FILTER_RETURN_VALUE dh_create_filter_arena(dh_filter_arena* arena, size_t buffer_length);
+
+/**
+ * @brief Computes the size of a slab that holds [number_filters] filters with the given options.
+ *
+ * The size includes the padding between the filters and the scratch memory that the design of the last filter needs.
+ * The sizes for different options can be added.
+ *
+ * @param[in] options the filter type.
+ * @param[in] number_filters the number of filters.
+ * @param[out] size the number of bytes.
+ * @return An enum with the result of the operation.
+ * @retval DH_FILTER_OK Operation was successfull
+ * @retval DH_FILTER_NO_DATA_STRUCTURE You gave NULL as options or size.
+ * @retval DH_FILTER_UNKNOWN_FILTER_TYPE An unknown filter was requested in the options.
+ * @retval DH_FILTER_UNSUPPORTED_REALIZATION The requested realization cannot be used with the filter type.
+ * @ingroup C-API
+ */
+DH_FILTER_RETURN_VALUE dh_filter_arena_required_size(const dh_filter_parameters* options, size_t number_filters, size_t* size);
+
+/**
+ * @brief Creates a filter in the free memory of the arena. No memory is allocated.
+ *
+ * The filter is the same as the one created by dh_create_filter(). Its buffer starts at the next cache line after
+ * the previous filter. The scratch memory of the design is returned to the arena when the filter is created.
+ * The filter does not own its buffer, so dh_free_filter() does not release memory. The filter must not be used after
+ * the arena was reset or freed.
+ *
+ * @param[in] arena An initialized arena.
+ * @param[out] filter pointer to the filter structure that will be initialized.
+ * @param[in] options the desired filter type.
+ * @return An enum with the result of the operation.
+ * @retval DH_FILTER_OK Operation was successfull
+ * @retval DH_FILTER_NO_DATA_STRUCTURE You gave NULL as argument.
+ * @retval DH_FILTER_DATA_STRUCTURE_NOT_INITIALIZED The arena has no slab.
+ * @retval DH_FILTER_UNKNOWN_FILTER_TYPE An unknown filter was requested in the options.
+ * @retval DH_FILTER_ALLOCATION_FAILED The free memory in the arena is too small.
+ * @retval DH_FILTER_UNSUPPORTED_REALIZATION The requested realization cannot be used with the filter type.
+ * @ingroup C-API
+ */
+DH_FILTER_RETURN_VALUE dh_filter_arena_create_filter(dh_filter_arena* arena, dh_filter_data* filter, dh_filter_parameters* options);
+
+/**
+ * @brief Releases all filters in the arena at once. The slab is kept and can be used for new filters.
+ *
+ * @param[in] arena the arena.
+ * @return An enum with the result of the operation.
+ * @retval DH_FILTER_OK Operation was successfull
+ * @retval DH_FILTER_NO_DATA_STRUCTURE You gave NULL as argument.
+ * @ingroup C-API
+ */
+DH_FILTER_RETURN_VALUE dh_reset_filter_arena(dh_filter_arena* arena);
+
+/**
+ * @brief Frees the slab of an arena created with dh_create_filter_arena() and all filters in it.
+ *
+ * @param[in] arena The arena that will be freed.
+ * @return An enum with the result of the operation.
+ * @retval DH_FILTER_OK Operation was successfull
+ * @ingroup C-API
+ */
+DH_FILTER_RETURN_VALUE dh_free_filter_arena(dh_filter_arena* arena);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DH_FILTER_ARENA_H_INCLUDED */
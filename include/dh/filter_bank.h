@@ -0,0 +1,155 @@
+#ifndef DH_FILTER_BANK_H_INCLUDED
+#define DH_FILTER_BANK_H_INCLUDED
+
+/** @file
+ * @brief A bank of identical filters that process many independent channels.
+ *
+ * The coefficients are designed once and shared by all channels. The past values of all channels are stored
+ * as structure of arrays: the values of one tap (or one state variable of a second order section) for all channels
+ * are stored next to each other. Every step of the filter is a loop over the channels with a single coefficient,
+ * so the compiler can process as many channels per instruction as the SIMD registers hold.
+ *
+ * FIR filters are computed in direct form 1 and IIR filters as second order sections in transposed direct form 2.
+ *
+ * This source code is licensed under the MIT license. See file "LICENSE" at the root of the repository.
+ */
+
+#include "dh/filter-types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * The data of a filter bank. Create it with dh_create_filter_bank() and free it with dh_free_filter_bank().
+ * @ingroup C-API
+ */
+typedef struct {
+    /** Pointer to the allocated buffer for the coefficients and the past values. */
+    char* buffer;
+    /** Size of the buffer in bytes. */
+    size_t buffer_length;
+    /** The shared feedforward coefficients of FIR filters. NULL for IIR filters. */
+    double* coefficients_in;
+    /** The shared coefficients of the second order sections (b0, b1, b2, a1, a2). NULL for FIR filters. */
+    double* sections;
+    /** Circular buffer with the past inputs of FIR filters. Tap t of channel c is stored at t*number_channels + c. */
+    double* inputs;
+    /** The state of the sections. State j of section k of channel c is stored at (2*k+j)*number_channels + c. */
+    double* state;
+    /** Scratch array with number_channels entries. */
+    double* work;
+    /** The gain that is applied to the outputs. */
+    double gain;
+    /** Number of channels. */
+    size_t number_channels;
+    /** Number of elements in coefficients_in. */
+    size_t number_coefficients_in;
+    /** Number of second order sections. */
+    size_t number_sections;
+    /** Tap of the newest input in the circular buffer. */
+    size_t current_input_index;
+    /** If false, every channel is set to the steady state of its first input. */
+    bool initialized;
+    /** The realization that is used to compute the outputs. */
+    DH_FILTER_REALIZATION realization;
+} dh_filter_bank;
+
+/**
+ * @brief Designs the filter and allocates the past values for [number_channels] channels.
+ *
+ * FIR filters accept the realizations DH_REALIZATION_DEFAULT, DH_REALIZATION_DIRECT_FORM_1 and DH_REALIZATION_DIRECT_FORM_1_MIRRORED.
+ * IIR filters accept DH_REALIZATION_DEFAULT and DH_REALIZATION_SECOND_ORDER_SECTIONS.
+ *
+ * @param[out] bank The structure that will be initialized.
+ * @param[in] options The filter that is applied to every channel.
+ * @param[in] number_channels Number of independent channels. Valid range: [1, inf]
+ * @return An enum with the result of the operation.
+ * @retval DH_FILTER_OK Operation was successfull
+ * @retval DH_FILTER_NO_DATA_STRUCTURE You gave NULL as argument.
+ * @retval DH_FILTER_ERROR The number of channels is 0.
+ * @retval DH_FILTER_UNKNOWN_FILTER_TYPE An unknown filter was requested in the options.
+ * @retval DH_FILTER_UNSUPPORTED_REALIZATION The realization cannot be computed across channels.
+ * @retval DH_FILTER_ALLOCATION_FAILED Not enough memory could be allocated.
+ * @ingroup C-API
+ */
+DH_FILTER_RETURN_VALUE dh_create_filter_bank(dh_filter_bank* bank, dh_filter_parameters* options, size_t number_channels);
+
+/**
+ * @brief Filters one value of every channel.
+ *
+ * @param[in] bank An initialized filter bank.
+ * @param[in] input Array with number_channels values. Value c is the next input of channel c.
+ * @param[out] output Array with number_channels values. May be the same array as [input].
+ * @return An enum with the result of the operation.
+ * @retval DH_FILTER_OK Operation was successfull
+ * @retval DH_FILTER_NO_DATA_STRUCTURE You gave NULL as argument.
+ * @retval DH_FILTER_DATA_STRUCTURE_NOT_INITIALIZED The filter bank was not correctly initialized.
+ * @ingroup C-API
+ */
+DH_FILTER_RETURN_VALUE dh_filter_bank_tick(dh_filter_bank* bank, const double* input, double* output);
+
+/**
+ * @brief Filters a block of [count] values for every channel.
+ *
+ * The outputs are identical to calling dh_filter_bank_tick() [count] times. The blocks are transposed to frames
+ * in tiles on the stack, so this function needs an additional copy of every value. dh_filter_bank_frames() is faster
+ * if the values are already stored as interleaved frames.
+ *
+ * @param[in] bank An initialized filter bank.
+ * @param[in] input Array with number_channels*count values. The block of channel c starts at c*count.
+ * @param[out] output Array with the same layout as [input]. May be the same array as [input].
+ * @param[in] count Number of values per channel.
+ * @return An enum with the result of the operation.
+ * @retval DH_FILTER_OK Operation was successfull
+ * @retval DH_FILTER_NO_DATA_STRUCTURE You gave NULL as argument.
+ * @retval DH_FILTER_DATA_STRUCTURE_NOT_INITIALIZED The filter bank was not correctly initialized.
+ * @ingroup C-API
+ */
+DH_FILTER_RETURN_VALUE dh_filter_bank_block(dh_filter_bank* bank, const double* input, double* output, size_t count);
+
+/**
+ * @brief Filters interleaved frames. Frame i holds one value of every channel and starts at i*number_channels.
+ *
+ * The outputs are identical to calling dh_filter_bank_tick() for every frame.
+ *
+ * @param[in] bank An initialized filter bank.
+ * @param[in] input Array with number_channels*number_frames values.
+ * @param[out] output Array with the same layout as [input]. May be the same array as [input].
+ * @param[in] number_frames Number of frames.
+ * @return An enum with the result of the operation.
+ * @retval DH_FILTER_OK Operation was successfull
+ * @retval DH_FILTER_NO_DATA_STRUCTURE You gave NULL as argument.
+ * @retval DH_FILTER_DATA_STRUCTURE_NOT_INITIALIZED The filter bank was not correctly initialized.
+ * @ingroup C-API
+ */
+DH_FILTER_RETURN_VALUE dh_filter_bank_frames(dh_filter_bank* bank, const double* input, double* output, size_t number_frames);
+
+/**
+ * @brief Forces every channel to the steady state for a constant input.
+ *
+ * @param[in] bank An initialized filter bank.
+ * @param[in] values Array with number_channels values. Value c is the constant input of channel c.
+ * @return An enum with the result of the operation.
+ * @retval DH_FILTER_OK Operation was successfull
+ * @retval DH_FILTER_NO_DATA_STRUCTURE You gave NULL as argument.
+ * @retval DH_FILTER_DATA_STRUCTURE_NOT_INITIALIZED The filter bank was not correctly initialized.
+ * @ingroup C-API
+ */
+DH_FILTER_RETURN_VALUE dh_initialize_filter_bank(dh_filter_bank* bank, const double* values);
+
+/**
+ * @brief Frees the buffers of a filter bank created with dh_create_filter_bank().
+ *
+ * @param[in] bank The filter bank that will be freed.
+ * @return An enum with the result of the operation.
+ * @retval DH_FILTER_OK Operation was successfull
+ * @ingroup C-API
+ */
+DH_FILTER_RETURN_VALUE dh_free_filter_bank(dh_filter_bank* bank);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DH_FILTER_BANK_H_INCLUDED */
@@ -0,0 +1,275 @@
+#ifndef DH_FIXED_POINT_H_INCLUDED
+#define DH_FIXED_POINT_H_INCLUDED
+
+/** @file
+ * @brief Fixed point filters for processors without a floating point unit.
+ *
+ * The filters are designed with double precision and the coefficients are quantized into the Q15 or Q31 format
+ * when the filter is created. At runtime, only integer operations are used: the products are summed in
+ * 64 bit accumulators and the results are rounded and saturated to the sample format.
+ *
+ * Coefficients with a magnitude of 1 or more are scaled down by a power of two. The accumulator is shifted
+ * back by the same number of bits ([shift]) before it is rounded. FIR filters compute a direct convolution.
+ * IIR filters are computed as second order sections in direct form 1, so that all terms of a section are summed
+ * in one wide accumulator. The numerator of every section is scaled so that the peak gain of the cascade up to this
+ * section is 1. The signals between the sections cannot overflow for sinusoidal inputs and the remaining gain
+ * is applied to the output.
+ *
+ * Samples are signed integers in the Q15 (int16_t) or Q31 (int32_t) format, i.e. the range [-1,1) is mapped to
+ * the whole range of the integer type.
+ *
+ * This source code is licensed under the MIT license. See file "LICENSE" at the root of the repository.
+ */
+
+#include "dh/filter-types.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Number of bits that the products of the Q31 filters are shifted right before they are accumulated.
+ * The accumulator can hold sums up to 2^DH_FIXED_POINT_Q31_GUARD_BITS without overflow. */
+#define DH_FIXED_POINT_Q31_GUARD_BITS 8
+
+/** The report about the quantization of the coefficients of a fixed point filter.
+ * @ingroup C-API
+ */
+typedef struct {
+    /** Number of bits the coefficients were scaled down to fit into the fixed point format. */
+    unsigned coefficient_shift;
+    /** Number of bits the output gain was scaled down to fit into the fixed point format. */
+    unsigned gain_shift;
+    /** Largest absolute difference between a designed and a quantized coefficient (including the output gain). */
+    double max_coefficient_error;
+    /** Largest absolute difference between the complex frequency responses of the designed
+     * and the quantized filter, evaluated at 1024 frequencies in [0,0.5]. */
+    double max_response_error;
+    /** Largest radius of the poles of the quantized filter. 0 for FIR filters. */
+    double max_pole_radius;
+    /** Distance of the poles to the unit circle: 1 - max_pole_radius. The filter is unstable if this value is not positive. */
+    double pole_radius_margin;
+} dh_fixed_point_report;
+
+/** The interal data for a filter that computes with Q15 samples.
+ *
+ * @note If you fill the structure manually, initialize all members with zero first.
+ * @ingroup C-API
+ **/
+typedef struct {
+    /** Mirrored circular buffer with the last inputs (2*number_coefficients_in entries). NULL for IIR filters. */
+    int16_t* inputs;
+    /** The quantized feedforward coefficients. NULL for IIR filters. */
+    int16_t* coefficients_in;
+    /** The quantized coefficients of the second order sections (b0, b1, b2, a1, a2). NULL for FIR filters. */
+    int16_t* sections;
+    /** The state of the sections: x[n-1], x[n-2], y[n-1], y[n-2] for every section. NULL for FIR filters. */
+    int16_t* state;
+    /** Pointer to the allocated buffer. */
+    char* buffer;
+    /** Size of the buffer. */
+    size_t buffer_length;
+    /** Number of elements in coefficients_in. */
+    size_t number_coefficients_in;
+    /** Number of second order sections. */
+    size_t number_sections;
+    /** Start index for the circular input buffer. */
+    size_t current_input_index;
+    /** Number of bits the coefficients were scaled down. */
+    unsigned shift;
+    /** Number of bits the output gain was scaled down. */
+    unsigned gain_shift;
+    /** The quantized output gain. */
+    int16_t gain;
+    /** Current output value. */
+    int16_t current_value;
+    /** If the filter was initialized. Relevant for low pass filters. */
+    bool initialized;
+    /** If the buffer needs to be freed during free. */
+    bool buffer_needs_cleanup;
+    /** The realization that is used to compute the outputs. */
+    DH_FILTER_REALIZATION realization;
+} dh_filter_data_q15;
+
+/** The interal data for a filter that computes with Q31 samples.
+ *
+ * @note If you fill the structure manually, initialize all members with zero first.
+ * @ingroup C-API
+ **/
+typedef struct {
+    /** Mirrored circular buffer with the last inputs (2*number_coefficients_in entries). NULL for IIR filters. */
+    int32_t* inputs;
+    /** The quantized feedforward coefficients. NULL for IIR filters. */
+    int32_t* coefficients_in;
+    /** The quantized coefficients of the second order sections (b0, b1, b2, a1, a2). NULL for FIR filters. */
+    int32_t* sections;
+    /** The state of the sections: x[n-1], x[n-2], y[n-1], y[n-2] for every section. NULL for FIR filters. */
+    int32_t* state;
+    /** Pointer to the allocated buffer. */
+    char* buffer;
+    /** Size of the buffer. */
+    size_t buffer_length;
+    /** Number of elements in coefficients_in. */
+    size_t number_coefficients_in;
+    /** Number of second order sections. */
+    size_t number_sections;
+    /** Start index for the circular input buffer. */
+    size_t current_input_index;
+    /** Number of bits the coefficients were scaled down. */
+    unsigned shift;
+    /** Number of bits the output gain was scaled down. */
+    unsigned gain_shift;
+    /** The quantized output gain. */
+    int32_t gain;
+    /** Current output value. */
+    int32_t current_value;
+    /** If the filter was initialized. Relevant for low pass filters. */
+    bool initialized;
+    /** If the buffer needs to be freed during free. */
+    bool buffer_needs_cleanup;
+    /** The realization that is used to compute the outputs. */
+    DH_FILTER_REALIZATION realization;
+} dh_filter_data_q31;
+
+/**
+ * @brief Designs a filter with double precision and quantizes it into a Q15 filter.
+ *
+ * FIR filters are computed as direct convolution. The Butterworth and Chebyshev filters are computed as
+ * second order sections. All other filters and realizations are rejected.
+ *
+ * @param[out] filter pointer to the filter structure that will be initialized.
+ * @param[in] options the desired filter type.
+ * @param[out] report Optional report about the quantization errors. Also written if the quantized filter is unstable.
+ * @return DH_FILTER_RETURN_VALUE
+ * @retval DH_FILTER_OK Operation was successfull
+ * @retval DH_FILTER_NO_DATA_STRUCTURE You gave NULL as first argument.
+ * @retval DH_FILTER_UNKNOWN_FILTER_TYPE An unknown filter was requested in the options.
+ * @retval DH_FILTER_ALLOCATION_FAILED Not enough memory for the filter could be allocated.
+ * @retval DH_FILTER_UNSUPPORTED_REALIZATION The filter type or realization cannot be computed with fixed point numbers.
+ * @retval DH_FILTER_ERROR The coefficients are too large for the format or the quantized filter is unstable.
+ * @ingroup C-API
+ */
+DH_FILTER_RETURN_VALUE dh_create_filter_q15(dh_filter_data_q15* filter, dh_filter_parameters* options, dh_fixed_point_report* report);
+
+/**
+ * @brief Designs a filter with double precision and quantizes it into a Q31 filter. See dh_create_filter_q15() for details.
+ *
+ * @param[out] filter pointer to the filter structure that will be initialized.
+ * @param[in] options the desired filter type.
+ * @param[out] report Optional report about the quantization errors. Also written if the quantized filter is unstable.
+ * @return DH_FILTER_RETURN_VALUE
+ * @retval DH_FILTER_OK Operation was successfull
+ * @retval DH_FILTER_NO_DATA_STRUCTURE You gave NULL as first argument.
+ * @retval DH_FILTER_UNKNOWN_FILTER_TYPE An unknown filter was requested in the options.
+ * @retval DH_FILTER_ALLOCATION_FAILED Not enough memory for the filter could be allocated.
+ * @retval DH_FILTER_UNSUPPORTED_REALIZATION The filter type or realization cannot be computed with fixed point numbers.
+ * @retval DH_FILTER_ERROR The coefficients are too large for the format or the quantized filter is unstable.
+ * @ingroup C-API
+ */
+DH_FILTER_RETURN_VALUE dh_create_filter_q31(dh_filter_data_q31* filter, dh_filter_parameters* options, dh_fixed_point_report* report);
+
+/**
+ * @brief Runs an iteration of a Q15 filter. See dh_filter() for details.
+ *
+ * @param[in] filter The data structure of the filter. Must be created with dh_create_filter_q15().
+ * @param[in] input The next input value to the filter.
+ * @param[out] output The current output value. Parameter is optional.
+ * @return An enum with the result of the operation.
+ * @retval DH_FILTER_OK Operation was successfull
+ * @retval DH_FILTER_NO_DATA_STRUCTURE You gave NULL as first argument.
+ * @retval DH_FILTER_DATA_STRUCTURE_NOT_INITIALIZED The filter data structure was not correctly initialized.
+ * @ingroup C-API
+ */
+DH_FILTER_RETURN_VALUE dh_filter_q15(dh_filter_data_q15* filter, int16_t input, int16_t* output);
+
+/**
+ * @brief Runs a Q15 filter for a block of input values. See dh_filter_block() for details.
+ *
+ * @param[in] filter The data structure of the filter. Must be created with dh_create_filter_q15().
+ * @param[in] input Array with [count] input values.
+ * @param[out] output Array where the [count] output values are written to. May be the same array as [input].
+ * @param[in] count Number of values to filter.
+ * @return An enum with the result of the operation.
+ * @retval DH_FILTER_OK Operation was successfull
+ * @retval DH_FILTER_NO_DATA_STRUCTURE You gave NULL as filter, input or output argument.
+ * @retval DH_FILTER_DATA_STRUCTURE_NOT_INITIALIZED The filter data structure was not correctly initialized.
+ * @ingroup C-API
+ */
+DH_FILTER_RETURN_VALUE dh_filter_block_q15(dh_filter_data_q15* filter, const int16_t* input, int16_t* output, size_t count);
+
+/**
+ * @brief Runs an iteration of a Q31 filter. See dh_filter() for details.
+ *
+ * @param[in] filter The data structure of the filter. Must be created with dh_create_filter_q31().
+ * @param[in] input The next input value to the filter.
+ * @param[out] output The current output value. Parameter is optional.
+ * @return An enum with the result of the operation.
+ * @retval DH_FILTER_OK Operation was successfull
+ * @retval DH_FILTER_NO_DATA_STRUCTURE You gave NULL as first argument.
+ * @retval DH_FILTER_DATA_STRUCTURE_NOT_INITIALIZED The filter data structure was not correctly initialized.
+ * @ingroup C-API
+ */
+DH_FILTER_RETURN_VALUE dh_filter_q31(dh_filter_data_q31* filter, int32_t input, int32_t* output);
+
+/**
+ * @brief Runs a Q31 filter for a block of input values. See dh_filter_block() for details.
+ *
+ * @param[in] filter The data structure of the filter. Must be created with dh_create_filter_q31().
+ * @param[in] input Array with [count] input values.
+ * @param[out] output Array where the [count] output values are written to. May be the same array as [input].
+ * @param[in] count Number of values to filter.
+ * @return An enum with the result of the operation.
+ * @retval DH_FILTER_OK Operation was successfull
+ * @retval DH_FILTER_NO_DATA_STRUCTURE You gave NULL as filter, input or output argument.
+ * @retval DH_FILTER_DATA_STRUCTURE_NOT_INITIALIZED The filter data structure was not correctly initialized.
+ * @ingroup C-API
+ */
+DH_FILTER_RETURN_VALUE dh_filter_block_q31(dh_filter_data_q31* filter, const int32_t* input, int32_t* output, size_t count);
+
+/**
+ * @brief Forces a Q15 filter to the steady state for the constant input [value]. See dh_initialize_filter() for details.
+ *
+ * @param[in] filter the filter structure
+ * @param[in] value the constant input
+ * @return An enum with the result of the operation.
+ * @retval DH_FILTER_OK Operation was successfull
+ * @retval DH_FILTER_NO_DATA_STRUCTURE You gave NULL as first argument.
+ * @ingroup C-API
+ */
+DH_FILTER_RETURN_VALUE dh_initialize_filter_q15(dh_filter_data_q15* filter, int16_t value);
+
+/**
+ * @brief Forces a Q31 filter to the steady state for the constant input [value]. See dh_initialize_filter() for details.
+ *
+ * @param[in] filter the filter structure
+ * @param[in] value the constant input
+ * @return An enum with the result of the operation.
+ * @retval DH_FILTER_OK Operation was successfull
+ * @retval DH_FILTER_NO_DATA_STRUCTURE You gave NULL as first argument.
+ * @ingroup C-API
+ */
+DH_FILTER_RETURN_VALUE dh_initialize_filter_q31(dh_filter_data_q31* filter, int32_t value);
+
+/** Frees the filter created with dh_create_filter_q15().
+ *
+ * @param[in] filter the filter structure that will be freed.
+ * @return An enum with the result of the operation.
+ * @retval DH_FILTER_OK Operation was successfull
+ * @ingroup C-API
+ */
+DH_FILTER_RETURN_VALUE dh_free_filter_q15(dh_filter_data_q15* filter);
+
+/** Frees the filter created with dh_create_filter_q31().
+ *
+ * @param[in] filter the filter structure that will be freed.
+ * @return An enum with the result of the operation.
+ * @retval DH_FILTER_OK Operation was successfull
+ * @ingroup C-API
+ */
+DH_FILTER_RETURN_VALUE dh_free_filter_q31(dh_filter_data_q31* filter);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DH_FIXED_POINT_H_INCLUDED */
@@ -0,0 +1,76 @@
+#ifndef DH_OVERLAP_SAVE_H_INCLUDED
+#define DH_OVERLAP_SAVE_H_INCLUDED
+
+/** @file
+ * @brief Overlap-save convolution for FIR filters with many coefficients.
+ *
+ * The inputs are processed in blocks with a fast fourier transform. The costs per value grow with
+ * O(log N) instead of O(N) for the direct convolution. The convolution must be requested with the realization
+ * DH_REALIZATION_OVERLAP_SAVE, because the outputs differ from the direct convolution by rounding errors.
+ * It is only used by dh_filter_block() if the block contains enough values. All other values are computed with the direct convolution,
+ * so that there is no additional delay.
+ *
+ * This source code is licensed under the MIT license. See file "LICENSE" at the root of the repository.
+ */
+
+#include "dh/filter-types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** The minimum number of coefficients of a FIR filter before the overlap-save convolution is used if it was requested. */
+#define DH_FILTER_FFT_MIN_COEFFICIENTS 32
+
+/**
+ * @brief Computes the length of the FFT for a FIR filter with the given number of coefficients.
+ *
+ * @param number_coefficients Number of feedforward coefficients.
+ * @return The length of the FFT or 0 if the filter is too short for the overlap-save convolution.
+ */
+size_t dh_overlap_save_fft_length(size_t number_coefficients);
+
+/**
+ * @brief Computes the number of doubles that are needed for the overlap-save convolution with the given FFT length.
+ *
+ * @param fft_length The length of the FFT.
+ * @return Number of doubles.
+ */
+size_t dh_overlap_save_buffer_length(size_t fft_length);
+
+/**
+ * @brief Sets the pointers of [data] to the given buffer.
+ *
+ * @param data The data structure that is initialized.
+ * @param buffer Array with at least dh_overlap_save_buffer_length() entries.
+ * @param fft_length The length of the FFT.
+ */
+void dh_overlap_save_assign_buffer(dh_overlap_save_data* data, double* buffer, size_t fft_length);
+
+/**
+ * @brief Computes the twiddle factors and the spectrum of the feedforward coefficients of the filter.
+ *
+ * Must be called after the coefficients were computed.
+ * @param filter The filter with the assigned overlap-save buffers.
+ */
+void dh_overlap_save_prepare(dh_filter_data* filter);
+
+/**
+ * @brief Filters as many complete blocks of [input] as possible with the overlap-save convolution.
+ *
+ * The circular input buffer of the filter is updated in the same way as by the direct convolution.
+ * [input] and [output] may be the same array.
+ *
+ * @param filter An initialized filter.
+ * @param input Array with [count] input values.
+ * @param output Array with [count] entries.
+ * @param count Number of values.
+ * @return The number of values that were filtered. The remaining values must be filtered with the direct convolution.
+ */
+size_t dh_overlap_save_run(dh_filter_data* filter, const double* input, double* output, size_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DH_OVERLAP_SAVE_H_INCLUDED */
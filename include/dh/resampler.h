@@ -0,0 +1,142 @@
+#ifndef DH_RESAMPLER_H_INCLUDED
+#define DH_RESAMPLER_H_INCLUDED
+
+/** @file
+ * @brief Polyphase resampler that changes the sampling rate by a rational factor L/M.
+ *
+ * Conceptually, L-1 zeros are inserted after every input, the result is filtered with a brickwall lowpass and
+ * only every M-th value is kept. The polyphase decomposition splits the lowpass into L sub-filters with
+ * [taps_per_phase] coefficients each. Every output is computed with exactly one sub-filter from the real inputs,
+ * so neither the inserted zeros nor the discarded outputs cost any operations.
+ *
+ * This source code is licensed under the MIT license. See file "LICENSE" at the root of the repository.
+ */
+
+#include "dh/filter-types.h"
+#include "dh/dot_product.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * The parameters for a resampler that will be created with dh_create_resampler().
+ * @ingroup C-API
+ */
+typedef struct {
+    /** Interpolation factor L. The output rate is the input rate multiplied with L/M. Valid range: [1, inf] */
+    size_t interpolation;
+    /** Decimation factor M. The output rate is the input rate multiplied with L/M. Valid range: [1, inf] */
+    size_t decimation;
+    /** Number of coefficients of every sub-filter. The anti-aliasing filter has interpolation*taps_per_phase coefficients.
+     * More coefficients give a steeper transition band and a longer delay. Valid range: [1, inf] */
+    size_t taps_per_phase;
+    /** Cutoff frequency of the anti-aliasing filter divided by the lower of both nyquist frequencies.
+     * Valid range: (0, 1]. A value of 0.9 leaves some room for the transition band. */
+    double bandwidth;
+} dh_resampler_parameters;
+
+/**
+ * The data of a resampler. Create it with dh_create_resampler() and free it with dh_free_resampler().
+ * @ingroup C-API
+ */
+typedef struct {
+    /** Pointer to the allocated buffer for the coefficients and the past inputs. */
+    char* buffer;
+    /** Size of the buffer in bytes. */
+    size_t buffer_length;
+    /** The coefficients of the sub-filters. Sub-filter p starts at index p*taps_per_phase and its first coefficient
+     * is multiplied with the newest input. */
+    double* coefficients;
+    /** Mirrored circular buffer with 2*taps_per_phase entries holding the past inputs, so that the last
+     * inputs are always stored in a contiguous range starting at history_index. */
+    double* history;
+    /** The function used for the dot products. */
+    dh_dot_product_function dot_product;
+    /** Interpolation factor L, divided by the greatest common divisor of L and M. */
+    size_t interpolation;
+    /** Decimation factor M, divided by the greatest common divisor of L and M. */
+    size_t decimation;
+    /** Number of coefficients per sub-filter. */
+    size_t taps_per_phase;
+    /** Index of the newest input in history. */
+    size_t history_index;
+    /** Sub-filter that computes the next output. If it is at least interpolation, more inputs are needed. */
+    size_t phase;
+    /** If false, the past inputs are set to the first input value, so that the resampler starts in its steady state. */
+    bool initialized;
+} dh_resampler_data;
+
+/**
+ * @brief Allocates the buffers and computes the polyphase coefficients of the resampler.
+ *
+ * The anti-aliasing filter is computed with dh_fill_array_fir_sinc(). The gain at 0 Hz is 1.
+ * L and M are divided by their greatest common divisor, so 4/6 creates the same resampler as 2/3.
+ *
+ * @param[out] resampler The structure that will be initialized.
+ * @param[in] options The resampling ratio and filter length.
+ * @return An enum with the result of the operation.
+ * @retval DH_FILTER_OK Operation was successfull
+ * @retval DH_FILTER_NO_DATA_STRUCTURE You gave NULL as argument.
+ * @retval DH_FILTER_ERROR A parameter was outside of its valid range.
+ * @retval DH_FILTER_ALLOCATION_FAILED Not enough memory could be allocated.
+ * @ingroup C-API
+ */
+DH_FILTER_RETURN_VALUE dh_create_resampler(dh_resampler_data* resampler, const dh_resampler_parameters* options);
+
+/**
+ * @brief Computes how many outputs the next call of dh_resample() with [input_count] values will write.
+ *
+ * @param[in] resampler An initialized resampler.
+ * @param[in] input_count Number of input values.
+ * @return The number of output values.
+ * @ingroup C-API
+ */
+size_t dh_resampler_output_count(const dh_resampler_data* resampler, size_t input_count);
+
+/**
+ * @brief Resamples a block of values.
+ *
+ * The state is kept across calls, so a signal can be split into blocks of arbitrary length.
+ * The outputs are identical to resampling the whole signal at once.
+ *
+ * @param[in] resampler An initialized resampler.
+ * @param[in] input Array with [input_count] values. May be NULL if [input_count] is 0.
+ * @param[in] input_count Number of input values.
+ * @param[out] output Array with at least dh_resampler_output_count() entries. Must not overlap with [input]. May be NULL if [input_count] is 0.
+ * @param[out] output_count The number of values written to [output]. Parameter is optional.
+ * @return An enum with the result of the operation.
+ * @retval DH_FILTER_OK Operation was successfull
+ * @retval DH_FILTER_NO_DATA_STRUCTURE You gave NULL as resampler argument, or as input or output argument for a non-empty block.
+ * @retval DH_FILTER_DATA_STRUCTURE_NOT_INITIALIZED The resampler was not correctly initialized.
+ * @ingroup C-API
+ */
+DH_FILTER_RETURN_VALUE dh_resample(dh_resampler_data* resampler, const double* input, size_t input_count, double* output, size_t* output_count);
+
+/**
+ * @brief Forces the resampler to the steady state by setting all past inputs to the given [value].
+ *
+ * @param[in] resampler An initialized resampler.
+ * @param[in] value The desired steady state.
+ * @return An enum with the result of the operation.
+ * @retval DH_FILTER_OK Operation was successfull
+ * @retval DH_FILTER_NO_DATA_STRUCTURE You gave NULL as first argument.
+ * @ingroup C-API
+ */
+DH_FILTER_RETURN_VALUE dh_initialize_resampler(dh_resampler_data* resampler, double value);
+
+/**
+ * @brief Frees the buffers of a resampler created with dh_create_resampler().
+ *
+ * @param[in] resampler The resampler that will be freed.
+ * @return An enum with the result of the operation.
+ * @retval DH_FILTER_OK Operation was successfull
+ * @ingroup C-API
+ */
+DH_FILTER_RETURN_VALUE dh_free_resampler(dh_resampler_data* resampler);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DH_RESAMPLER_H_INCLUDED */
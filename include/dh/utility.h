@@ -56,6 +56,24 @@ void dh_normalize_gain_at(double* numerator, size_t len_numerator,double* denomi
  */
 COMPLEX dh_gain_at(double* numerator, size_t len_numerator,double* denominator, size_t len_denominator, double x_evaluate);
 
+/**
+ * @brief Checks if the filter type has no feedback.
+ * 
+ * @param type The filter type.
+ * @return true for all FIR filters and DH_NO_FILTER.
+ */
+bool dh_filter_type_is_fir(DH_FILTER_TYPE type);
+
+/**
+ * @brief Computes the coefficients of a brickwall lowpass or highpass (sinc function). The gain at 0 Hz is normalized to 1.
+ * 
+ * @param data Output array with [count] entries.
+ * @param count Number of coefficients.
+ * @param cutoff Cutoff frequency divided by the sampling frequency. Range: [0,0.5]
+ * @param highpass If true, the coefficients of the highpass are computed.
+ */
+void dh_fill_array_fir_sinc(double* data, size_t count,double cutoff, bool highpass);
+
 /**
  * @brief Convolves two sets of FIR filter parameters to combine them into one filter.
  * 
@@ -98,10 +116,22 @@ typedef struct
     /** User data for the functions */
     void* user_data;
 
+    /** Optional scratch memory with at least dh_transfer_function_workspace_size() bytes.
+     * If NULL, the temporary buffers are allocated. */
+    void* workspace;
+
     /** The filter characteristic */
     DH_FILTER_CHARACTERISTIC characteristic;
 } dh_transfer_function_callbacks;
 
+/**
+ * @brief Computes the size of the scratch memory that dh_compute_transfer_function_polynomials() needs for a filter of the given order.
+ * 
+ * @param filter_order The order of the filter.
+ * @return Size in bytes.
+ */
+size_t dh_transfer_function_workspace_size(size_t filter_order);
+
 /**
  * @brief Computes the transfer function polynomial for a filter using the given callbacks.
  * 
@@ -111,7 +141,9 @@ typedef struct
  * The real part of the polynomial coefficients is written to the coefficient arrays in [filter]. 
  * The order of the polynomial coefficients is inverted: index 0 is the coefficient for x**n.
  * 
- * This function will allocate temporary buffers.
+ * If the filter has an array for second order sections, the sections are computed with dh_compute_second_order_sections().
+ * 
+ * This function will allocate temporary buffers unless cbs.workspace is set.
  * 
  * @param filter The filter that will be initialized. Output values are written to the arrays.
  * @param options The options for the filter that are used to compute the values.
@@ -120,6 +152,33 @@ typedef struct
  */
 DH_FILTER_RETURN_VALUE dh_compute_transfer_function_polynomials(dh_filter_data* filter, const dh_filter_parameters* options, const dh_transfer_function_callbacks cbs);
 
+/**
+ * @brief Computes the second order sections for a filter using the given callbacks.
+ * 
+ * The poles and zeros are computed in the same way as in dh_compute_transfer_function_polynomials().
+ * Conjugate roots are combined into quadratic factors. Each pair of poles is combined with the closest pair of zeros
+ * into one section. The sections are sorted by the distance of the poles to the unit circle, so the section with
+ * the poles closest to the unit circle is applied last. The gain of every section is normalized to 1.0.
+ * The sections are written to the sections array of [filter], which must have room for all sections.
+ * 
+ * This function will allocate temporary buffers unless cbs.workspace is set.
+ * 
+ * @param filter The filter that will be initialized. Output values are written to the sections array.
+ * @param options The options for the filter that are used to compute the values.
+ * @param cbs Struct with the function pointers that are used to initialize the poles and zeros on the s-plane.
+ * @return Returns DH_FILTER_OK on success, otherwise an error code is returned.
+ */
+DH_FILTER_RETURN_VALUE dh_compute_second_order_sections(dh_filter_data* filter, const dh_filter_parameters* options, const dh_transfer_function_callbacks cbs);
+
+/**
+ * @brief Evaluates a cascade of second order sections at the given position and returns the gain.
+ * 
+ * @param sections Array with the coefficients of the sections (b0, b1, b2, a1, a2 for each section).
+ * @param number_sections Number of sections.
+ * @param x_evaluate Position where the sections are evaluated on the complex unit circle.
+ */
+COMPLEX dh_gain_at_sections(const double* sections, size_t number_sections, double x_evaluate);
+
 /** Used to get rid of compiler warnings */
 #define MAYBE_UNUSED(X) (void)((X))
 
@@ -6,17 +6,149 @@
 
 namespace dh {
 
+namespace {
 
-filter::filter(dh_filter_parameters options) : options_(options) {
+// overloads that map the data structures of both sample types to the C-API
+
+DH_FILTER_RETURN_VALUE create_data(dh_filter_data* data, dh_filter_parameters* options) {
+    return dh_create_filter(data, options);
+}
+
+DH_FILTER_RETURN_VALUE create_data(dh_filter_data_f32* data, dh_filter_parameters* options) {
+    return dh_create_filter_f32(data, options);
+}
+
+void free_data(dh_filter_data* data) {
+    dh_free_filter(data);
+}
+
+void free_data(dh_filter_data_f32* data) {
+    dh_free_filter_f32(data);
+}
+
+DH_FILTER_RETURN_VALUE run(dh_filter_data* data, double in, double* out) {
+    return dh_filter(data, in, out);
+}
+
+DH_FILTER_RETURN_VALUE run(dh_filter_data_f32* data, float in, float* out) {
+    return dh_filter_f32(data, in, out);
+}
+
+DH_FILTER_RETURN_VALUE run_block(dh_filter_data* data, const double* in, double* out, size_t count) {
+    return dh_filter_block(data, in, out, count);
+}
+
+DH_FILTER_RETURN_VALUE run_block(dh_filter_data_f32* data, const float* in, float* out, size_t count) {
+    return dh_filter_block_f32(data, in, out, count);
+}
+
+DH_FILTER_RETURN_VALUE set_gain_of(dh_filter_data* data, double gain) {
+    return dh_filter_set_gain(data, gain);
+}
+
+DH_FILTER_RETURN_VALUE set_gain_of(dh_filter_data_f32* data, float gain) {
+    return dh_filter_set_gain_f32(data, gain);
+}
+
+DH_FILTER_RETURN_VALUE get_gain_of(const dh_filter_data* data, double* gain) {
+    return dh_filter_get_gain(data, gain);
+}
+
+DH_FILTER_RETURN_VALUE get_gain_of(const dh_filter_data_f32* data, float* gain) {
+    return dh_filter_get_gain_f32(data, gain);
+}
+
+void copy_state(dh_filter_data& data, const dh_filter_data& other) {
+    data.current_input_index = other.current_input_index;
+    data.current_output_index = other.current_output_index;
+    data.decimation_phase = other.decimation_phase;
+    data.initialized = other.initialized;
+    data.current_value = other.current_value;
+    data.accumulator = other.accumulator;
+    data.accumulator_partial = other.accumulator_partial;
+    data.kernel = other.kernel;
+}
+
+void copy_state(dh_filter_data_f32& data, const dh_filter_data_f32& other) {
+    data.current_input_index = other.current_input_index;
+    data.initialized = other.initialized;
+    data.current_value = other.current_value;
+    data.gain = other.gain;
+}
+
+size_t number_feedforward(const dh_filter_data& data) {
+    return data.number_coefficients_in;
+}
+
+size_t number_feedforward(const dh_filter_data_f32& data) {
+    return data.number_coefficients_in;
+}
+
+const double* feedback(const dh_filter_data& data, size_t* count) {
+    *count = data.number_coefficients_out;
+    return data.number_coefficients_out>0 ? data.coefficients_out : nullptr;
+}
+
+const float* feedback(const dh_filter_data_f32&, size_t* count) {
+    // single precision filters have no feedback polynomial
+    *count = 0;
+    return nullptr;
+}
+
+bool is_good(const dh_filter_data& data) {
+    return data.number_coefficients_in!=0;
+}
+
+bool is_good(const dh_filter_data_f32& data) {
+    return data.buffer!=nullptr;
+}
+
+std::vector<dh_frequency_response_t> frequency_response(const dh_filter_data& data, double sampling_frequency, size_t count) {
+    std::vector<dh_frequency_response_t> rv{};
+    rv.reserve(count);
+    for(size_t i=0;i<=count;i++) {
+        dh_frequency_response_t resp{};
+        resp.frequency = static_cast<double>(i)/static_cast<double>(2*count);
+        auto status = dh_filter_get_gain_at(&data, resp.frequency, &resp);
+        if(status != DH_FILTER_OK) {
+            throw filter_error("Failed to get gain!");
+        }
+        resp.frequency *= sampling_frequency;
+        rv.emplace_back(resp);
+    }
+    return rv;
+}
+
+std::vector<dh_frequency_response_t> frequency_response(const dh_filter_data_f32& data, const dh_filter_parameters& options, size_t count) {
+    // the response of the converted coefficients is not available, so the designed response is returned
+    float gain = 1.0f;
+    if(dh_filter_get_gain_f32(&data, &gain) != DH_FILTER_OK) {
+        throw filter_error("Failed to get gain!");
+    }
+    auto designed = dh::filter(options);
+    designed.set_gain(gain);
+    return designed.compute_frequency_response(count);
+}
+
+std::vector<dh_frequency_response_t> frequency_response(const dh_filter_data& data, const dh_filter_parameters& options, size_t count) {
+    return frequency_response(data, options.sampling_frequency, count);
+}
+
+}
+
+template<typename T>
+basic_filter<T>::basic_filter(dh_filter_parameters options) : options_(options) {
     create_internal_data();
 }
 
-filter::~filter() {
-    dh_free_filter(&data_);
+template<typename T>
+basic_filter<T>::~basic_filter() {
+    free_data(&data_);
 }
 
-void filter::create_internal_data() {
-    auto status = dh_create_filter(&data_,&options_);
+template<typename T>
+void basic_filter<T>::create_internal_data() {
+    auto status = create_data(&data_,&options_);
     switch (status)
     {
     case DH_FILTER_OK:
@@ -25,92 +157,97 @@ void filter::create_internal_data() {
         throw error("Unkown filter type");
     case DH_FILTER_ALLOCATION_FAILED:
         throw error("Allocation of filter failed");
+    case DH_FILTER_UNSUPPORTED_REALIZATION:
+        throw error("Unsupported realization");
     default:
         throw error("Unspecified error");
     }
 }
-void filter::deep_copy(const dh_filter_data& other) {
-    std::copy(other.inputs, other.inputs+data_.number_coefficients_in, data_.inputs);
-    std::copy(other.outputs, other.outputs+data_.number_coefficients_out, data_.outputs);
-    data_.current_input_index = other.current_input_index;
-    data_.current_output_index = other.current_output_index;
-    data_.initialized = other.initialized;
-    data_.current_value = other.current_value;
+
+template<typename T>
+void basic_filter<T>::deep_copy(const typename filter_data<T>::type& other) {
+    // both filters were created with the same options, so the buffers have the same layout
+    std::copy(other.buffer, other.buffer+other.buffer_length, data_.buffer);
+    copy_state(data_, other);
 }
 
-filter::filter(const filter& other) : filter(other.options_) {
+template<typename T>
+basic_filter<T>::basic_filter(const basic_filter& other) : basic_filter(other.options_) {
     deep_copy(other.data_);
 }
 
-filter& filter::operator=(const filter& other) {
-    dh_free_filter(&data_);
+template<typename T>
+basic_filter<T>& basic_filter<T>::operator=(const basic_filter& other) {
+    free_data(&data_);
     options_ = other.options_;
     create_internal_data();
     deep_copy(other.data_);
     return *this;
 }
 
-filter::filter(filter&& other) : options_(other.options_), data_(other.data_) {
+template<typename T>
+basic_filter<T>::basic_filter(basic_filter&& other) : options_(other.options_), data_(other.data_) {
     other.data_.buffer_needs_cleanup = false;
-    dh_free_filter(&other.data_);
+    free_data(&other.data_);
 }
 
-filter& filter::operator=(filter&& other) {
-    dh_free_filter(&data_);
+template<typename T>
+basic_filter<T>& basic_filter<T>::operator=(basic_filter&& other) {
+    free_data(&data_);
     options_ = other.options_;
     data_ = other.data_;
     other.data_.buffer_needs_cleanup = false;
-    dh_free_filter(&other.data_);
+    free_data(&other.data_);
     return *this;
 }
 
-double filter::update(double in) {
-    double rv = 0.0;
-    if(dh_filter(&data_,in,&rv) != DH_FILTER_OK) {
+template<typename T>
+T basic_filter<T>::update(T in) {
+    T rv = 0;
+    if(run(&data_,in,&rv) != DH_FILTER_OK) {
         throw error("Failed to update the filter! Filter was probably moved from.");
     }
     return rv;
 }
 
+template<typename T>
+void basic_filter<T>::update(const T* in, T* out, size_t count) {
+    if(run_block(&data_,in,out,count) != DH_FILTER_OK) {
+        throw error("Failed to update the filter! Filter was probably moved from.");
+    }
+}
 
-void filter::set_gain(double gain) {
-    if(dh_filter_set_gain(&data_,gain) != DH_FILTER_OK) {
+template<typename T>
+void basic_filter<T>::set_gain(T gain) {
+    if(set_gain_of(&data_,gain) != DH_FILTER_OK) {
         throw error("Failed to set gain! Filter was probably moved from.");
     }
 }
 
-double filter::gain() const {
-    double rv = 0.0;
-    if(dh_filter_get_gain(&data_,&rv) != DH_FILTER_OK) {
+template<typename T>
+T basic_filter<T>::gain() const {
+    T rv = 0;
+    if(get_gain_of(&data_,&rv) != DH_FILTER_OK) {
         throw error("Failed to get gain! Filter was probably moved from.");
     }
     return rv;
 }
 
-std::vector<dh_frequency_response_t> filter::compute_frequency_response(size_t count) const {
+template<typename T>
+std::vector<dh_frequency_response_t> basic_filter<T>::compute_frequency_response(size_t count) const {
     if(!good()) {
         throw error("Failed to compute frequency response! Filter was probably moved from.");
     }
-    std::vector<dh_frequency_response_t> rv{};
-    rv.reserve(count);
-    for(size_t i=0;i<=count;i++) {
-        dh_frequency_response_t resp{};
-        resp.frequency = static_cast<double>(i)/static_cast<double>(2*count);
-        auto status = dh_filter_get_gain_at(&data_, resp.frequency, &resp);
-        if(status != DH_FILTER_OK) {
-            throw error("Failed to get gain!");
-        }
-        resp.frequency *= options_.sampling_frequency;
-        rv.emplace_back(resp);
-    }
-    return rv;
+    return frequency_response(data_, options_, count);
 }
 
-bool  filter::good() const noexcept {
-    return data_.number_coefficients_in!=0;
+template<typename T>
+bool basic_filter<T>::good() const noexcept {
+    return is_good(data_);
 }
 
-filter::span filter::feedforward_coefficients() const noexcept {
+template<typename T>
+typename basic_filter<T>::span basic_filter<T>::feedforward_coefficients() const noexcept {
     if(data_.number_coefficients_in>0) {
         return span(data_.coefficients_in,data_.number_coefficients_in);
     } else {
@@ -118,20 +255,19 @@ filter::span filter::feedforward_coefficients() const noexcept {
     }
 }
 
-filter::span filter::feedback_coefficients() const noexcept {
-    if(data_.number_coefficients_out>0) {
-        return span(data_.coefficients_out,data_.number_coefficients_out);
-    } else {
-        return span(nullptr,0);
-    }
+template<typename T>
+typename basic_filter<T>::span basic_filter<T>::feedback_coefficients() const noexcept {
+    size_t count = 0;
+    const T* coefficients = feedback(data_, &count);
+    return span(coefficients,count);
 }
 
-
-std::vector<filter::graph_point> filter::compute_step_response() const
+template<typename T>
+std::vector<typename basic_filter<T>::graph_point> basic_filter<T>::compute_step_response() const
 {
-    std::vector<filter::graph_point> rv{};
-    size_t count = std::max<size_t>(50U,2*data_.number_coefficients_in);
-    auto copy = dh::filter(options_);
+    std::vector<graph_point> rv{};
+    size_t count = std::max<size_t>(50U,2*number_feedforward(data_));
+    auto copy = basic_filter<T>(options_);
     double input = 0.0;
     double output = 0.0;
     for(size_t i=0;i<count;++i) {
@@ -140,18 +276,19 @@ std::vector<filter::graph_point> filter::compute_step_response() const
         } else {
             input = 0.0;
         }
-        output = copy.update(input);
+        output = copy.update(static_cast<T>(input));
         double x = (static_cast<double>(i)-9.0)*1.0/options_.sampling_frequency;
         rv.emplace_back(graph_point{x,input,output});
     }
     return rv;
 }
 
-std::vector<filter::graph_point> filter::compute_impulse_response() const
+template<typename T>
+std::vector<typename basic_filter<T>::graph_point> basic_filter<T>::compute_impulse_response() const
 {
-    std::vector<filter::graph_point> rv{};
-    size_t count = std::max<size_t>(50U,2*data_.number_coefficients_in);
-    auto copy = dh::filter(options_);
+    std::vector<graph_point> rv{};
+    size_t count = std::max<size_t>(50U,2*number_feedforward(data_));
+    auto copy = basic_filter<T>(options_);
     double input = 0.0;
     double output = 0.0;
     for(size_t i=0;i<count;++i) {
@@ -160,12 +297,14 @@ std::vector<filter::graph_point> filter::compute_impulse_response() const
         } else {
             input = 0.0;
         }
-        output = copy.update(input);
+        output = copy.update(static_cast<T>(input));
         double x = (static_cast<double>(i)-9.0)*1.0/options_.sampling_frequency;
         rv.emplace_back(graph_point{x,input,output});
     }
     return rv;
 }
 
+template class basic_filter<double>;
+template class basic_filter<float>;
 
 }
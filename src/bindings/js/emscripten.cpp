@@ -30,6 +30,16 @@ EMSCRIPTEN_BINDINGS(filter_params) {
     .value("IIR_CHEBYSHEV2_BANDPASS", DH_IIR_CHEBYSHEV2_BANDPASS)
     .value("IIR_CHEBYSHEV2_BANDSTOP", DH_IIR_CHEBYSHEV2_BANDSTOP);
 
+  enum_<DH_FILTER_REALIZATION>("FilterRealization")
+    .value("DEFAULT", DH_REALIZATION_DEFAULT)
+    .value("DIRECT_FORM_1", DH_REALIZATION_DIRECT_FORM_1)
+    .value("DIRECT_FORM_1_MIRRORED", DH_REALIZATION_DIRECT_FORM_1_MIRRORED)
+    .value("SECOND_ORDER_SECTIONS", DH_REALIZATION_SECOND_ORDER_SECTIONS)
+    .value("TRANSPOSED_DIRECT_FORM_2", DH_REALIZATION_TRANSPOSED_DIRECT_FORM_2)
+    .value("RUNNING_SUM", DH_REALIZATION_RUNNING_SUM)
+    .value("RECURSIVE_EXPONENTIAL", DH_REALIZATION_RECURSIVE_EXPONENTIAL)
+    .value("OVERLAP_SAVE", DH_REALIZATION_OVERLAP_SAVE);
+
   class_<dh_filter_parameters>("FilterParameters")
     .constructor<>()
     .property("cutoffFrequencyLow", &dh_filter_parameters::cutoff_frequency_low)
@@ -37,7 +47,8 @@ EMSCRIPTEN_BINDINGS(filter_params) {
     .property("samplingFrequency", &dh_filter_parameters::sampling_frequency)
     .property("ripple", &dh_filter_parameters::ripple)
     .property("filterOrder", &dh_filter_parameters::filter_order)
-    .property("filterType", &dh_filter_parameters::filter_type);
+    .property("filterType", &dh_filter_parameters::filter_type)
+    .property("realization", &dh_filter_parameters::realization);
 }
 
 
@@ -26,7 +26,7 @@ static size_t butterworth_splane_poles(COMPLEX* splane,size_t count,size_t order
     return order;
 }
 
-DH_FILTER_RETURN_VALUE dh_compute_butterworth_filter_coefficients(dh_filter_data* filter, dh_filter_parameters* options, DH_FILTER_CHARACTERISTIC characteristic)
+DH_FILTER_RETURN_VALUE dh_compute_butterworth_filter_coefficients(dh_filter_data* filter, dh_filter_parameters* options, DH_FILTER_CHARACTERISTIC characteristic, void* workspace)
 {
     if(filter == NULL || options == NULL || filter->coefficients_in == NULL || filter->coefficients_out == NULL) {
         return DH_FILTER_NO_DATA_STRUCTURE;
@@ -36,5 +36,6 @@ DH_FILTER_RETURN_VALUE dh_compute_butterworth_filter_coefficients(dh_filter_data
     cbs.zeros = &butterworth_splane_zeros;
     cbs.poles = &butterworth_splane_poles;
     cbs.user_data = NULL;
+    cbs.workspace = workspace;
     return dh_compute_transfer_function_polynomials(filter,options,cbs);
 }
@@ -56,7 +56,7 @@ static size_t chebyshev_splane_poles(COMPLEX* splane,size_t count,size_t order,v
     return order;
 }
 
-DH_FILTER_RETURN_VALUE dh_compute_chebyshev_filter_coefficients(dh_filter_data* filter, dh_filter_parameters* options, DH_FILTER_CHARACTERISTIC characteristic, bool isType2)
+DH_FILTER_RETURN_VALUE dh_compute_chebyshev_filter_coefficients(dh_filter_data* filter, dh_filter_parameters* options, DH_FILTER_CHARACTERISTIC characteristic, bool isType2, void* workspace)
 {
     if(filter == NULL || options == NULL || filter->coefficients_in == NULL || filter->coefficients_out == NULL) {
         return DH_FILTER_NO_DATA_STRUCTURE;
@@ -69,5 +69,6 @@ DH_FILTER_RETURN_VALUE dh_compute_chebyshev_filter_coefficients(dh_filter_data*
     data.isType2 = isType2;
     data.ripple_db = options->ripple;
     cbs.user_data = &data;
+    cbs.workspace = workspace;
     return dh_compute_transfer_function_polynomials(filter,options,cbs);
 }
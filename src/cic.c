@@ -0,0 +1,257 @@
+#include "dh/cic.h"
+#include "dh/utility.h"
+#define _USE_MATH_DEFINES
+#include "math.h"
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @file
+ * @brief This file contains the cascaded integrator-comb filters.
+ *
+ * A decimator runs the integrators for every input and the combs for every R-th input.
+ * An interpolator runs the combs for every input and inserts R-1 zeros before the integrators.
+ * All registers are unsigned, so the wrap around of the integrators is well defined.
+ *
+ * This source code is licensed under the MIT license. See file "LICENSE" at the root of the repository.
+ */
+
+/** Number of intervals per coefficient used to integrate the desired response of the compensation filter. */
+#define DH_CIC_COMPENSATION_INTERVALS 64
+
+DH_FILTER_RETURN_VALUE dh_create_cic(dh_cic_data* cic, const dh_cic_parameters* options)
+{
+    assert(cic != NULL);
+    assert(options != NULL);
+    if (cic == NULL || options == NULL) {
+        return DH_FILTER_NO_DATA_STRUCTURE;
+    }
+    if (options->stages == 0 || options->rate == 0 || options->differential_delay == 0) {
+        return DH_FILTER_ERROR;
+    }
+    // the outputs of a decimator are bounded by 2^31 * (R*M)^N, which must fit into 64 bits
+    const uint64_t limit = (uint64_t)1 << 32;
+    const uint64_t length = (uint64_t)options->rate * (uint64_t)options->differential_delay;
+    if (length > limit) {
+        return DH_FILTER_ERROR;
+    }
+    uint64_t gain = 1;
+    for (size_t k=0; k<options->stages; ++k) {
+        gain *= length;
+        if (gain > limit) {
+            return DH_FILTER_ERROR;
+        }
+    }
+    unsigned bit_growth = 0;
+    while (((uint64_t)1 << bit_growth) < gain) {
+        ++bit_growth;
+    }
+
+    const size_t number_registers = options->stages * (1 + options->differential_delay);
+    cic->buffer_length = number_registers * sizeof(uint64_t);
+    cic->buffer = (char*)malloc(cic->buffer_length);
+    if (cic->buffer == NULL) {
+        cic->buffer_length = 0;
+        return DH_FILTER_ALLOCATION_FAILED;
+    }
+    cic->integrators = (uint64_t*)cic->buffer;
+    cic->combs = cic->integrators + options->stages;
+    cic->stages = options->stages;
+    cic->rate = options->rate;
+    cic->differential_delay = options->differential_delay;
+    cic->bit_growth = bit_growth;
+    cic->interpolator = options->interpolator;
+    cic->gain = options->interpolator ? (double)gain / (double)options->rate : (double)gain;
+    dh_reset_cic(cic);
+    return DH_FILTER_OK;
+}
+
+size_t dh_cic_output_count(const dh_cic_data* cic, size_t input_count)
+{
+    if (cic == NULL || cic->rate == 0) {
+        return 0;
+    }
+    if (cic->interpolator) {
+        return input_count * cic->rate;
+    }
+    return (cic->phase + input_count) / cic->rate;
+}
+
+/**
+ * @brief Converts a register to a signed value. The conversion of values above INT64_MAX is implementation defined in C, so it is done explicitly.
+ */
+static inline int64_t dh_cic_to_signed(uint64_t value)
+{
+    return value <= (uint64_t)INT64_MAX ? (int64_t)value : -(int64_t)(~value) - 1;
+}
+
+/**
+ * @brief Runs the combs for one value at the low rate and returns the output of the last comb.
+ */
+static inline uint64_t dh_cic_run_combs(dh_cic_data* cic, uint64_t value)
+{
+    const size_t delay = cic->differential_delay;
+    const size_t index = cic->comb_index;
+    for (size_t k=0; k<cic->stages; ++k) {
+        uint64_t* past = cic->combs + k*delay + index;
+        const uint64_t delayed = *past;
+        *past = value;
+        value -= delayed;
+    }
+    cic->comb_index = index + 1 < delay ? index + 1 : 0;
+    return value;
+}
+
+/**
+ * @brief Runs the integrators for one value at the high rate and returns the output of the last integrator.
+ */
+static inline uint64_t dh_cic_run_integrators(uint64_t* integrators, size_t stages, uint64_t value)
+{
+    for (size_t k=0; k<stages; ++k) {
+        integrators[k] += value;
+        value = integrators[k];
+    }
+    return value;
+}
+
+DH_FILTER_RETURN_VALUE dh_cic_filter(dh_cic_data* cic, const int32_t* input, size_t input_count, int64_t* output, size_t* output_count)
+{
+    assert(cic != NULL);
+    if (cic == NULL || input == NULL || output == NULL) {
+        return DH_FILTER_NO_DATA_STRUCTURE;
+    }
+    if (cic->buffer == NULL || cic->stages == 0 || cic->rate == 0) {
+        return DH_FILTER_DATA_STRUCTURE_NOT_INITIALIZED;
+    }
+    uint64_t* integrators = cic->integrators;
+    const size_t stages = cic->stages;
+    const size_t rate = cic->rate;
+    size_t written = 0;
+
+    if (cic->interpolator) {
+        for (size_t i=0; i<input_count; ++i) {
+            const uint64_t value = dh_cic_run_combs(cic, (uint64_t)(int64_t)input[i]);
+            output[written++] = dh_cic_to_signed(dh_cic_run_integrators(integrators, stages, value));
+            for (size_t r=1; r<rate; ++r) {
+                output[written++] = dh_cic_to_signed(dh_cic_run_integrators(integrators, stages, 0));
+            }
+        }
+    } else {
+        size_t phase = cic->phase;
+        for (size_t i=0; i<input_count; ++i) {
+            const uint64_t value = dh_cic_run_integrators(integrators, stages, (uint64_t)(int64_t)input[i]);
+            if (++phase == rate) {
+                phase = 0;
+                output[written++] = dh_cic_to_signed(dh_cic_run_combs(cic, value));
+            }
+        }
+        cic->phase = phase;
+    }
+    if (output_count != NULL) {
+        *output_count = written;
+    }
+    return DH_FILTER_OK;
+}
+
+/**
+ * @brief Computes the magnitude of the normalized response of the CIC filter: |sin(pi*R*M*f) / (R*M*sin(pi*f))|^N.
+ */
+static double dh_cic_magnitude(const dh_cic_data* cic, double frequency)
+{
+    const double length = (double)(cic->rate * cic->differential_delay);
+    const double denominator = length * sin(M_PI * frequency);
+    const double ratio = denominator != 0.0 ? fabs(sin(M_PI * length * frequency) / denominator) : 1.0;
+    return pow(ratio, (double)cic->stages);
+}
+
+DH_FILTER_RETURN_VALUE dh_cic_get_gain_at(const dh_cic_data* cic, double frequency, dh_frequency_response_t* gain)
+{
+    if (cic == NULL || gain == NULL) {
+        return DH_FILTER_NO_DATA_STRUCTURE;
+    }
+    if (cic->stages == 0 || cic->rate == 0 || cic->differential_delay == 0) {
+        return DH_FILTER_DATA_STRUCTURE_NOT_INITIALIZED;
+    }
+    const double length = (double)(cic->rate * cic->differential_delay);
+    const double denominator = length * sin(M_PI * frequency);
+    const double ratio = denominator != 0.0 ? sin(M_PI * length * frequency) / denominator : 1.0;
+    // every moving sum delays the signal by (R*M-1)/2 values, a negative ratio adds half a turn
+    double phase = -M_PI * frequency * (length - 1.0) * (double)cic->stages;
+    if (ratio < 0.0 && cic->stages % 2 == 1) {
+        phase += M_PI;
+    }
+    gain->frequency = frequency;
+    gain->gain = dh_cic_magnitude(cic, frequency);
+    gain->phase_shift = atan2(sin(phase), cos(phase)) / M_PI * 180.0;
+    return DH_FILTER_OK;
+}
+
+DH_FILTER_RETURN_VALUE dh_cic_compensation_fir(const dh_cic_data* cic, double* coefficients, size_t count, double cutoff)
+{
+    if (cic == NULL || coefficients == NULL) {
+        return DH_FILTER_NO_DATA_STRUCTURE;
+    }
+    if (cic->stages == 0 || cic->rate == 0 || cic->differential_delay == 0) {
+        return DH_FILTER_DATA_STRUCTURE_NOT_INITIALIZED;
+    }
+    if (count == 0 || !(cutoff > 0.0 && cutoff <= 0.5)) {
+        return DH_FILTER_ERROR;
+    }
+    dh_fill_array_fir_sinc(coefficients, count, cutoff, false);
+    // adds 2 * integral over [0,cutoff] of (1/|H(f/R)| - 1) * cos(2*pi*f*(i-center)) with the simpson rule
+    const int center = (int)count / 2;
+    const size_t intervals = 2 * DH_CIC_COMPENSATION_INTERVALS * count;
+    const double step = cutoff / (double)intervals;
+    for (size_t s=0; s<=intervals; ++s) {
+        const double frequency = step * (double)s;
+        const double weight = s == 0 || s == intervals ? 1.0 : (s % 2 == 1 ? 4.0 : 2.0);
+        const double magnitude = dh_cic_magnitude(cic, frequency / (double)cic->rate);
+        const double difference = magnitude > 0.0 ? 1.0 / magnitude - 1.0 : 0.0;
+        const double scale = 2.0 * step / 3.0 * weight * difference;
+        for (size_t i=0; i<count; ++i) {
+            coefficients[i] += scale * cos(2.0 * M_PI * frequency * (double)((int)i - center));
+        }
+    }
+    // the hamming window reduces the ripple caused by the step of the desired response at the cutoff
+    for (size_t i=0; i<count && count > 1; ++i) {
+        coefficients[i] *= 0.54 - 0.46 * cos(2.0 * M_PI * (double)i / (double)(count - 1));
+    }
+    double gain[1] = {1.0};
+    dh_normalize_gain_at(coefficients, count, gain, 1, 0.0);
+    return DH_FILTER_OK;
+}
+
+DH_FILTER_RETURN_VALUE dh_reset_cic(dh_cic_data* cic)
+{
+    assert(cic != NULL);
+    if (cic == NULL) {
+        return DH_FILTER_NO_DATA_STRUCTURE;
+    }
+    if (cic->buffer != NULL) {
+        memset(cic->buffer, 0, cic->buffer_length);
+    }
+    cic->comb_index = 0;
+    cic->phase = 0;
+    return DH_FILTER_OK;
+}
+
+DH_FILTER_RETURN_VALUE dh_free_cic(dh_cic_data* cic)
+{
+    if (cic != NULL) {
+        free(cic->buffer);
+        cic->buffer = NULL;
+        cic->buffer_length = 0;
+        cic->integrators = NULL;
+        cic->combs = NULL;
+        cic->stages = 0;
+        cic->rate = 0;
+        cic->differential_delay = 0;
+        cic->comb_index = 0;
+        cic->phase = 0;
+        cic->bit_growth = 0;
+        cic->gain = 0.0;
+        cic->interpolator = false;
+    }
+    return DH_FILTER_OK;
+}
@@ -1,8 +1,12 @@
 #include "dh/filter.h"
 #include "dh/butterworth.h"
 #include "dh/chebyshev.h"
+#include "dh/dot_product.h"
+#include "dh/overlap_save.h"
 #include "dh/utility.h"
 #include <assert.h>
+#include <float.h>
+#include <stdint.h>
 #include <stdlib.h>
 #define _USE_MATH_DEFINES
 #include "math.h"
@@ -15,14 +19,41 @@
  * This source code is licensed under the MIT license. See file "LICENSE" at the root of the repository.
  */
 
-static DH_FILTER_RETURN_VALUE create_moving_average(dh_filter_data* filter, dh_filter_parameters* options);
-static DH_FILTER_RETURN_VALUE create_moving_average_highpass(dh_filter_data* filter, dh_filter_parameters* options);
+static DH_FILTER_RETURN_VALUE design_moving_average(dh_filter_data* filter);
+static DH_FILTER_RETURN_VALUE design_moving_average_highpass(dh_filter_data* filter);
 static DH_FILTER_RETURN_VALUE iir_exponential_lowpass(dh_filter_data* filter, dh_filter_parameters* options);
 static DH_FILTER_RETURN_VALUE fir_exponential_lowpass(dh_filter_data* filter, dh_filter_parameters* options);
-static DH_FILTER_RETURN_VALUE iir_butterworth(dh_filter_data* filter, dh_filter_parameters* options, DH_FILTER_CHARACTERISTIC type);
-static DH_FILTER_RETURN_VALUE iir_chebyshev(dh_filter_data* filter, dh_filter_parameters* options, DH_FILTER_CHARACTERISTIC type, bool isType2);
+static DH_FILTER_RETURN_VALUE iir_butterworth(dh_filter_data* filter, dh_filter_parameters* options, DH_FILTER_CHARACTERISTIC type, void* workspace);
+static DH_FILTER_RETURN_VALUE iir_chebyshev(dh_filter_data* filter, dh_filter_parameters* options, DH_FILTER_CHARACTERISTIC type, bool isType2, void* workspace);
 static DH_FILTER_RETURN_VALUE fir_create_sinc(dh_filter_data* filter, dh_filter_parameters* options);
-static DH_FILTER_RETURN_VALUE fir_create_sinc_bandfilter(dh_filter_data* filter, dh_filter_parameters* options, bool bandpass);
+static DH_FILTER_RETURN_VALUE fir_create_sinc_bandfilter(dh_filter_data* filter, dh_filter_parameters* options, bool bandpass, void* workspace);
+static DH_FILTER_REALIZATION select_realization(const dh_filter_parameters* options);
+static bool compute_number_coefficients(const dh_filter_parameters* options, size_t* num_inputs, size_t* num_outputs);
+static DH_FILTER_RETURN_VALUE dh_filter_allocate_buffers(dh_filter_data* filter, size_t num_inputs, size_t num_outputs, const dh_filter_parameters* options);
+static size_t dh_filter_align_length(size_t length);
+static size_t dh_filter_required_buffer_length(const dh_filter_parameters* options, size_t num_inputs, size_t num_outputs);
+static void dh_filter_assign_buffers_in(dh_filter_data* filter, char* buffer, size_t num_inputs, size_t num_outputs, const dh_filter_parameters* options);
+static DH_FILTER_RETURN_VALUE design_filter(dh_filter_data* filter, dh_filter_parameters* options, void* workspace);
+static void select_filter_functions(dh_filter_data* filter);
+static void restore_accumulators(dh_filter_data* filter);
+static size_t compute_denormal_check_interval(const dh_filter_data* filter);
+
+DH_FILTER_RETURN_VALUE dh_filter_parameters_init(dh_filter_parameters* options)
+{
+    assert(options != NULL);
+    if(options == NULL) {
+        return DH_FILTER_NO_DATA_STRUCTURE;
+    }
+    options->cutoff_frequency_low = 0.0;
+    options->cutoff_frequency_high = 0.0;
+    options->sampling_frequency = 0.0;
+    options->ripple = 0.0;
+    options->filter_order = 0;
+    options->filter_type = DH_NO_FILTER;
+    options->realization = DH_REALIZATION_DEFAULT;
+    options->flush_denormals = false;
+    return DH_FILTER_OK;
+}
 
 DH_FILTER_RETURN_VALUE dh_create_filter(dh_filter_data* filter, dh_filter_parameters* options)
 {
@@ -31,17 +62,251 @@ DH_FILTER_RETURN_VALUE dh_create_filter(dh_filter_data* filter, dh_filter_parame
     if(filter == NULL || options == NULL) {
         return DH_FILTER_NO_DATA_STRUCTURE;
     }
+    if(select_realization(options) == DH_REALIZATION_DEFAULT) {
+        return DH_FILTER_UNSUPPORTED_REALIZATION;
+    }
+    if(options->filter_type == DH_NO_FILTER) {
+        options->filter_order = 0;
+    }
+    size_t num_inputs = 0;
+    size_t num_outputs = 0;
+    if(!compute_number_coefficients(options, &num_inputs, &num_outputs)) {
+        return DH_FILTER_UNKNOWN_FILTER_TYPE;
+    }
+    if (dh_filter_allocate_buffers(filter, num_inputs, num_outputs, options) != DH_FILTER_OK) {
+        return DH_FILTER_ALLOCATION_FAILED;
+    }
+    DH_FILTER_RETURN_VALUE rv = design_filter(filter, options, NULL);
+    if (rv != DH_FILTER_OK) {
+        dh_free_filter(filter);
+        return rv;
+    }
+    filter->flush_denormals = options->flush_denormals;
+    select_filter_functions(filter);
+    return DH_FILTER_OK;
+}
+
+DH_FILTER_RETURN_VALUE dh_filter_required_size(const dh_filter_parameters* options, size_t* size, size_t* alignment)
+{
+    if(options == NULL || size == NULL) {
+        return DH_FILTER_NO_DATA_STRUCTURE;
+    }
+    if(select_realization(options) == DH_REALIZATION_DEFAULT) {
+        return DH_FILTER_UNSUPPORTED_REALIZATION;
+    }
+    dh_filter_parameters parameters = *options;
+    if(parameters.filter_type == DH_NO_FILTER) {
+        parameters.filter_order = 0;
+    }
+    size_t num_inputs = 0;
+    size_t num_outputs = 0;
+    if(!compute_number_coefficients(&parameters, &num_inputs, &num_outputs)) {
+        return DH_FILTER_UNKNOWN_FILTER_TYPE;
+    }
+    *size = dh_filter_required_buffer_length(&parameters, num_inputs, num_outputs);
+    if(alignment != NULL) {
+        *alignment = DH_FILTER_BUFFER_ALIGNMENT;
+    }
+    return DH_FILTER_OK;
+}
+
+DH_FILTER_RETURN_VALUE dh_create_filter_in_buffer(dh_filter_data* filter, dh_filter_parameters* options, void* buffer, size_t buffer_length)
+{
+    assert(filter != NULL);
+    assert(options != NULL);
+    if(filter == NULL || options == NULL || buffer == NULL) {
+        return DH_FILTER_NO_DATA_STRUCTURE;
+    }
+    if(select_realization(options) == DH_REALIZATION_DEFAULT) {
+        return DH_FILTER_UNSUPPORTED_REALIZATION;
+    }
+    if(options->filter_type == DH_NO_FILTER) {
+        options->filter_order = 0;
+    }
+    size_t num_inputs = 0;
+    size_t num_outputs = 0;
+    if(!compute_number_coefficients(options, &num_inputs, &num_outputs)) {
+        return DH_FILTER_UNKNOWN_FILTER_TYPE;
+    }
+    if(buffer_length < dh_filter_required_buffer_length(options, num_inputs, num_outputs) || (uintptr_t)buffer % DH_FILTER_BUFFER_ALIGNMENT != 0) {
+        return DH_FILTER_ALLOCATION_FAILED;
+    }
+    dh_filter_assign_buffers_in(filter, (char*)buffer, num_inputs, num_outputs, options);
+    // the design uses the memory behind the arrays of the filter as workspace
+    void* workspace = (char*)buffer + dh_filter_align_length(filter->buffer_length);
+    DH_FILTER_RETURN_VALUE rv = design_filter(filter, options, workspace);
+    if (rv != DH_FILTER_OK) {
+        dh_free_filter(filter);
+        return rv;
+    }
+    filter->flush_denormals = options->flush_denormals;
+    select_filter_functions(filter);
+    return DH_FILTER_OK;
+}
+
+size_t dh_filter_retune_workspace_size(const dh_filter_parameters* options)
+{
+    if (options == NULL) {
+        return 0;
+    }
+    switch(options->filter_type) {
+        case DH_FIR_BRICKWALL_BANDPASS: // falltrough
+        case DH_FIR_BRICKWALL_BANDSTOP:
+            return 2 * (options->filter_order + 1) * sizeof(double);
+        case DH_IIR_BUTTERWORTH_LOWPASS: // falltrough
+        case DH_IIR_BUTTERWORTH_HIGHPASS:
+        case DH_IIR_BUTTERWORTH_BANDPASS:
+        case DH_IIR_BUTTERWORTH_BANDSTOP:
+        case DH_IIR_CHEBYSHEV_LOWPASS:
+        case DH_IIR_CHEBYSHEV_HIGHPASS:
+        case DH_IIR_CHEBYSHEV_BANDPASS:
+        case DH_IIR_CHEBYSHEV_BANDSTOP:
+        case DH_IIR_CHEBYSHEV2_LOWPASS:
+        case DH_IIR_CHEBYSHEV2_HIGHPASS:
+        case DH_IIR_CHEBYSHEV2_BANDPASS:
+        case DH_IIR_CHEBYSHEV2_BANDSTOP:
+            return dh_transfer_function_workspace_size(options->filter_order);
+        default:
+            return 0;
+    }
+}
+
+DH_FILTER_RETURN_VALUE dh_filter_retune(dh_filter_data* filter, const dh_filter_parameters* options, void* workspace, size_t workspace_size)
+{
+    assert(filter != NULL);
+    assert(options != NULL);
+    if(filter == NULL || options == NULL) {
+        return DH_FILTER_NO_DATA_STRUCTURE;
+    }
+    if(filter->buffer == NULL) {
+        return DH_FILTER_DATA_STRUCTURE_NOT_INITIALIZED;
+    }
+    dh_filter_parameters parameters = *options;
+    if(parameters.filter_type == DH_NO_FILTER) {
+        parameters.filter_order = 0;
+    }
+    size_t num_inputs = 0;
+    size_t num_outputs = 0;
+    if(!compute_number_coefficients(&parameters, &num_inputs, &num_outputs)) {
+        return DH_FILTER_UNKNOWN_FILTER_TYPE;
+    }
+    if(select_realization(&parameters) != filter->realization) {
+        return DH_FILTER_UNSUPPORTED_REALIZATION;
+    }
+    if(num_inputs != filter->number_coefficients_in || num_outputs != filter->number_coefficients_out) {
+        return DH_FILTER_ERROR;
+    }
+    // the design must not fall back to temporary allocations
+    const size_t available = workspace != NULL ? workspace_size : 0;
+    if(available < dh_filter_retune_workspace_size(&parameters)) {
+        return DH_FILTER_ALLOCATION_FAILED;
+    }
+    // the past inputs and outputs are kept, so a filter that has seen values must not be set to the steady state again
+    const bool initialized = filter->initialized;
+    DH_FILTER_RETURN_VALUE rv = design_filter(filter, &parameters, workspace);
+    filter->initialized = initialized;
+    if (rv != DH_FILTER_OK) {
+        return rv;
+    }
+    filter->flush_denormals = parameters.flush_denormals;
+    restore_accumulators(filter);
+    select_filter_functions(filter);
+    return DH_FILTER_OK;
+}
+
+/**
+ * @brief Recomputes the sums of the running sum and the recursive exponential from the past inputs.
+ * 
+ * The sums of the recursive exponential are weighted with the coefficients, so they are stale after a new design.
+ * The inputs from the current index to the end of the buffer were written since the last wrap around and form the partial sum.
+ */
+static void restore_accumulators(dh_filter_data* filter)
+{
+    if (filter->realization != DH_REALIZATION_RUNNING_SUM && filter->realization != DH_REALIZATION_RECURSIVE_EXPONENTIAL) {
+        return;
+    }
+    const size_t number_coefficients_in = filter->number_coefficients_in;
+    const size_t written = filter->current_input_index > 0 ? number_coefficients_in - filter->current_input_index : 0;
+    double sum = 0.0;
+    double partial = 0.0;
+    for (size_t i=0; i<number_coefficients_in; ++i) {
+        // the newest input is at the current index, older inputs follow
+        const size_t index = filter->current_input_index + i < number_coefficients_in ? filter->current_input_index + i
+                                                                                      : filter->current_input_index + i - number_coefficients_in;
+        const double weight = filter->realization == DH_REALIZATION_RECURSIVE_EXPONENTIAL ? filter->coefficients_in[i] : 1.0;
+        sum += weight * filter->inputs[index];
+        if (i + 1 == written) {
+            partial = sum;
+        }
+    }
+    filter->accumulator = sum;
+    filter->accumulator_partial = partial;
+}
+
+/**
+ * @brief Computes the number of feedforward and feedback coefficients of a filter with the given options.
+ * 
+ * @return false if the filter type is unknown.
+ */
+static bool compute_number_coefficients(const dh_filter_parameters* options, size_t* num_inputs, size_t* num_outputs)
+{
+    const size_t order = options->filter_order;
+    switch(options->filter_type){
+        case DH_NO_FILTER: // falltrough
+        case DH_FIR_MOVING_AVERAGE_LOWPASS:
+        case DH_FIR_MOVING_AVERAGE_HIGHPASS:
+        case DH_FIR_EXPONENTIAL_MOVING_AVERAGE_LOWPASS:
+        case DH_FIR_BRICKWALL_LOWPASS:
+        case DH_FIR_BRICKWALL_HIGHPASS:
+        case DH_FIR_BRICKWALL_BANDSTOP:
+            *num_inputs = order + 1;
+            *num_outputs = 1;
+            return true;
+        case DH_FIR_BRICKWALL_BANDPASS:
+            *num_inputs = 2 * order + 1;
+            *num_outputs = 1;
+            return true;
+        case DH_IIR_EXPONENTIAL_LOWPASS:
+            *num_inputs = 1;
+            *num_outputs = 2;
+            return true;
+        case DH_IIR_BUTTERWORTH_LOWPASS: // falltrough
+        case DH_IIR_BUTTERWORTH_HIGHPASS:
+        case DH_IIR_CHEBYSHEV_LOWPASS:
+        case DH_IIR_CHEBYSHEV_HIGHPASS:
+        case DH_IIR_CHEBYSHEV2_LOWPASS:
+        case DH_IIR_CHEBYSHEV2_HIGHPASS:
+            *num_inputs = order + 1;
+            *num_outputs = order + 1;
+            return true;
+        case DH_IIR_BUTTERWORTH_BANDPASS: // falltrough
+        case DH_IIR_BUTTERWORTH_BANDSTOP:
+        case DH_IIR_CHEBYSHEV_BANDPASS:
+        case DH_IIR_CHEBYSHEV_BANDSTOP:
+        case DH_IIR_CHEBYSHEV2_BANDPASS:
+        case DH_IIR_CHEBYSHEV2_BANDSTOP:
+            *num_inputs = 2 * order + 1;
+            *num_outputs = 2 * order + 1;
+            return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Computes the coefficients of a filter whose buffers were allocated for the given options.
+ * 
+ * @param workspace Optional scratch memory with dh_filter_retune_workspace_size() bytes. If NULL, temporary buffers are allocated.
+ */
+static DH_FILTER_RETURN_VALUE design_filter(dh_filter_data* filter, dh_filter_parameters* options, void* workspace)
+{
     DH_FILTER_RETURN_VALUE rv = DH_FILTER_UNKNOWN_FILTER_TYPE;
     switch(options->filter_type){
-        case DH_NO_FILTER:
-            options->filter_order = 0;
-            rv = create_moving_average(filter, options);
-            break;
+        case DH_NO_FILTER: // falltrough
         case DH_FIR_MOVING_AVERAGE_LOWPASS:
-            rv = create_moving_average(filter, options);
+            rv = design_moving_average(filter);
             break;
         case DH_FIR_MOVING_AVERAGE_HIGHPASS:
-            rv = create_moving_average_highpass(filter, options);
+            rv = design_moving_average_highpass(filter);
             break;
         case DH_FIR_EXPONENTIAL_MOVING_AVERAGE_LOWPASS:
             rv = fir_exponential_lowpass(filter, options);
@@ -52,53 +317,309 @@ DH_FILTER_RETURN_VALUE dh_create_filter(dh_filter_data* filter, dh_filter_parame
             break;
         case DH_FIR_BRICKWALL_BANDPASS: // falltrough
         case DH_FIR_BRICKWALL_BANDSTOP:
-            rv = fir_create_sinc_bandfilter(filter, options, options->filter_type == DH_FIR_BRICKWALL_BANDPASS);
+            rv = fir_create_sinc_bandfilter(filter, options, options->filter_type == DH_FIR_BRICKWALL_BANDPASS, workspace);
             break;
         case DH_IIR_EXPONENTIAL_LOWPASS:
             rv = iir_exponential_lowpass(filter, options);
             break;
-        case DH_IIR_BUTTERWORTH_LOWPASS : return iir_butterworth(filter, options, DH_LOWPASS);
-        case DH_IIR_BUTTERWORTH_HIGHPASS: return iir_butterworth(filter, options, DH_HIGHPASS);
-        case DH_IIR_BUTTERWORTH_BANDPASS: return iir_butterworth(filter, options, DH_BANDPASS);
-        case DH_IIR_BUTTERWORTH_BANDSTOP: return iir_butterworth(filter, options, DH_BANDSTOP);
-        case DH_IIR_CHEBYSHEV_LOWPASS   : return iir_chebyshev(filter, options, DH_LOWPASS,false);
-        case DH_IIR_CHEBYSHEV_HIGHPASS  : return iir_chebyshev(filter, options, DH_HIGHPASS,false);
-        case DH_IIR_CHEBYSHEV_BANDPASS  : return iir_chebyshev(filter, options, DH_BANDPASS,false);
-        case DH_IIR_CHEBYSHEV_BANDSTOP  : return iir_chebyshev(filter, options, DH_BANDSTOP,false);
-        case DH_IIR_CHEBYSHEV2_LOWPASS  : return iir_chebyshev(filter, options, DH_LOWPASS,true);
-        case DH_IIR_CHEBYSHEV2_HIGHPASS : return iir_chebyshev(filter, options, DH_HIGHPASS,true);
-        case DH_IIR_CHEBYSHEV2_BANDPASS : return iir_chebyshev(filter, options, DH_BANDPASS,true);
-        case DH_IIR_CHEBYSHEV2_BANDSTOP : return iir_chebyshev(filter, options, DH_BANDSTOP,true);
+        case DH_IIR_BUTTERWORTH_LOWPASS:
+            rv = iir_butterworth(filter, options, DH_LOWPASS, workspace);
+            break;
+        case DH_IIR_BUTTERWORTH_HIGHPASS:
+            rv = iir_butterworth(filter, options, DH_HIGHPASS, workspace);
+            break;
+        case DH_IIR_BUTTERWORTH_BANDPASS:
+            rv = iir_butterworth(filter, options, DH_BANDPASS, workspace);
+            break;
+        case DH_IIR_BUTTERWORTH_BANDSTOP:
+            rv = iir_butterworth(filter, options, DH_BANDSTOP, workspace);
+            break;
+        case DH_IIR_CHEBYSHEV_LOWPASS:
+            rv = iir_chebyshev(filter, options, DH_LOWPASS, false, workspace);
+            break;
+        case DH_IIR_CHEBYSHEV_HIGHPASS:
+            rv = iir_chebyshev(filter, options, DH_HIGHPASS, false, workspace);
+            break;
+        case DH_IIR_CHEBYSHEV_BANDPASS:
+            rv = iir_chebyshev(filter, options, DH_BANDPASS, false, workspace);
+            break;
+        case DH_IIR_CHEBYSHEV_BANDSTOP:
+            rv = iir_chebyshev(filter, options, DH_BANDSTOP, false, workspace);
+            break;
+        case DH_IIR_CHEBYSHEV2_LOWPASS:
+            rv = iir_chebyshev(filter, options, DH_LOWPASS, true, workspace);
+            break;
+        case DH_IIR_CHEBYSHEV2_HIGHPASS:
+            rv = iir_chebyshev(filter, options, DH_HIGHPASS, true, workspace);
+            break;
+        case DH_IIR_CHEBYSHEV2_BANDPASS:
+            rv = iir_chebyshev(filter, options, DH_BANDPASS, true, workspace);
+            break;
+        case DH_IIR_CHEBYSHEV2_BANDSTOP:
+            rv = iir_chebyshev(filter, options, DH_BANDSTOP, true, workspace);
+            break;
     }
     return rv;
 }
 
+/**
+ * @brief Selects the dot product and the kernel for the coefficients of the filter and prepares the overlap-save convolution.
+ */
+static void select_filter_functions(dh_filter_data* filter)
+{
+    filter->dot_product = NULL;
+    filter->symmetry = DH_FIR_NOT_SYMMETRIC;
+    if (filter->number_coefficients_out <= 1 &&
+        (filter->realization == DH_REALIZATION_DIRECT_FORM_1 || filter->realization == DH_REALIZATION_DIRECT_FORM_1_MIRRORED)) {
+        filter->dot_product = dh_select_dot_product_function(filter->number_coefficients_in);
+        if (filter->realization == DH_REALIZATION_DIRECT_FORM_1_MIRRORED) {
+            // the folded products pair the newest with the oldest input, which are only adjacent in memory in the mirrored buffer
+            filter->symmetry = dh_detect_fir_symmetry(filter->coefficients_in, filter->number_coefficients_in);
+            if (filter->symmetry != DH_FIR_NOT_SYMMETRIC) {
+                filter->dot_product = dh_select_folded_dot_product_function(filter->number_coefficients_in, filter->symmetry);
+            }
+        }
+        dh_overlap_save_prepare(filter);
+    }
+    filter->kernel = dh_select_filter_kernel(filter);
+    filter->denormal_check_interval = compute_denormal_check_interval(filter);
+}
+
+/**
+ * @brief Computes the number of values after which a state above DH_FILTER_DENORMAL_THRESHOLD may become subnormal.
+ * 
+ * The product of the magnitudes of all poles is the magnitude of the last feedback coefficient. The poles of a stable filter
+ * lie inside the unit circle, so no pole is smaller than this coefficient and the state decays at most by this factor per value.
+ * Poles at zero only delay the values and are skipped with the trailing zero coefficients.
+ */
+static size_t compute_denormal_check_interval(const dh_filter_data* filter)
+{
+    double radius = 1.0;
+    if (filter->realization == DH_REALIZATION_SECOND_ORDER_SECTIONS) {
+        for (size_t k=0; k<filter->number_sections; ++k) {
+            const double* c = filter->sections + 5*k;
+            const double section_radius = c[4] != 0.0 ? fabs(c[4]) : fabs(c[3]);
+            if (section_radius > 0.0 && section_radius < radius) {
+                radius = section_radius;
+            }
+        }
+    } else if (filter->realization != DH_REALIZATION_RUNNING_SUM && filter->realization != DH_REALIZATION_RECURSIVE_EXPONENTIAL) {
+        for (size_t k=filter->number_coefficients_out; k>1; --k) {
+            if (filter->coefficients_out[k-1] != 0.0) {
+                radius = fabs(filter->coefficients_out[k-1]);
+                break;
+            }
+        }
+    }
+    if (radius >= 1.0) {
+        return DH_FILTER_DENORMAL_CHECK_INTERVAL;
+    }
+    // the state decays from the threshold to the smallest normal number in the returned number of values at the earliest
+    const double values = log(DBL_MIN / DH_FILTER_DENORMAL_THRESHOLD) / log(radius);
+    if (values < 1.0) {
+        return 1;
+    }
+    return values < (double)DH_FILTER_DENORMAL_CHECK_INTERVAL ? (size_t)values : DH_FILTER_DENORMAL_CHECK_INTERVAL;
+}
+
+/**
+ * @brief Checks if the filter type is designed from poles and zeros, so that it can be realized with second order sections.
+ */
+static bool is_designed_from_roots(DH_FILTER_TYPE type)
+{
+    switch(type) {
+        case DH_IIR_BUTTERWORTH_LOWPASS: // falltrough
+        case DH_IIR_BUTTERWORTH_HIGHPASS:
+        case DH_IIR_BUTTERWORTH_BANDPASS:
+        case DH_IIR_BUTTERWORTH_BANDSTOP:
+        case DH_IIR_CHEBYSHEV_LOWPASS:
+        case DH_IIR_CHEBYSHEV_HIGHPASS:
+        case DH_IIR_CHEBYSHEV_BANDPASS:
+        case DH_IIR_CHEBYSHEV_BANDSTOP:
+        case DH_IIR_CHEBYSHEV2_LOWPASS:
+        case DH_IIR_CHEBYSHEV2_HIGHPASS:
+        case DH_IIR_CHEBYSHEV2_BANDPASS:
+        case DH_IIR_CHEBYSHEV2_BANDSTOP:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief Checks if the filter type is a moving average, so that it can be realized with a running sum.
+ */
+static bool is_moving_average(DH_FILTER_TYPE type)
+{
+    return type == DH_FIR_MOVING_AVERAGE_LOWPASS || type == DH_FIR_MOVING_AVERAGE_HIGHPASS;
+}
+
+/**
+ * @brief Checks if the filter type is designed with symmetric coefficients, so that it can use the folded dot products.
+ */
+static bool is_linear_phase_fir(DH_FILTER_TYPE type)
+{
+    return type == DH_FIR_BRICKWALL_LOWPASS || type == DH_FIR_BRICKWALL_HIGHPASS || type == DH_FIR_BRICKWALL_BANDPASS || type == DH_FIR_BRICKWALL_BANDSTOP;
+}
+
+/**
+ * @brief Checks if the filter type has no feedback coefficients.
+ */
+static bool is_fir(DH_FILTER_TYPE type)
+{
+    switch(type) {
+        case DH_NO_FILTER: // falltrough
+        case DH_FIR_MOVING_AVERAGE_LOWPASS:
+        case DH_FIR_MOVING_AVERAGE_HIGHPASS:
+        case DH_FIR_EXPONENTIAL_MOVING_AVERAGE_LOWPASS:
+        case DH_FIR_BRICKWALL_LOWPASS:
+        case DH_FIR_BRICKWALL_HIGHPASS:
+        case DH_FIR_BRICKWALL_BANDPASS:
+        case DH_FIR_BRICKWALL_BANDSTOP:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief Selects the realization that is used for a filter with the given options.
+ * 
+ * @return The realization or DH_REALIZATION_DEFAULT if the requested realization is not supported.
+ */
+static DH_FILTER_REALIZATION select_realization(const dh_filter_parameters* options)
+{
+    switch(options->realization) {
+        case DH_REALIZATION_DEFAULT:
+            if (options->filter_type == DH_FIR_EXPONENTIAL_MOVING_AVERAGE_LOWPASS) {
+                return DH_REALIZATION_RECURSIVE_EXPONENTIAL;
+            }
+            if (is_linear_phase_fir(options->filter_type)) {
+                return DH_REALIZATION_DIRECT_FORM_1_MIRRORED;
+            }
+            return is_moving_average(options->filter_type) ? DH_REALIZATION_RUNNING_SUM : DH_REALIZATION_DIRECT_FORM_1;
+        case DH_REALIZATION_DIRECT_FORM_1:
+            return DH_REALIZATION_DIRECT_FORM_1;
+        case DH_REALIZATION_DIRECT_FORM_1_MIRRORED:
+            return DH_REALIZATION_DIRECT_FORM_1_MIRRORED;
+        case DH_REALIZATION_SECOND_ORDER_SECTIONS:
+            return is_designed_from_roots(options->filter_type) ? DH_REALIZATION_SECOND_ORDER_SECTIONS : DH_REALIZATION_DEFAULT;
+        case DH_REALIZATION_TRANSPOSED_DIRECT_FORM_2:
+            return DH_REALIZATION_TRANSPOSED_DIRECT_FORM_2;
+        case DH_REALIZATION_RUNNING_SUM:
+            return is_moving_average(options->filter_type) ? DH_REALIZATION_RUNNING_SUM : DH_REALIZATION_DEFAULT;
+        case DH_REALIZATION_RECURSIVE_EXPONENTIAL:
+            return options->filter_type == DH_FIR_EXPONENTIAL_MOVING_AVERAGE_LOWPASS ? DH_REALIZATION_RECURSIVE_EXPONENTIAL : DH_REALIZATION_DEFAULT;
+        case DH_REALIZATION_OVERLAP_SAVE:
+            // single values are computed in direct form 1, only the blocks use the fast convolution
+            return is_fir(options->filter_type) ? DH_REALIZATION_DIRECT_FORM_1 : DH_REALIZATION_DEFAULT;
+    }
+    return DH_REALIZATION_DEFAULT;
+}
+
 static void zero_inout_buffers(dh_filter_data* filter) {
-    for(size_t i=0; i<filter->number_coefficients_in; ++i) {
-        filter->inputs[i] = 0.0;
+    size_t history_factor = filter->realization == DH_REALIZATION_DIRECT_FORM_1_MIRRORED ? 2 : 1;
+    if (filter->inputs != NULL) {
+        for(size_t i=0; i<history_factor*filter->number_coefficients_in; ++i) {
+            filter->inputs[i] = 0.0;
+        }
+    }
+    if (filter->outputs != NULL) {
+        for(size_t i=0; i<history_factor*filter->number_coefficients_out; ++i) {
+            filter->outputs[i] = 0.0;
+        }
     }
-    for(size_t i=0; i<filter->number_coefficients_out; ++i) {
-        filter->outputs[i] = 0.0;
+    for(size_t i=0; i<filter->state_length; ++i) {
+        filter->state[i] = 0.0;
     }
+    filter->accumulator = 0.0;
+    filter->accumulator_partial = 0.0;
 }
 
-static DH_FILTER_RETURN_VALUE dh_filter_allocate_buffers(dh_filter_data* filter, size_t num_inputs, size_t num_outputs)
+/** The sizes of the arrays in the buffer of a filter. */
+typedef struct {
+    /** Number of feedforward coefficients. */
+    size_t num_inputs;
+    /** Number of feedback coefficients. */
+    size_t num_outputs;
+    /** Length of the arrays for the past values relative to the number of coefficients: 0, 1 or 2. */
+    size_t history_factor;
+    /** Number of second order sections. */
+    size_t num_sections;
+    /** Number of state variables. */
+    size_t state_length;
+    /** Length of the FFT of the overlap-save convolution or 0. */
+    size_t fft_length;
+    /** Total size of the buffer in bytes. */
+    size_t buffer_length;
+} dh_filter_buffer_layout;
+
+/**
+ * @brief Computes the arrays in the buffer for the coefficients and the past inputs and outputs.
+ * 
+ * The buffer is split into the arrays coefficients_in, inputs, coefficients_out and outputs (in this order).
+ * If the realization is DH_REALIZATION_DIRECT_FORM_1_MIRRORED, then the arrays for the past inputs
+ * and outputs have twice the length of the coefficient arrays.
+ * If the realization is DH_REALIZATION_SECOND_ORDER_SECTIONS, there are no arrays for the past inputs and
+ * outputs. Instead, the arrays for the sections (5 values per section) and their state (2 values per section)
+ * follow the coefficient arrays.
+ * If the realization is DH_REALIZATION_TRANSPOSED_DIRECT_FORM_2, there are no arrays for the past inputs and
+ * outputs. Instead, the state array with max(num_inputs,num_outputs)-1 values follows the coefficient arrays.
+ * If the realization DH_REALIZATION_OVERLAP_SAVE was requested for a FIR filter with many coefficients, the buffer for the
+ * overlap-save convolution follows at the end.
+ */
+static dh_filter_buffer_layout dh_filter_compute_layout(size_t num_inputs, size_t num_outputs, const dh_filter_parameters* options)
 {
-    size_t total_num = 2 * (num_inputs + num_outputs);
-    filter->buffer_length = total_num * sizeof(double);
-    filter->buffer = malloc(filter->buffer_length);
-    if(filter->buffer == NULL) {
-        return DH_FILTER_ALLOCATION_FAILED;
+    const DH_FILTER_REALIZATION realization = select_realization(options);
+    dh_filter_buffer_layout layout;
+    const size_t filter_order = num_inputs > num_outputs ? num_inputs - 1 : num_outputs - 1;
+    layout.num_inputs = num_inputs;
+    layout.num_outputs = num_outputs;
+    layout.history_factor = 1;
+    layout.num_sections = 0;
+    layout.state_length = 0;
+    switch(realization) {
+        case DH_REALIZATION_DIRECT_FORM_1_MIRRORED:
+            layout.history_factor = 2;
+            break;
+        case DH_REALIZATION_SECOND_ORDER_SECTIONS:
+            layout.history_factor = 0;
+            layout.num_sections = (filter_order + 1) / 2;
+            layout.state_length = 2 * layout.num_sections;
+            break;
+        case DH_REALIZATION_TRANSPOSED_DIRECT_FORM_2:
+            layout.history_factor = 0;
+            layout.state_length = filter_order;
+            break;
+        default:
+            break;
     }
-    filter->buffer_needs_cleanup = true;
+    // the buffer for the fast convolution is only reserved if it was requested
+    layout.fft_length = options->realization == DH_REALIZATION_OVERLAP_SAVE ? dh_overlap_save_fft_length(num_inputs) : 0;
+    size_t total_num = (1 + layout.history_factor) * (num_inputs + num_outputs) + 5 * layout.num_sections + layout.state_length
+                       + dh_overlap_save_buffer_length(layout.fft_length);
+    layout.buffer_length = total_num * sizeof(double);
+    return layout;
+}
+
+/**
+ * @brief Sets the pointers of the filter to the arrays in [buffer] and resets all values.
+ */
+static void dh_filter_assign_buffers(dh_filter_data* filter, char* buffer, const dh_filter_buffer_layout* layout, DH_FILTER_REALIZATION realization)
+{
+    const size_t num_inputs = layout->num_inputs;
+    const size_t num_outputs = layout->num_outputs;
+    const size_t history_factor = layout->history_factor;
+    filter->buffer = buffer;
+    filter->buffer_length = layout->buffer_length;
 
     size_t offset = 0;
     double* ptr = (double*)filter->buffer;
     if (num_inputs>0) {
         filter->coefficients_in = ptr;
         offset += num_inputs;
-        filter->inputs = ptr + offset;
-        offset += num_inputs;
+        filter->inputs = history_factor > 0 ? ptr + offset : NULL;
+        offset += history_factor * num_inputs;
     }
     else {
         filter->coefficients_in = NULL;
@@ -108,29 +629,85 @@ static DH_FILTER_RETURN_VALUE dh_filter_allocate_buffers(dh_filter_data* filter,
     if (num_outputs>0) {
         filter->coefficients_out = ptr + offset;
         offset += num_outputs;
-        filter->outputs = ptr + offset;
-        offset += num_outputs;
+        filter->outputs = history_factor > 0 ? ptr + offset : NULL;
+        offset += history_factor * num_outputs;
     }
     else {
         filter->coefficients_out = NULL;
         filter->outputs = NULL;
     }
 
+    filter->sections = layout->num_sections > 0 ? ptr + offset : NULL;
+    offset += 5 * layout->num_sections;
+    filter->state = layout->state_length > 0 ? ptr + offset : NULL;
+    offset += layout->state_length;
+    dh_overlap_save_assign_buffer(&filter->overlap_save, ptr + offset, layout->fft_length);
+
     filter->current_input_index = 0;
     filter->current_output_index = 0;
+    filter->decimation_phase = 0;
     filter->number_coefficients_in = num_inputs;
     filter->number_coefficients_out = num_outputs;
+    filter->number_sections = layout->num_sections;
+    filter->state_length = layout->state_length;
     filter->initialized = false;
+    filter->realization = realization;
+    filter->dot_product = NULL;
+    filter->symmetry = DH_FIR_NOT_SYMMETRIC;
+    filter->kernel = NULL;
+    filter->flush_denormals = false;
+    filter->denormal_check_interval = 0;
     
     zero_inout_buffers(filter);
-    return DH_FILTER_OK;
 }
 
-static DH_FILTER_RETURN_VALUE create_moving_average(dh_filter_data* filter, dh_filter_parameters* options)
+/**
+ * @brief Rounds [length] up to a multiple of DH_FILTER_BUFFER_ALIGNMENT.
+ */
+static size_t dh_filter_align_length(size_t length)
 {
-    if (dh_filter_allocate_buffers(filter, options->filter_order+1, 1) != DH_FILTER_OK) {
+    return (length + DH_FILTER_BUFFER_ALIGNMENT - 1) / DH_FILTER_BUFFER_ALIGNMENT * DH_FILTER_BUFFER_ALIGNMENT;
+}
+
+/**
+ * @brief Computes the number of bytes that dh_create_filter_in_buffer() needs: the arrays of the filter followed by the workspace for the design.
+ */
+static size_t dh_filter_required_buffer_length(const dh_filter_parameters* options, size_t num_inputs, size_t num_outputs)
+{
+    const dh_filter_buffer_layout layout = dh_filter_compute_layout(num_inputs, num_outputs, options);
+    return dh_filter_align_length(layout.buffer_length) + dh_filter_retune_workspace_size(options);
+}
+
+/**
+ * @brief Places the arrays of the filter at the start of a buffer that is owned by the caller.
+ */
+static void dh_filter_assign_buffers_in(dh_filter_data* filter, char* buffer, size_t num_inputs, size_t num_outputs, const dh_filter_parameters* options)
+{
+    const DH_FILTER_REALIZATION realization = select_realization(options);
+    const dh_filter_buffer_layout layout = dh_filter_compute_layout(num_inputs, num_outputs, options);
+    dh_filter_assign_buffers(filter, buffer, &layout, realization);
+    filter->buffer_needs_cleanup = false;
+}
+
+/**
+ * @brief Allocates the buffer for the coefficients and the past inputs and outputs. See dh_filter_compute_layout() for the arrays in the buffer.
+ */
+static DH_FILTER_RETURN_VALUE dh_filter_allocate_buffers(dh_filter_data* filter, size_t num_inputs, size_t num_outputs, const dh_filter_parameters* options)
+{
+    const DH_FILTER_REALIZATION realization = select_realization(options);
+    const dh_filter_buffer_layout layout = dh_filter_compute_layout(num_inputs, num_outputs, options);
+    char* buffer = (char*)malloc(layout.buffer_length);
+    if(buffer == NULL) {
+        filter->buffer = NULL;
         return DH_FILTER_ALLOCATION_FAILED;
     }
+    dh_filter_assign_buffers(filter, buffer, &layout, realization);
+    filter->buffer_needs_cleanup = true;
+    return DH_FILTER_OK;
+}
+
+static DH_FILTER_RETURN_VALUE design_moving_average(dh_filter_data* filter)
+{
     double val = 1.0/(double)filter->number_coefficients_in;
     for (size_t i=0; i<filter->number_coefficients_in; ++i) {
         filter->coefficients_in[i] = val;
@@ -139,80 +716,54 @@ static DH_FILTER_RETURN_VALUE create_moving_average(dh_filter_data* filter, dh_f
     return DH_FILTER_OK;
 }
 
-static void fill_array_fir_sinc(double* data, size_t count,double cutoff, bool highpass) {
-    assert(data != NULL);
-    int xshift = (int)count/2;
-    for (size_t i=0; i<count; ++i) {
-        int idx = (int)i;
-        double x = 2*M_PI*cutoff*(idx-xshift);
-        data[i] = x!=0.0 ? sin(x)/x : 1.0;
-    }
-    double gain[1] = {1.0};
-    
-    dh_normalize_gain_at(data,count,gain,1,0.0);
-
-    if (highpass) {
-        for (size_t i=0; i<count; ++i) {
-            if(i!=(size_t)xshift) {
-                data[i] = -data[i];
-            } else {
-                data[i] = 1.0 - data[i];
-            }
-        }
-    }
-}
-
 static DH_FILTER_RETURN_VALUE fir_create_sinc(dh_filter_data* filter, dh_filter_parameters* options)
 {
-    if (dh_filter_allocate_buffers(filter, options->filter_order+1, 1) != DH_FILTER_OK) {
-        return DH_FILTER_ALLOCATION_FAILED;
-    }
     double cutoff = options->cutoff_frequency_low/options->sampling_frequency;
     bool is_highpass = options->filter_type == DH_FIR_BRICKWALL_HIGHPASS;
-    fill_array_fir_sinc(filter->coefficients_in,filter->number_coefficients_in,cutoff , is_highpass);
+    dh_fill_array_fir_sinc(filter->coefficients_in,filter->number_coefficients_in,cutoff , is_highpass);
     filter->coefficients_out[0] = 1.0;
     filter->initialized = options->filter_type != DH_FIR_BRICKWALL_LOWPASS;
     return DH_FILTER_OK;
 }
 
 
-static DH_FILTER_RETURN_VALUE fir_create_sinc_bandfilter(dh_filter_data* filter, dh_filter_parameters* options, bool bandpass)
+static DH_FILTER_RETURN_VALUE fir_create_sinc_bandfilter(dh_filter_data* filter, dh_filter_parameters* options, bool bandpass, void* workspace)
 {
     size_t count_single_filter = options->filter_order+1;
-    if (dh_filter_allocate_buffers(filter, 2*count_single_filter-1, 1) != DH_FILTER_OK) {
-        return DH_FILTER_ALLOCATION_FAILED;
-    }
     double cutoff_low = options->cutoff_frequency_low/options->sampling_frequency;
     double cutoff_high = options->cutoff_frequency_high/options->sampling_frequency;
-    // in order to save allocations, we will use the input and output buffers for the temporary values
-    // inputs has size 2*count_single_filter-1 followed by 2 doubles
-    // we need 2*count_single_filter -> ok, there are 8 bytes of buffer left
-    double* coeff_in_temp_low = filter->inputs;
-    double* coeff_in_temp_high = filter->inputs + count_single_filter;
-    assert(8 == (char*)(filter->buffer+ filter->buffer_length)-(char*)(coeff_in_temp_high + count_single_filter));
-
-    fill_array_fir_sinc(coeff_in_temp_low,count_single_filter,cutoff_low, bandpass);
-    fill_array_fir_sinc(coeff_in_temp_high,count_single_filter,cutoff_high, !bandpass);
+    // the two single filters are computed in the workspace or in a temporary allocation
+    double* temporary = (double*)workspace;
+    if (temporary == NULL) {
+        temporary = (double*)malloc(2 * count_single_filter * sizeof(double));
+        if (temporary == NULL) {
+            return DH_FILTER_ALLOCATION_FAILED;
+        }
+    }
+    double* coeff_in_temp_low = temporary;
+    double* coeff_in_temp_high = temporary + count_single_filter;
+
+    dh_fill_array_fir_sinc(coeff_in_temp_low,count_single_filter,cutoff_low, bandpass);
+    dh_fill_array_fir_sinc(coeff_in_temp_high,count_single_filter,cutoff_high, !bandpass);
     if(bandpass) {
         dh_convolve_parameters(coeff_in_temp_low,coeff_in_temp_high,count_single_filter,filter->coefficients_in);
     } else {
         for(size_t i=0; i<count_single_filter;++i) {
             filter->coefficients_in[i]= coeff_in_temp_low[i] + coeff_in_temp_high[i];
         }
-        filter->number_coefficients_in = count_single_filter;
+    }
+    if (temporary != workspace) {
+        free(temporary);
     }
     filter->coefficients_out[0] = 1.0;
     filter->initialized = true;
-    zero_inout_buffers(filter);
     return DH_FILTER_OK;
 }
 
 
-static DH_FILTER_RETURN_VALUE create_moving_average_highpass(dh_filter_data* filter, dh_filter_parameters* options)
+static DH_FILTER_RETURN_VALUE design_moving_average_highpass(dh_filter_data* filter)
 {
-    if (create_moving_average(filter, options) != DH_FILTER_OK) {
-        return DH_FILTER_ALLOCATION_FAILED;
-    }
+    design_moving_average(filter);
     filter->coefficients_in[0] = 1.0 - filter->coefficients_in[0];
     for (size_t i=1; i<filter->number_coefficients_in; ++i) {
         filter->coefficients_in[i] = -filter->coefficients_in[i];
@@ -224,9 +775,6 @@ static DH_FILTER_RETURN_VALUE create_moving_average_highpass(dh_filter_data* fil
 
 static DH_FILTER_RETURN_VALUE iir_exponential_lowpass(dh_filter_data* filter, dh_filter_parameters* options)
 {
-    if (dh_filter_allocate_buffers(filter, 1, 2) != DH_FILTER_OK) {
-        return DH_FILTER_ALLOCATION_FAILED;
-    }
     double val = options->cutoff_frequency_low/options->sampling_frequency;
     filter->coefficients_in[0] = val;
     filter->coefficients_out[0] = 1.0;
@@ -236,9 +784,6 @@ static DH_FILTER_RETURN_VALUE iir_exponential_lowpass(dh_filter_data* filter, dh
 
 static DH_FILTER_RETURN_VALUE fir_exponential_lowpass(dh_filter_data* filter, dh_filter_parameters* options)
 {
-    if (dh_filter_allocate_buffers(filter, options->filter_order+1, 1) != DH_FILTER_OK) {
-        return DH_FILTER_ALLOCATION_FAILED;
-    }
     double val = 1.0-(options->cutoff_frequency_low/options->sampling_frequency);
     double current = val;
     double integrated = 0.0;
@@ -254,23 +799,14 @@ static DH_FILTER_RETURN_VALUE fir_exponential_lowpass(dh_filter_data* filter, dh
     return DH_FILTER_OK;
 }
 
-static DH_FILTER_RETURN_VALUE iir_butterworth(dh_filter_data* filter, dh_filter_parameters* options, DH_FILTER_CHARACTERISTIC type)
+static DH_FILTER_RETURN_VALUE iir_butterworth(dh_filter_data* filter, dh_filter_parameters* options, DH_FILTER_CHARACTERISTIC type, void* workspace)
 {
-    size_t coefficients = type==DH_LOWPASS || type==DH_HIGHPASS ? options->filter_order + 1 : 2*options->filter_order + 1;
-    if (dh_filter_allocate_buffers(filter, coefficients, coefficients) != DH_FILTER_OK) {
-        return DH_FILTER_ALLOCATION_FAILED;
-    }
     filter->initialized = type!=DH_LOWPASS;
-    return dh_compute_butterworth_filter_coefficients(filter,options,type);
+    return dh_compute_butterworth_filter_coefficients(filter,options,type,workspace);
 }
 
-static DH_FILTER_RETURN_VALUE iir_chebyshev(dh_filter_data* filter, dh_filter_parameters* options, DH_FILTER_CHARACTERISTIC type, bool isType2)
+static DH_FILTER_RETURN_VALUE iir_chebyshev(dh_filter_data* filter, dh_filter_parameters* options, DH_FILTER_CHARACTERISTIC type, bool isType2, void* workspace)
 {
-    size_t coefficients = type==DH_LOWPASS || type==DH_HIGHPASS ? options->filter_order + 1 : 2*options->filter_order + 1;
-    if (dh_filter_allocate_buffers(filter, coefficients, coefficients) != DH_FILTER_OK) {
-        return DH_FILTER_ALLOCATION_FAILED;
-    }
     filter->initialized = type!=DH_LOWPASS;
-    return dh_compute_chebyshev_filter_coefficients(filter,options,type,isType2);
+    return dh_compute_chebyshev_filter_coefficients(filter,options,type,isType2,workspace);
 }
-
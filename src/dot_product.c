@@ -0,0 +1,543 @@
+#include "dh/dot_product.h"
+#include <math.h>
+
+/**
+ * @file
+ * @brief This file contains the vectorized dot products for FIR filters.
+ *
+ * Each vectorized version uses four independent accumulators, so that the latency of the additions
+ * (or fused multiply adds) is hidden. The order of the summation differs from the scalar version,
+ * so the results may differ in the last bits.
+ *
+ * The folded versions are used for symmetric coefficients. They load the inputs of the second half in reverse
+ * order, add them to the inputs of the first half and multiply the sums with the first half of the coefficients.
+ * For antisymmetric coefficients, the sign bit of the reversed inputs is flipped before the addition.
+ *
+ * This source code is licensed under the MIT license. See file "LICENSE" at the root of the repository.
+ */
+
+#if !defined(DH_FILTER_DISABLE_SIMD) && (defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || (defined(_M_IX86) && _M_IX86_FP >= 2))
+#define DH_FILTER_SIMD_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define DH_TARGET(X)
+#else
+#define DH_TARGET(X) __attribute__((target(X)))
+#endif
+#endif
+
+double dh_dot_product_scalar(const double* coefficients, const double* data, size_t count)
+{
+    double out = 0.0;
+    for(size_t i=0; i<count; ++i) {
+        out += coefficients[i] * data[i];
+    }
+    return out;
+}
+
+float dh_dot_product_scalar_f32(const float* coefficients, const float* data, size_t count)
+{
+    float out = 0.0f;
+    for(size_t i=0; i<count; ++i) {
+        out += coefficients[i] * data[i];
+    }
+    return out;
+}
+
+/**
+ * @brief Computes the folded dot product for symmetric (or antisymmetric) coefficients.
+ * Only the first (count+1)/2 coefficients are read.
+ */
+static double dh_folded_dot_product_scalar(const double* coefficients, const double* data, size_t count, bool antisymmetric)
+{
+    const size_t half = count / 2;
+    const double* reversed = data + count - 1;
+    double out = 0.0;
+    if (antisymmetric) {
+        for(size_t i=0; i<half; ++i) {
+            out += coefficients[i] * (data[i] - *(reversed - i));
+        }
+    } else {
+        for(size_t i=0; i<half; ++i) {
+            out += coefficients[i] * (data[i] + *(reversed - i));
+        }
+        if (count % 2 == 1) {
+            out += coefficients[half] * data[half];
+        }
+    }
+    return out;
+}
+
+static double dh_symmetric_dot_product_scalar(const double* coefficients, const double* data, size_t count)
+{
+    return dh_folded_dot_product_scalar(coefficients, data, count, false);
+}
+
+static double dh_antisymmetric_dot_product_scalar(const double* coefficients, const double* data, size_t count)
+{
+    return dh_folded_dot_product_scalar(coefficients, data, count, true);
+}
+
+#ifdef DH_FILTER_SIMD_X86
+
+DH_TARGET("sse2")
+static double dh_dot_product_sse2(const double* coefficients, const double* data, size_t count)
+{
+    __m128d acc0 = _mm_setzero_pd();
+    __m128d acc1 = _mm_setzero_pd();
+    __m128d acc2 = _mm_setzero_pd();
+    __m128d acc3 = _mm_setzero_pd();
+    size_t i = 0;
+    for(; i+8 <= count; i+=8) {
+        acc0 = _mm_add_pd(acc0, _mm_mul_pd(_mm_loadu_pd(coefficients+i), _mm_loadu_pd(data+i)));
+        acc1 = _mm_add_pd(acc1, _mm_mul_pd(_mm_loadu_pd(coefficients+i+2), _mm_loadu_pd(data+i+2)));
+        acc2 = _mm_add_pd(acc2, _mm_mul_pd(_mm_loadu_pd(coefficients+i+4), _mm_loadu_pd(data+i+4)));
+        acc3 = _mm_add_pd(acc3, _mm_mul_pd(_mm_loadu_pd(coefficients+i+6), _mm_loadu_pd(data+i+6)));
+    }
+    for(; i+2 <= count; i+=2) {
+        acc0 = _mm_add_pd(acc0, _mm_mul_pd(_mm_loadu_pd(coefficients+i), _mm_loadu_pd(data+i)));
+    }
+    __m128d sum = _mm_add_pd(_mm_add_pd(acc0, acc1), _mm_add_pd(acc2, acc3));
+    double out = _mm_cvtsd_f64(_mm_add_sd(sum, _mm_unpackhi_pd(sum, sum)));
+    for(; i<count; ++i) {
+        out += coefficients[i] * data[i];
+    }
+    return out;
+}
+
+DH_TARGET("avx2,fma")
+static double dh_dot_product_avx2(const double* coefficients, const double* data, size_t count)
+{
+    __m256d acc0 = _mm256_setzero_pd();
+    __m256d acc1 = _mm256_setzero_pd();
+    __m256d acc2 = _mm256_setzero_pd();
+    __m256d acc3 = _mm256_setzero_pd();
+    size_t i = 0;
+    for(; i+16 <= count; i+=16) {
+        acc0 = _mm256_fmadd_pd(_mm256_loadu_pd(coefficients+i), _mm256_loadu_pd(data+i), acc0);
+        acc1 = _mm256_fmadd_pd(_mm256_loadu_pd(coefficients+i+4), _mm256_loadu_pd(data+i+4), acc1);
+        acc2 = _mm256_fmadd_pd(_mm256_loadu_pd(coefficients+i+8), _mm256_loadu_pd(data+i+8), acc2);
+        acc3 = _mm256_fmadd_pd(_mm256_loadu_pd(coefficients+i+12), _mm256_loadu_pd(data+i+12), acc3);
+    }
+    for(; i+4 <= count; i+=4) {
+        acc0 = _mm256_fmadd_pd(_mm256_loadu_pd(coefficients+i), _mm256_loadu_pd(data+i), acc0);
+    }
+    __m256d sum = _mm256_add_pd(_mm256_add_pd(acc0, acc1), _mm256_add_pd(acc2, acc3));
+    __m128d half = _mm_add_pd(_mm256_castpd256_pd128(sum), _mm256_extractf128_pd(sum, 1));
+    double out = _mm_cvtsd_f64(_mm_add_sd(half, _mm_unpackhi_pd(half, half)));
+    for(; i<count; ++i) {
+        out += coefficients[i] * data[i];
+    }
+    return out;
+}
+
+DH_TARGET("avx512f")
+static double dh_dot_product_avx512(const double* coefficients, const double* data, size_t count)
+{
+    __m512d acc0 = _mm512_setzero_pd();
+    __m512d acc1 = _mm512_setzero_pd();
+    __m512d acc2 = _mm512_setzero_pd();
+    __m512d acc3 = _mm512_setzero_pd();
+    size_t i = 0;
+    for(; i+32 <= count; i+=32) {
+        acc0 = _mm512_fmadd_pd(_mm512_loadu_pd(coefficients+i), _mm512_loadu_pd(data+i), acc0);
+        acc1 = _mm512_fmadd_pd(_mm512_loadu_pd(coefficients+i+8), _mm512_loadu_pd(data+i+8), acc1);
+        acc2 = _mm512_fmadd_pd(_mm512_loadu_pd(coefficients+i+16), _mm512_loadu_pd(data+i+16), acc2);
+        acc3 = _mm512_fmadd_pd(_mm512_loadu_pd(coefficients+i+24), _mm512_loadu_pd(data+i+24), acc3);
+    }
+    for(; i+8 <= count; i+=8) {
+        acc0 = _mm512_fmadd_pd(_mm512_loadu_pd(coefficients+i), _mm512_loadu_pd(data+i), acc0);
+    }
+    if (i < count) {
+        const __mmask8 mask = (__mmask8)((1U << (count - i)) - 1U);
+        acc1 = _mm512_fmadd_pd(_mm512_maskz_loadu_pd(mask, coefficients+i), _mm512_maskz_loadu_pd(mask, data+i), acc1);
+    }
+    __m512d sum = _mm512_add_pd(_mm512_add_pd(acc0, acc1), _mm512_add_pd(acc2, acc3));
+    return _mm512_reduce_add_pd(sum);
+}
+
+DH_TARGET("sse2")
+static float dh_dot_product_sse2_f32(const float* coefficients, const float* data, size_t count)
+{
+    __m128 acc0 = _mm_setzero_ps();
+    __m128 acc1 = _mm_setzero_ps();
+    __m128 acc2 = _mm_setzero_ps();
+    __m128 acc3 = _mm_setzero_ps();
+    size_t i = 0;
+    for(; i+16 <= count; i+=16) {
+        acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(coefficients+i), _mm_loadu_ps(data+i)));
+        acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(coefficients+i+4), _mm_loadu_ps(data+i+4)));
+        acc2 = _mm_add_ps(acc2, _mm_mul_ps(_mm_loadu_ps(coefficients+i+8), _mm_loadu_ps(data+i+8)));
+        acc3 = _mm_add_ps(acc3, _mm_mul_ps(_mm_loadu_ps(coefficients+i+12), _mm_loadu_ps(data+i+12)));
+    }
+    for(; i+4 <= count; i+=4) {
+        acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(coefficients+i), _mm_loadu_ps(data+i)));
+    }
+    __m128 sum = _mm_add_ps(_mm_add_ps(acc0, acc1), _mm_add_ps(acc2, acc3));
+    sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+    float out = _mm_cvtss_f32(_mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1)));
+    for(; i<count; ++i) {
+        out += coefficients[i] * data[i];
+    }
+    return out;
+}
+
+DH_TARGET("avx2,fma")
+static float dh_dot_product_avx2_f32(const float* coefficients, const float* data, size_t count)
+{
+    __m256 acc0 = _mm256_setzero_ps();
+    __m256 acc1 = _mm256_setzero_ps();
+    __m256 acc2 = _mm256_setzero_ps();
+    __m256 acc3 = _mm256_setzero_ps();
+    size_t i = 0;
+    for(; i+32 <= count; i+=32) {
+        acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(coefficients+i), _mm256_loadu_ps(data+i), acc0);
+        acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(coefficients+i+8), _mm256_loadu_ps(data+i+8), acc1);
+        acc2 = _mm256_fmadd_ps(_mm256_loadu_ps(coefficients+i+16), _mm256_loadu_ps(data+i+16), acc2);
+        acc3 = _mm256_fmadd_ps(_mm256_loadu_ps(coefficients+i+24), _mm256_loadu_ps(data+i+24), acc3);
+    }
+    for(; i+8 <= count; i+=8) {
+        acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(coefficients+i), _mm256_loadu_ps(data+i), acc0);
+    }
+    __m256 sum = _mm256_add_ps(_mm256_add_ps(acc0, acc1), _mm256_add_ps(acc2, acc3));
+    __m128 half = _mm_add_ps(_mm256_castps256_ps128(sum), _mm256_extractf128_ps(sum, 1));
+    half = _mm_add_ps(half, _mm_movehl_ps(half, half));
+    float out = _mm_cvtss_f32(_mm_add_ss(half, _mm_shuffle_ps(half, half, 1)));
+    for(; i<count; ++i) {
+        out += coefficients[i] * data[i];
+    }
+    return out;
+}
+
+DH_TARGET("avx512f")
+static float dh_dot_product_avx512_f32(const float* coefficients, const float* data, size_t count)
+{
+    __m512 acc0 = _mm512_setzero_ps();
+    __m512 acc1 = _mm512_setzero_ps();
+    __m512 acc2 = _mm512_setzero_ps();
+    __m512 acc3 = _mm512_setzero_ps();
+    size_t i = 0;
+    for(; i+64 <= count; i+=64) {
+        acc0 = _mm512_fmadd_ps(_mm512_loadu_ps(coefficients+i), _mm512_loadu_ps(data+i), acc0);
+        acc1 = _mm512_fmadd_ps(_mm512_loadu_ps(coefficients+i+16), _mm512_loadu_ps(data+i+16), acc1);
+        acc2 = _mm512_fmadd_ps(_mm512_loadu_ps(coefficients+i+32), _mm512_loadu_ps(data+i+32), acc2);
+        acc3 = _mm512_fmadd_ps(_mm512_loadu_ps(coefficients+i+48), _mm512_loadu_ps(data+i+48), acc3);
+    }
+    for(; i+16 <= count; i+=16) {
+        acc0 = _mm512_fmadd_ps(_mm512_loadu_ps(coefficients+i), _mm512_loadu_ps(data+i), acc0);
+    }
+    if (i < count) {
+        const __mmask16 mask = (__mmask16)((1U << (count - i)) - 1U);
+        acc1 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(mask, coefficients+i), _mm512_maskz_loadu_ps(mask, data+i), acc1);
+    }
+    __m512 sum = _mm512_add_ps(_mm512_add_ps(acc0, acc1), _mm512_add_ps(acc2, acc3));
+    return _mm512_reduce_add_ps(sum);
+}
+
+/**
+ * @brief Adds the folded terms that are left over after the vectorized loops, starting at pair [i].
+ */
+static double dh_folded_dot_product_tail(const double* coefficients, const double* data, size_t count, size_t i, bool antisymmetric)
+{
+    const size_t half = count / 2;
+    double out = 0.0;
+    for(; i<half; ++i) {
+        const double mirrored = data[count - 1 - i];
+        out += coefficients[i] * (data[i] + (antisymmetric ? -mirrored : mirrored));
+    }
+    if (count % 2 == 1 && !antisymmetric) {
+        out += coefficients[half] * data[half];
+    }
+    return out;
+}
+
+DH_TARGET("sse2")
+static double dh_folded_dot_product_sse2(const double* coefficients, const double* data, size_t count, bool antisymmetric)
+{
+    const size_t half = count / 2;
+    const __m128d sign = _mm_set1_pd(antisymmetric ? -0.0 : 0.0);
+    const double* end = data + count;
+    __m128d acc0 = _mm_setzero_pd();
+    __m128d acc1 = _mm_setzero_pd();
+    size_t i = 0;
+    for(; i+4 <= half; i+=4) {
+        __m128d reversed0 = _mm_loadu_pd(end - i - 2);
+        __m128d reversed1 = _mm_loadu_pd(end - i - 4);
+        reversed0 = _mm_xor_pd(_mm_shuffle_pd(reversed0, reversed0, 1), sign);
+        reversed1 = _mm_xor_pd(_mm_shuffle_pd(reversed1, reversed1, 1), sign);
+        acc0 = _mm_add_pd(acc0, _mm_mul_pd(_mm_loadu_pd(coefficients+i), _mm_add_pd(_mm_loadu_pd(data+i), reversed0)));
+        acc1 = _mm_add_pd(acc1, _mm_mul_pd(_mm_loadu_pd(coefficients+i+2), _mm_add_pd(_mm_loadu_pd(data+i+2), reversed1)));
+    }
+    for(; i+2 <= half; i+=2) {
+        __m128d reversed = _mm_loadu_pd(end - i - 2);
+        reversed = _mm_xor_pd(_mm_shuffle_pd(reversed, reversed, 1), sign);
+        acc0 = _mm_add_pd(acc0, _mm_mul_pd(_mm_loadu_pd(coefficients+i), _mm_add_pd(_mm_loadu_pd(data+i), reversed)));
+    }
+    __m128d sum = _mm_add_pd(acc0, acc1);
+    double out = _mm_cvtsd_f64(_mm_add_sd(sum, _mm_unpackhi_pd(sum, sum)));
+    return out + dh_folded_dot_product_tail(coefficients, data, count, i, antisymmetric);
+}
+
+DH_TARGET("avx2,fma")
+static double dh_folded_dot_product_avx2(const double* coefficients, const double* data, size_t count, bool antisymmetric)
+{
+    const size_t half = count / 2;
+    const __m256d sign = _mm256_set1_pd(antisymmetric ? -0.0 : 0.0);
+    const double* end = data + count;
+    __m256d acc0 = _mm256_setzero_pd();
+    __m256d acc1 = _mm256_setzero_pd();
+    __m256d acc2 = _mm256_setzero_pd();
+    __m256d acc3 = _mm256_setzero_pd();
+    size_t i = 0;
+    for(; i+16 <= half; i+=16) {
+        const __m256d reversed0 = _mm256_xor_pd(_mm256_permute4x64_pd(_mm256_loadu_pd(end - i - 4), _MM_SHUFFLE(0,1,2,3)), sign);
+        const __m256d reversed1 = _mm256_xor_pd(_mm256_permute4x64_pd(_mm256_loadu_pd(end - i - 8), _MM_SHUFFLE(0,1,2,3)), sign);
+        const __m256d reversed2 = _mm256_xor_pd(_mm256_permute4x64_pd(_mm256_loadu_pd(end - i - 12), _MM_SHUFFLE(0,1,2,3)), sign);
+        const __m256d reversed3 = _mm256_xor_pd(_mm256_permute4x64_pd(_mm256_loadu_pd(end - i - 16), _MM_SHUFFLE(0,1,2,3)), sign);
+        acc0 = _mm256_fmadd_pd(_mm256_loadu_pd(coefficients+i), _mm256_add_pd(_mm256_loadu_pd(data+i), reversed0), acc0);
+        acc1 = _mm256_fmadd_pd(_mm256_loadu_pd(coefficients+i+4), _mm256_add_pd(_mm256_loadu_pd(data+i+4), reversed1), acc1);
+        acc2 = _mm256_fmadd_pd(_mm256_loadu_pd(coefficients+i+8), _mm256_add_pd(_mm256_loadu_pd(data+i+8), reversed2), acc2);
+        acc3 = _mm256_fmadd_pd(_mm256_loadu_pd(coefficients+i+12), _mm256_add_pd(_mm256_loadu_pd(data+i+12), reversed3), acc3);
+    }
+    for(; i+4 <= half; i+=4) {
+        const __m256d reversed = _mm256_xor_pd(_mm256_permute4x64_pd(_mm256_loadu_pd(end - i - 4), _MM_SHUFFLE(0,1,2,3)), sign);
+        acc0 = _mm256_fmadd_pd(_mm256_loadu_pd(coefficients+i), _mm256_add_pd(_mm256_loadu_pd(data+i), reversed), acc0);
+    }
+    __m256d sum = _mm256_add_pd(_mm256_add_pd(acc0, acc1), _mm256_add_pd(acc2, acc3));
+    __m128d sum128 = _mm_add_pd(_mm256_castpd256_pd128(sum), _mm256_extractf128_pd(sum, 1));
+    double out = _mm_cvtsd_f64(_mm_add_sd(sum128, _mm_unpackhi_pd(sum128, sum128)));
+    return out + dh_folded_dot_product_tail(coefficients, data, count, i, antisymmetric);
+}
+
+DH_TARGET("avx512f")
+static double dh_folded_dot_product_avx512(const double* coefficients, const double* data, size_t count, bool antisymmetric)
+{
+    const size_t half = count / 2;
+    const __m512i sign = _mm512_castpd_si512(_mm512_set1_pd(antisymmetric ? -0.0 : 0.0));
+    const __m512i reverse = _mm512_set_epi64(0, 1, 2, 3, 4, 5, 6, 7);
+    const double* end = data + count;
+    __m512d acc0 = _mm512_setzero_pd();
+    __m512d acc1 = _mm512_setzero_pd();
+    size_t i = 0;
+    for(; i+16 <= half; i+=16) {
+        const __m512d reversed0 = _mm512_castsi512_pd(_mm512_xor_si512(_mm512_castpd_si512(_mm512_permutexvar_pd(reverse, _mm512_loadu_pd(end - i - 8))), sign));
+        const __m512d reversed1 = _mm512_castsi512_pd(_mm512_xor_si512(_mm512_castpd_si512(_mm512_permutexvar_pd(reverse, _mm512_loadu_pd(end - i - 16))), sign));
+        acc0 = _mm512_fmadd_pd(_mm512_loadu_pd(coefficients+i), _mm512_add_pd(_mm512_loadu_pd(data+i), reversed0), acc0);
+        acc1 = _mm512_fmadd_pd(_mm512_loadu_pd(coefficients+i+8), _mm512_add_pd(_mm512_loadu_pd(data+i+8), reversed1), acc1);
+    }
+    for(; i+8 <= half; i+=8) {
+        const __m512d reversed = _mm512_castsi512_pd(_mm512_xor_si512(_mm512_castpd_si512(_mm512_permutexvar_pd(reverse, _mm512_loadu_pd(end - i - 8))), sign));
+        acc0 = _mm512_fmadd_pd(_mm512_loadu_pd(coefficients+i), _mm512_add_pd(_mm512_loadu_pd(data+i), reversed), acc0);
+    }
+    const double out = _mm512_reduce_add_pd(_mm512_add_pd(acc0, acc1));
+    return out + dh_folded_dot_product_tail(coefficients, data, count, i, antisymmetric);
+}
+
+static double dh_symmetric_dot_product_sse2(const double* coefficients, const double* data, size_t count)
+{
+    return dh_folded_dot_product_sse2(coefficients, data, count, false);
+}
+
+static double dh_antisymmetric_dot_product_sse2(const double* coefficients, const double* data, size_t count)
+{
+    return dh_folded_dot_product_sse2(coefficients, data, count, true);
+}
+
+static double dh_symmetric_dot_product_avx2(const double* coefficients, const double* data, size_t count)
+{
+    return dh_folded_dot_product_avx2(coefficients, data, count, false);
+}
+
+static double dh_antisymmetric_dot_product_avx2(const double* coefficients, const double* data, size_t count)
+{
+    return dh_folded_dot_product_avx2(coefficients, data, count, true);
+}
+
+static double dh_symmetric_dot_product_avx512(const double* coefficients, const double* data, size_t count)
+{
+    return dh_folded_dot_product_avx512(coefficients, data, count, false);
+}
+
+static double dh_antisymmetric_dot_product_avx512(const double* coefficients, const double* data, size_t count)
+{
+    return dh_folded_dot_product_avx512(coefficients, data, count, true);
+}
+
+#if defined(_MSC_VER) && !defined(__clang__)
+static bool dh_os_supports_xsave_state(unsigned long long mask)
+{
+    int info[4];
+    __cpuid(info, 1);
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    return osxsave && (_xgetbv(0) & mask) == mask;
+}
+#endif
+
+DH_SIMD_INSTRUCTION_SET dh_detect_simd_instruction_set(void)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 0);
+    const int max_leaf = info[0];
+    __cpuid(info, 1);
+    const bool sse2 = (info[3] & (1 << 26)) != 0;
+    const bool fma = (info[2] & (1 << 12)) != 0;
+    bool avx2 = false;
+    bool avx512 = false;
+    if (max_leaf >= 7) {
+        __cpuidex(info, 7, 0);
+        // ymm state: bits 1,2, zmm state: bits 5,6,7
+        avx2 = (info[1] & (1 << 5)) != 0 && fma && dh_os_supports_xsave_state(0x6);
+        avx512 = (info[1] & (1 << 16)) != 0 && dh_os_supports_xsave_state(0xE6);
+    }
+#else
+    __builtin_cpu_init();
+    const bool sse2 = __builtin_cpu_supports("sse2");
+    const bool avx2 = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    const bool avx512 = __builtin_cpu_supports("avx512f");
+#endif
+    if (avx512) {
+        return DH_SIMD_AVX512;
+    }
+    if (avx2) {
+        return DH_SIMD_AVX2;
+    }
+    if (sse2) {
+        return DH_SIMD_SSE2;
+    }
+    return DH_SIMD_NONE;
+}
+
+#else
+
+DH_SIMD_INSTRUCTION_SET dh_detect_simd_instruction_set(void)
+{
+    return DH_SIMD_NONE;
+}
+
+#endif
+
+dh_dot_product_function dh_get_dot_product_function(DH_SIMD_INSTRUCTION_SET set)
+{
+    if (set > dh_detect_simd_instruction_set()) {
+        return NULL;
+    }
+    switch(set) {
+        case DH_SIMD_NONE: return &dh_dot_product_scalar;
+#ifdef DH_FILTER_SIMD_X86
+        case DH_SIMD_SSE2: return &dh_dot_product_sse2;
+        case DH_SIMD_AVX2: return &dh_dot_product_avx2;
+        case DH_SIMD_AVX512: return &dh_dot_product_avx512;
+#else
+        default: break;
+#endif
+    }
+    return NULL;
+}
+
+dh_dot_product_function dh_select_dot_product_function(size_t number_coefficients)
+{
+    if (number_coefficients < DH_FILTER_SIMD_MIN_COEFFICIENTS) {
+        return NULL;
+    }
+    DH_SIMD_INSTRUCTION_SET set = dh_detect_simd_instruction_set();
+    if (set == DH_SIMD_NONE) {
+        return NULL;
+    }
+    return dh_get_dot_product_function(set);
+}
+
+dh_dot_product_function dh_get_folded_dot_product_function(DH_SIMD_INSTRUCTION_SET set, DH_FIR_SYMMETRY symmetry)
+{
+    if (set > dh_detect_simd_instruction_set() || symmetry == DH_FIR_NOT_SYMMETRIC) {
+        return NULL;
+    }
+    const bool antisymmetric = symmetry == DH_FIR_ANTISYMMETRIC;
+    switch(set) {
+        case DH_SIMD_NONE: return antisymmetric ? &dh_antisymmetric_dot_product_scalar : &dh_symmetric_dot_product_scalar;
+#ifdef DH_FILTER_SIMD_X86
+        case DH_SIMD_SSE2: return antisymmetric ? &dh_antisymmetric_dot_product_sse2 : &dh_symmetric_dot_product_sse2;
+        case DH_SIMD_AVX2: return antisymmetric ? &dh_antisymmetric_dot_product_avx2 : &dh_symmetric_dot_product_avx2;
+        case DH_SIMD_AVX512: return antisymmetric ? &dh_antisymmetric_dot_product_avx512 : &dh_symmetric_dot_product_avx512;
+#else
+        default: break;
+#endif
+    }
+    return NULL;
+}
+
+dh_dot_product_function dh_select_folded_dot_product_function(size_t number_coefficients, DH_FIR_SYMMETRY symmetry)
+{
+    // the vectorized loops need 2*DH_FILTER_SIMD_MIN_COEFFICIENTS coefficients to fill the registers with pairs
+    if (number_coefficients < 2*DH_FILTER_SIMD_MIN_COEFFICIENTS) {
+        return dh_get_folded_dot_product_function(DH_SIMD_NONE, symmetry);
+    }
+    return dh_get_folded_dot_product_function(dh_detect_simd_instruction_set(), symmetry);
+}
+
+DH_FIR_SYMMETRY dh_detect_fir_symmetry(double* coefficients, size_t count)
+{
+    if (coefficients == NULL || count < 2) {
+        return DH_FIR_NOT_SYMMETRIC;
+    }
+    double largest = 0.0;
+    for(size_t i=0; i<count; ++i) {
+        largest = fmax(largest, fabs(coefficients[i]));
+    }
+    const double tolerance = 1e-12 * largest;
+    const size_t half = count / 2;
+    bool symmetric = true;
+    bool antisymmetric = true;
+    for(size_t i=0; i<half && (symmetric || antisymmetric); ++i) {
+        const double first = coefficients[i];
+        const double second = coefficients[count - 1 - i];
+        symmetric = symmetric && fabs(first - second) <= tolerance;
+        antisymmetric = antisymmetric && fabs(first + second) <= tolerance;
+    }
+    if (count % 2 == 1 && fabs(coefficients[half]) > tolerance) {
+        antisymmetric = false;
+    }
+    if (symmetric) {
+        for(size_t i=0; i<half; ++i) {
+            coefficients[count - 1 - i] = coefficients[i];
+        }
+        return DH_FIR_SYMMETRIC;
+    }
+    if (antisymmetric) {
+        for(size_t i=0; i<half; ++i) {
+            coefficients[count - 1 - i] = -coefficients[i];
+        }
+        if (count % 2 == 1) {
+            coefficients[half] = 0.0;
+        }
+        return DH_FIR_ANTISYMMETRIC;
+    }
+    return DH_FIR_NOT_SYMMETRIC;
+}
+
+dh_dot_product_function_f32 dh_get_dot_product_function_f32(DH_SIMD_INSTRUCTION_SET set)
+{
+    if (set > dh_detect_simd_instruction_set()) {
+        return NULL;
+    }
+    switch(set) {
+        case DH_SIMD_NONE: return &dh_dot_product_scalar_f32;
+#ifdef DH_FILTER_SIMD_X86
+        case DH_SIMD_SSE2: return &dh_dot_product_sse2_f32;
+        case DH_SIMD_AVX2: return &dh_dot_product_avx2_f32;
+        case DH_SIMD_AVX512: return &dh_dot_product_avx512_f32;
+#else
+        default: break;
+#endif
+    }
+    return NULL;
+}
+
+dh_dot_product_function_f32 dh_select_dot_product_function_f32(size_t number_coefficients)
+{
+    if (number_coefficients < DH_FILTER_SIMD_MIN_COEFFICIENTS) {
+        return &dh_dot_product_scalar_f32;
+    }
+    return dh_get_dot_product_function_f32(dh_detect_simd_instruction_set());
+}
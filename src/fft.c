@@ -0,0 +1,139 @@
+#include "dh/fft.h"
+#define _USE_MATH_DEFINES
+#include "math.h"
+
+/**
+ * @file
+ * @brief This file contains the fast fourier transform that is used for the overlap-save convolution.
+ *
+ * This source code is licensed under the MIT license. See file "LICENSE" at the root of the repository.
+ */
+
+bool dh_fft_is_valid_length(size_t length)
+{
+    return length >= 4 && (length & (length - 1)) == 0;
+}
+
+void dh_fft_compute_twiddles(double* twiddles, size_t length)
+{
+    for (size_t k=0; k<length/2; ++k) {
+        const double phi = -2.0 * M_PI * (double)k / (double)length;
+        twiddles[2*k] = cos(phi);
+        twiddles[2*k+1] = sin(phi);
+    }
+}
+
+/**
+ * @brief In place radix-2 transform of [count] interleaved complex values.
+ *
+ * @param data Interleaved complex values.
+ * @param count Number of complex values. Must be a power of two.
+ * @param twiddles Twiddle factors of a transform with the real length 2*count.
+ * @param sign 1.0 for the forward transform, -1.0 for the (unnormalized) inverse transform.
+ */
+static void complex_fft(double* data, size_t count, const double* twiddles, double sign)
+{
+    // bit reversed order
+    size_t j = 0;
+    for (size_t i=1; i<count; ++i) {
+        size_t bit = count >> 1;
+        for (; j & bit; bit >>= 1) {
+            j ^= bit;
+        }
+        j ^= bit;
+        if (i < j) {
+            double tmp = data[2*i];
+            data[2*i] = data[2*j];
+            data[2*j] = tmp;
+            tmp = data[2*i+1];
+            data[2*i+1] = data[2*j+1];
+            data[2*j+1] = tmp;
+        }
+    }
+
+    // butterflies. The twiddle table has count entries for the factors exp(-2*pi*i*k/(2*count)).
+    for (size_t length=2; length<=count; length <<= 1) {
+        const size_t half = length / 2;
+        const size_t step = 2 * count / length;
+        for (size_t start=0; start<count; start+=length) {
+            for (size_t k=0; k<half; ++k) {
+                const double wr = twiddles[2*k*step];
+                const double wi = sign * twiddles[2*k*step+1];
+                double* u = data + 2*(start+k);
+                double* v = data + 2*(start+k+half);
+                const double vr = v[0]*wr - v[1]*wi;
+                const double vi = v[0]*wi + v[1]*wr;
+                v[0] = u[0] - vr;
+                v[1] = u[1] - vi;
+                u[0] += vr;
+                u[1] += vi;
+            }
+        }
+    }
+}
+
+void dh_fft_real_forward(double* data, size_t length, const double* twiddles)
+{
+    const size_t n = length / 2;
+    // the even values are the real parts, the odd values the imaginary parts of a complex signal
+    complex_fft(data, n, twiddles, 1.0);
+
+    const double zr = data[0];
+    const double zi = data[1];
+    data[0] = zr + zi;
+    data[1] = 0.0;
+    data[2*n] = zr - zi;
+    data[2*n+1] = 0.0;
+    // X[k] = E + w**k * O, X[n-k] = conj(E - w**k * O)
+    // with E = (Z[k] + conj(Z[n-k]))/2 and O = (Z[k] - conj(Z[n-k]))/(2i)
+    for (size_t k=1; k<=n/2; ++k) {
+        const size_t m = n - k;
+        const double ar = data[2*k];
+        const double ai = data[2*k+1];
+        const double br = data[2*m];
+        const double bi = data[2*m+1];
+        const double er = 0.5 * (ar + br);
+        const double ei = 0.5 * (ai - bi);
+        const double odd_r = 0.5 * (ai + bi);
+        const double odd_i = -0.5 * (ar - br);
+        const double wr = twiddles[2*k];
+        const double wi = twiddles[2*k+1];
+        const double tr = wr*odd_r - wi*odd_i;
+        const double ti = wr*odd_i + wi*odd_r;
+        data[2*k] = er + tr;
+        data[2*k+1] = ei + ti;
+        data[2*m] = er - tr;
+        data[2*m+1] = -(ei - ti);
+    }
+}
+
+void dh_fft_real_inverse(double* data, size_t length, const double* twiddles)
+{
+    const size_t n = length / 2;
+    const double x0 = data[0];
+    const double xn = data[2*n];
+    data[0] = 0.5 * (x0 + xn);
+    data[1] = 0.5 * (x0 - xn);
+    // Z[k] = E + i*O, Z[n-k] = conj(E) + i*conj(O)
+    // with E = (X[k] + conj(X[n-k]))/2 and O = (X[k] - conj(X[n-k]))/2 * conj(w**k)
+    for (size_t k=1; k<=n/2; ++k) {
+        const size_t m = n - k;
+        const double ar = data[2*k];
+        const double ai = data[2*k+1];
+        const double br = data[2*m];
+        const double bi = data[2*m+1];
+        const double er = 0.5 * (ar + br);
+        const double ei = 0.5 * (ai - bi);
+        const double dr = 0.5 * (ar - br);
+        const double di = 0.5 * (ai + bi);
+        const double wr = twiddles[2*k];
+        const double wi = -twiddles[2*k+1];
+        const double odd_r = dr*wr - di*wi;
+        const double odd_i = dr*wi + di*wr;
+        data[2*k] = er - odd_i;
+        data[2*k+1] = ei + odd_r;
+        data[2*m] = er + odd_i;
+        data[2*m+1] = -ei + odd_r;
+    }
+    complex_fft(data, n, twiddles, -1.0);
+}
@@ -1,10 +1,12 @@
 #include "dh/filter.h"
 #include "dh/utility.h"
+#include "dh/overlap_save.h"
 #define _USE_MATH_DEFINES
 #include "math.h"
 #include "complex.h"
 #include <assert.h>
 #include <stdio.h>
+#include <stdlib.h>
 
 /**
  * @file 
@@ -13,13 +15,44 @@
  * This source code is licensed under the MIT license. See file "LICENSE" at the root of the repository.
  */
 
-static void dh_filter_add_input(dh_filter_data* filter, double input);
-static double dh_filter_run_filter_loop(double* coefficients, size_t num_coeffs, double* data, size_t current_idx , size_t start);
-static void dh_filter_run_input_loop(dh_filter_data* filter);
-static void dh_filter_run_output_loop(dh_filter_data* filter);
-static void dh_filter_shift_output(dh_filter_data* filter);
-static void dh_filter_add_output(dh_filter_data* filter);
-static void dh_filter_apply_gain(dh_filter_data* filter);
+/** Number of values that dh_filter_block_strided() and dh_filtfilt() copy to a contiguous array on the stack before they are filtered. */
+#define DH_FILTER_STRIDED_CHUNK_LENGTH 256
+/** Number of values in a group of frames processed by dh_filter_frames_inplace(). 4096 doubles fill 32 KiB. */
+#define DH_FILTER_FRAME_GROUP_LENGTH 4096
+
+static double dh_filter_run_filter_loop(const double* coefficients, size_t num_coeffs, const double* data, size_t current_idx , size_t start);
+static DH_FILTER_RETURN_VALUE dh_filter_check_buffers(const dh_filter_data* filter);
+static void dh_filter_run_block(dh_filter_data* filter, const double* input, double* output, size_t count);
+static void dh_filter_run_block_mirrored(dh_filter_data* filter, const double* input, double* output, size_t count);
+static double dh_filter_run_linear_loop(const double* coefficients, size_t num_coeffs, const double* data, size_t start);
+static void dh_filter_run_block_sections(dh_filter_data* filter, const double* input, double* output, size_t count);
+static void dh_filter_run_block_transposed(dh_filter_data* filter, const double* input, double* output, size_t count);
+static void dh_filter_run_block_running_sum(dh_filter_data* filter, const double* input, double* output, size_t count);
+static void dh_filter_run_block_recursive_exponential(dh_filter_data* filter, const double* input, double* output, size_t count);
+static void dh_filter_run(dh_filter_data* filter, const double* input, double* output, size_t count);
+static void dh_filter_run_kernel(dh_filter_data* filter, const double* input, double* output, size_t count);
+static void dh_filter_flush_denormals(dh_filter_data* filter, size_t count);
+static double dh_filter_run_dot_product(dh_dot_product_function dot_product, const double* coefficients, size_t num_coeffs, const double* data, size_t current_idx);
+static void dh_filter_block_reversed(dh_filter_data* filter, double* data, size_t count);
+static void dh_filter_push_inputs(dh_filter_data* filter, const double* input, size_t count);
+static void dh_initialize_steady_state(dh_filter_data* filter, double value);
+static void dh_filter_run_block_fir(dh_filter_data* filter, const double* input, double* output, size_t count);
+static void dh_filter_run_block_fir_unity_gain(dh_filter_data* filter, const double* input, double* output, size_t count);
+static void dh_filter_run_block_fir_mirrored(dh_filter_data* filter, const double* input, double* output, size_t count);
+static void dh_filter_run_block_fir_mirrored_unity_gain(dh_filter_data* filter, const double* input, double* output, size_t count);
+static void dh_filter_run_block_one_pole(dh_filter_data* filter, const double* input, double* output, size_t count);
+
+/** Largest order of the IIR filters in direct form 1 that have a fully unrolled kernel. */
+#define DH_FILTER_UNROLLED_MAX_ORDER 8
+
+/**
+ * @brief Number of state values used by the transposed direct form 2: max(M,N)-1.
+ */
+static size_t dh_filter_transposed_state_length(const dh_filter_data* filter)
+{
+    const size_t length = filter->number_coefficients_in > filter->number_coefficients_out ? filter->number_coefficients_in : filter->number_coefficients_out;
+    return length > 0 ? length - 1 : 0;
+}
 
 DH_FILTER_RETURN_VALUE dh_filter(dh_filter_data* filter, double input, double* output)
 {
@@ -27,110 +60,997 @@ DH_FILTER_RETURN_VALUE dh_filter(dh_filter_data* filter, double input, double* o
     if (!filter) {
         return DH_FILTER_NO_DATA_STRUCTURE;
     }
-    if (filter->number_coefficients_in == 0 || filter->inputs == NULL || filter->coefficients_in == NULL) {
-        return DH_FILTER_DATA_STRUCTURE_NOT_INITIALIZED;
+    // the checks are cheap and also guard the kernel of structures that were filled manually
+    DH_FILTER_RETURN_VALUE rv = dh_filter_check_buffers(filter);
+    if (rv != DH_FILTER_OK) {
+        return rv;
     }
     if(!filter->initialized) {
         dh_initialize_filter(filter,input);
     }
 
-    dh_filter_add_input(filter, input);
-    dh_filter_run_input_loop(filter);
+    dh_filter_run(filter, &input, &filter->current_value, 1);
 
-    if (filter->number_coefficients_out > 1) {
-        if (filter->outputs == NULL || filter->coefficients_out == NULL) {
-            return DH_FILTER_DATA_STRUCTURE_NOT_INITIALIZED;
-        }
-        dh_filter_shift_output(filter);
-        dh_filter_run_output_loop(filter);
-        dh_filter_add_output(filter);
+    if (output) {
+        *output = filter->current_value;
+    }
+
+    return DH_FILTER_OK;
+}
+
+DH_FILTER_RETURN_VALUE dh_filter_block(dh_filter_data* filter, const double* input, double* output, size_t count)
+{
+    assert(filter);
+    if (!filter) {
+        return DH_FILTER_NO_DATA_STRUCTURE;
+    }
+    DH_FILTER_RETURN_VALUE rv = dh_filter_check_buffers(filter);
+    if (rv != DH_FILTER_OK) {
+        return rv;
+    }
+    if (count == 0) {
+        return DH_FILTER_OK;
     }
-    if (filter->number_coefficients_out >= 1) {
-        dh_filter_apply_gain(filter);
+    if (!input || !output) {
+        return DH_FILTER_NO_DATA_STRUCTURE;
+    }
+    if(!filter->initialized) {
+        dh_initialize_filter(filter,input[0]);
     }
 
-    if (output) {
-        *output = filter->current_value;
+    size_t processed = 0;
+    if (filter->overlap_save.fft_length > 0) {
+        processed = dh_overlap_save_run(filter, input, output, count);
+    }
+    if (processed < count) {
+        dh_filter_run(filter, input + processed, output + processed, count - processed);
     }
+    filter->current_value = output[count-1];
+    return DH_FILTER_OK;
+}
 
+DH_FILTER_RETURN_VALUE dh_filter_block_inplace(dh_filter_data* filter, double* data, size_t count)
+{
+    return dh_filter_block(filter, data, data, count);
+}
+
+DH_FILTER_RETURN_VALUE dh_filter_block_strided(dh_filter_data* filter, const double* input, size_t input_stride, double* output, size_t output_stride, size_t count)
+{
+    assert(filter);
+    if (!filter) {
+        return DH_FILTER_NO_DATA_STRUCTURE;
+    }
+    DH_FILTER_RETURN_VALUE rv = dh_filter_check_buffers(filter);
+    if (rv != DH_FILTER_OK) {
+        return rv;
+    }
+    if (input_stride == 0 || output_stride == 0) {
+        return DH_FILTER_ERROR;
+    }
+    if (count == 0) {
+        return DH_FILTER_OK;
+    }
+    if (!input || !output) {
+        return DH_FILTER_NO_DATA_STRUCTURE;
+    }
+    if (input_stride == 1 && output_stride == 1) {
+        return dh_filter_block(filter, input, output, count);
+    }
+    double chunk[DH_FILTER_STRIDED_CHUNK_LENGTH];
+    for (size_t start=0; start<count; start+=DH_FILTER_STRIDED_CHUNK_LENGTH) {
+        const size_t length = count - start < DH_FILTER_STRIDED_CHUNK_LENGTH ? count - start : DH_FILTER_STRIDED_CHUNK_LENGTH;
+        for (size_t i=0; i<length; ++i) {
+            chunk[i] = input[(start + i) * input_stride];
+        }
+        dh_filter_block(filter, chunk, chunk, length);
+        for (size_t i=0; i<length; ++i) {
+            output[(start + i) * output_stride] = chunk[i];
+        }
+    }
     return DH_FILTER_OK;
 }
 
+DH_FILTER_RETURN_VALUE dh_filter_frames_inplace(dh_filter_data* filters, size_t number_channels, double* data, size_t number_frames)
+{
+    assert(filters);
+    if (!filters) {
+        return DH_FILTER_NO_DATA_STRUCTURE;
+    }
+    for (size_t c=0; c<number_channels; ++c) {
+        DH_FILTER_RETURN_VALUE rv = dh_filter_check_buffers(&filters[c]);
+        if (rv != DH_FILTER_OK) {
+            return rv;
+        }
+    }
+    if (number_frames == 0 || number_channels == 0) {
+        return DH_FILTER_OK;
+    }
+    if (!data) {
+        return DH_FILTER_NO_DATA_STRUCTURE;
+    }
+    // every channel of a group is filtered before the next group is loaded
+    size_t frames_per_group = DH_FILTER_FRAME_GROUP_LENGTH / number_channels;
+    frames_per_group = frames_per_group > 0 ? frames_per_group : 1;
+    for (size_t start=0; start<number_frames; start+=frames_per_group) {
+        const size_t length = number_frames - start < frames_per_group ? number_frames - start : frames_per_group;
+        double* group = data + start * number_channels;
+        for (size_t c=0; c<number_channels; ++c) {
+            dh_filter_block_strided(&filters[c], group + c, number_channels, group + c, number_channels, length);
+        }
+    }
+    return DH_FILTER_OK;
+}
 
-DH_FILTER_RETURN_VALUE dh_initialize_filter(dh_filter_data* filter, double value)
+DH_FILTER_RETURN_VALUE dh_filtfilt(dh_filter_data* filter, double* data, size_t count)
 {
     assert(filter);
     if (!filter) {
         return DH_FILTER_NO_DATA_STRUCTURE;
     }
-    for(size_t i=0; i< filter->number_coefficients_in; ++i) {
-        filter->inputs[i] = value;
+    DH_FILTER_RETURN_VALUE rv = dh_filter_check_buffers(filter);
+    if (rv != DH_FILTER_OK) {
+        return rv;
     }
-    for(size_t i=0; i< filter->number_coefficients_out; ++i) {
-        filter->outputs[i] = value;
+    if (count == 0) {
+        return DH_FILTER_OK;
     }
-    filter->current_value = value;
-    filter->initialized = true;
+    if (!data) {
+        return DH_FILTER_NO_DATA_STRUCTURE;
+    }
+    size_t edge = filter->number_coefficients_in > filter->number_coefficients_out ? filter->number_coefficients_in : filter->number_coefficients_out;
+    edge = 2 * filter->number_sections + 1 > edge ? 2 * filter->number_sections + 1 : edge;
+    edge = 3 * edge < count ? 3 * edge : count - 1;
+    double* left = NULL;
+    double* right = NULL;
+    if (edge > 0) {
+        left = (double*)malloc(2 * edge * sizeof(double));
+        if (left == NULL) {
+            return DH_FILTER_ALLOCATION_FAILED;
+        }
+        right = left + edge;
+        // odd reflection around the first and last value keeps the value and the slope at both edges
+        for (size_t i=0; i<edge; ++i) {
+            left[i] = 2.0 * data[0] - data[edge - i];
+            right[i] = 2.0 * data[count - 1] - data[count - 2 - i];
+        }
+    }
+
+    dh_initialize_steady_state(filter, edge > 0 ? left[0] : data[0]);
+    dh_filter_block(filter, left, left, edge);
+    dh_filter_block(filter, data, data, count);
+    dh_filter_block(filter, right, right, edge);
+
+    // the left extension of the backward pass is not part of the output and is skipped
+    dh_initialize_steady_state(filter, edge > 0 ? right[edge - 1] : data[count - 1]);
+    dh_filter_block_reversed(filter, right, edge);
+    dh_filter_block_reversed(filter, data, count);
+    free(left);
     return DH_FILTER_OK;
 }
 
-static void dh_filter_add_input(dh_filter_data* filter, double input)
+DH_FILTER_RETURN_VALUE dh_filter_decimate(dh_filter_data* filter, const double* input, size_t count, size_t factor, double* output, size_t* output_count)
 {
-    if (filter->current_input_index>0) {
-        filter->current_input_index -= 1;
+    assert(filter);
+    if (!filter) {
+        return DH_FILTER_NO_DATA_STRUCTURE;
+    }
+    DH_FILTER_RETURN_VALUE rv = dh_filter_check_buffers(filter);
+    if (rv != DH_FILTER_OK) {
+        return rv;
+    }
+    if (factor == 0) {
+        return DH_FILTER_ERROR;
+    }
+    if (output_count) {
+        *output_count = 0;
+    }
+    if (count == 0) {
+        return DH_FILTER_OK;
     }
-    else {
-        filter->current_input_index = filter->number_coefficients_in - 1U;
+    if (!input || !output) {
+        return DH_FILTER_NO_DATA_STRUCTURE;
+    }
+    if(!filter->initialized) {
+        dh_initialize_filter(filter,input[0]);
     }
-    filter->inputs[filter->current_input_index] = input;
+
+    size_t phase = filter->decimation_phase;
+    size_t written = 0;
+    const bool fir = filter->number_coefficients_out <= 1 && (filter->realization == DH_REALIZATION_DEFAULT
+        || filter->realization == DH_REALIZATION_DIRECT_FORM_1 || filter->realization == DH_REALIZATION_DIRECT_FORM_1_MIRRORED);
+    if (fir) {
+        // the dropped inputs are only written to the history, the kept outputs are computed by the kernel of the filter
+        size_t i = 0;
+        while (i < count) {
+            const size_t skipped = phase < count - i ? phase : count - i;
+            dh_filter_push_inputs(filter, input + i, skipped);
+            i += skipped;
+            phase -= skipped;
+            if (i < count) {
+                dh_filter_run(filter, input + i, output + written, 1);
+                filter->current_value = output[written];
+                ++written;
+                ++i;
+                phase = factor - 1;
+            }
+        }
+    } else {
+        // recursive filters need every output for the feedback, so the outputs are computed in chunks on the stack
+        double chunk[DH_FILTER_STRIDED_CHUNK_LENGTH];
+        for (size_t start=0; start<count; start+=DH_FILTER_STRIDED_CHUNK_LENGTH) {
+            const size_t length = count - start < DH_FILTER_STRIDED_CHUNK_LENGTH ? count - start : DH_FILTER_STRIDED_CHUNK_LENGTH;
+            dh_filter_block(filter, input + start, chunk, length);
+            size_t i = phase;
+            for (; i<length; i+=factor) {
+                output[written++] = chunk[i];
+            }
+            phase = i - length;
+        }
+    }
+    filter->decimation_phase = phase;
+    if (output_count) {
+        *output_count = written;
+    }
+    return DH_FILTER_OK;
 }
 
-static double dh_filter_run_filter_loop(double* coefficients, size_t num_coeffs, double* data, size_t current_idx , size_t start)
+/**
+ * @brief Writes [count] values to the input history of a FIR filter in direct form 1 without computing the outputs.
+ */
+static void dh_filter_push_inputs(dh_filter_data* filter, const double* input, size_t count)
 {
-    double out = 0.0;
-    size_t split_loops = num_coeffs - current_idx;
-    for(size_t i=start; i< split_loops; ++i) {
-        size_t idx = current_idx + i;
-        out += coefficients[i] * data[idx];
+    double* inputs = filter->inputs;
+    const size_t number_coefficients_in = filter->number_coefficients_in;
+    const bool mirrored = filter->realization == DH_REALIZATION_DIRECT_FORM_1_MIRRORED;
+    size_t input_index = filter->current_input_index;
+    for (size_t i=0; i<count; ++i) {
+        input_index = input_index > 0 ? input_index - 1 : number_coefficients_in - 1U;
+        inputs[input_index] = input[i];
+        if (mirrored) {
+            inputs[input_index + number_coefficients_in] = input[i];
+        }
     }
-    for(size_t i=split_loops; i <  num_coeffs; ++i) {
-        size_t idx = i-split_loops;
-        out += coefficients[i] * data[idx];
+    filter->current_input_index = input_index;
+}
+
+/**
+ * @brief Filters [data] in place from the last to the first value. Reversed chunks are copied to the stack, so that the block kernels can be used.
+ */
+static void dh_filter_block_reversed(dh_filter_data* filter, double* data, size_t count)
+{
+    double chunk[DH_FILTER_STRIDED_CHUNK_LENGTH];
+    for (size_t end=count; end>0; ) {
+        const size_t length = end < DH_FILTER_STRIDED_CHUNK_LENGTH ? end : DH_FILTER_STRIDED_CHUNK_LENGTH;
+        for (size_t i=0; i<length; ++i) {
+            chunk[i] = data[end - 1 - i];
+        }
+        dh_filter_block(filter, chunk, chunk, length);
+        for (size_t i=0; i<length; ++i) {
+            data[end - 1 - i] = chunk[i];
+        }
+        end -= length;
     }
-    return out;
 }
 
-static void dh_filter_run_input_loop(dh_filter_data* filter)
+/**
+ * @brief Checks if all buffers that are accessed during a filter cycle are set.
+ */
+static DH_FILTER_RETURN_VALUE dh_filter_check_buffers(const dh_filter_data* filter)
 {
-    filter->current_value = dh_filter_run_filter_loop(filter->coefficients_in, filter->number_coefficients_in, filter->inputs, filter->current_input_index, 0);
+    if (filter->realization == DH_REALIZATION_SECOND_ORDER_SECTIONS) {
+        if (filter->number_sections == 0 || filter->sections == NULL || filter->state == NULL || filter->state_length < 2*filter->number_sections
+            || filter->number_coefficients_out == 0 || filter->coefficients_out == NULL) {
+            return DH_FILTER_DATA_STRUCTURE_NOT_INITIALIZED;
+        }
+        return DH_FILTER_OK;
+    }
+    if (filter->realization == DH_REALIZATION_TRANSPOSED_DIRECT_FORM_2) {
+        if (filter->number_coefficients_in == 0 || filter->coefficients_in == NULL || filter->number_coefficients_out == 0 || filter->coefficients_out == NULL
+            || filter->state_length < dh_filter_transposed_state_length(filter) || (filter->state == NULL && filter->state_length > 0)) {
+            return DH_FILTER_DATA_STRUCTURE_NOT_INITIALIZED;
+        }
+        return DH_FILTER_OK;
+    }
+    if (filter->number_coefficients_in == 0 || filter->inputs == NULL || filter->coefficients_in == NULL) {
+        return DH_FILTER_DATA_STRUCTURE_NOT_INITIALIZED;
+    }
+    if ((filter->realization == DH_REALIZATION_RUNNING_SUM || filter->realization == DH_REALIZATION_RECURSIVE_EXPONENTIAL)
+        && (filter->number_coefficients_out == 0 || filter->coefficients_out == NULL)) {
+        return DH_FILTER_DATA_STRUCTURE_NOT_INITIALIZED;
+    }
+    if (filter->number_coefficients_out > 1 && (filter->outputs == NULL || filter->coefficients_out == NULL)) {
+        return DH_FILTER_DATA_STRUCTURE_NOT_INITIALIZED;
+    }
+    return DH_FILTER_OK;
 }
 
-static void dh_filter_run_output_loop(dh_filter_data* filter)
+/**
+ * @brief Runs the filter for all values in [input]. If denormals are flushed, the values are filtered in chunks
+ * of dh_filter_data::denormal_check_interval values and the state is checked after each chunk.
+ */
+static void dh_filter_run(dh_filter_data* filter, const double* input, double* output, size_t count)
 {
-    filter->current_value -= dh_filter_run_filter_loop(filter->coefficients_out, filter->number_coefficients_out, filter->outputs, filter->current_output_index, 1);
+    if (!filter->flush_denormals) {
+        dh_filter_run_kernel(filter, input, output, count);
+        return;
+    }
+    const size_t interval = filter->denormal_check_interval > 0 ? filter->denormal_check_interval : 1;
+    for (size_t start=0; start<count; start+=interval) {
+        const size_t length = count - start < interval ? count - start : interval;
+        dh_filter_run_kernel(filter, input + start, output + start, length);
+        dh_filter_flush_denormals(filter, length);
+    }
 }
 
-static void dh_filter_shift_output(dh_filter_data* filter)
+/**
+ * @brief Sets [value] to zero if its magnitude is below DH_FILTER_DENORMAL_THRESHOLD.
+ */
+static inline void dh_filter_flush_value(double* value)
 {
-    if (filter->current_output_index>0) {
-        filter->current_output_index -= 1;
+    if (fabs(*value) < DH_FILTER_DENORMAL_THRESHOLD) {
+        *value = 0.0;
     }
-    else {
-        filter->current_output_index = filter->number_coefficients_out - 1U;
+}
+
+/**
+ * @brief Sets the past outputs or state variables of recursive filters with a magnitude below DH_FILTER_DENORMAL_THRESHOLD to zero.
+ * 
+ * The direct form 1 only checks the [count] newest outputs, because the older ones were checked by the previous call.
+ */
+static void dh_filter_flush_denormals(dh_filter_data* filter, size_t count)
+{
+    switch(filter->realization) {
+        case DH_REALIZATION_SECOND_ORDER_SECTIONS: // falltrough
+        case DH_REALIZATION_TRANSPOSED_DIRECT_FORM_2:
+            for (size_t k=0; k<filter->state_length; ++k) {
+                dh_filter_flush_value(&filter->state[k]);
+            }
+            break;
+        case DH_REALIZATION_RUNNING_SUM: // falltrough
+        case DH_REALIZATION_RECURSIVE_EXPONENTIAL:
+            // the accumulators hold the sum of a finite window and do not decay
+            break;
+        default: {
+            const size_t number_coefficients_out = filter->number_coefficients_out;
+            if (number_coefficients_out <= 1) {
+                break;
+            }
+            const bool mirrored = filter->realization == DH_REALIZATION_DIRECT_FORM_1_MIRRORED;
+            size_t index = filter->current_output_index;
+            for (size_t k=0; k<count && k<number_coefficients_out; ++k) {
+                dh_filter_flush_value(&filter->outputs[index]);
+                if (mirrored) {
+                    dh_filter_flush_value(&filter->outputs[index + number_coefficients_out]);
+                }
+                index = index + 1 < number_coefficients_out ? index + 1 : 0;
+            }
+            break;
+        }
     }
 }
 
-static void dh_filter_add_output(dh_filter_data* filter)
+/**
+ * @brief Runs the filter for all values in [input] with the kernel for the realization of the filter.
+ */
+static void dh_filter_run_kernel(dh_filter_data* filter, const double* input, double* output, size_t count)
 {
-    filter->outputs[filter->current_output_index] = filter->current_value;
+    if (filter->kernel) {
+        filter->kernel(filter, input, output, count);
+        return;
+    }
+    switch(filter->realization) {
+        case DH_REALIZATION_DIRECT_FORM_1_MIRRORED:
+            dh_filter_run_block_mirrored(filter, input, output, count);
+            break;
+        case DH_REALIZATION_SECOND_ORDER_SECTIONS:
+            dh_filter_run_block_sections(filter, input, output, count);
+            break;
+        case DH_REALIZATION_TRANSPOSED_DIRECT_FORM_2:
+            dh_filter_run_block_transposed(filter, input, output, count);
+            break;
+        case DH_REALIZATION_RUNNING_SUM:
+            dh_filter_run_block_running_sum(filter, input, output, count);
+            break;
+        case DH_REALIZATION_RECURSIVE_EXPONENTIAL:
+            dh_filter_run_block_recursive_exponential(filter, input, output, count);
+            break;
+        default:
+            dh_filter_run_block(filter, input, output, count);
+            break;
+    }
 }
 
+/**
+ * @brief Runs the filter for all values in [input] and writes the results to [output].
+ * 
+ * The buffers of the filter must have been checked before. The ring buffer indices are kept in local
+ * variables for the whole block and written back at the end. [input] and [output] may be the same array.
+ * The order of all arithmetic operations is the same for every block size, so filtering a signal in blocks
+ * gives exactly the same results as filtering it value by value.
+ */
+static void dh_filter_run_block(dh_filter_data* filter, const double* input, double* output, size_t count)
+{
+    const double* coefficients_in = filter->coefficients_in;
+    const double* coefficients_out = filter->coefficients_out;
+    double* inputs = filter->inputs;
+    double* outputs = filter->outputs;
+    const size_t number_coefficients_in = filter->number_coefficients_in;
+    const size_t number_coefficients_out = filter->number_coefficients_out;
+    const dh_dot_product_function dot_product = filter->dot_product;
+    size_t input_index = filter->current_input_index;
+    size_t output_index = filter->current_output_index;
+
+    for (size_t i=0; i<count; ++i) {
+        input_index = input_index > 0 ? input_index - 1 : number_coefficients_in - 1U;
+        inputs[input_index] = input[i];
+        double value = dot_product ? dh_filter_run_dot_product(dot_product, coefficients_in, number_coefficients_in, inputs, input_index)
+                                   : dh_filter_run_filter_loop(coefficients_in, number_coefficients_in, inputs, input_index, 0);
 
-static void dh_filter_apply_gain(dh_filter_data* filter)
+        if (number_coefficients_out > 1) {
+            output_index = output_index > 0 ? output_index - 1 : number_coefficients_out - 1U;
+            value -= dh_filter_run_filter_loop(coefficients_out, number_coefficients_out, outputs, output_index, 1);
+            outputs[output_index] = value;
+        }
+        if (number_coefficients_out >= 1) {
+            value *= coefficients_out[0];
+        }
+        output[i] = value;
+    }
+
+    filter->current_input_index = input_index;
+    filter->current_output_index = output_index;
+}
+
+/**
+ * @brief Same as dh_filter_run_block(), but for filters with mirrored buffers.
+ * 
+ * Every value is written at position index and index + number of coefficients. As a result, the
+ * values starting at the current index are always stored in a contiguous range and the loops do not
+ * have to be split. The summation order is the same as in dh_filter_run_block(), so the results are identical.
+ */
+static void dh_filter_run_block_mirrored(dh_filter_data* filter, const double* input, double* output, size_t count)
 {
-    filter->current_value *= filter->coefficients_out[0];
+    const double* coefficients_in = filter->coefficients_in;
+    const double* coefficients_out = filter->coefficients_out;
+    double* inputs = filter->inputs;
+    double* outputs = filter->outputs;
+    const size_t number_coefficients_in = filter->number_coefficients_in;
+    const size_t number_coefficients_out = filter->number_coefficients_out;
+    const dh_dot_product_function dot_product = filter->dot_product;
+    size_t input_index = filter->current_input_index;
+    size_t output_index = filter->current_output_index;
+
+    for (size_t i=0; i<count; ++i) {
+        input_index = input_index > 0 ? input_index - 1 : number_coefficients_in - 1U;
+        inputs[input_index] = input[i];
+        inputs[input_index + number_coefficients_in] = input[i];
+        double value = dot_product ? dot_product(coefficients_in, inputs + input_index, number_coefficients_in)
+                                   : dh_filter_run_linear_loop(coefficients_in, number_coefficients_in, inputs + input_index, 0);
+
+        if (number_coefficients_out > 1) {
+            output_index = output_index > 0 ? output_index - 1 : number_coefficients_out - 1U;
+            value -= dh_filter_run_linear_loop(coefficients_out, number_coefficients_out, outputs + output_index, 1);
+            outputs[output_index] = value;
+            outputs[output_index + number_coefficients_out] = value;
+        }
+        if (number_coefficients_out >= 1) {
+            value *= coefficients_out[0];
+        }
+        output[i] = value;
+    }
+
+    filter->current_input_index = input_index;
+    filter->current_output_index = output_index;
 }
 
+/**
+ * @brief Runs a FIR filter in direct form 1. The conditions are constant in every caller, so the compiler removes them.
+ * 
+ * Without [vectorized], the plain loops are used instead of the dot product. The summation order is the same as in
+ * dh_filter_run_block() and dh_filter_run_block_mirrored().
+ */
+static inline void dh_filter_run_block_fir_generic(dh_filter_data* filter, const double* input, double* output, size_t count,
+    const bool mirrored, const bool vectorized, const bool apply_gain)
+{
+    const double* coefficients_in = filter->coefficients_in;
+    double* inputs = filter->inputs;
+    const size_t number_coefficients_in = filter->number_coefficients_in;
+    const dh_dot_product_function dot_product = filter->dot_product;
+    const double gain = apply_gain ? filter->coefficients_out[0] : 1.0;
+    size_t input_index = filter->current_input_index;
+
+    for (size_t i=0; i<count; ++i) {
+        input_index = input_index > 0 ? input_index - 1 : number_coefficients_in - 1U;
+        inputs[input_index] = input[i];
+        double value;
+        if (mirrored) {
+            inputs[input_index + number_coefficients_in] = input[i];
+            value = vectorized ? dot_product(coefficients_in, inputs + input_index, number_coefficients_in)
+                               : dh_filter_run_linear_loop(coefficients_in, number_coefficients_in, inputs + input_index, 0);
+        } else {
+            value = vectorized ? dh_filter_run_dot_product(dot_product, coefficients_in, number_coefficients_in, inputs, input_index)
+                               : dh_filter_run_filter_loop(coefficients_in, number_coefficients_in, inputs, input_index, 0);
+        }
+        output[i] = apply_gain ? value * gain : value;
+    }
+
+    filter->current_input_index = input_index;
+}
+
+/** Defines the kernel for FIR filters in direct form 1 with the given buffer layout, summation and gain. */
+#define DH_FILTER_DEFINE_FIR_KERNEL(name, mirrored, vectorized, apply_gain) \
+    static void dh_filter_run_block_##name(dh_filter_data* filter, const double* input, double* output, size_t count) \
+    { \
+        dh_filter_run_block_fir_generic(filter, input, output, count, (mirrored), (vectorized), (apply_gain)); \
+    }
+
+DH_FILTER_DEFINE_FIR_KERNEL(fir, false, true, true)
+DH_FILTER_DEFINE_FIR_KERNEL(fir_unity_gain, false, true, false)
+DH_FILTER_DEFINE_FIR_KERNEL(fir_scalar, false, false, true)
+DH_FILTER_DEFINE_FIR_KERNEL(fir_scalar_unity_gain, false, false, false)
+DH_FILTER_DEFINE_FIR_KERNEL(fir_mirrored, true, true, true)
+DH_FILTER_DEFINE_FIR_KERNEL(fir_mirrored_unity_gain, true, true, false)
+DH_FILTER_DEFINE_FIR_KERNEL(fir_mirrored_scalar, true, false, true)
+DH_FILTER_DEFINE_FIR_KERNEL(fir_mirrored_scalar_unity_gain, true, false, false)
+
+/**
+ * @brief Selects the kernel for a FIR filter in direct form 1.
+ */
+static dh_filter_kernel_function dh_select_fir_kernel(const dh_filter_data* filter, const bool mirrored)
+{
+    const bool unity_gain = filter->number_coefficients_out == 0 || filter->coefficients_out[0] == 1.0;
+    if (mirrored) {
+        if (filter->dot_product) {
+            return unity_gain ? dh_filter_run_block_fir_mirrored_unity_gain : dh_filter_run_block_fir_mirrored;
+        }
+        return unity_gain ? dh_filter_run_block_fir_mirrored_scalar_unity_gain : dh_filter_run_block_fir_mirrored_scalar;
+    }
+    if (filter->dot_product) {
+        return unity_gain ? dh_filter_run_block_fir_unity_gain : dh_filter_run_block_fir;
+    }
+    return unity_gain ? dh_filter_run_block_fir_scalar_unity_gain : dh_filter_run_block_fir_scalar;
+}
+
+/**
+ * @brief Runs an IIR filter with one feedforward and two feedback coefficients in direct form 1.
+ * 
+ * The last output is kept in a register. The circular output buffer with two values is still updated,
+ * so that the state is the same as after dh_filter_run_block().
+ */
+static void dh_filter_run_block_one_pole(dh_filter_data* filter, const double* input, double* output, size_t count)
+{
+    const double b0 = filter->coefficients_in[0];
+    const double a1 = filter->coefficients_out[1];
+    const double gain = filter->coefficients_out[0];
+    double* outputs = filter->outputs;
+    size_t output_index = filter->current_output_index;
+    double last = outputs[output_index];
+    double previous = last;
+
+    for (size_t i=0; i<count; ++i) {
+        previous = last;
+        last = b0 * input[i] - a1 * last;
+        output[i] = last * gain;
+    }
+    if (count > 0) {
+        // the index toggles with every value
+        output_index = count % 2 == 1 ? 1 - output_index : output_index;
+        filter->inputs[0] = input[count - 1];
+        outputs[output_index] = last;
+        outputs[1 - output_index] = previous;
+        filter->current_output_index = output_index;
+    }
+}
+
+/**
+ * @brief Runs an IIR filter in direct form 1 with [n] feedforward and [n] feedback coefficients.
+ * 
+ * [n] is a constant in every caller, so the loops over the coefficients are fully unrolled. The summation order is the
+ * same as in dh_filter_run_block().
+ */
+static inline void dh_filter_run_block_unrolled(dh_filter_data* filter, const double* input, double* output, size_t count, const size_t n)
+{
+    const double* coefficients_in = filter->coefficients_in;
+    const double* coefficients_out = filter->coefficients_out;
+    double* inputs = filter->inputs;
+    double* outputs = filter->outputs;
+    const double gain = coefficients_out[0];
+    size_t input_index = filter->current_input_index;
+    size_t output_index = filter->current_output_index;
+
+    for (size_t i=0; i<count; ++i) {
+        input_index = input_index > 0 ? input_index - 1 : n - 1U;
+        inputs[input_index] = input[i];
+        double value = 0.0;
+        for (size_t k=0; k<n; ++k) {
+            const size_t index = input_index + k < n ? input_index + k : input_index + k - n;
+            value += coefficients_in[k] * inputs[index];
+        }
+        output_index = output_index > 0 ? output_index - 1 : n - 1U;
+        double feedback = 0.0;
+        for (size_t k=1; k<n; ++k) {
+            const size_t index = output_index + k < n ? output_index + k : output_index + k - n;
+            feedback += coefficients_out[k] * outputs[index];
+        }
+        value -= feedback;
+        outputs[output_index] = value;
+        output[i] = value * gain;
+    }
+
+    filter->current_input_index = input_index;
+    filter->current_output_index = output_index;
+}
+
+/** Defines the fully unrolled kernel for IIR filters in direct form 1 with the given order. */
+#define DH_FILTER_DEFINE_UNROLLED_KERNEL(order) \
+    static void dh_filter_run_block_order_##order(dh_filter_data* filter, const double* input, double* output, size_t count) \
+    { \
+        dh_filter_run_block_unrolled(filter, input, output, count, (order) + 1); \
+    }
+
+DH_FILTER_DEFINE_UNROLLED_KERNEL(1)
+DH_FILTER_DEFINE_UNROLLED_KERNEL(2)
+DH_FILTER_DEFINE_UNROLLED_KERNEL(3)
+DH_FILTER_DEFINE_UNROLLED_KERNEL(4)
+DH_FILTER_DEFINE_UNROLLED_KERNEL(5)
+DH_FILTER_DEFINE_UNROLLED_KERNEL(6)
+DH_FILTER_DEFINE_UNROLLED_KERNEL(7)
+DH_FILTER_DEFINE_UNROLLED_KERNEL(8)
+
+/** The unrolled kernels. Index is the order of the filter. */
+static const dh_filter_kernel_function dh_filter_unrolled_kernels[DH_FILTER_UNROLLED_MAX_ORDER + 1] = {
+    NULL,
+    dh_filter_run_block_order_1,
+    dh_filter_run_block_order_2,
+    dh_filter_run_block_order_3,
+    dh_filter_run_block_order_4,
+    dh_filter_run_block_order_5,
+    dh_filter_run_block_order_6,
+    dh_filter_run_block_order_7,
+    dh_filter_run_block_order_8
+};
+
+dh_filter_kernel_function dh_select_filter_kernel(const dh_filter_data* filter)
+{
+    if (!filter || dh_filter_check_buffers(filter) != DH_FILTER_OK) {
+        return NULL;
+    }
+    const size_t number_coefficients_in = filter->number_coefficients_in;
+    const size_t number_coefficients_out = filter->number_coefficients_out;
+    switch(filter->realization) {
+        case DH_REALIZATION_SECOND_ORDER_SECTIONS:
+            return dh_filter_run_block_sections;
+        case DH_REALIZATION_TRANSPOSED_DIRECT_FORM_2:
+            return dh_filter_run_block_transposed;
+        case DH_REALIZATION_RUNNING_SUM:
+            return dh_filter_run_block_running_sum;
+        case DH_REALIZATION_RECURSIVE_EXPONENTIAL:
+            return dh_filter_run_block_recursive_exponential;
+        case DH_REALIZATION_DIRECT_FORM_1_MIRRORED:
+            if (number_coefficients_out <= 1) {
+                return dh_select_fir_kernel(filter, true);
+            }
+            return dh_filter_run_block_mirrored;
+        default:
+            if (number_coefficients_out <= 1) {
+                return dh_select_fir_kernel(filter, false);
+            }
+            if (number_coefficients_in == 1 && number_coefficients_out == 2) {
+                return dh_filter_run_block_one_pole;
+            }
+            if (number_coefficients_in == number_coefficients_out && number_coefficients_in >= 2 && number_coefficients_in <= DH_FILTER_UNROLLED_MAX_ORDER + 1) {
+                return dh_filter_unrolled_kernels[number_coefficients_in - 1];
+            }
+            return dh_filter_run_block;
+    }
+}
+
+/**
+ * @brief Runs a cascade of second order sections in transposed direct form 2.
+ * 
+ * Every section has two state variables. The output of a section is the input of the next one.
+ * The gain in coefficients_out[0] is applied to the output of the last section.
+ */
+static void dh_filter_run_block_sections(dh_filter_data* filter, const double* input, double* output, size_t count)
+{
+    const double* sections = filter->sections;
+    double* state = filter->state;
+    const size_t number_sections = filter->number_sections;
+    const double gain = filter->coefficients_out[0];
+
+    for (size_t i=0; i<count; ++i) {
+        double value = input[i];
+        for (size_t k=0; k<number_sections; ++k) {
+            const double* c = sections + 5*k;
+            double* s = state + 2*k;
+            const double y = c[0] * value + s[0];
+            s[0] = c[1] * value - c[3] * y + s[1];
+            s[1] = c[2] * value - c[4] * y;
+            value = y;
+        }
+        output[i] = value * gain;
+    }
+}
+
+/**
+ * @brief Runs a moving average with a running sum.
+ * 
+ * The moving averages have the coefficients c0 for the current input and c for all past inputs,
+ * so the output is (c0-c)*input + c*sum. The sum is updated with the new input and the input that leaves the window.
+ * A second sum starts at zero whenever the circular buffer wraps around. After one window it contains all inputs
+ * and replaces the running sum, so the rounding errors are bounded by the errors of one window.
+ */
+static void dh_filter_run_block_running_sum(dh_filter_data* filter, const double* input, double* output, size_t count)
+{
+    const size_t number_coefficients_in = filter->number_coefficients_in;
+    const double coefficient_sum = filter->coefficients_in[number_coefficients_in - 1];
+    const double coefficient_input = filter->coefficients_in[0] - coefficient_sum;
+    const double gain = filter->coefficients_out[0];
+    double* inputs = filter->inputs;
+    size_t input_index = filter->current_input_index;
+    double sum = filter->accumulator;
+    double partial = filter->accumulator_partial;
+
+    for (size_t i=0; i<count; ++i) {
+        const double x = input[i];
+        input_index = input_index > 0 ? input_index - 1 : number_coefficients_in - 1U;
+        sum += x - inputs[input_index];
+        inputs[input_index] = x;
+        partial += x;
+        if (input_index == 0) {
+            sum = partial;
+            partial = 0.0;
+        }
+        output[i] = (coefficient_input * x + coefficient_sum * sum) * gain;
+    }
+
+    filter->current_input_index = input_index;
+    filter->accumulator = sum;
+    filter->accumulator_partial = partial;
+}
+
+/**
+ * @brief Computes the factor between two consecutive coefficients of a FIR exponential moving average.
+ */
+static double dh_filter_exponential_decay(const dh_filter_data* filter)
+{
+    return filter->number_coefficients_in > 1 ? filter->coefficients_in[1] / filter->coefficients_in[0] : 0.0;
+}
+
+/**
+ * @brief Runs a FIR exponential moving average as recursion.
+ * 
+ * The coefficients are c[i] = c[0] * decay**i, so the output is decay*last_output + c[0]*input - c[N-1]*decay*leaving_input.
+ * The errors of the recursion are bounded in the same way as in dh_filter_run_block_running_sum(): a second recursion
+ * without the subtraction starts at zero whenever the circular buffer wraps around and replaces the first one after one window.
+ */
+static void dh_filter_run_block_recursive_exponential(dh_filter_data* filter, const double* input, double* output, size_t count)
+{
+    const size_t number_coefficients_in = filter->number_coefficients_in;
+    const double decay = dh_filter_exponential_decay(filter);
+    const double coefficient_input = filter->coefficients_in[0];
+    const double coefficient_leaving = filter->coefficients_in[number_coefficients_in - 1] * decay;
+    const double gain = filter->coefficients_out[0];
+    double* inputs = filter->inputs;
+    size_t input_index = filter->current_input_index;
+    double sum = filter->accumulator;
+    double partial = filter->accumulator_partial;
+
+    for (size_t i=0; i<count; ++i) {
+        const double x = input[i];
+        input_index = input_index > 0 ? input_index - 1 : number_coefficients_in - 1U;
+        sum = decay * sum + coefficient_input * x - coefficient_leaving * inputs[input_index];
+        inputs[input_index] = x;
+        partial = decay * partial + coefficient_input * x;
+        if (input_index == 0) {
+            sum = partial;
+            partial = 0.0;
+        }
+        output[i] = sum * gain;
+    }
+
+    filter->current_input_index = input_index;
+    filter->accumulator = sum;
+    filter->accumulator_partial = partial;
+}
+
+/**
+ * @brief Computes the contribution of the coefficients with index [k] to the state of the transposed direct form 2.
+ */
+static inline double dh_filter_transposed_term(const double* coefficients_in, size_t number_coefficients_in, const double* coefficients_out, size_t number_coefficients_out,
+                                               size_t k, double input, double output)
+{
+    double rv = k < number_coefficients_in ? coefficients_in[k] * input : 0.0;
+    if (k < number_coefficients_out) {
+        rv -= coefficients_out[k] * output;
+    }
+    return rv;
+}
+
+/**
+ * @brief Runs the filter in transposed direct form 2.
+ * 
+ * state[k-1] holds the sum of all terms with the coefficients k and higher that were computed with past values.
+ * As in dh_filter_run_block(), the feedback uses the values before the gain in coefficients_out[0] is applied.
+ */
+static void dh_filter_run_block_transposed(dh_filter_data* filter, const double* input, double* output, size_t count)
+{
+    const double* coefficients_in = filter->coefficients_in;
+    const double* coefficients_out = filter->coefficients_out;
+    const size_t number_coefficients_in = filter->number_coefficients_in;
+    const size_t number_coefficients_out = filter->number_coefficients_out;
+    const size_t order = dh_filter_transposed_state_length(filter);
+    double* state = filter->state;
+
+    for (size_t i=0; i<count; ++i) {
+        const double x = input[i];
+        double value = coefficients_in[0] * x;
+        if (order > 0) {
+            value += state[0];
+            for (size_t k=1; k<order; ++k) {
+                state[k-1] = dh_filter_transposed_term(coefficients_in, number_coefficients_in, coefficients_out, number_coefficients_out, k, x, value) + state[k];
+            }
+            state[order-1] = dh_filter_transposed_term(coefficients_in, number_coefficients_in, coefficients_out, number_coefficients_out, order, x, value);
+        }
+        output[i] = value * coefficients_out[0];
+    }
+}
+
+/**
+ * @brief Sets the sums of the running sum and the recursive exponential as if all past inputs were [value].
+ */
+static void dh_initialize_accumulators(dh_filter_data* filter, double value)
+{
+    // the inputs from the current index to the end of the buffer were written since the last wrap around
+    const size_t written = filter->current_input_index > 0 ? filter->number_coefficients_in - filter->current_input_index : 0;
+    if (filter->realization == DH_REALIZATION_RECURSIVE_EXPONENTIAL) {
+        double sum = 0.0;
+        double partial = 0.0;
+        for (size_t i=0; i<filter->number_coefficients_in; ++i) {
+            sum += filter->coefficients_in[i] * value;
+            if (i + 1 == written) {
+                partial = sum;
+            }
+        }
+        filter->accumulator = sum;
+        filter->accumulator_partial = partial;
+    } else {
+        filter->accumulator = (double)filter->number_coefficients_in * value;
+        filter->accumulator_partial = (double)written * value;
+    }
+}
+
+/**
+ * @brief Sets the state of the transposed direct form 2 as if all past inputs were [input] and all past outputs (before the gain) were [output].
+ * 
+ * With [input] equal to [output], this is the same state as for the direct form 1 after dh_initialize_filter().
+ */
+static void dh_initialize_transposed(dh_filter_data* filter, double input, double output)
+{
+    const size_t order = dh_filter_transposed_state_length(filter);
+    double sum = 0.0;
+    for (size_t k=order; k>0; --k) {
+        sum += dh_filter_transposed_term(filter->coefficients_in, filter->number_coefficients_in, filter->coefficients_out, filter->number_coefficients_out, k, input, output);
+        filter->state[k-1] = sum;
+    }
+}
+
+/**
+ * @brief Sets the state of the second order sections to the steady state for the constant input [value].
+ */
+static void dh_initialize_sections(dh_filter_data* filter, double value)
+{
+    for (size_t k=0; k<filter->number_sections; ++k) {
+        const double* c = filter->sections + 5*k;
+        double* s = filter->state + 2*k;
+        const double denominator = 1.0 + c[3] + c[4];
+        const double y = denominator != 0.0 ? value * (c[0] + c[1] + c[2]) / denominator : 0.0;
+        s[1] = c[2] * value - c[4] * y;
+        s[0] = c[1] * value - c[3] * y + s[1];
+        value = y;
+    }
+}
+
+/**
+ * @brief Sets the filter to the steady state for the constant input [value].
+ * 
+ * Unlike dh_initialize_filter(), the past outputs are not set to the input, but to the input multiplied with the
+ * gain at 0 Hz of the coefficients. So highpass and bandpass filters start without transient as well.
+ */
+static void dh_initialize_steady_state(dh_filter_data* filter, double value)
+{
+    if (filter->realization == DH_REALIZATION_SECOND_ORDER_SECTIONS) {
+        dh_initialize_sections(filter, value);
+    } else {
+        // the outputs before the gain are v = sum(b_k) * x - sum(a_k) * v for k >= 1
+        double numerator = 0.0;
+        for (size_t k=0; k<filter->number_coefficients_in; ++k) {
+            numerator += filter->coefficients_in[k];
+        }
+        double denominator = 1.0;
+        for (size_t k=1; k<filter->number_coefficients_out; ++k) {
+            denominator += filter->coefficients_out[k];
+        }
+        const double output = denominator != 0.0 ? value * numerator / denominator : 0.0;
+        if (filter->realization == DH_REALIZATION_TRANSPOSED_DIRECT_FORM_2) {
+            dh_initialize_transposed(filter, value, output);
+        } else {
+            const size_t history_factor = filter->realization == DH_REALIZATION_DIRECT_FORM_1_MIRRORED ? 2 : 1;
+            for (size_t i=0; i<history_factor*filter->number_coefficients_in; ++i) {
+                filter->inputs[i] = value;
+            }
+            for (size_t i=0; i<history_factor*filter->number_coefficients_out; ++i) {
+                filter->outputs[i] = output;
+            }
+            dh_initialize_accumulators(filter, value);
+        }
+    }
+    filter->initialized = true;
+}
+
+static double dh_filter_run_linear_loop(const double* coefficients, size_t num_coeffs, const double* data, size_t start)
+{
+    double out = 0.0;
+    for(size_t i=start; i< num_coeffs; ++i) {
+        out += coefficients[i] * data[i];
+    }
+    return out;
+}
+
+static double dh_filter_run_filter_loop(const double* coefficients, size_t num_coeffs, const double* data, size_t current_idx , size_t start)
+{
+    double out = 0.0;
+    size_t split_loops = num_coeffs - current_idx;
+    for(size_t i=start; i< split_loops; ++i) {
+        size_t idx = current_idx + i;
+        out += coefficients[i] * data[idx];
+    }
+    for(size_t i=split_loops; i <  num_coeffs; ++i) {
+        size_t idx = i-split_loops;
+        out += coefficients[i] * data[idx];
+    }
+    return out;
+}
+
+/**
+ * @brief Same as dh_filter_run_filter_loop() with start 0, but the two contiguous parts of the ring buffer
+ * are passed to the (vectorized) function [dot_product].
+ */
+static double dh_filter_run_dot_product(dh_dot_product_function dot_product, const double* coefficients, size_t num_coeffs, const double* data, size_t current_idx)
+{
+    size_t split_loops = num_coeffs - current_idx;
+    return dot_product(coefficients, data + current_idx, split_loops) + dot_product(coefficients + split_loops, data, current_idx);
+}
+
+DH_FILTER_RETURN_VALUE dh_initialize_filter(dh_filter_data* filter, double value)
+{
+    assert(filter);
+    if (!filter) {
+        return DH_FILTER_NO_DATA_STRUCTURE;
+    }
+    switch(filter->realization) {
+        case DH_REALIZATION_SECOND_ORDER_SECTIONS:
+            dh_initialize_sections(filter, value);
+            break;
+        case DH_REALIZATION_TRANSPOSED_DIRECT_FORM_2:
+            dh_initialize_transposed(filter, value, value);
+            break;
+        default: {
+            const size_t history_factor = filter->realization == DH_REALIZATION_DIRECT_FORM_1_MIRRORED ? 2 : 1;
+            for(size_t i=0; i< history_factor*filter->number_coefficients_in; ++i) {
+                filter->inputs[i] = value;
+            }
+            for(size_t i=0; i< history_factor*filter->number_coefficients_out; ++i) {
+                filter->outputs[i] = value;
+            }
+            dh_initialize_accumulators(filter, value);
+            break;
+        }
+    }
+    filter->current_value = value;
+    filter->initialized = true;
+    return DH_FILTER_OK;
+}
 
 DH_FILTER_RETURN_VALUE dh_filter_set_gain(dh_filter_data* filter, double gain)
 {
@@ -142,6 +1062,9 @@ DH_FILTER_RETURN_VALUE dh_filter_set_gain(dh_filter_data* filter, double gain)
     }
     filter->current_value *= gain/filter->coefficients_out[0];
     filter->coefficients_out[0] = gain;
+    if (filter->kernel) {
+        filter->kernel = dh_select_filter_kernel(filter);
+    }
     return DH_FILTER_OK;
 }
 
@@ -168,7 +1091,12 @@ DH_FILTER_RETURN_VALUE dh_filter_get_gain_at(const dh_filter_data* filter, doubl
         return DH_FILTER_DATA_STRUCTURE_NOT_INITIALIZED;
     }
     gain->frequency = frequency;
-    COMPLEX complex_gain = dh_gain_at(filter->coefficients_in,filter->number_coefficients_in,filter->coefficients_out,filter->number_coefficients_out, gain->frequency);
+    COMPLEX complex_gain;
+    if (filter->realization == DH_REALIZATION_SECOND_ORDER_SECTIONS && filter->sections != NULL) {
+        complex_gain = COMPLEX_MUL(dh_gain_at_sections(filter->sections, filter->number_sections, gain->frequency), MAKE_COMPLEX_NUMER(filter->coefficients_out[0], 0.0));
+    } else {
+        complex_gain = dh_gain_at(filter->coefficients_in,filter->number_coefficients_in,filter->coefficients_out,filter->number_coefficients_out, gain->frequency);
+    }
     gain->gain = cabs(complex_gain);
     gain->phase_shift = atan2(cimag(complex_gain),creal(complex_gain)) / M_PI * 180.0;
     return DH_FILTER_OK;
@@ -0,0 +1,116 @@
+#include "dh/filter_arena.h"
+#include "dh/filter.h"
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+/**
+ * @file
+ * @brief This file contains the arena for many filters.
+ *
+ * The arena is a bump allocator: a filter is created with dh_create_filter_in_buffer() at the first aligned
+ * position behind the used memory. Afterwards only the arrays of the filter count as used, so the scratch memory
+ * of the design is reused by the next filter.
+ *
+ * This source code is licensed under the MIT license. See file "LICENSE" at the root of the repository.
+ */
+
+/**
+ * @brief Rounds [length] up to a multiple of DH_FILTER_ARENA_ALIGNMENT.
+ */
+static size_t dh_filter_arena_align(size_t length)
+{
+    return (length + DH_FILTER_ARENA_ALIGNMENT - 1) / DH_FILTER_ARENA_ALIGNMENT * DH_FILTER_ARENA_ALIGNMENT;
+}
+
+DH_FILTER_RETURN_VALUE dh_create_filter_arena(dh_filter_arena* arena, size_t buffer_length)
+{
+    assert(arena != NULL);
+    if (arena == NULL) {
+        return DH_FILTER_NO_DATA_STRUCTURE;
+    }
+    // malloc only guarantees the alignment of the fundamental types, so the start of the slab is moved to the next cache line
+    arena->memory = (char*)malloc(buffer_length + DH_FILTER_ARENA_ALIGNMENT);
+    if (arena->memory == NULL) {
+        arena->buffer = NULL;
+        arena->buffer_length = 0;
+        arena->used = 0;
+        arena->number_filters = 0;
+        return DH_FILTER_ALLOCATION_FAILED;
+    }
+    const size_t misalignment = (size_t)((uintptr_t)arena->memory % DH_FILTER_ARENA_ALIGNMENT);
+    arena->buffer = arena->memory + (DH_FILTER_ARENA_ALIGNMENT - misalignment);
+    arena->buffer_length = buffer_length;
+    arena->used = 0;
+    arena->number_filters = 0;
+    return DH_FILTER_OK;
+}
+
+DH_FILTER_RETURN_VALUE dh_filter_arena_required_size(const dh_filter_parameters* options, size_t number_filters, size_t* size)
+{
+    if (options == NULL || size == NULL) {
+        return DH_FILTER_NO_DATA_STRUCTURE;
+    }
+    size_t required = 0;
+    DH_FILTER_RETURN_VALUE rv = dh_filter_required_size(options, &required, NULL);
+    if (rv != DH_FILTER_OK) {
+        return rv;
+    }
+    // only the last filter needs the scratch memory behind its arrays
+    const size_t filter_length = required - dh_filter_retune_workspace_size(options);
+    *size = number_filters > 0 ? (number_filters - 1) * dh_filter_arena_align(filter_length) + required : 0;
+    return DH_FILTER_OK;
+}
+
+DH_FILTER_RETURN_VALUE dh_filter_arena_create_filter(dh_filter_arena* arena, dh_filter_data* filter, dh_filter_parameters* options)
+{
+    assert(arena != NULL);
+    assert(filter != NULL);
+    assert(options != NULL);
+    if (arena == NULL || filter == NULL || options == NULL) {
+        return DH_FILTER_NO_DATA_STRUCTURE;
+    }
+    if (arena->buffer == NULL) {
+        return DH_FILTER_DATA_STRUCTURE_NOT_INITIALIZED;
+    }
+    size_t required = 0;
+    DH_FILTER_RETURN_VALUE rv = dh_filter_required_size(options, &required, NULL);
+    if (rv != DH_FILTER_OK) {
+        return rv;
+    }
+    const size_t offset = dh_filter_arena_align(arena->used);
+    if (offset > arena->buffer_length || arena->buffer_length - offset < required) {
+        return DH_FILTER_ALLOCATION_FAILED;
+    }
+    rv = dh_create_filter_in_buffer(filter, options, arena->buffer + offset, arena->buffer_length - offset);
+    if (rv != DH_FILTER_OK) {
+        return rv;
+    }
+    arena->used = offset + filter->buffer_length;
+    arena->number_filters += 1;
+    return DH_FILTER_OK;
+}
+
+DH_FILTER_RETURN_VALUE dh_reset_filter_arena(dh_filter_arena* arena)
+{
+    assert(arena != NULL);
+    if (arena == NULL) {
+        return DH_FILTER_NO_DATA_STRUCTURE;
+    }
+    arena->used = 0;
+    arena->number_filters = 0;
+    return DH_FILTER_OK;
+}
+
+DH_FILTER_RETURN_VALUE dh_free_filter_arena(dh_filter_arena* arena)
+{
+    if (arena != NULL) {
+        free(arena->memory);
+        arena->memory = NULL;
+        arena->buffer = NULL;
+        arena->buffer_length = 0;
+        arena->used = 0;
+        arena->number_filters = 0;
+    }
+    return DH_FILTER_OK;
+}
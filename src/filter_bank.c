@@ -0,0 +1,324 @@
+#include "dh/filter_bank.h"
+#include "dh/filter.h"
+#include "dh/utility.h"
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @file
+ * @brief This file contains the filter bank for many channels.
+ *
+ * All channels advance by one value at the same time, so they share the index of the circular buffer.
+ * The kernels loop over the taps or sections in the outer loop and over the channels in the inner loop.
+ * The inner loops access contiguous memory and have no dependencies between iterations, so they are vectorized.
+ *
+ * This source code is licensed under the MIT license. See file "LICENSE" at the root of the repository.
+ */
+
+/** Number of values in a tile that dh_filter_bank_block() transposes on the stack. 4096 doubles fill 32 KiB. */
+#define DH_FILTER_BANK_TILE_LENGTH 4096
+/** Minimum number of values per channel in a tile of dh_filter_bank_block(). 8 doubles fill a cache line. */
+#define DH_FILTER_BANK_MIN_TILE_FRAMES 8
+
+static void dh_filter_bank_run(dh_filter_bank* bank, const double* input, double* output);
+
+DH_FILTER_RETURN_VALUE dh_create_filter_bank(dh_filter_bank* bank, dh_filter_parameters* options, size_t number_channels)
+{
+    assert(bank != NULL);
+    assert(options != NULL);
+    if (bank == NULL || options == NULL) {
+        return DH_FILTER_NO_DATA_STRUCTURE;
+    }
+    if (number_channels == 0) {
+        return DH_FILTER_ERROR;
+    }
+    dh_filter_parameters design = *options;
+    const bool fir = dh_filter_type_is_fir(options->filter_type);
+    if (fir) {
+        if (options->realization != DH_REALIZATION_DEFAULT && options->realization != DH_REALIZATION_DIRECT_FORM_1 &&
+            options->realization != DH_REALIZATION_DIRECT_FORM_1_MIRRORED) {
+            return DH_FILTER_UNSUPPORTED_REALIZATION;
+        }
+        design.realization = DH_REALIZATION_DIRECT_FORM_1;
+    } else {
+        if (options->realization != DH_REALIZATION_DEFAULT && options->realization != DH_REALIZATION_SECOND_ORDER_SECTIONS) {
+            return DH_FILTER_UNSUPPORTED_REALIZATION;
+        }
+        design.realization = DH_REALIZATION_SECOND_ORDER_SECTIONS;
+    }
+
+    dh_filter_data source;
+    DH_FILTER_RETURN_VALUE rv = dh_create_filter(&source, &design);
+    if (rv != DH_FILTER_OK) {
+        return rv;
+    }
+    const size_t number_coefficients_in = fir ? source.number_coefficients_in : 0;
+    const size_t number_sections = fir ? 0 : source.number_sections;
+    const size_t number_doubles = number_coefficients_in * (1 + number_channels) + number_sections * (5 + 2 * number_channels) + number_channels;
+    bank->buffer_length = number_doubles * sizeof(double);
+    bank->buffer = (char*)malloc(bank->buffer_length);
+    if (bank->buffer == NULL) {
+        bank->buffer_length = 0;
+        dh_free_filter(&source);
+        return DH_FILTER_ALLOCATION_FAILED;
+    }
+    double* data = (double*)bank->buffer;
+    bank->gain = source.coefficients_out[0];
+    bank->number_channels = number_channels;
+    bank->number_coefficients_in = number_coefficients_in;
+    bank->number_sections = number_sections;
+    bank->current_input_index = 0;
+    bank->work = data;
+    data += number_channels;
+    if (fir) {
+        bank->realization = DH_REALIZATION_DIRECT_FORM_1;
+        bank->coefficients_in = data;
+        bank->inputs = data + number_coefficients_in;
+        bank->sections = NULL;
+        bank->state = NULL;
+        memcpy(bank->coefficients_in, source.coefficients_in, number_coefficients_in * sizeof(double));
+        memset(bank->inputs, 0, number_coefficients_in * number_channels * sizeof(double));
+    } else {
+        bank->realization = DH_REALIZATION_SECOND_ORDER_SECTIONS;
+        bank->coefficients_in = NULL;
+        bank->inputs = NULL;
+        bank->sections = data;
+        bank->state = data + 5 * number_sections;
+        memcpy(bank->sections, source.sections, 5 * number_sections * sizeof(double));
+        memset(bank->state, 0, 2 * number_sections * number_channels * sizeof(double));
+    }
+    bank->initialized = source.initialized;
+    dh_free_filter(&source);
+    return DH_FILTER_OK;
+}
+
+static DH_FILTER_RETURN_VALUE dh_filter_bank_check_buffers(const dh_filter_bank* bank)
+{
+    if (bank->work == NULL || bank->number_channels == 0) {
+        return DH_FILTER_DATA_STRUCTURE_NOT_INITIALIZED;
+    }
+    if (bank->realization == DH_REALIZATION_SECOND_ORDER_SECTIONS) {
+        return bank->sections == NULL || bank->state == NULL ? DH_FILTER_DATA_STRUCTURE_NOT_INITIALIZED : DH_FILTER_OK;
+    }
+    if (bank->inputs == NULL || bank->coefficients_in == NULL || bank->number_coefficients_in == 0) {
+        return DH_FILTER_DATA_STRUCTURE_NOT_INITIALIZED;
+    }
+    return DH_FILTER_OK;
+}
+
+DH_FILTER_RETURN_VALUE dh_filter_bank_tick(dh_filter_bank* bank, const double* input, double* output)
+{
+    assert(bank);
+    if (!bank || !input || !output) {
+        return DH_FILTER_NO_DATA_STRUCTURE;
+    }
+    DH_FILTER_RETURN_VALUE rv = dh_filter_bank_check_buffers(bank);
+    if (rv != DH_FILTER_OK) {
+        return rv;
+    }
+    if (!bank->initialized) {
+        dh_initialize_filter_bank(bank, input);
+    }
+    dh_filter_bank_run(bank, input, output);
+    return DH_FILTER_OK;
+}
+
+DH_FILTER_RETURN_VALUE dh_filter_bank_block(dh_filter_bank* bank, const double* input, double* output, size_t count)
+{
+    assert(bank);
+    if (!bank) {
+        return DH_FILTER_NO_DATA_STRUCTURE;
+    }
+    DH_FILTER_RETURN_VALUE rv = dh_filter_bank_check_buffers(bank);
+    if (rv != DH_FILTER_OK) {
+        return rv;
+    }
+    if (count == 0) {
+        return DH_FILTER_OK;
+    }
+    if (input == NULL || output == NULL) {
+        return DH_FILTER_NO_DATA_STRUCTURE;
+    }
+    // the blocks are transposed to frames in tiles of several values per channel, so that every cache line
+    // of a channel is loaded once per tile instead of once per value
+    const size_t number_channels = bank->number_channels;
+    double tile[DH_FILTER_BANK_TILE_LENGTH];
+    size_t tile_frames = DH_FILTER_BANK_TILE_LENGTH / number_channels;
+    double* frames = tile;
+    double* allocated = NULL;
+    if (tile_frames < DH_FILTER_BANK_MIN_TILE_FRAMES && count > 1) {
+        // too many channels for the stack: a tile with one cache line per channel is allocated, or the frames are
+        // gathered one at a time if that fails
+        allocated = (double*)malloc(DH_FILTER_BANK_MIN_TILE_FRAMES * number_channels * sizeof(double));
+        tile_frames = allocated != NULL ? DH_FILTER_BANK_MIN_TILE_FRAMES : 1;
+        frames = allocated != NULL ? allocated : bank->work;
+    } else if (tile_frames == 0) {
+        tile_frames = 1;
+        frames = bank->work;
+    }
+    for (size_t start=0; start<count; start+=tile_frames) {
+        const size_t length = count - start < tile_frames ? count - start : tile_frames;
+        for (size_t c=0; c<number_channels; ++c) {
+            const double* channel = input + c*count + start;
+            for (size_t i=0; i<length; ++i) {
+                frames[i*number_channels + c] = channel[i];
+            }
+        }
+        for (size_t i=0; i<length; ++i) {
+            double* frame = frames + i*number_channels;
+            if (!bank->initialized) {
+                dh_initialize_filter_bank(bank, frame);
+            }
+            dh_filter_bank_run(bank, frame, frame);
+        }
+        for (size_t c=0; c<number_channels; ++c) {
+            double* channel = output + c*count + start;
+            for (size_t i=0; i<length; ++i) {
+                channel[i] = frames[i*number_channels + c];
+            }
+        }
+    }
+    free(allocated);
+    return DH_FILTER_OK;
+}
+
+DH_FILTER_RETURN_VALUE dh_filter_bank_frames(dh_filter_bank* bank, const double* input, double* output, size_t number_frames)
+{
+    assert(bank);
+    if (!bank) {
+        return DH_FILTER_NO_DATA_STRUCTURE;
+    }
+    DH_FILTER_RETURN_VALUE rv = dh_filter_bank_check_buffers(bank);
+    if (rv != DH_FILTER_OK) {
+        return rv;
+    }
+    if (number_frames == 0) {
+        return DH_FILTER_OK;
+    }
+    if (input == NULL || output == NULL) {
+        return DH_FILTER_NO_DATA_STRUCTURE;
+    }
+    // the frames already have the layout of the kernel, so no values are copied
+    const size_t number_channels = bank->number_channels;
+    for (size_t i=0; i<number_frames; ++i) {
+        if (!bank->initialized) {
+            dh_initialize_filter_bank(bank, input + i*number_channels);
+        }
+        dh_filter_bank_run(bank, input + i*number_channels, output + i*number_channels);
+    }
+    return DH_FILTER_OK;
+}
+
+/**
+ * @brief Filters one value of every channel. [output] is used as accumulator and may be the same array as [input].
+ */
+static void dh_filter_bank_run(dh_filter_bank* bank, const double* input, double* output)
+{
+    const size_t number_channels = bank->number_channels;
+    const double gain = bank->gain;
+    if (bank->realization == DH_REALIZATION_SECOND_ORDER_SECTIONS) {
+        if (output != input) {
+            memcpy(output, input, number_channels * sizeof(double));
+        }
+        for (size_t k=0; k<bank->number_sections; ++k) {
+            const double* section = bank->sections + 5*k;
+            const double b0 = section[0];
+            const double b1 = section[1];
+            const double b2 = section[2];
+            const double a1 = section[3];
+            const double a2 = section[4];
+            double* s0 = bank->state + 2*k*number_channels;
+            double* s1 = s0 + number_channels;
+            for (size_t c=0; c<number_channels; ++c) {
+                const double x = output[c];
+                const double y = b0 * x + s0[c];
+                s0[c] = b1 * x - a1 * y + s1[c];
+                s1[c] = b2 * x - a2 * y;
+                output[c] = y;
+            }
+        }
+    } else {
+        const size_t number_coefficients_in = bank->number_coefficients_in;
+        const double* coefficients_in = bank->coefficients_in;
+        size_t input_index = bank->current_input_index;
+        input_index = input_index > 0 ? input_index - 1 : number_coefficients_in - 1U;
+        double* newest = bank->inputs + input_index*number_channels;
+        memcpy(newest, input, number_channels * sizeof(double));
+        for (size_t c=0; c<number_channels; ++c) {
+            output[c] = coefficients_in[0] * newest[c];
+        }
+        for (size_t t=1; t<number_coefficients_in; ++t) {
+            size_t row = input_index + t;
+            row = row < number_coefficients_in ? row : row - number_coefficients_in;
+            const double* x = bank->inputs + row*number_channels;
+            const double coefficient = coefficients_in[t];
+            for (size_t c=0; c<number_channels; ++c) {
+                output[c] += coefficient * x[c];
+            }
+        }
+        bank->current_input_index = input_index;
+    }
+    for (size_t c=0; c<number_channels; ++c) {
+        output[c] *= gain;
+    }
+}
+
+DH_FILTER_RETURN_VALUE dh_initialize_filter_bank(dh_filter_bank* bank, const double* values)
+{
+    assert(bank);
+    if (!bank || !values) {
+        return DH_FILTER_NO_DATA_STRUCTURE;
+    }
+    DH_FILTER_RETURN_VALUE rv = dh_filter_bank_check_buffers(bank);
+    if (rv != DH_FILTER_OK) {
+        return rv;
+    }
+    const size_t number_channels = bank->number_channels;
+    if (bank->realization == DH_REALIZATION_SECOND_ORDER_SECTIONS) {
+        // the input of section k is the constant input multiplied with the gains at 0 Hz of the sections before it
+        double input_gain = 1.0;
+        for (size_t k=0; k<bank->number_sections; ++k) {
+            const double* section = bank->sections + 5*k;
+            const double denominator = 1.0 + section[3] + section[4];
+            const double dc_gain = denominator != 0.0 ? (section[0] + section[1] + section[2]) / denominator : 0.0;
+            double* s0 = bank->state + 2*k*number_channels;
+            double* s1 = s0 + number_channels;
+            for (size_t c=0; c<number_channels; ++c) {
+                const double x = input_gain * values[c];
+                const double y = dc_gain * x;
+                s1[c] = section[2] * x - section[4] * y;
+                s0[c] = section[1] * x - section[3] * y + s1[c];
+            }
+            input_gain *= dc_gain;
+        }
+    } else {
+        for (size_t t=0; t<bank->number_coefficients_in; ++t) {
+            memcpy(bank->inputs + t*number_channels, values, number_channels * sizeof(double));
+        }
+    }
+    bank->initialized = true;
+    return DH_FILTER_OK;
+}
+
+DH_FILTER_RETURN_VALUE dh_free_filter_bank(dh_filter_bank* bank)
+{
+    if (bank != NULL) {
+        free(bank->buffer);
+        bank->buffer = NULL;
+        bank->buffer_length = 0;
+        bank->coefficients_in = NULL;
+        bank->sections = NULL;
+        bank->inputs = NULL;
+        bank->state = NULL;
+        bank->work = NULL;
+        bank->gain = 0.0;
+        bank->number_channels = 0;
+        bank->number_coefficients_in = 0;
+        bank->number_sections = 0;
+        bank->current_input_index = 0;
+        bank->initialized = false;
+        bank->realization = DH_REALIZATION_DEFAULT;
+    }
+    return DH_FILTER_OK;
+}
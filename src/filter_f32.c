@@ -0,0 +1,281 @@
+#include "dh/filter.h"
+#include "dh/dot_product.h"
+#include "dh/utility.h"
+#include <assert.h>
+#include <stdlib.h>
+
+/**
+ * @file
+ * @brief This file contains the single precision filters.
+ *
+ * The coefficients are computed with a double precision filter that is converted and freed afterwards.
+ * FIR filters have no feedback, so the rounding errors of every output are bounded by the errors of one dot product.
+ * IIR filters are only supported as second order sections, because the poles of the direct forms move
+ * too far when the coefficients are rounded to single precision.
+ *
+ * This source code is licensed under the MIT license. See file "LICENSE" at the root of the repository.
+ */
+
+static DH_FILTER_RETURN_VALUE dh_filter_check_buffers_f32(const dh_filter_data_f32* filter);
+static void dh_filter_run_f32(dh_filter_data_f32* filter, const float* input, float* output, size_t count);
+
+DH_FILTER_RETURN_VALUE dh_create_filter_f32(dh_filter_data_f32* filter, dh_filter_parameters* options)
+{
+    assert(filter != NULL);
+    assert(options != NULL);
+    if (filter == NULL || options == NULL) {
+        return DH_FILTER_NO_DATA_STRUCTURE;
+    }
+    dh_filter_parameters design = *options;
+    const bool fir = dh_filter_type_is_fir(options->filter_type);
+    if (fir) {
+        if (options->realization != DH_REALIZATION_DEFAULT && options->realization != DH_REALIZATION_DIRECT_FORM_1 &&
+            options->realization != DH_REALIZATION_DIRECT_FORM_1_MIRRORED) {
+            return DH_FILTER_UNSUPPORTED_REALIZATION;
+        }
+        design.realization = DH_REALIZATION_DIRECT_FORM_1;
+    } else {
+        if (options->realization != DH_REALIZATION_DEFAULT && options->realization != DH_REALIZATION_SECOND_ORDER_SECTIONS) {
+            return DH_FILTER_UNSUPPORTED_REALIZATION;
+        }
+        design.realization = DH_REALIZATION_SECOND_ORDER_SECTIONS;
+    }
+
+    dh_filter_data source;
+    DH_FILTER_RETURN_VALUE rv = dh_create_filter(&source, &design);
+    if (rv != DH_FILTER_OK) {
+        return rv;
+    }
+
+    const size_t number_coefficients_in = fir ? source.number_coefficients_in : 0;
+    const size_t number_sections = fir ? 0 : source.number_sections;
+    const size_t number_floats = 3 * number_coefficients_in + 7 * number_sections;
+    filter->buffer_length = (number_floats > 0 ? number_floats : 1) * sizeof(float);
+    filter->buffer = (char*)malloc(filter->buffer_length);
+    if (filter->buffer == NULL) {
+        filter->buffer_length = 0;
+        dh_free_filter(&source);
+        return DH_FILTER_ALLOCATION_FAILED;
+    }
+    float* data = (float*)filter->buffer;
+    filter->buffer_needs_cleanup = true;
+    filter->number_coefficients_in = number_coefficients_in;
+    filter->number_sections = number_sections;
+    filter->current_input_index = 0;
+    filter->current_value = 0.0f;
+    filter->gain = (float)source.coefficients_out[0];
+    const bool initialized = source.initialized;
+    if (fir) {
+        filter->realization = DH_REALIZATION_DIRECT_FORM_1_MIRRORED;
+        filter->coefficients_in = data;
+        filter->inputs = data + number_coefficients_in;
+        filter->sections = NULL;
+        filter->state = NULL;
+        for (size_t i=0; i<number_coefficients_in; ++i) {
+            filter->coefficients_in[i] = (float)source.coefficients_in[i];
+        }
+        filter->dot_product = dh_select_dot_product_function_f32(number_coefficients_in);
+    } else {
+        filter->realization = DH_REALIZATION_SECOND_ORDER_SECTIONS;
+        filter->coefficients_in = NULL;
+        filter->inputs = NULL;
+        filter->sections = data;
+        filter->state = data + 5 * number_sections;
+        for (size_t i=0; i<5*number_sections; ++i) {
+            filter->sections[i] = (float)source.sections[i];
+        }
+        filter->dot_product = NULL;
+    }
+    dh_free_filter(&source);
+    // like the double filter: start with zeros or with the steady state of the first input
+    dh_initialize_filter_f32(filter, 0.0f);
+    filter->initialized = initialized;
+    return DH_FILTER_OK;
+}
+
+DH_FILTER_RETURN_VALUE dh_filter_f32(dh_filter_data_f32* filter, float input, float* output)
+{
+    assert(filter);
+    if (!filter) {
+        return DH_FILTER_NO_DATA_STRUCTURE;
+    }
+    DH_FILTER_RETURN_VALUE rv = dh_filter_check_buffers_f32(filter);
+    if (rv != DH_FILTER_OK) {
+        return rv;
+    }
+    if (!filter->initialized) {
+        dh_initialize_filter_f32(filter, input);
+    }
+    dh_filter_run_f32(filter, &input, &filter->current_value, 1);
+    if (output) {
+        *output = filter->current_value;
+    }
+    return DH_FILTER_OK;
+}
+
+DH_FILTER_RETURN_VALUE dh_filter_block_f32(dh_filter_data_f32* filter, const float* input, float* output, size_t count)
+{
+    assert(filter);
+    if (!filter) {
+        return DH_FILTER_NO_DATA_STRUCTURE;
+    }
+    DH_FILTER_RETURN_VALUE rv = dh_filter_check_buffers_f32(filter);
+    if (rv != DH_FILTER_OK) {
+        return rv;
+    }
+    if (count == 0) {
+        return DH_FILTER_OK;
+    }
+    if (input == NULL || output == NULL) {
+        return DH_FILTER_NO_DATA_STRUCTURE;
+    }
+    if (!filter->initialized) {
+        dh_initialize_filter_f32(filter, input[0]);
+    }
+    dh_filter_run_f32(filter, input, output, count);
+    filter->current_value = output[count-1];
+    return DH_FILTER_OK;
+}
+
+DH_FILTER_RETURN_VALUE dh_filter_block_inplace_f32(dh_filter_data_f32* filter, float* data, size_t count)
+{
+    return dh_filter_block_f32(filter, data, data, count);
+}
+
+static DH_FILTER_RETURN_VALUE dh_filter_check_buffers_f32(const dh_filter_data_f32* filter)
+{
+    if (filter->realization == DH_REALIZATION_SECOND_ORDER_SECTIONS) {
+        if (filter->sections == NULL || filter->state == NULL) {
+            return DH_FILTER_DATA_STRUCTURE_NOT_INITIALIZED;
+        }
+        return DH_FILTER_OK;
+    }
+    if (filter->inputs == NULL || filter->coefficients_in == NULL || filter->number_coefficients_in == 0 || filter->dot_product == NULL) {
+        return DH_FILTER_DATA_STRUCTURE_NOT_INITIALIZED;
+    }
+    return DH_FILTER_OK;
+}
+
+/**
+ * @brief Runs the filter for [count] values. The inputs of FIR filters are stored in a mirrored circular buffer,
+ * so that every output is a single dot product over a contiguous range.
+ */
+static void dh_filter_run_f32(dh_filter_data_f32* filter, const float* input, float* output, size_t count)
+{
+    const float gain = filter->gain;
+    if (filter->realization == DH_REALIZATION_SECOND_ORDER_SECTIONS) {
+        const float* sections = filter->sections;
+        float* state = filter->state;
+        const size_t number_sections = filter->number_sections;
+        for (size_t i=0; i<count; ++i) {
+            float value = input[i];
+            for (size_t k=0; k<number_sections; ++k) {
+                const float* c = sections + 5*k;
+                float* s = state + 2*k;
+                const float y = c[0] * value + s[0];
+                s[0] = c[1] * value - c[3] * y + s[1];
+                s[1] = c[2] * value - c[4] * y;
+                value = y;
+            }
+            output[i] = value * gain;
+        }
+        return;
+    }
+
+    const float* coefficients_in = filter->coefficients_in;
+    float* inputs = filter->inputs;
+    const size_t number_coefficients_in = filter->number_coefficients_in;
+    const dh_dot_product_function_f32 dot_product = filter->dot_product;
+    size_t input_index = filter->current_input_index;
+    for (size_t i=0; i<count; ++i) {
+        input_index = input_index > 0 ? input_index - 1 : number_coefficients_in - 1U;
+        inputs[input_index] = input[i];
+        inputs[input_index + number_coefficients_in] = input[i];
+        output[i] = dot_product(coefficients_in, inputs + input_index, number_coefficients_in) * gain;
+    }
+    filter->current_input_index = input_index;
+}
+
+DH_FILTER_RETURN_VALUE dh_initialize_filter_f32(dh_filter_data_f32* filter, float value)
+{
+    assert(filter);
+    if (!filter) {
+        return DH_FILTER_NO_DATA_STRUCTURE;
+    }
+    if (filter->realization == DH_REALIZATION_SECOND_ORDER_SECTIONS) {
+        // the steady state is computed with double precision, so that it is as close as possible to the converted coefficients
+        double input = value;
+        for (size_t k=0; k<filter->number_sections && filter->state != NULL; ++k) {
+            const float* c = filter->sections + 5*k;
+            float* s = filter->state + 2*k;
+            const double denominator = 1.0 + (double)c[3] + (double)c[4];
+            const double y = denominator != 0.0 ? input * ((double)c[0] + (double)c[1] + (double)c[2]) / denominator : 0.0;
+            const double s1 = (double)c[2] * input - (double)c[4] * y;
+            s[1] = (float)s1;
+            s[0] = (float)((double)c[1] * input - (double)c[3] * y + s1);
+            input = y;
+        }
+        filter->current_value = (float)input * filter->gain;
+    } else {
+        for (size_t i=0; i<2*filter->number_coefficients_in && filter->inputs != NULL; ++i) {
+            filter->inputs[i] = value;
+        }
+        filter->current_value = value;
+    }
+    filter->initialized = true;
+    return DH_FILTER_OK;
+}
+
+DH_FILTER_RETURN_VALUE dh_free_filter_f32(dh_filter_data_f32* filter)
+{
+    if (filter != NULL) {
+        if (filter->buffer_needs_cleanup) {
+            free(filter->buffer);
+        }
+        filter->inputs = NULL;
+        filter->coefficients_in = NULL;
+        filter->sections = NULL;
+        filter->state = NULL;
+        filter->buffer = NULL;
+        filter->current_value = 0.0f;
+        filter->gain = 0.0f;
+        filter->buffer_length = 0;
+        filter->number_coefficients_in = 0;
+        filter->number_sections = 0;
+        filter->current_input_index = 0;
+        filter->initialized = false;
+        filter->buffer_needs_cleanup = false;
+        filter->realization = DH_REALIZATION_DEFAULT;
+        filter->dot_product = NULL;
+    }
+    return DH_FILTER_OK;
+}
+
+DH_FILTER_RETURN_VALUE dh_filter_set_gain_f32(dh_filter_data_f32* filter, float gain)
+{
+    assert(filter);
+    if (!filter) {
+        return DH_FILTER_NO_DATA_STRUCTURE;
+    }
+    if (dh_filter_check_buffers_f32(filter) != DH_FILTER_OK) {
+        return DH_FILTER_DATA_STRUCTURE_NOT_INITIALIZED;
+    }
+    if (filter->gain != 0.0f) {
+        filter->current_value *= gain/filter->gain;
+    }
+    filter->gain = gain;
+    return DH_FILTER_OK;
+}
+
+DH_FILTER_RETURN_VALUE dh_filter_get_gain_f32(const dh_filter_data_f32* filter, float* gain)
+{
+    assert(filter);
+    if (!filter || !gain) {
+        return DH_FILTER_NO_DATA_STRUCTURE;
+    }
+    if (dh_filter_check_buffers_f32(filter) != DH_FILTER_OK) {
+        return DH_FILTER_DATA_STRUCTURE_NOT_INITIALIZED;
+    }
+    *gain = filter->gain;
+    return DH_FILTER_OK;
+}
@@ -0,0 +1,402 @@
+#include "dh/filter.h"
+#include <assert.h>
+#include <float.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef DH_FILTER_DISABLE_THREADS
+#include <pthread.h>
+#endif
+
+/**
+ * @file
+ * @brief This file contains the filtering of long signals with several threads.
+ *
+ * A filter is a linear system: the output of a chunk that starts with the state s is the output for the state zero
+ * plus the response to s with zero inputs. The same holds for the state at the end of the chunk, which is the final
+ * state for the start zero plus Phi*s. Phi is the state transition matrix for the length of the chunk. It is the L-th power
+ * of the matrix A for a single value.
+ *
+ * Second order sections and the transposed direct form 2 keep their state vector in dh_filter_data::state. The direct form 1
+ * keeps the past inputs and outputs in its circular buffers. The past inputs at the start of a chunk are known from the signal,
+ * so only the past outputs (before the gain, newest first) form the state vector that is propagated.
+ *
+ * This source code is licensed under the MIT license. See file "LICENSE" at the root of the repository.
+ */
+
+/** Chunks are not shorter than this number of values. Shorter signals use fewer threads. */
+#define DH_FILTER_PARALLEL_MIN_CHUNK_LENGTH 1024
+/** Number of values of the zero-input responses that are computed at once on the stack. */
+#define DH_FILTER_PARALLEL_RESPONSE_LENGTH 256
+
+/** The data of one chunk. */
+typedef struct {
+    /** A shallow copy of the filter that shares the coefficients and owns its state or circular buffers. */
+    dh_filter_data filter;
+    /** The final state for the start zero after the first pass. Used as scratch memory by the second pass. */
+    double* state;
+    /** The true state at the start of the chunk. */
+    double* initial_state;
+    /** Input of the chunk. */
+    const double* input;
+    /** Output of the chunk. */
+    double* output;
+    /** Number of values in the chunk. */
+    size_t count;
+    /** Number of values in the state vector. */
+    size_t state_length;
+} dh_filter_chunk;
+
+/**
+ * @brief Checks if the realization keeps its state in the circular buffers of the direct form 1.
+ */
+static bool dh_filter_parallel_is_direct_form(const dh_filter_data* filter)
+{
+    return filter->realization == DH_REALIZATION_DEFAULT || filter->realization == DH_REALIZATION_DIRECT_FORM_1
+        || filter->realization == DH_REALIZATION_DIRECT_FORM_1_MIRRORED;
+}
+
+/**
+ * @brief Number of values in the state vector.
+ */
+static size_t dh_filter_parallel_state_length(const dh_filter_data* filter)
+{
+    if (filter->realization == DH_REALIZATION_SECOND_ORDER_SECTIONS) {
+        return 2 * filter->number_sections;
+    }
+    if (dh_filter_parallel_is_direct_form(filter)) {
+        return filter->number_coefficients_out > 0 ? filter->number_coefficients_out - 1 : 0;
+    }
+    const size_t length = filter->number_coefficients_in > filter->number_coefficients_out ? filter->number_coefficients_in : filter->number_coefficients_out;
+    return length > 0 ? length - 1 : 0;
+}
+
+/**
+ * @brief Number of values in the state variables or circular buffers of a copy of the filter.
+ */
+static size_t dh_filter_parallel_storage_length(const dh_filter_data* filter)
+{
+    if (dh_filter_parallel_is_direct_form(filter)) {
+        const size_t history_factor = filter->realization == DH_REALIZATION_DIRECT_FORM_1_MIRRORED ? 2 : 1;
+        return history_factor * (filter->number_coefficients_in + filter->number_coefficients_out);
+    }
+    return filter->state_length;
+}
+
+/**
+ * @brief Points the state or the circular buffers of [filter] to [storage] and sets them to zero.
+ */
+static void dh_filter_parallel_assign_storage(dh_filter_data* filter, double* storage)
+{
+    memset(storage, 0, dh_filter_parallel_storage_length(filter) * sizeof(double));
+    if (dh_filter_parallel_is_direct_form(filter)) {
+        const size_t history_factor = filter->realization == DH_REALIZATION_DIRECT_FORM_1_MIRRORED ? 2 : 1;
+        filter->inputs = storage;
+        filter->outputs = filter->number_coefficients_out > 0 ? storage + history_factor * filter->number_coefficients_in : NULL;
+        filter->current_input_index = 0;
+        filter->current_output_index = 0;
+    } else {
+        filter->state = storage;
+    }
+}
+
+/**
+ * @brief Copies the state vector of [filter] to [state]. For the direct form 1 these are the past outputs, newest first.
+ */
+static void dh_filter_parallel_get_state(const dh_filter_data* filter, double* state, size_t n)
+{
+    if (!dh_filter_parallel_is_direct_form(filter)) {
+        memcpy(state, filter->state, n * sizeof(double));
+        return;
+    }
+    const size_t number_coefficients_out = filter->number_coefficients_out;
+    for (size_t k=0; k<n; ++k) {
+        const size_t index = filter->current_output_index + k;
+        state[k] = filter->outputs[index < number_coefficients_out ? index : index - number_coefficients_out];
+    }
+}
+
+/**
+ * @brief Sets the state vector of [filter] to [state]. The oldest output of the direct form 1 is overwritten before it is used.
+ */
+static void dh_filter_parallel_set_state(dh_filter_data* filter, const double* state, size_t n)
+{
+    if (!dh_filter_parallel_is_direct_form(filter)) {
+        memcpy(filter->state, state, n * sizeof(double));
+        return;
+    }
+    const size_t number_coefficients_out = filter->number_coefficients_out;
+    const bool mirrored = filter->realization == DH_REALIZATION_DIRECT_FORM_1_MIRRORED;
+    for (size_t k=0; k<n; ++k) {
+        const size_t index = filter->current_output_index + k < number_coefficients_out ? filter->current_output_index + k
+                                                                                         : filter->current_output_index + k - number_coefficients_out;
+        filter->outputs[index] = state[k];
+        if (mirrored) {
+            filter->outputs[index + number_coefficients_out] = state[k];
+        }
+    }
+}
+
+/**
+ * @brief Sets the past inputs of a direct form 1 copy with the current index 0 to the [offset] values before [input]
+ * and the newest values of [history] before them.
+ *
+ * The values are copied before any chunk is filtered, because the output may be the same array as the input.
+ */
+static void dh_filter_parallel_set_inputs(dh_filter_data* filter, const double* input, size_t offset, const double* history)
+{
+    const size_t number_coefficients_in = filter->number_coefficients_in;
+    const bool mirrored = filter->realization == DH_REALIZATION_DIRECT_FORM_1_MIRRORED;
+    for (size_t age=0; age+1<number_coefficients_in; ++age) {
+        const double value = age < offset ? input[offset - 1 - age] : history[age - offset];
+        filter->inputs[age] = value;
+        if (mirrored) {
+            filter->inputs[age + number_coefficients_in] = value;
+        }
+    }
+}
+
+/**
+ * @brief First pass: filters the chunk starting with a state of zeros, or with the state of the filter for the first chunk.
+ */
+static void* dh_filter_chunk_zero_state(void* argument)
+{
+    dh_filter_chunk* chunk = (dh_filter_chunk*)argument;
+    dh_filter_block(&chunk->filter, chunk->input, chunk->output, chunk->count);
+    return NULL;
+}
+
+/**
+ * @brief Second pass: adds the response to the true initial state with zero inputs.
+ *
+ * The response of a stable filter decays exponentially. It is computed until the state is so small
+ * compared to the initial state that the remaining outputs are below the rounding errors.
+ */
+static void* dh_filter_chunk_zero_input(void* argument)
+{
+    dh_filter_chunk* chunk = (dh_filter_chunk*)argument;
+    double largest = 0.0;
+    for (size_t k=0; k<chunk->state_length; ++k) {
+        largest = fmax(largest, fabs(chunk->initial_state[k]));
+    }
+    // the past inputs of the direct form 1 are zero, too
+    dh_filter_parallel_assign_storage(&chunk->filter, dh_filter_parallel_is_direct_form(&chunk->filter) ? chunk->filter.inputs : chunk->filter.state);
+    dh_filter_parallel_set_state(&chunk->filter, chunk->initial_state, chunk->state_length);
+    const double threshold = largest * DBL_EPSILON * DBL_EPSILON;
+    const double zeros[DH_FILTER_PARALLEL_RESPONSE_LENGTH] = {0.0};
+    double response[DH_FILTER_PARALLEL_RESPONSE_LENGTH];
+    for (size_t start=0; start<chunk->count && largest > threshold; start+=DH_FILTER_PARALLEL_RESPONSE_LENGTH) {
+        const size_t length = chunk->count - start < DH_FILTER_PARALLEL_RESPONSE_LENGTH ? chunk->count - start : DH_FILTER_PARALLEL_RESPONSE_LENGTH;
+        dh_filter_block(&chunk->filter, zeros, response, length);
+        for (size_t i=0; i<length; ++i) {
+            chunk->output[start + i] += response[i];
+        }
+        dh_filter_parallel_get_state(&chunk->filter, chunk->state, chunk->state_length);
+        largest = 0.0;
+        for (size_t k=0; k<chunk->state_length; ++k) {
+            largest = fmax(largest, fabs(chunk->state[k]));
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Runs [function] for the chunks [first] to number_chunks-1. Chunk [first] is processed on the calling thread, all others
+ * on new threads. If a thread cannot be started, its chunk is processed on the calling thread.
+ */
+static void dh_filter_run_chunks(void* (*function)(void*), dh_filter_chunk* chunks, size_t first, size_t number_chunks)
+{
+#ifndef DH_FILTER_DISABLE_THREADS
+    pthread_t* threads = (pthread_t*)malloc(number_chunks * sizeof(pthread_t));
+    bool* started = (bool*)calloc(number_chunks, sizeof(bool));
+    for (size_t j=first+1; j<number_chunks && threads != NULL && started != NULL; ++j) {
+        started[j] = pthread_create(&threads[j], NULL, function, &chunks[j]) == 0;
+    }
+    function(&chunks[first]);
+    for (size_t j=first+1; j<number_chunks; ++j) {
+        if (threads != NULL && started != NULL && started[j]) {
+            pthread_join(threads[j], NULL);
+        } else {
+            function(&chunks[j]);
+        }
+    }
+    free(threads);
+    free(started);
+#else
+    for (size_t j=first; j<number_chunks; ++j) {
+        function(&chunks[j]);
+    }
+#endif
+}
+
+/**
+ * @brief Computes result = a*b for square matrices of size n in row major order.
+ */
+static void dh_matrix_multiply(const double* a, const double* b, double* result, size_t n)
+{
+    for (size_t r=0; r<n; ++r) {
+        for (size_t c=0; c<n; ++c) {
+            double sum = 0.0;
+            for (size_t k=0; k<n; ++k) {
+                sum += a[r*n + k] * b[k*n + c];
+            }
+            result[r*n + c] = sum;
+        }
+    }
+}
+
+/**
+ * @brief Computes result = single^power by repeated squaring. [work] must hold 2*n*n values.
+ */
+static void dh_matrix_power(const double* single, size_t power, double* result, double* work, size_t n)
+{
+    double* base = work;
+    double* temporary = work + n*n;
+    memcpy(base, single, n * n * sizeof(double));
+    memset(result, 0, n * n * sizeof(double));
+    for (size_t k=0; k<n; ++k) {
+        result[k*n + k] = 1.0;
+    }
+    while (power > 0) {
+        if (power & 1U) {
+            dh_matrix_multiply(result, base, temporary, n);
+            memcpy(result, temporary, n * n * sizeof(double));
+        }
+        power >>= 1U;
+        if (power > 0) {
+            dh_matrix_multiply(base, base, temporary, n);
+            memcpy(base, temporary, n * n * sizeof(double));
+        }
+    }
+}
+
+/**
+ * @brief Computes result = final_state + transition*state.
+ */
+static void dh_propagate_state(const double* transition, const double* state, const double* final_state, double* result, size_t n)
+{
+    for (size_t r=0; r<n; ++r) {
+        double sum = final_state[r];
+        for (size_t k=0; k<n; ++k) {
+            sum += transition[r*n + k] * state[k];
+        }
+        result[r] = sum;
+    }
+}
+
+DH_FILTER_RETURN_VALUE dh_filter_block_parallel(dh_filter_data* filter, const double* input, double* output, size_t count, size_t number_threads)
+{
+    assert(filter);
+    if (!filter) {
+        return DH_FILTER_NO_DATA_STRUCTURE;
+    }
+    if (filter->realization == DH_REALIZATION_RUNNING_SUM || filter->realization == DH_REALIZATION_RECURSIVE_EXPONENTIAL) {
+        return DH_FILTER_UNSUPPORTED_REALIZATION;
+    }
+    const bool direct_form = dh_filter_parallel_is_direct_form(filter);
+    const size_t state_length = dh_filter_parallel_state_length(filter);
+    size_t number_chunks = count / DH_FILTER_PARALLEL_MIN_CHUNK_LENGTH;
+    number_chunks = number_chunks < number_threads ? number_chunks : number_threads;
+    if (number_chunks <= 1 || (state_length == 0 && !direct_form)) {
+        return dh_filter_block(filter, input, output, count);
+    }
+    // checks the buffers and sets the steady state if necessary
+    DH_FILTER_RETURN_VALUE rv = dh_filter_block(filter, input, output, 1);
+    if (rv != DH_FILTER_OK) {
+        return rv;
+    }
+    input += 1;
+    output += 1;
+    count -= 1;
+
+    const size_t n = state_length;
+    const size_t storage_length = dh_filter_parallel_storage_length(filter);
+    const size_t history_length = direct_form ? filter->number_coefficients_in : 0;
+    const size_t chunk_length = count / number_chunks;
+    const size_t last_length = count - (number_chunks - 1) * chunk_length;
+    dh_filter_chunk* chunks = (dh_filter_chunk*)malloc(number_chunks * sizeof(dh_filter_chunk)
+        + (number_chunks * (2 * n + storage_length) + 5 * n * n + history_length) * sizeof(double));
+    if (chunks == NULL) {
+        return DH_FILTER_ALLOCATION_FAILED;
+    }
+    double* states = (double*)(chunks + number_chunks);
+    double* storage = states + 2 * number_chunks * n;
+    double* single = storage + number_chunks * storage_length;
+    double* transition = single + n * n;
+    double* work = transition + n * n;
+    double* history = work + 3 * n * n;
+    if (direct_form) {
+        // the past inputs before the signal, newest first
+        for (size_t age=0; age<history_length; ++age) {
+            const size_t index = filter->current_input_index + age;
+            history[age] = filter->inputs[index < filter->number_coefficients_in ? index : index - filter->number_coefficients_in];
+        }
+    }
+    for (size_t j=0; j<number_chunks; ++j) {
+        chunks[j].filter = *filter;
+        chunks[j].filter.initialized = true;
+        chunks[j].filter.overlap_save.fft_length = 0;
+        chunks[j].state = states + 2 * j * n;
+        chunks[j].initial_state = chunks[j].state + n;
+        chunks[j].input = input + j * chunk_length;
+        chunks[j].output = output + j * chunk_length;
+        chunks[j].count = j + 1 < number_chunks ? chunk_length : last_length;
+        chunks[j].state_length = n;
+        // the first chunk continues with the state of the filter and needs no correction
+        if (j > 0) {
+            dh_filter_parallel_assign_storage(&chunks[j].filter, storage + j * storage_length);
+            if (direct_form) {
+                dh_filter_parallel_set_inputs(&chunks[j].filter, input, j * chunk_length, history);
+            }
+        }
+    }
+
+    dh_filter_run_chunks(dh_filter_chunk_zero_state, chunks, 0, number_chunks);
+    for (size_t j=1; j<number_chunks; ++j) {
+        dh_filter_parallel_get_state(&chunks[j].filter, chunks[j].state, n);
+    }
+    const dh_filter_chunk* last = &chunks[number_chunks - 1];
+    if (direct_form) {
+        // the past inputs at the end of the signal are in the buffer of the last chunk
+        const size_t history_factor = filter->realization == DH_REALIZATION_DIRECT_FORM_1_MIRRORED ? 2 : 1;
+        memcpy(filter->inputs, last->filter.inputs, history_factor * filter->number_coefficients_in * sizeof(double));
+        filter->current_input_index = last->filter.current_input_index;
+        filter->current_output_index = chunks[0].filter.current_output_index;
+    }
+
+    if (n > 0) {
+        // column k of the transition matrix for one value is the next state for the state e_k and the input 0
+        dh_filter_data* probe = &chunks[1].filter;
+        for (size_t k=0; k<n; ++k) {
+            const double zero = 0.0;
+            double unused = 0.0;
+            dh_filter_parallel_assign_storage(probe, storage + storage_length);
+            memset(work, 0, n * sizeof(double));
+            work[k] = 1.0;
+            dh_filter_parallel_set_state(probe, work, n);
+            dh_filter_block(probe, &zero, &unused, 1);
+            dh_filter_parallel_get_state(probe, work, n);
+            for (size_t r=0; r<n; ++r) {
+                single[r*n + k] = work[r];
+            }
+        }
+
+        // the true states at the chunk boundaries are propagated serially, which needs one matrix-vector product per chunk
+        dh_matrix_power(single, chunk_length, transition, work, n);
+        dh_filter_parallel_get_state(&chunks[0].filter, chunks[1].initial_state, n);
+        for (size_t j=1; j+1<number_chunks; ++j) {
+            dh_propagate_state(transition, chunks[j].initial_state, chunks[j].state, chunks[j+1].initial_state, n);
+        }
+        if (last_length != chunk_length) {
+            dh_matrix_power(single, last_length, transition, work, n);
+        }
+        dh_propagate_state(transition, last->initial_state, last->state, work + 2 * n * n, n);
+        dh_filter_parallel_set_state(filter, work + 2 * n * n, n);
+
+        dh_filter_run_chunks(dh_filter_chunk_zero_input, chunks, 1, number_chunks);
+    }
+    filter->current_value = output[count - 1];
+    free(chunks);
+    return DH_FILTER_OK;
+}
@@ -0,0 +1,709 @@
+#include "dh/fixed_point.h"
+#include "dh/filter.h"
+#include "dh/utility.h"
+#include <assert.h>
+#include <complex.h>
+#include <math.h>
+#include <stdlib.h>
+
+/**
+ * @file
+ * @brief This file contains the Q15 and Q31 filters.
+ *
+ * The filter is designed with double precision. FIR filters get the gain folded into the coefficients, so that
+ * the sum cannot exceed the output range before the gain is applied. The numerators of the second order sections
+ * are scaled so that the peak magnitude of the cascade after each section is 1 on a grid of frequencies.
+ * Then all coefficients are quantized with a common shift and the output gain with a separate shift.
+ *
+ * Q15 products are exact in 32 bits and are summed in a 64 bit accumulator. Q31 products need 62 bits, so they are
+ * shifted right by DH_FIXED_POINT_Q31_GUARD_BITS before they are summed. The shift of the coefficients is limited,
+ * so that the final shift of the accumulator is at least one bit and the result can be rounded.
+ *
+ * This source code is licensed under the MIT license. See file "LICENSE" at the root of the repository.
+ */
+
+/** Number of frequencies in [0,0.5] that are used to scale the sections and to compute the report. */
+#define DH_FIXED_POINT_GRID_SIZE 1024
+
+/** Number of fractional bits of the Q15 format. */
+#define DH_Q15_FRACTION_BITS 15
+/** Number of fractional bits of the Q31 format. */
+#define DH_Q31_FRACTION_BITS 31
+
+/** The double precision coefficients before quantization. */
+typedef struct {
+    /** FIR coefficients with the folded gain or the scaled sections. */
+    double* values;
+    /** Number of FIR coefficients. 0 for IIR filters. */
+    size_t number_coefficients_in;
+    /** Number of sections. 0 for FIR filters. */
+    size_t number_sections;
+    /** Remaining gain that is applied to the output. */
+    double gain;
+    /** Initialization state of the designed filter. */
+    bool initialized;
+} dh_fixed_point_design;
+
+static DH_FILTER_RETURN_VALUE dh_design_fixed_point(dh_fixed_point_design* design, const dh_filter_parameters* options);
+static DH_FILTER_RETURN_VALUE dh_quantize_design(const dh_fixed_point_design* design, unsigned fraction_bits, unsigned max_shift,
+    int32_t* quantized, int32_t* gain, unsigned* shift, unsigned* gain_shift, dh_fixed_point_report* report);
+static double dh_dequantize(int32_t value, unsigned fraction_bits, unsigned shift);
+static void dh_run_q15(dh_filter_data_q15* filter, const int16_t* input, int16_t* output, size_t count);
+static void dh_run_q31(dh_filter_data_q31* filter, const int32_t* input, int32_t* output, size_t count);
+
+static size_t dh_design_value_count(const dh_fixed_point_design* design)
+{
+    return design->number_sections > 0 ? 5 * design->number_sections : design->number_coefficients_in;
+}
+
+static double dh_grid_frequency(size_t i)
+{
+    return 0.5 * (double)i / (double)(DH_FIXED_POINT_GRID_SIZE - 1);
+}
+
+static COMPLEX dh_design_response(double* values, size_t number_coefficients_in, size_t number_sections, double gain, double frequency)
+{
+    if (number_sections > 0) {
+        return COMPLEX_MUL(dh_gain_at_sections(values, number_sections, frequency), MAKE_COMPLEX_NUMER(gain, 0.0));
+    }
+    double denominator = 1.0;
+    return COMPLEX_MUL(dh_gain_at(values, number_coefficients_in, &denominator, 1, frequency), MAKE_COMPLEX_NUMER(gain, 0.0));
+}
+
+static int64_t dh_round_shift(int64_t value, unsigned shift)
+{
+    return (value + ((int64_t)1 << (shift - 1))) >> shift;
+}
+
+static int16_t dh_saturate_q15(int64_t value)
+{
+    return value > INT16_MAX ? INT16_MAX : (value < INT16_MIN ? INT16_MIN : (int16_t)value);
+}
+
+static int32_t dh_saturate_q31(int64_t value)
+{
+    return value > INT32_MAX ? INT32_MAX : (value < INT32_MIN ? INT32_MIN : (int32_t)value);
+}
+
+static DH_FILTER_RETURN_VALUE dh_design_fixed_point(dh_fixed_point_design* design, const dh_filter_parameters* options)
+{
+    dh_filter_parameters parameters = *options;
+    const bool fir = dh_filter_type_is_fir(options->filter_type);
+    if (fir) {
+        if (options->realization != DH_REALIZATION_DEFAULT && options->realization != DH_REALIZATION_DIRECT_FORM_1 &&
+            options->realization != DH_REALIZATION_DIRECT_FORM_1_MIRRORED) {
+            return DH_FILTER_UNSUPPORTED_REALIZATION;
+        }
+        parameters.realization = DH_REALIZATION_DIRECT_FORM_1;
+    } else {
+        if (options->realization != DH_REALIZATION_DEFAULT && options->realization != DH_REALIZATION_SECOND_ORDER_SECTIONS) {
+            return DH_FILTER_UNSUPPORTED_REALIZATION;
+        }
+        parameters.realization = DH_REALIZATION_SECOND_ORDER_SECTIONS;
+    }
+
+    dh_filter_data source;
+    DH_FILTER_RETURN_VALUE rv = dh_create_filter(&source, &parameters);
+    if (rv != DH_FILTER_OK) {
+        return rv;
+    }
+    design->number_coefficients_in = fir ? source.number_coefficients_in : 0;
+    design->number_sections = fir ? 0 : source.number_sections;
+    design->initialized = source.initialized;
+    const size_t count = dh_design_value_count(design);
+    design->values = (double*)malloc((count > 0 ? count : 1) * sizeof(double));
+    if (design->values == NULL) {
+        dh_free_filter(&source);
+        return DH_FILTER_ALLOCATION_FAILED;
+    }
+    const double gain = source.coefficients_out[0];
+    if (fir) {
+        for (size_t i=0; i<count; ++i) {
+            design->values[i] = source.coefficients_in[i] * gain;
+        }
+        design->gain = 1.0;
+    } else {
+        for (size_t i=0; i<count; ++i) {
+            design->values[i] = source.sections[i];
+        }
+        design->gain = gain;
+        // scale the numerator of each section, so that the peak gain of the cascade up to this section is 1
+        for (size_t k=0; k<design->number_sections; ++k) {
+            double peak = 0.0;
+            for (size_t i=0; i<DH_FIXED_POINT_GRID_SIZE; ++i) {
+                peak = fmax(peak, cabs(dh_gain_at_sections(design->values, k+1, dh_grid_frequency(i))));
+            }
+            if (peak > 0.0) {
+                double* section = design->values + 5*k;
+                section[0] /= peak;
+                section[1] /= peak;
+                section[2] /= peak;
+                design->gain *= peak;
+            }
+        }
+    }
+    dh_free_filter(&source);
+    return DH_FILTER_OK;
+}
+
+static void dh_free_fixed_point_design(dh_fixed_point_design* design)
+{
+    free(design->values);
+    design->values = NULL;
+}
+
+/**
+ * @brief Returns the smallest shift, so that [value] can be represented with [fraction_bits] - shift fractional bits.
+ */
+static unsigned dh_fixed_point_shift(double value, unsigned fraction_bits)
+{
+    const double limit = ldexp(1.0, (int)fraction_bits) - 1.0;
+    unsigned shift = 0;
+    while (shift <= fraction_bits && floor(fabs(value) * ldexp(1.0, (int)(fraction_bits - shift)) + 0.5) > limit) {
+        ++shift;
+    }
+    return shift;
+}
+
+static int32_t dh_quantize(double value, unsigned fraction_bits, unsigned shift)
+{
+    const double limit = ldexp(1.0, (int)fraction_bits);
+    double scaled = floor(value * ldexp(1.0, (int)(fraction_bits - shift)) + 0.5);
+    scaled = scaled > limit - 1.0 ? limit - 1.0 : (scaled < -limit ? -limit : scaled);
+    return (int32_t)scaled;
+}
+
+static double dh_dequantize(int32_t value, unsigned fraction_bits, unsigned shift)
+{
+    return ldexp((double)value, -(int)(fraction_bits - shift));
+}
+
+static double dh_section_pole_radius(const double* section)
+{
+    const double a1 = section[3];
+    const double a2 = section[4];
+    const double discriminant = a1 * a1 - 4.0 * a2;
+    if (discriminant < 0.0) {
+        return sqrt(a2);
+    }
+    return 0.5 * (fabs(a1) + sqrt(discriminant));
+}
+
+/**
+ * @brief Quantizes the designed coefficients and fills the report.
+ *
+ * @retval DH_FILTER_ERROR The coefficients need a larger shift than [max_shift] or the quantized filter is unstable.
+ */
+static DH_FILTER_RETURN_VALUE dh_quantize_design(const dh_fixed_point_design* design, unsigned fraction_bits, unsigned max_shift,
+    int32_t* quantized, int32_t* gain, unsigned* shift, unsigned* gain_shift, dh_fixed_point_report* report)
+{
+    const size_t count = dh_design_value_count(design);
+    double max_value = 0.0;
+    for (size_t i=0; i<count; ++i) {
+        max_value = fmax(max_value, fabs(design->values[i]));
+    }
+    *shift = dh_fixed_point_shift(max_value, fraction_bits);
+    *gain_shift = dh_fixed_point_shift(design->gain, fraction_bits);
+    report->coefficient_shift = *shift;
+    report->gain_shift = *gain_shift;
+    if (*shift > max_shift || *gain_shift > max_shift) {
+        return DH_FILTER_ERROR;
+    }
+
+    double* dequantized = (double*)malloc((count > 0 ? count : 1) * sizeof(double));
+    if (dequantized == NULL) {
+        return DH_FILTER_ALLOCATION_FAILED;
+    }
+    *gain = dh_quantize(design->gain, fraction_bits, *gain_shift);
+    const double dequantized_gain = dh_dequantize(*gain, fraction_bits, *gain_shift);
+    report->max_coefficient_error = fabs(dequantized_gain - design->gain);
+    for (size_t i=0; i<count; ++i) {
+        quantized[i] = dh_quantize(design->values[i], fraction_bits, *shift);
+        dequantized[i] = dh_dequantize(quantized[i], fraction_bits, *shift);
+        report->max_coefficient_error = fmax(report->max_coefficient_error, fabs(dequantized[i] - design->values[i]));
+    }
+
+    report->max_response_error = 0.0;
+    for (size_t i=0; i<DH_FIXED_POINT_GRID_SIZE; ++i) {
+        const double frequency = dh_grid_frequency(i);
+        const COMPLEX designed = dh_design_response(design->values, design->number_coefficients_in, design->number_sections, design->gain, frequency);
+        const COMPLEX actual = dh_design_response(dequantized, design->number_coefficients_in, design->number_sections, dequantized_gain, frequency);
+        report->max_response_error = fmax(report->max_response_error, cabs(COMPLEX_SUB(designed, actual)));
+    }
+
+    report->max_pole_radius = 0.0;
+    for (size_t k=0; k<design->number_sections; ++k) {
+        report->max_pole_radius = fmax(report->max_pole_radius, dh_section_pole_radius(dequantized + 5*k));
+    }
+    report->pole_radius_margin = 1.0 - report->max_pole_radius;
+    free(dequantized);
+    return report->pole_radius_margin > 0.0 ? DH_FILTER_OK : DH_FILTER_ERROR;
+}
+
+/**
+ * @brief Returns the gain of a quantized section at the frequency 0.
+ */
+static double dh_section_dc_gain(const double* section)
+{
+    const double denominator = 1.0 + section[3] + section[4];
+    return denominator != 0.0 ? (section[0] + section[1] + section[2]) / denominator : 0.0;
+}
+
+DH_FILTER_RETURN_VALUE dh_create_filter_q15(dh_filter_data_q15* filter, dh_filter_parameters* options, dh_fixed_point_report* report)
+{
+    assert(filter != NULL);
+    assert(options != NULL);
+    if (filter == NULL || options == NULL) {
+        return DH_FILTER_NO_DATA_STRUCTURE;
+    }
+    dh_fixed_point_design design;
+    DH_FILTER_RETURN_VALUE rv = dh_design_fixed_point(&design, options);
+    if (rv != DH_FILTER_OK) {
+        return rv;
+    }
+    const size_t count = dh_design_value_count(&design);
+    const size_t number_values = design.number_sections > 0 ? 9 * design.number_sections : 3 * design.number_coefficients_in;
+    int32_t* quantized = (int32_t*)malloc((count > 0 ? count : 1) * sizeof(int32_t));
+    filter->buffer_length = (number_values > 0 ? number_values : 1) * sizeof(int16_t);
+    filter->buffer = (char*)malloc(filter->buffer_length);
+    if (quantized == NULL || filter->buffer == NULL) {
+        free(quantized);
+        free(filter->buffer);
+        filter->buffer = NULL;
+        filter->buffer_length = 0;
+        dh_free_fixed_point_design(&design);
+        return DH_FILTER_ALLOCATION_FAILED;
+    }
+    dh_fixed_point_report local_report;
+    int32_t gain = 0;
+    rv = dh_quantize_design(&design, DH_Q15_FRACTION_BITS, DH_Q15_FRACTION_BITS - 1, quantized, &gain,
+        &filter->shift, &filter->gain_shift, report != NULL ? report : &local_report);
+    if (rv != DH_FILTER_OK) {
+        free(quantized);
+        free(filter->buffer);
+        filter->buffer = NULL;
+        filter->buffer_length = 0;
+        dh_free_fixed_point_design(&design);
+        return rv;
+    }
+    int16_t* data = (int16_t*)filter->buffer;
+    filter->buffer_needs_cleanup = true;
+    filter->number_coefficients_in = design.number_coefficients_in;
+    filter->number_sections = design.number_sections;
+    filter->current_input_index = 0;
+    filter->current_value = 0;
+    filter->gain = (int16_t)gain;
+    if (design.number_sections > 0) {
+        filter->realization = DH_REALIZATION_SECOND_ORDER_SECTIONS;
+        filter->coefficients_in = NULL;
+        filter->inputs = NULL;
+        filter->sections = data;
+        filter->state = data + 5 * design.number_sections;
+    } else {
+        filter->realization = DH_REALIZATION_DIRECT_FORM_1_MIRRORED;
+        filter->coefficients_in = data;
+        filter->inputs = data + design.number_coefficients_in;
+        filter->sections = NULL;
+        filter->state = NULL;
+    }
+    int16_t* coefficients = design.number_sections > 0 ? filter->sections : filter->coefficients_in;
+    for (size_t i=0; i<count; ++i) {
+        coefficients[i] = (int16_t)quantized[i];
+    }
+    const bool initialized = design.initialized;
+    free(quantized);
+    dh_free_fixed_point_design(&design);
+    dh_initialize_filter_q15(filter, 0);
+    filter->initialized = initialized;
+    return DH_FILTER_OK;
+}
+
+DH_FILTER_RETURN_VALUE dh_create_filter_q31(dh_filter_data_q31* filter, dh_filter_parameters* options, dh_fixed_point_report* report)
+{
+    assert(filter != NULL);
+    assert(options != NULL);
+    if (filter == NULL || options == NULL) {
+        return DH_FILTER_NO_DATA_STRUCTURE;
+    }
+    dh_fixed_point_design design;
+    DH_FILTER_RETURN_VALUE rv = dh_design_fixed_point(&design, options);
+    if (rv != DH_FILTER_OK) {
+        return rv;
+    }
+    const size_t number_values = design.number_sections > 0 ? 9 * design.number_sections : 3 * design.number_coefficients_in;
+    filter->buffer_length = (number_values > 0 ? number_values : 1) * sizeof(int32_t);
+    filter->buffer = (char*)malloc(filter->buffer_length);
+    if (filter->buffer == NULL) {
+        filter->buffer_length = 0;
+        dh_free_fixed_point_design(&design);
+        return DH_FILTER_ALLOCATION_FAILED;
+    }
+    int32_t* data = (int32_t*)filter->buffer;
+    dh_fixed_point_report local_report;
+    int32_t gain = 0;
+    rv = dh_quantize_design(&design, DH_Q31_FRACTION_BITS,
+        DH_Q31_FRACTION_BITS - DH_FIXED_POINT_Q31_GUARD_BITS - 1, data, &gain,
+        &filter->shift, &filter->gain_shift, report != NULL ? report : &local_report);
+    if (rv != DH_FILTER_OK) {
+        free(filter->buffer);
+        filter->buffer = NULL;
+        filter->buffer_length = 0;
+        dh_free_fixed_point_design(&design);
+        return rv;
+    }
+    filter->buffer_needs_cleanup = true;
+    filter->number_coefficients_in = design.number_coefficients_in;
+    filter->number_sections = design.number_sections;
+    filter->current_input_index = 0;
+    filter->current_value = 0;
+    filter->gain = gain;
+    if (design.number_sections > 0) {
+        filter->realization = DH_REALIZATION_SECOND_ORDER_SECTIONS;
+        filter->coefficients_in = NULL;
+        filter->inputs = NULL;
+        filter->sections = data;
+        filter->state = data + 5 * design.number_sections;
+    } else {
+        filter->realization = DH_REALIZATION_DIRECT_FORM_1_MIRRORED;
+        filter->coefficients_in = data;
+        filter->inputs = data + design.number_coefficients_in;
+        filter->sections = NULL;
+        filter->state = NULL;
+    }
+    const bool initialized = design.initialized;
+    dh_free_fixed_point_design(&design);
+    dh_initialize_filter_q31(filter, 0);
+    filter->initialized = initialized;
+    return DH_FILTER_OK;
+}
+
+static DH_FILTER_RETURN_VALUE dh_check_buffers_q15(const dh_filter_data_q15* filter)
+{
+    if (filter->realization == DH_REALIZATION_SECOND_ORDER_SECTIONS) {
+        return filter->sections == NULL || filter->state == NULL ? DH_FILTER_DATA_STRUCTURE_NOT_INITIALIZED : DH_FILTER_OK;
+    }
+    if (filter->inputs == NULL || filter->coefficients_in == NULL || filter->number_coefficients_in == 0) {
+        return DH_FILTER_DATA_STRUCTURE_NOT_INITIALIZED;
+    }
+    return DH_FILTER_OK;
+}
+
+static DH_FILTER_RETURN_VALUE dh_check_buffers_q31(const dh_filter_data_q31* filter)
+{
+    if (filter->realization == DH_REALIZATION_SECOND_ORDER_SECTIONS) {
+        return filter->sections == NULL || filter->state == NULL ? DH_FILTER_DATA_STRUCTURE_NOT_INITIALIZED : DH_FILTER_OK;
+    }
+    if (filter->inputs == NULL || filter->coefficients_in == NULL || filter->number_coefficients_in == 0) {
+        return DH_FILTER_DATA_STRUCTURE_NOT_INITIALIZED;
+    }
+    return DH_FILTER_OK;
+}
+
+DH_FILTER_RETURN_VALUE dh_filter_q15(dh_filter_data_q15* filter, int16_t input, int16_t* output)
+{
+    assert(filter);
+    if (!filter) {
+        return DH_FILTER_NO_DATA_STRUCTURE;
+    }
+    DH_FILTER_RETURN_VALUE rv = dh_check_buffers_q15(filter);
+    if (rv != DH_FILTER_OK) {
+        return rv;
+    }
+    if (!filter->initialized) {
+        dh_initialize_filter_q15(filter, input);
+    }
+    dh_run_q15(filter, &input, &filter->current_value, 1);
+    if (output) {
+        *output = filter->current_value;
+    }
+    return DH_FILTER_OK;
+}
+
+DH_FILTER_RETURN_VALUE dh_filter_q31(dh_filter_data_q31* filter, int32_t input, int32_t* output)
+{
+    assert(filter);
+    if (!filter) {
+        return DH_FILTER_NO_DATA_STRUCTURE;
+    }
+    DH_FILTER_RETURN_VALUE rv = dh_check_buffers_q31(filter);
+    if (rv != DH_FILTER_OK) {
+        return rv;
+    }
+    if (!filter->initialized) {
+        dh_initialize_filter_q31(filter, input);
+    }
+    dh_run_q31(filter, &input, &filter->current_value, 1);
+    if (output) {
+        *output = filter->current_value;
+    }
+    return DH_FILTER_OK;
+}
+
+DH_FILTER_RETURN_VALUE dh_filter_block_q15(dh_filter_data_q15* filter, const int16_t* input, int16_t* output, size_t count)
+{
+    assert(filter);
+    if (!filter) {
+        return DH_FILTER_NO_DATA_STRUCTURE;
+    }
+    DH_FILTER_RETURN_VALUE rv = dh_check_buffers_q15(filter);
+    if (rv != DH_FILTER_OK) {
+        return rv;
+    }
+    if (count == 0) {
+        return DH_FILTER_OK;
+    }
+    if (input == NULL || output == NULL) {
+        return DH_FILTER_NO_DATA_STRUCTURE;
+    }
+    if (!filter->initialized) {
+        dh_initialize_filter_q15(filter, input[0]);
+    }
+    dh_run_q15(filter, input, output, count);
+    filter->current_value = output[count-1];
+    return DH_FILTER_OK;
+}
+
+DH_FILTER_RETURN_VALUE dh_filter_block_q31(dh_filter_data_q31* filter, const int32_t* input, int32_t* output, size_t count)
+{
+    assert(filter);
+    if (!filter) {
+        return DH_FILTER_NO_DATA_STRUCTURE;
+    }
+    DH_FILTER_RETURN_VALUE rv = dh_check_buffers_q31(filter);
+    if (rv != DH_FILTER_OK) {
+        return rv;
+    }
+    if (count == 0) {
+        return DH_FILTER_OK;
+    }
+    if (input == NULL || output == NULL) {
+        return DH_FILTER_NO_DATA_STRUCTURE;
+    }
+    if (!filter->initialized) {
+        dh_initialize_filter_q31(filter, input[0]);
+    }
+    dh_run_q31(filter, input, output, count);
+    filter->current_value = output[count-1];
+    return DH_FILTER_OK;
+}
+
+/**
+ * @brief Runs the Q15 filter for [count] values. The sections are computed in direct form 1, so that
+ * all five products of a section are summed in the wide accumulator before the result is rounded.
+ */
+static void dh_run_q15(dh_filter_data_q15* filter, const int16_t* input, int16_t* output, size_t count)
+{
+    const unsigned output_shift = DH_Q15_FRACTION_BITS - filter->shift;
+    const unsigned gain_shift = DH_Q15_FRACTION_BITS - filter->gain_shift;
+    const int32_t gain = filter->gain;
+    if (filter->realization == DH_REALIZATION_SECOND_ORDER_SECTIONS) {
+        const int16_t* sections = filter->sections;
+        int16_t* state = filter->state;
+        const size_t number_sections = filter->number_sections;
+        for (size_t i=0; i<count; ++i) {
+            int16_t value = input[i];
+            for (size_t k=0; k<number_sections; ++k) {
+                const int16_t* c = sections + 5*k;
+                int16_t* s = state + 4*k;
+                const int64_t accumulator = (int64_t)((int32_t)c[0] * value) + (int32_t)c[1] * s[0] + (int32_t)c[2] * s[1]
+                    - (int32_t)c[3] * s[2] - (int32_t)c[4] * s[3];
+                const int16_t y = dh_saturate_q15(dh_round_shift(accumulator, output_shift));
+                s[1] = s[0];
+                s[0] = value;
+                s[3] = s[2];
+                s[2] = y;
+                value = y;
+            }
+            output[i] = dh_saturate_q15(dh_round_shift((int64_t)value * gain, gain_shift));
+        }
+        return;
+    }
+
+    const int16_t* coefficients_in = filter->coefficients_in;
+    int16_t* inputs = filter->inputs;
+    const size_t number_coefficients_in = filter->number_coefficients_in;
+    size_t input_index = filter->current_input_index;
+    for (size_t i=0; i<count; ++i) {
+        input_index = input_index > 0 ? input_index - 1 : number_coefficients_in - 1U;
+        inputs[input_index] = input[i];
+        inputs[input_index + number_coefficients_in] = input[i];
+        const int16_t* x = inputs + input_index;
+        int64_t accumulator = 0;
+        for (size_t k=0; k<number_coefficients_in; ++k) {
+            accumulator += (int32_t)coefficients_in[k] * x[k];
+        }
+        const int16_t value = dh_saturate_q15(dh_round_shift(accumulator, output_shift));
+        output[i] = dh_saturate_q15(dh_round_shift((int64_t)value * gain, gain_shift));
+    }
+    filter->current_input_index = input_index;
+}
+
+/**
+ * @brief Runs the Q31 filter for [count] values. Same as dh_run_q15(), but every product is shifted by
+ * DH_FIXED_POINT_Q31_GUARD_BITS before it is accumulated.
+ */
+static void dh_run_q31(dh_filter_data_q31* filter, const int32_t* input, int32_t* output, size_t count)
+{
+    const unsigned output_shift = DH_Q31_FRACTION_BITS - DH_FIXED_POINT_Q31_GUARD_BITS - filter->shift;
+    const unsigned gain_shift = DH_Q31_FRACTION_BITS - filter->gain_shift;
+    const int64_t gain = filter->gain;
+    if (filter->realization == DH_REALIZATION_SECOND_ORDER_SECTIONS) {
+        const int32_t* sections = filter->sections;
+        int32_t* state = filter->state;
+        const size_t number_sections = filter->number_sections;
+        for (size_t i=0; i<count; ++i) {
+            int32_t value = input[i];
+            for (size_t k=0; k<number_sections; ++k) {
+                const int32_t* c = sections + 5*k;
+                int32_t* s = state + 4*k;
+                const int64_t accumulator = (((int64_t)c[0] * value) >> DH_FIXED_POINT_Q31_GUARD_BITS)
+                    + (((int64_t)c[1] * s[0]) >> DH_FIXED_POINT_Q31_GUARD_BITS)
+                    + (((int64_t)c[2] * s[1]) >> DH_FIXED_POINT_Q31_GUARD_BITS)
+                    - (((int64_t)c[3] * s[2]) >> DH_FIXED_POINT_Q31_GUARD_BITS)
+                    - (((int64_t)c[4] * s[3]) >> DH_FIXED_POINT_Q31_GUARD_BITS);
+                const int32_t y = dh_saturate_q31(dh_round_shift(accumulator, output_shift));
+                s[1] = s[0];
+                s[0] = value;
+                s[3] = s[2];
+                s[2] = y;
+                value = y;
+            }
+            output[i] = dh_saturate_q31(dh_round_shift((int64_t)value * gain, gain_shift));
+        }
+        return;
+    }
+
+    const int32_t* coefficients_in = filter->coefficients_in;
+    int32_t* inputs = filter->inputs;
+    const size_t number_coefficients_in = filter->number_coefficients_in;
+    size_t input_index = filter->current_input_index;
+    for (size_t i=0; i<count; ++i) {
+        input_index = input_index > 0 ? input_index - 1 : number_coefficients_in - 1U;
+        inputs[input_index] = input[i];
+        inputs[input_index + number_coefficients_in] = input[i];
+        const int32_t* x = inputs + input_index;
+        int64_t accumulator = 0;
+        for (size_t k=0; k<number_coefficients_in; ++k) {
+            accumulator += ((int64_t)coefficients_in[k] * x[k]) >> DH_FIXED_POINT_Q31_GUARD_BITS;
+        }
+        const int32_t value = dh_saturate_q31(dh_round_shift(accumulator, output_shift));
+        output[i] = dh_saturate_q31(dh_round_shift((int64_t)value * gain, gain_shift));
+    }
+    filter->current_input_index = input_index;
+}
+
+DH_FILTER_RETURN_VALUE dh_initialize_filter_q15(dh_filter_data_q15* filter, int16_t value)
+{
+    assert(filter);
+    if (!filter) {
+        return DH_FILTER_NO_DATA_STRUCTURE;
+    }
+    if (filter->realization == DH_REALIZATION_SECOND_ORDER_SECTIONS) {
+        int16_t input = value;
+        for (size_t k=0; k<filter->number_sections && filter->state != NULL; ++k) {
+            double section[5];
+            for (size_t i=0; i<5; ++i) {
+                section[i] = dh_dequantize(filter->sections[5*k + i], DH_Q15_FRACTION_BITS, filter->shift);
+            }
+            const int16_t y = dh_saturate_q15((int64_t)floor((double)input * dh_section_dc_gain(section) + 0.5));
+            int16_t* s = filter->state + 4*k;
+            s[0] = input;
+            s[1] = input;
+            s[2] = y;
+            s[3] = y;
+            input = y;
+        }
+        filter->current_value = dh_saturate_q15(dh_round_shift((int64_t)input * filter->gain, DH_Q15_FRACTION_BITS - filter->gain_shift));
+    } else {
+        for (size_t i=0; i<2*filter->number_coefficients_in && filter->inputs != NULL; ++i) {
+            filter->inputs[i] = value;
+        }
+        filter->current_value = value;
+    }
+    filter->initialized = true;
+    return DH_FILTER_OK;
+}
+
+DH_FILTER_RETURN_VALUE dh_initialize_filter_q31(dh_filter_data_q31* filter, int32_t value)
+{
+    assert(filter);
+    if (!filter) {
+        return DH_FILTER_NO_DATA_STRUCTURE;
+    }
+    if (filter->realization == DH_REALIZATION_SECOND_ORDER_SECTIONS) {
+        int32_t input = value;
+        for (size_t k=0; k<filter->number_sections && filter->state != NULL; ++k) {
+            double section[5];
+            for (size_t i=0; i<5; ++i) {
+                section[i] = dh_dequantize(filter->sections[5*k + i], DH_Q31_FRACTION_BITS, filter->shift);
+            }
+            const int32_t y = dh_saturate_q31((int64_t)floor((double)input * dh_section_dc_gain(section) + 0.5));
+            int32_t* s = filter->state + 4*k;
+            s[0] = input;
+            s[1] = input;
+            s[2] = y;
+            s[3] = y;
+            input = y;
+        }
+        filter->current_value = dh_saturate_q31(dh_round_shift((int64_t)input * filter->gain, DH_Q31_FRACTION_BITS - filter->gain_shift));
+    } else {
+        for (size_t i=0; i<2*filter->number_coefficients_in && filter->inputs != NULL; ++i) {
+            filter->inputs[i] = value;
+        }
+        filter->current_value = value;
+    }
+    filter->initialized = true;
+    return DH_FILTER_OK;
+}
+
+DH_FILTER_RETURN_VALUE dh_free_filter_q15(dh_filter_data_q15* filter)
+{
+    if (filter != NULL) {
+        if (filter->buffer_needs_cleanup) {
+            free(filter->buffer);
+        }
+        filter->inputs = NULL;
+        filter->coefficients_in = NULL;
+        filter->sections = NULL;
+        filter->state = NULL;
+        filter->buffer = NULL;
+        filter->buffer_length = 0;
+        filter->number_coefficients_in = 0;
+        filter->number_sections = 0;
+        filter->current_input_index = 0;
+        filter->shift = 0;
+        filter->gain_shift = 0;
+        filter->gain = 0;
+        filter->current_value = 0;
+        filter->initialized = false;
+        filter->buffer_needs_cleanup = false;
+        filter->realization = DH_REALIZATION_DEFAULT;
+    }
+    return DH_FILTER_OK;
+}
+
+DH_FILTER_RETURN_VALUE dh_free_filter_q31(dh_filter_data_q31* filter)
+{
+    if (filter != NULL) {
+        if (filter->buffer_needs_cleanup) {
+            free(filter->buffer);
+        }
+        filter->inputs = NULL;
+        filter->coefficients_in = NULL;
+        filter->sections = NULL;
+        filter->state = NULL;
+        filter->buffer = NULL;
+        filter->buffer_length = 0;
+        filter->number_coefficients_in = 0;
+        filter->number_sections = 0;
+        filter->current_input_index = 0;
+        filter->shift = 0;
+        filter->gain_shift = 0;
+        filter->gain = 0;
+        filter->current_value = 0;
+        filter->initialized = false;
+        filter->buffer_needs_cleanup = false;
+        filter->realization = DH_REALIZATION_DEFAULT;
+    }
+    return DH_FILTER_OK;
+}
@@ -1,4 +1,5 @@
 #include "dh/filter.h"
+#include "dh/overlap_save.h"
 #include <stdlib.h>
 
 /**
@@ -18,15 +19,29 @@ DH_FILTER_RETURN_VALUE dh_free_filter(dh_filter_data* filter)
         filter->coefficients_in = NULL;
         filter->outputs = NULL;
         filter->coefficients_out = NULL;
+        filter->sections = NULL;
+        filter->state = NULL;
         filter->buffer = NULL;
         filter->current_value = 0.0;
+        filter->accumulator = 0.0;
+        filter->accumulator_partial = 0.0;
         filter->buffer_length = 0;
         filter->number_coefficients_in = 0;
         filter->number_coefficients_out = 0;
+        filter->number_sections = 0;
+        filter->state_length = 0;
         filter->current_input_index = 0;
         filter->current_output_index = 0;
+        filter->decimation_phase = 0;
         filter->initialized = false;
         filter->buffer_needs_cleanup = false;
+        filter->realization = DH_REALIZATION_DEFAULT;
+        filter->dot_product = NULL;
+        filter->symmetry = DH_FIR_NOT_SYMMETRIC;
+        filter->kernel = NULL;
+        filter->flush_denormals = false;
+        filter->denormal_check_interval = 0;
+        dh_overlap_save_assign_buffer(&filter->overlap_save, NULL, 0);
     }
     return DH_FILTER_OK;
 }
@@ -0,0 +1,123 @@
+#include "dh/overlap_save.h"
+#include "dh/fft.h"
+#include <string.h>
+
+/**
+ * @file
+ * @brief This file contains the overlap-save convolution for FIR filters with many coefficients.
+ *
+ * Every block of the FFT contains the last N-1 inputs followed by fft_length-N+1 new inputs.
+ * After the circular convolution with the coefficients, the last fft_length-N+1 values are the outputs
+ * for the new inputs.
+ *
+ * This source code is licensed under the MIT license. See file "LICENSE" at the root of the repository.
+ */
+
+size_t dh_overlap_save_fft_length(size_t number_coefficients)
+{
+    if (number_coefficients < DH_FILTER_FFT_MIN_COEFFICIENTS) {
+        return 0;
+    }
+    // about 3/4 of every block are new values
+    size_t length = 4;
+    while (length < 4 * number_coefficients) {
+        length *= 2;
+    }
+    return length;
+}
+
+size_t dh_overlap_save_buffer_length(size_t fft_length)
+{
+    return fft_length > 0 ? 3 * fft_length + 4 : 0;
+}
+
+void dh_overlap_save_assign_buffer(dh_overlap_save_data* data, double* buffer, size_t fft_length)
+{
+    if (fft_length == 0 || buffer == NULL) {
+        data->twiddles = NULL;
+        data->spectrum = NULL;
+        data->frame = NULL;
+        data->fft_length = 0;
+        return;
+    }
+    data->twiddles = buffer;
+    data->spectrum = buffer + fft_length;
+    data->frame = buffer + 2 * fft_length + 2;
+    data->fft_length = fft_length;
+}
+
+void dh_overlap_save_prepare(dh_filter_data* filter)
+{
+    dh_overlap_save_data* data = &filter->overlap_save;
+    const size_t length = data->fft_length;
+    if (length == 0 || filter->number_coefficients_in > length) {
+        return;
+    }
+    dh_fft_compute_twiddles(data->twiddles, length);
+    for (size_t i=0; i<length+2; ++i) {
+        data->spectrum[i] = i < filter->number_coefficients_in ? filter->coefficients_in[i] : 0.0;
+    }
+    dh_fft_real_forward(data->spectrum, length, data->twiddles);
+    // the inverse transform is scaled by length/2
+    const double scale = 2.0 / (double)length;
+    for (size_t i=0; i<length+2; ++i) {
+        data->spectrum[i] *= scale;
+    }
+}
+
+size_t dh_overlap_save_run(dh_filter_data* filter, const double* input, double* output, size_t count)
+{
+    const dh_overlap_save_data* data = &filter->overlap_save;
+    const size_t length = data->fft_length;
+    const size_t number_coefficients_in = filter->number_coefficients_in;
+    if (length == 0 || number_coefficients_in == 0 || number_coefficients_in > length) {
+        return 0;
+    }
+    const size_t block = length - number_coefficients_in + 1;
+    const size_t history = number_coefficients_in - 1;
+    const bool mirrored = filter->realization == DH_REALIZATION_DIRECT_FORM_1_MIRRORED;
+    const double gain = filter->coefficients_out[0];
+    double* inputs = filter->inputs;
+    double* frame = data->frame;
+    const double* spectrum = data->spectrum;
+    size_t input_index = filter->current_input_index;
+    size_t processed = 0;
+
+    while (count - processed >= block) {
+        // past inputs with the oldest value first. inputs[input_index] is the newest value.
+        for (size_t k=0; k<history; ++k) {
+            size_t position = input_index + k;
+            if (position >= number_coefficients_in) {
+                position -= number_coefficients_in;
+            }
+            frame[history - 1 - k] = inputs[position];
+        }
+        memcpy(frame + history, input + processed, block * sizeof(double));
+
+        // the history must be updated before the outputs are written, because input and output may be the same array
+        for (size_t k=0; k<block; ++k) {
+            input_index = input_index > 0 ? input_index - 1 : number_coefficients_in - 1U;
+            inputs[input_index] = frame[history + k];
+            if (mirrored) {
+                inputs[input_index + number_coefficients_in] = frame[history + k];
+            }
+        }
+
+        dh_fft_real_forward(frame, length, data->twiddles);
+        for (size_t k=0; k<=length/2; ++k) {
+            const double re = frame[2*k] * spectrum[2*k] - frame[2*k+1] * spectrum[2*k+1];
+            const double im = frame[2*k] * spectrum[2*k+1] + frame[2*k+1] * spectrum[2*k];
+            frame[2*k] = re;
+            frame[2*k+1] = im;
+        }
+        dh_fft_real_inverse(frame, length, data->twiddles);
+
+        for (size_t k=0; k<block; ++k) {
+            output[processed + k] = frame[history + k] * gain;
+        }
+        processed += block;
+    }
+
+    filter->current_input_index = input_index;
+    return processed;
+}
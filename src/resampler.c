@@ -0,0 +1,179 @@
+#include "dh/resampler.h"
+#include "dh/utility.h"
+#include <assert.h>
+#include <stdlib.h>
+
+/**
+ * @file
+ * @brief This file contains the polyphase resampler.
+ *
+ * The anti-aliasing filter h runs at L times the input rate. Output m corresponds to the upsampled index m*M = q*L + p.
+ * Only every L-th upsampled value is not zero, so the output is the sum of h[p + t*L] * x[q-t] over t.
+ * These coefficients form sub-filter p. The resampler tracks p in [phase]: every input advances the upsampled
+ * index by L, every output by M.
+ *
+ * This source code is licensed under the MIT license. See file "LICENSE" at the root of the repository.
+ */
+
+/**
+ * @brief Computes the greatest common divisor of [a] and [b].
+ */
+static size_t dh_resampler_gcd(size_t a, size_t b)
+{
+    while (b != 0) {
+        const size_t rest = a % b;
+        a = b;
+        b = rest;
+    }
+    return a;
+}
+
+DH_FILTER_RETURN_VALUE dh_create_resampler(dh_resampler_data* resampler, const dh_resampler_parameters* options)
+{
+    assert(resampler != NULL);
+    assert(options != NULL);
+    if (resampler == NULL || options == NULL) {
+        return DH_FILTER_NO_DATA_STRUCTURE;
+    }
+    if (options->interpolation == 0 || options->decimation == 0 || options->taps_per_phase == 0
+        || !(options->bandwidth > 0.0 && options->bandwidth <= 1.0)) {
+        return DH_FILTER_ERROR;
+    }
+    // a common factor of L and M would only add sub-filters that are never used
+    const size_t divisor = dh_resampler_gcd(options->interpolation, options->decimation);
+    const size_t interpolation = options->interpolation / divisor;
+    const size_t decimation = options->decimation / divisor;
+    const size_t taps = options->taps_per_phase;
+    const size_t number_coefficients = interpolation * taps;
+    resampler->buffer_length = (number_coefficients + 2 * taps) * sizeof(double);
+    resampler->buffer = (char*)malloc(resampler->buffer_length);
+    if (resampler->buffer == NULL) {
+        resampler->buffer_length = 0;
+        return DH_FILTER_ALLOCATION_FAILED;
+    }
+    resampler->coefficients = (double*)resampler->buffer;
+    resampler->history = resampler->coefficients + number_coefficients;
+    resampler->interpolation = interpolation;
+    resampler->decimation = decimation;
+    resampler->taps_per_phase = taps;
+    resampler->history_index = 0;
+    resampler->phase = 0;
+
+    double* prototype = (double*)malloc(number_coefficients * sizeof(double));
+    if (prototype == NULL) {
+        dh_free_resampler(resampler);
+        return DH_FILTER_ALLOCATION_FAILED;
+    }
+    const size_t max_factor = interpolation > decimation ? interpolation : decimation;
+    const double cutoff = 0.5 * options->bandwidth / (double)max_factor;
+    dh_fill_array_fir_sinc(prototype, number_coefficients, cutoff, false);
+    // every sub-filter sees only one of L upsampled values, so the gain is restored by a factor L
+    for (size_t p=0; p<interpolation; ++p) {
+        for (size_t t=0; t<taps; ++t) {
+            resampler->coefficients[p*taps + t] = prototype[p + t*interpolation] * (double)interpolation;
+        }
+    }
+    free(prototype);
+
+    resampler->dot_product = dh_select_dot_product_function(taps);
+    if (resampler->dot_product == NULL) {
+        resampler->dot_product = dh_dot_product_scalar;
+    }
+    dh_initialize_resampler(resampler, 0.0);
+    resampler->initialized = false;
+    return DH_FILTER_OK;
+}
+
+size_t dh_resampler_output_count(const dh_resampler_data* resampler, size_t input_count)
+{
+    if (resampler == NULL || resampler->decimation == 0) {
+        return 0;
+    }
+    const size_t end = input_count * resampler->interpolation;
+    if (resampler->phase >= end) {
+        return 0;
+    }
+    return (end - resampler->phase + resampler->decimation - 1) / resampler->decimation;
+}
+
+DH_FILTER_RETURN_VALUE dh_resample(dh_resampler_data* resampler, const double* input, size_t input_count, double* output, size_t* output_count)
+{
+    assert(resampler != NULL);
+    if (resampler == NULL) {
+        return DH_FILTER_NO_DATA_STRUCTURE;
+    }
+    if (resampler->buffer == NULL || resampler->taps_per_phase == 0) {
+        return DH_FILTER_DATA_STRUCTURE_NOT_INITIALIZED;
+    }
+    if (output_count != NULL) {
+        *output_count = 0;
+    }
+    if (input_count == 0) {
+        return DH_FILTER_OK;
+    }
+    if (input == NULL || output == NULL) {
+        return DH_FILTER_NO_DATA_STRUCTURE;
+    }
+    if (!resampler->initialized) {
+        dh_initialize_resampler(resampler, input[0]);
+    }
+    const size_t taps = resampler->taps_per_phase;
+    const size_t interpolation = resampler->interpolation;
+    const size_t decimation = resampler->decimation;
+    const double* coefficients = resampler->coefficients;
+    double* history = resampler->history;
+    const dh_dot_product_function dot_product = resampler->dot_product;
+    size_t history_index = resampler->history_index;
+    size_t phase = resampler->phase;
+    size_t written = 0;
+
+    for (size_t i=0; i<input_count; ++i) {
+        history_index = history_index > 0 ? history_index - 1 : taps - 1;
+        history[history_index] = input[i];
+        history[history_index + taps] = input[i];
+        while (phase < interpolation) {
+            output[written++] = dot_product(coefficients + phase * taps, history + history_index, taps);
+            phase += decimation;
+        }
+        phase -= interpolation;
+    }
+
+    resampler->history_index = history_index;
+    resampler->phase = phase;
+    if (output_count != NULL) {
+        *output_count = written;
+    }
+    return DH_FILTER_OK;
+}
+
+DH_FILTER_RETURN_VALUE dh_initialize_resampler(dh_resampler_data* resampler, double value)
+{
+    assert(resampler != NULL);
+    if (resampler == NULL) {
+        return DH_FILTER_NO_DATA_STRUCTURE;
+    }
+    for (size_t i=0; i<2*resampler->taps_per_phase && resampler->history != NULL; ++i) {
+        resampler->history[i] = value;
+    }
+    resampler->initialized = true;
+    return DH_FILTER_OK;
+}
+
+DH_FILTER_RETURN_VALUE dh_free_resampler(dh_resampler_data* resampler)
+{
+    if (resampler != NULL) {
+        free(resampler->buffer);
+        resampler->buffer = NULL;
+        resampler->buffer_length = 0;
+        resampler->coefficients = NULL;
+        resampler->history = NULL;
+        resampler->dot_product = NULL;
+        resampler->interpolation = 0;
+        resampler->decimation = 0;
+        resampler->taps_per_phase = 0;
+        resampler->history_index = 0;
+        resampler->phase = 0;
+        resampler->initialized = false;
+    }
+    return DH_FILTER_OK;
+}
@@ -3,6 +3,7 @@
 #define _USE_MATH_DEFINES
 #include "math.h"
 #include "stdlib.h"
+#include "assert.h"
 #include <complex.h>
 
 /**
@@ -82,6 +83,36 @@ void dh_normalize_gain_at(double* numerator, size_t len_numerator,double* denomi
     }
 }
 
+bool dh_filter_type_is_fir(DH_FILTER_TYPE type)
+{
+    return type == DH_NO_FILTER || type == DH_FIR_MOVING_AVERAGE_LOWPASS || type == DH_FIR_MOVING_AVERAGE_HIGHPASS ||
+        type == DH_FIR_EXPONENTIAL_MOVING_AVERAGE_LOWPASS || type == DH_FIR_BRICKWALL_LOWPASS ||
+        type == DH_FIR_BRICKWALL_HIGHPASS || type == DH_FIR_BRICKWALL_BANDPASS || type == DH_FIR_BRICKWALL_BANDSTOP;
+}
+
+void dh_fill_array_fir_sinc(double* data, size_t count,double cutoff, bool highpass) {
+    assert(data != NULL);
+    int xshift = (int)count/2;
+    for (size_t i=0; i<count; ++i) {
+        int idx = (int)i;
+        double x = 2*M_PI*cutoff*(idx-xshift);
+        data[i] = x!=0.0 ? sin(x)/x : 1.0;
+    }
+    double gain[1] = {1.0};
+    
+    dh_normalize_gain_at(data,count,gain,1,0.0);
+
+    if (highpass) {
+        for (size_t i=0; i<count; ++i) {
+            if(i!=(size_t)xshift) {
+                data[i] = -data[i];
+            } else {
+                data[i] = 1.0 - data[i];
+            }
+        }
+    }
+}
+
 void dh_convolve_parameters(double * param1,double * param2, size_t len,double * out ) {
     if(param1 == NULL || param2 == NULL || out==NULL) {
         return;
@@ -226,27 +257,21 @@ static size_t bilinear_z_transform_and_append_ones(COMPLEX* splane, size_t num_e
 }
 
 /**
- * @brief Computes the transfer function polynomial for a filter with the given roots.
+ * @brief Transforms the roots of an analog lowpass to the roots of the digital filter on the z-plane.
  * 
  * The roots are converted from an analog low pass to the desired characteristic and roots are appended
- * if needed. Then the roots are converted from the s-plane to the z-plane and the polynomial is expanded.
- * The real part of the polynomial coefficients is written to [output]. The order of the polynomial coefficients
- * is inverted: index 0 is the coefficient for x**n.
+ * if needed. Then the roots are converted from the s-plane to the z-plane.
  * 
  * @param type The type of the filter.
  * @param roots Array with complex roots of the polynomial on the s-plane for an analog lowpass.
  * @param count Number of roots.
  * @param center Center frequency of the filter.
  * @param width Width of the band of the filter. Ignored for lowpass and highpass.
- * @param polynomial Pointer to the buffer where the polynomial is expanded. Needs at least count+1 entries. 
- * @param output Pointer to the array where the outputs are written to. Needs at least count+1 entries.
  * @param target_count The target number of roots. Additional roots will be appended if there are not enough.
- * @return size_t Number of elements written to output.
+ * @return size_t Number of roots on the z-plane.
  */
-static size_t compute_transferfunction_polynomial(DH_FILTER_CHARACTERISTIC type, COMPLEX* roots, size_t count,
-                         double center, double width,
-                         COMPLEX* polynomial, double* output,
-                         size_t target_count){
+static size_t transform_roots_to_z_plane(DH_FILTER_CHARACTERISTIC type, COMPLEX* roots, size_t count,
+                         double center, double width, size_t target_count){
     switch(type) {
     case DH_LOWPASS:
         count = shiftLowpassFrequency(roots,count,center);
@@ -264,7 +289,31 @@ static size_t compute_transferfunction_polynomial(DH_FILTER_CHARACTERISTIC type,
         break;
     }
 
-    count = bilinear_z_transform_and_append_ones(roots,count,2.0,target_count-count);
+    return bilinear_z_transform_and_append_ones(roots,count,2.0,target_count-count);
+}
+
+/**
+ * @brief Computes the transfer function polynomial for a filter with the given roots.
+ * 
+ * The roots are transformed with transform_roots_to_z_plane() and the polynomial is expanded.
+ * The real part of the polynomial coefficients is written to [output]. The order of the polynomial coefficients
+ * is inverted: index 0 is the coefficient for x**n.
+ * 
+ * @param type The type of the filter.
+ * @param roots Array with complex roots of the polynomial on the s-plane for an analog lowpass.
+ * @param count Number of roots.
+ * @param center Center frequency of the filter.
+ * @param width Width of the band of the filter. Ignored for lowpass and highpass.
+ * @param polynomial Pointer to the buffer where the polynomial is expanded. Needs at least count+1 entries. 
+ * @param output Pointer to the array where the outputs are written to. Needs at least count+1 entries.
+ * @param target_count The target number of roots. Additional roots will be appended if there are not enough.
+ * @return size_t Number of elements written to output.
+ */
+static size_t compute_transferfunction_polynomial(DH_FILTER_CHARACTERISTIC type, COMPLEX* roots, size_t count,
+                         double center, double width,
+                         COMPLEX* polynomial, double* output,
+                         size_t target_count){
+    count = transform_roots_to_z_plane(type, roots, count, center, width, target_count);
     size_t polylen = count+1;
 
     dh_compute_polynomial_coefficients_from_roots(roots, polylen, polynomial);
@@ -329,7 +378,7 @@ DH_FILTER_RETURN_VALUE dh_compute_transfer_function_polynomials(dh_filter_data*
 
     // allocate temporary buffers
     size_t buffer_length = 4*filter_order+1;
-    COMPLEX* buffer = (COMPLEX*)malloc(sizeof(COMPLEX) * buffer_length);
+    COMPLEX* buffer = cbs.workspace != NULL ? (COMPLEX*)cbs.workspace : (COMPLEX*)malloc(sizeof(COMPLEX) * buffer_length);
     if(buffer == NULL) {
         return DH_FILTER_ALLOCATION_FAILED;
     }
@@ -345,10 +394,205 @@ DH_FILTER_RETURN_VALUE dh_compute_transfer_function_polynomials(dh_filter_data*
     size_t number_poles = cbs.poles(splane,polylen,filter_order,cbs.user_data);
     number_poles = compute_transferfunction_polynomial(type, splane, number_poles, center, width, polynomial, denominator, filter_order);
 
-    free(buffer);
+    if (buffer != cbs.workspace) {
+        free(buffer);
+    }
 
     // normalize gain to 1
     const double frequency = normalize_at_frequency(type, cutoff_frequency_low, cutoff_frequency_high, sampling_frequency);
     dh_normalize_gain_at(numerator,number_zeros,denominator,number_poles, frequency);
+    if (filter->sections != NULL) {
+        return dh_compute_second_order_sections(filter, options, cbs);
+    }
+    return DH_FILTER_OK;
+}
+
+/** Imaginary parts below this value are treated as real roots. */
+#define DH_REAL_ROOT_TOLERANCE 1e-9
+
+/**
+ * @brief Factors of a polynomial with real coefficients: z**2 + c1*z + c2.
+ */
+typedef struct {
+    /** Coefficient for z**1. */
+    double c1;
+    /** Coefficient for z**0. */
+    double c2;
+    /** One of the roots of the factor. Used to pair zeros and poles. */
+    COMPLEX root;
+    /** The largest magnitude of the roots. */
+    double radius;
+} dh_quadratic_factor;
+
+static int compare_real_part(const void* lhs, const void* rhs) {
+    const double a = creal(*(const COMPLEX*)lhs);
+    const double b = creal(*(const COMPLEX*)rhs);
+    return (a > b) - (a < b);
+}
+
+static int compare_radius(const void* lhs, const void* rhs) {
+    const double a = ((const dh_quadratic_factor*)lhs)->radius;
+    const double b = ((const dh_quadratic_factor*)rhs)->radius;
+    return (a > b) - (a < b);
+}
+
+/**
+ * @brief Groups the roots of a polynomial with real coefficients into quadratic factors.
+ * 
+ * Each complex root is combined with its conjugate. The remaining real roots are sorted and
+ * neighbours are combined. If there is an odd number of real roots, the last factor has only one root (c2 = 0).
+ * 
+ * @param roots Array of roots. The array is reordered.
+ * @param count Number of roots.
+ * @param factors Output array. Must have (count+1)/2 entries.
+ * @return Number of written factors.
+ */
+static size_t group_roots_into_quadratic_factors(COMPLEX* roots, size_t count, dh_quadratic_factor* factors) {
+    size_t number_factors = 0;
+    size_t number_real = 0;
+    for(size_t i=0; i<count; ++i) {
+        const COMPLEX root = roots[i];
+        if (fabs(cimag(root)) <= DH_REAL_ROOT_TOLERANCE) {
+            // move the real roots to the front of the array
+            roots[i] = roots[number_real];
+            roots[number_real] = root;
+            ++number_real;
+            continue;
+        }
+        if (cimag(root) < 0.0) {
+            continue;
+        }
+        factors[number_factors].c1 = -2.0 * creal(root);
+        factors[number_factors].c2 = creal(root)*creal(root) + cimag(root)*cimag(root);
+        factors[number_factors].root = root;
+        factors[number_factors].radius = cabs(root);
+        ++number_factors;
+    }
+    qsort(roots, number_real, sizeof(COMPLEX), &compare_real_part);
+    for(size_t i=0; i<number_real; i+=2) {
+        const double first = creal(roots[i]);
+        const double second = i+1 < number_real ? creal(roots[i+1]) : 0.0;
+        factors[number_factors].c1 = -(first + second);
+        factors[number_factors].c2 = first * second;
+        factors[number_factors].root = MAKE_COMPLEX_NUMER(first, 0.0);
+        factors[number_factors].radius = fmax(fabs(first), fabs(second));
+        ++number_factors;
+    }
+    return number_factors;
+}
+
+/**
+ * @brief Evaluates the section at the given position on the complex unit circle.
+ */
+static COMPLEX evaluate_section(const double* section, double x_evaluate) {
+    double numerator[3] = {section[0], section[1], section[2]};
+    double denominator[3] = {1.0, section[3], section[4]};
+    return dh_gain_at(numerator, 3, denominator, 3, x_evaluate);
+}
+
+COMPLEX dh_gain_at_sections(const double* sections, size_t number_sections, double x_evaluate)
+{
+    COMPLEX rv = MAKE_COMPLEX_NUMER(1.0,0.0);
+    if (sections == NULL) {
+        return rv;
+    }
+    for(size_t i=0; i<number_sections; ++i) {
+        rv = COMPLEX_MUL(rv, evaluate_section(sections + 5*i, x_evaluate));
+    }
+    return rv;
+}
+
+size_t dh_transfer_function_workspace_size(size_t filter_order)
+{
+    // the polynomials and the sections are computed one after another and share the memory
+    const size_t polynomials = (4*filter_order+1) * sizeof(COMPLEX);
+    const size_t sections = 4*filter_order * sizeof(COMPLEX) + 2*filter_order * sizeof(dh_quadratic_factor);
+    return polynomials > sections ? polynomials : sections;
+}
+
+DH_FILTER_RETURN_VALUE dh_compute_second_order_sections(dh_filter_data* filter, const dh_filter_parameters* options, const dh_transfer_function_callbacks cbs)
+{
+    if(filter == NULL || options == NULL || filter->sections == NULL || cbs.zeros == NULL || cbs.poles == NULL) {
+        return DH_FILTER_NO_DATA_STRUCTURE;
+    }
+    const DH_FILTER_CHARACTERISTIC type = cbs.characteristic;
+    const size_t filter_order = options->filter_order;
+    const double cutoff_frequency_low =  options->cutoff_frequency_low;
+    const double cutoff_frequency_high =  options->cutoff_frequency_high;
+    const double sampling_frequency =  options->sampling_frequency;
+    
+    double warped_low = 4 * transform_frequency(cutoff_frequency_low/sampling_frequency);
+    double warped_high = 4 * transform_frequency(cutoff_frequency_high/sampling_frequency);
+    
+    double center = compute_center(type,warped_low,warped_high);
+    double width = compute_width(type,warped_low,warped_high);
+
+    // allocate temporary buffers
+    const size_t max_roots = 2*filter_order;
+    const size_t max_factors = filter_order;
+    char* buffer = cbs.workspace != NULL ? (char*)cbs.workspace : (char*)malloc(2 * max_roots * sizeof(COMPLEX) + 2 * max_factors * sizeof(dh_quadratic_factor));
+    if(buffer == NULL) {
+        return DH_FILTER_ALLOCATION_FAILED;
+    }
+    COMPLEX* zeros = (COMPLEX*)buffer;
+    COMPLEX* poles = zeros + max_roots;
+    dh_quadratic_factor* zero_factors = (dh_quadratic_factor*)(poles + max_roots);
+    dh_quadratic_factor* pole_factors = zero_factors + max_factors;
+
+    size_t number_zeros = cbs.zeros(zeros,max_roots,filter_order,cbs.user_data);
+    number_zeros = transform_roots_to_z_plane(type, zeros, number_zeros, center, width, filter_order);
+    size_t number_poles = cbs.poles(poles,max_roots,filter_order,cbs.user_data);
+    number_poles = transform_roots_to_z_plane(type, poles, number_poles, center, width, filter_order);
+    assert(number_zeros == number_poles);
+
+    size_t number_zero_factors = group_roots_into_quadratic_factors(zeros, number_zeros, zero_factors);
+    size_t number_sections = group_roots_into_quadratic_factors(poles, number_poles, pole_factors);
+    assert(number_zero_factors == number_sections);
+    assert(number_sections <= filter->number_sections);
+
+    // the poles closest to the unit circle are placed last and are paired first with the closest zeros
+    qsort(pole_factors, number_sections, sizeof(dh_quadratic_factor), &compare_radius);
+    const double frequency = normalize_at_frequency(type, cutoff_frequency_low, cutoff_frequency_high, sampling_frequency);
+    for(size_t k=number_sections; k>0; --k) {
+        const dh_quadratic_factor* pole = &pole_factors[k-1];
+        size_t best = 0;
+        double best_distance = INFINITY;
+        for(size_t i=0; i<number_zero_factors; ++i) {
+            double distance = cabs(COMPLEX_SUB(zero_factors[i].root, pole->root));
+            if (distance < best_distance) {
+                best_distance = distance;
+                best = i;
+            }
+        }
+        double* section = filter->sections + 5*(k-1);
+        section[0] = 1.0;
+        section[1] = zero_factors[best].c1;
+        section[2] = zero_factors[best].c2;
+        section[3] = pole->c1;
+        section[4] = pole->c2;
+        zero_factors[best] = zero_factors[number_zero_factors-1];
+        --number_zero_factors;
+
+        // normalize every section to gain 1, so that the intermediate values have the same magnitude as the output
+        double gain = cabs(evaluate_section(section, frequency));
+        if (gain > 0.0) {
+            section[0] /= gain;
+            section[1] /= gain;
+            section[2] /= gain;
+        }
+    }
+    if (buffer != cbs.workspace) {
+        free(buffer);
+    }
+
+    // unused sections are passed through
+    for(size_t k=number_sections; k<filter->number_sections; ++k) {
+        double* section = filter->sections + 5*k;
+        section[0] = 1.0;
+        section[1] = 0.0;
+        section[2] = 0.0;
+        section[3] = 0.0;
+        section[4] = 0.0;
+    }
     return DH_FILTER_OK;
 }
@@ -0,0 +1,177 @@
+#include "catch2/catch_test_macros.hpp"
+#include "dh/filter.h"
+#include "test-helpers.hpp"
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+/**
+ * This source code is licensed under the MIT license. See file "LICENSE" at the root of the repository.
+ */
+
+static std::vector<double> filter_single_values(dh_filter_parameters opts, const std::vector<double>& input) {
+    dh_filter_data filter;
+    REQUIRE(dh_create_filter(&filter, &opts) == DH_FILTER_OK);
+    std::vector<double> rv(input.size());
+    for(size_t i=0; i<input.size(); ++i) {
+        REQUIRE(dh_filter(&filter, input[i], &rv[i]) == DH_FILTER_OK);
+    }
+    dh_free_filter(&filter);
+    return rv;
+}
+
+SCENARIO( "Blocks of values can be filtered", "[filter]" ) {
+    const DH_FILTER_TYPE types[] = {
+        DH_NO_FILTER,
+        DH_FIR_MOVING_AVERAGE_LOWPASS,
+        DH_FIR_MOVING_AVERAGE_HIGHPASS,
+        DH_FIR_EXPONENTIAL_MOVING_AVERAGE_LOWPASS,
+        DH_FIR_BRICKWALL_LOWPASS,
+        DH_FIR_BRICKWALL_BANDSTOP,
+        DH_IIR_EXPONENTIAL_LOWPASS,
+        DH_IIR_BUTTERWORTH_LOWPASS,
+        DH_IIR_BUTTERWORTH_HIGHPASS,
+        DH_IIR_CHEBYSHEV_BANDPASS,
+        DH_IIR_CHEBYSHEV2_BANDSTOP
+    };
+    const auto input = create_test_signal(500);
+
+    for(auto type : types) {
+        GIVEN( "A filter of type " + std::to_string(static_cast<int>(type)) ) {
+            auto opts = create_test_parameters(type, 6);
+            const auto expected = filter_single_values(opts, input);
+            dh_filter_data filter;
+            REQUIRE(dh_create_filter(&filter, &opts) == DH_FILTER_OK);
+
+            WHEN( "the whole signal is filtered as one block" ) {
+                std::vector<double> output(input.size());
+                REQUIRE(dh_filter_block(&filter, input.data(), output.data(), input.size()) == DH_FILTER_OK);
+                THEN( "the output is identical to filtering every value" ) {
+                    for(size_t i=0; i<input.size(); ++i) {
+                        REQUIRE(output[i] == expected[i]);
+                    }
+                    REQUIRE(filter.current_value == expected.back());
+                }
+            }
+
+            WHEN( "the signal is filtered in place with blocks of different sizes and single values" ) {
+                std::vector<double> data = input;
+                size_t position = 0;
+                size_t block = 1;
+                while(position < data.size()) {
+                    size_t count = std::min(block, data.size()-position);
+                    REQUIRE(dh_filter_block_inplace(&filter, data.data()+position, count) == DH_FILTER_OK);
+                    position += count;
+                    if (position < data.size()) {
+                        REQUIRE(dh_filter(&filter, data[position], &data[position]) == DH_FILTER_OK);
+                        position += 1;
+                    }
+                    block = (block*3)%41 + 1;
+                }
+                THEN( "the output is identical to filtering every value" ) {
+                    for(size_t i=0; i<input.size(); ++i) {
+                        REQUIRE(data[i] == expected[i]);
+                    }
+                }
+            }
+
+            WHEN( "the signal is read and written with strides" ) {
+                std::vector<double> strided_input(3*input.size(), -100.0);
+                std::vector<double> strided_output(2*input.size(), -100.0);
+                for(size_t i=0; i<input.size(); ++i) {
+                    strided_input[3*i] = input[i];
+                }
+                REQUIRE(dh_filter_block_strided(&filter, strided_input.data(), 3, strided_output.data(), 2, input.size()) == DH_FILTER_OK);
+                THEN( "the output is identical to filtering every value" ) {
+                    for(size_t i=0; i<input.size(); ++i) {
+                        REQUIRE(strided_output[2*i] == expected[i]);
+                        REQUIRE(strided_output[2*i+1] == -100.0);
+                    }
+                    REQUIRE(filter.current_value == expected.back());
+                }
+            }
+            dh_free_filter(&filter);
+        }
+    }
+}
+
+SCENARIO( "The block API validates its arguments", "[filter]" ) {
+    GIVEN( "A butterworth filter" ) {
+        auto opts = create_test_parameters(DH_IIR_BUTTERWORTH_LOWPASS, 2);
+        dh_filter_data filter;
+        REQUIRE(dh_create_filter(&filter, &opts) == DH_FILTER_OK);
+        double value = 1.0;
+
+        THEN( "NULL arguments are rejected" ) {
+            REQUIRE(dh_filter_block(&filter, NULL, &value, 1) == DH_FILTER_NO_DATA_STRUCTURE);
+            REQUIRE(dh_filter_block(&filter, &value, NULL, 1) == DH_FILTER_NO_DATA_STRUCTURE);
+            REQUIRE(dh_filter_block_inplace(&filter, NULL, 1) == DH_FILTER_NO_DATA_STRUCTURE);
+        }
+
+        THEN( "empty blocks do not initialize the filter" ) {
+            REQUIRE(dh_filter_block(&filter, NULL, NULL, 0) == DH_FILTER_OK);
+            REQUIRE(filter.initialized == false);
+        }
+
+        WHEN( "the filter is freed" ) {
+            dh_free_filter(&filter);
+            THEN( "the filter can no longer be used" ) {
+                REQUIRE(dh_filter_block(&filter, &value, &value, 1) == DH_FILTER_DATA_STRUCTURE_NOT_INITIALIZED);
+            }
+        }
+        dh_free_filter(&filter);
+    }
+}
+
+SCENARIO( "Interleaved frames can be filtered in place", "[filter]" ) {
+    GIVEN( "One filter per channel" ) {
+        const DH_FILTER_TYPE types[] = {
+            DH_FIR_BRICKWALL_LOWPASS,
+            DH_IIR_BUTTERWORTH_LOWPASS,
+            DH_IIR_CHEBYSHEV_BANDPASS,
+            DH_FIR_MOVING_AVERAGE_LOWPASS,
+            DH_IIR_EXPONENTIAL_LOWPASS
+        };
+        const size_t orders[] = {40, 6, 4, 20, 1};
+        const size_t number_channels = sizeof(types)/sizeof(types[0]);
+        const size_t number_frames = 3000;
+        std::vector<dh_filter_data> filters(number_channels);
+        std::vector<std::vector<double>> expected(number_channels);
+        std::vector<double> frames(number_channels * number_frames);
+        for(size_t c=0; c<number_channels; ++c) {
+            auto opts = create_test_parameters(types[c], orders[c]);
+            auto input = create_test_signal(number_frames + c);
+            input.erase(input.begin(), input.begin() + c);
+            expected[c] = filter_single_values(opts, input);
+            REQUIRE(dh_create_filter(&filters[c], &opts) == DH_FILTER_OK);
+            for(size_t i=0; i<number_frames; ++i) {
+                frames[i*number_channels + c] = input[i];
+            }
+        }
+
+        WHEN( "the frames are filtered" ) {
+            REQUIRE(dh_filter_frames_inplace(filters.data(), number_channels, frames.data(), 1000) == DH_FILTER_OK);
+            REQUIRE(dh_filter_frames_inplace(filters.data(), number_channels, frames.data() + 1000*number_channels, 2000) == DH_FILTER_OK);
+            THEN( "every channel is identical to filtering it alone" ) {
+                for(size_t c=0; c<number_channels; ++c) {
+                    for(size_t i=0; i<number_frames; ++i) {
+                        REQUIRE(std::fabs(frames[i*number_channels + c] - expected[c][i]) < 1e-12);
+                    }
+                }
+            }
+        }
+
+        WHEN( "one of the filters is not initialized" ) {
+            dh_free_filter(&filters[2]);
+            const auto copy = frames;
+            THEN( "no value is changed" ) {
+                REQUIRE(dh_filter_frames_inplace(filters.data(), number_channels, frames.data(), number_frames) == DH_FILTER_DATA_STRUCTURE_NOT_INITIALIZED);
+                REQUIRE(frames == copy);
+            }
+        }
+        for(auto& filter : filters) {
+            dh_free_filter(&filter);
+        }
+    }
+}
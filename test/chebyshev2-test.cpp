@@ -11,7 +11,7 @@
 SCENARIO( "Chebyshev type 2 design", "[filter]" ) {
     GIVEN("I need to compute coefficients for a second order chebyshev type2 lowpass at 15 Hz/100Hz with -0.3dB ripple") {
       dh_filter_data filter_data;
-      dh_filter_parameters opts;
+      dh_filter_parameters opts{};
       opts.filter_type = DH_IIR_CHEBYSHEV2_LOWPASS;
       opts.cutoff_frequency_low = 15.0;
       opts.sampling_frequency = 100.0;
@@ -46,7 +46,7 @@ SCENARIO( "Chebyshev type 2 design", "[filter]" ) {
 
     GIVEN("I need to compute coefficients for a second order chebyshev type2 highpass at 15 Hz/100Hz with -0.3dB ripple") {
       dh_filter_data filter_data;
-      dh_filter_parameters opts;
+      dh_filter_parameters opts{};
       opts.filter_type = DH_IIR_CHEBYSHEV2_HIGHPASS;
       opts.cutoff_frequency_low = 15.0;
       opts.sampling_frequency = 100.0;
@@ -81,7 +81,7 @@ SCENARIO( "Chebyshev type 2 design", "[filter]" ) {
 
     GIVEN("I need to compute a second order bandpass at [30Hz,60Hz] for 200Hz sampling rate with 3db ripple") {
       dh_filter_data filter_data;
-      dh_filter_parameters opts;
+      dh_filter_parameters opts{};
       opts.filter_type = DH_IIR_CHEBYSHEV2_BANDPASS;
       opts.cutoff_frequency_low = 30.0;
       opts.cutoff_frequency_high = 60.0;
@@ -115,7 +115,7 @@ SCENARIO( "Chebyshev type 2 design", "[filter]" ) {
 
     GIVEN("I need to compute a second order bandstop at [30Hz,60Hz] for 200Hz sampling rate with 3db ripple") {
       dh_filter_data filter_data;
-      dh_filter_parameters opts;
+      dh_filter_parameters opts{};
       opts.filter_type = DH_IIR_CHEBYSHEV2_BANDSTOP;
       opts.cutoff_frequency_low = 30.0;
       opts.cutoff_frequency_high = 60.0;
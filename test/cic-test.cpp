@@ -0,0 +1,186 @@
+#include "catch2/catch_test_macros.hpp"
+#include "dh/cic.h"
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * This source code is licensed under the MIT license. See file "LICENSE" at the root of the repository.
+ */
+
+static int32_t cic_input(size_t i) {
+    const double t = static_cast<double>(i);
+    return static_cast<int32_t>(2000000000.0 * (0.45*std::sin(0.01*t) + 0.45*std::sin(0.7*t + 1.0)) + (i%37 < 5 ? 100000000 : -100000000));
+}
+
+/** Applies N moving sums of length R*M at the high rate. */
+static std::vector<int64_t> moving_sums(std::vector<int64_t> values, size_t stages, size_t length) {
+    for(size_t k=0; k<stages; ++k) {
+        std::vector<int64_t> result(values.size(), 0);
+        int64_t sum = 0;
+        for(size_t i=0; i<values.size(); ++i) {
+            sum += values[i];
+            if (i >= length) {
+                sum -= values[i - length];
+            }
+            result[i] = sum;
+        }
+        values = result;
+    }
+    return values;
+}
+
+/** Frequency response of the impulse response h of length R*M convolved N times with itself, normalized to 1 at 0 Hz. */
+static double reference_magnitude(size_t stages, size_t length, double frequency) {
+    std::vector<int64_t> impulse(stages * length, 0);
+    impulse[0] = 1;
+    const auto h = moving_sums(impulse, stages, length);
+    double re = 0.0;
+    double im = 0.0;
+    double dc = 0.0;
+    for(size_t i=0; i<h.size(); ++i) {
+        re += static_cast<double>(h[i]) * std::cos(2.0*M_PI*frequency*static_cast<double>(i));
+        im -= static_cast<double>(h[i]) * std::sin(2.0*M_PI*frequency*static_cast<double>(i));
+        dc += static_cast<double>(h[i]);
+    }
+    return std::sqrt(re*re + im*im) / dc;
+}
+
+SCENARIO( "CIC filters decimate and interpolate without multiplications", "[filter]" ) {
+    struct test_case {
+        size_t stages;
+        size_t rate;
+        size_t differential_delay;
+    };
+    const test_case cases[] = {
+        {1, 4, 1},
+        {3, 8, 1},
+        {4, 16, 2},
+        {5, 25, 1}
+    };
+    const size_t count = 4000;
+
+    for(const auto& current : cases) {
+        const size_t length = current.rate * current.differential_delay;
+        GIVEN( "A CIC decimator with " + std::to_string(current.stages) + " stages and the rate change " + std::to_string(current.rate) ) {
+            dh_cic_parameters opts{current.stages, current.rate, current.differential_delay, false};
+            dh_cic_data cic;
+            REQUIRE(dh_create_cic(&cic, &opts) == DH_FILTER_OK);
+            REQUIRE(cic.gain == std::pow(static_cast<double>(length), static_cast<double>(current.stages)));
+            std::vector<int64_t> high(count);
+            std::vector<int32_t> input(count);
+            for(size_t i=0; i<count; ++i) {
+                input[i] = cic_input(i);
+                high[i] = input[i];
+            }
+            const auto filtered = moving_sums(high, current.stages, length);
+
+            WHEN( "the signal is filtered in blocks of different lengths" ) {
+                std::vector<int64_t> output;
+                const size_t block_sizes[] = {1, 3, 17, 500, count - 521};
+                size_t position = 0;
+                for(size_t block : block_sizes) {
+                    const size_t expected = dh_cic_output_count(&cic, block);
+                    std::vector<int64_t> buffer(expected + 1);
+                    size_t written = 0;
+                    REQUIRE(dh_cic_filter(&cic, input.data() + position, block, buffer.data(), &written) == DH_FILTER_OK);
+                    REQUIRE(written == expected);
+                    output.insert(output.end(), buffer.begin(), buffer.begin() + written);
+                    position += block;
+                }
+                THEN( "the outputs are every R-th value of the moving sums" ) {
+                    REQUIRE(output.size() == count / current.rate);
+                    for(size_t m=0; m<output.size(); ++m) {
+                        REQUIRE(output[m] == filtered[(m + 1)*current.rate - 1]);
+                    }
+                }
+            }
+
+            WHEN( "the frequency response is computed" ) {
+                THEN( "it is the normalized response of the moving sums" ) {
+                    for(double f=0.0; f<=0.5; f+=0.0123) {
+                        dh_frequency_response_t response;
+                        REQUIRE(dh_cic_get_gain_at(&cic, f, &response) == DH_FILTER_OK);
+                        REQUIRE(std::fabs(response.gain - reference_magnitude(current.stages, length, f)) < 1e-9);
+                    }
+                }
+            }
+
+            WHEN( "a compensation filter is designed" ) {
+                const double cutoff = 0.25;
+                std::vector<double> coefficients(41);
+                REQUIRE(dh_cic_compensation_fir(&cic, coefficients.data(), coefficients.size(), cutoff) == DH_FILTER_OK);
+                THEN( "the passband of both filters is flat" ) {
+                    double sum = 0.0;
+                    for(double c : coefficients) {
+                        sum += c;
+                    }
+                    REQUIRE(std::fabs(sum - 1.0) < 1e-12);
+                    double max_deviation_compensated = 0.0;
+                    double max_deviation_cic = 0.0;
+                    for(double f=0.0; f<=0.6*cutoff; f+=0.005) {
+                        double re = 0.0;
+                        double im = 0.0;
+                        for(size_t i=0; i<coefficients.size(); ++i) {
+                            re += coefficients[i] * std::cos(2.0*M_PI*f*static_cast<double>(i));
+                            im -= coefficients[i] * std::sin(2.0*M_PI*f*static_cast<double>(i));
+                        }
+                        dh_frequency_response_t response;
+                        REQUIRE(dh_cic_get_gain_at(&cic, f / static_cast<double>(current.rate), &response) == DH_FILTER_OK);
+                        max_deviation_compensated = std::fmax(max_deviation_compensated, std::fabs(std::sqrt(re*re + im*im) * response.gain - 1.0));
+                        max_deviation_cic = std::fmax(max_deviation_cic, std::fabs(response.gain - 1.0));
+                    }
+                    REQUIRE(max_deviation_compensated < 0.02);
+                    REQUIRE(max_deviation_compensated < 0.25 * max_deviation_cic);
+                }
+            }
+            dh_free_cic(&cic);
+        }
+
+        GIVEN( "A CIC interpolator with " + std::to_string(current.stages) + " stages and the rate change " + std::to_string(current.rate) ) {
+            dh_cic_parameters opts{current.stages, current.rate, current.differential_delay, true};
+            dh_cic_data cic;
+            REQUIRE(dh_create_cic(&cic, &opts) == DH_FILTER_OK);
+            const size_t input_count = 300;
+            std::vector<int32_t> input(input_count);
+            std::vector<int64_t> high(input_count * current.rate, 0);
+            for(size_t i=0; i<input_count; ++i) {
+                input[i] = cic_input(i) / 8;
+                high[i * current.rate] = input[i];
+            }
+            const auto filtered = moving_sums(high, current.stages, length);
+            WHEN( "the signal is filtered in two blocks" ) {
+                std::vector<int64_t> output(dh_cic_output_count(&cic, input_count));
+                size_t first = 0;
+                size_t second = 0;
+                REQUIRE(dh_cic_filter(&cic, input.data(), 101, output.data(), &first) == DH_FILTER_OK);
+                REQUIRE(dh_cic_filter(&cic, input.data() + 101, input_count - 101, output.data() + first, &second) == DH_FILTER_OK);
+                THEN( "the outputs are the moving sums of the signal with inserted zeros" ) {
+                    REQUIRE(first + second == filtered.size());
+                    REQUIRE(output == filtered);
+                }
+            }
+            dh_free_cic(&cic);
+        }
+    }
+
+    GIVEN( "Invalid parameters" ) {
+        dh_cic_data cic{};
+        THEN( "the filter is not created" ) {
+            dh_cic_parameters opts{0, 4, 1, false};
+            REQUIRE(dh_create_cic(&cic, &opts) == DH_FILTER_ERROR);
+            opts = dh_cic_parameters{3, 0, 1, false};
+            REQUIRE(dh_create_cic(&cic, &opts) == DH_FILTER_ERROR);
+            opts = dh_cic_parameters{3, 4, 0, false};
+            REQUIRE(dh_create_cic(&cic, &opts) == DH_FILTER_ERROR);
+            // (1024*2)^3 needs 33 bits
+            opts = dh_cic_parameters{3, 1024, 2, false};
+            REQUIRE(dh_create_cic(&cic, &opts) == DH_FILTER_ERROR);
+            opts = dh_cic_parameters{3, 1024, 1, false};
+            REQUIRE(dh_create_cic(&cic, &opts) == DH_FILTER_OK);
+            REQUIRE(cic.bit_growth == 30);
+            dh_free_cic(&cic);
+        }
+    }
+}
@@ -0,0 +1,94 @@
+#include "catch2/catch_test_macros.hpp"
+#include "dh/cpp/design.hpp"
+#include "dh/cpp/filter.hpp"
+#include <cmath>
+#include <string>
+#include <vector>
+
+/**
+ * This source code is licensed under the MIT license. See file "LICENSE" at the root of the repository.
+ */
+
+template<DH_FILTER_TYPE Type, size_t Order>
+constexpr dh_filter_parameters create_parameters() {
+    dh_filter_parameters opts{};
+    opts.filter_type = Type;
+    opts.filter_order = Order;
+    opts.cutoff_frequency_low = 10.0;
+    opts.cutoff_frequency_high = 20.0;
+    opts.sampling_frequency = 100.0;
+    opts.ripple = -1.0;
+    return opts;
+}
+
+/** Returns the largest difference between the coefficients designed at compile time and at runtime, relative to the largest coefficient. */
+template<DH_FILTER_TYPE Type, size_t Order>
+double compare_design() {
+    static constexpr auto coefficients = dh::design<Type, Order>(create_parameters<Type, Order>());
+    auto opts = create_parameters<Type, Order>();
+    opts.realization = DH_REALIZATION_DIRECT_FORM_1;
+    dh_filter_data reference;
+    REQUIRE(dh_create_filter(&reference, &opts) == DH_FILTER_OK);
+    REQUIRE(reference.number_coefficients_in == coefficients.feedforward.size());
+    REQUIRE(reference.number_coefficients_out == coefficients.feedback.size());
+    REQUIRE(reference.initialized == coefficients.initialized);
+    double largest = 0.0;
+    double difference = 0.0;
+    for(size_t i=0; i<coefficients.feedforward.size(); ++i) {
+        largest = std::fmax(largest, std::fabs(reference.coefficients_in[i]));
+        difference = std::fmax(difference, std::fabs(reference.coefficients_in[i] - coefficients.feedforward[i]));
+    }
+    for(size_t i=0; i<coefficients.feedback.size(); ++i) {
+        largest = std::fmax(largest, std::fabs(reference.coefficients_out[i]));
+        difference = std::fmax(difference, std::fabs(reference.coefficients_out[i] - coefficients.feedback[i]));
+    }
+    dh_free_filter(&reference);
+    return difference / largest;
+}
+
+SCENARIO( "Filters can be designed at compile time", "[filter]" ) {
+    GIVEN( "Coefficients designed in a constant expression" ) {
+        static constexpr auto coefficients = dh::design<DH_IIR_BUTTERWORTH_LOWPASS, 4>(create_parameters<DH_IIR_BUTTERWORTH_LOWPASS, 4>());
+        static_assert(coefficients.feedforward.size() == 5, "a 4th order lowpass has 5 coefficients");
+        static_assert(coefficients.feedback[0] == 1.0, "the gain is 1");
+        static_assert(!coefficients.initialized, "lowpass filters start in the steady state of the first input");
+        WHEN( "a filter is created from them" ) {
+            dh::static_filter<5, 5> filter(coefficients);
+            auto reference = dh::filter(create_parameters<DH_IIR_BUTTERWORTH_LOWPASS, 4>());
+            THEN( "the outputs are the same as for a filter designed at runtime" ) {
+                for(size_t i=0; i<500; ++i) {
+                    const double value = 2.0 + std::sin(0.1*static_cast<double>(i)) + (i%31 < 9 ? 1.0 : -1.0);
+                    REQUIRE(std::fabs(filter.update(value) - reference.update(value)) < 1e-10);
+                }
+            }
+        }
+    }
+
+    GIVEN( "All supported filter types" ) {
+        THEN( "the coefficients are the same as the ones designed at runtime up to rounding errors" ) {
+            REQUIRE(compare_design<DH_FIR_BRICKWALL_LOWPASS, 10>() < 1e-12);
+            REQUIRE(compare_design<DH_FIR_BRICKWALL_HIGHPASS, 31>() < 1e-12);
+            REQUIRE(compare_design<DH_FIR_BRICKWALL_BANDPASS, 20>() < 1e-12);
+            REQUIRE(compare_design<DH_FIR_BRICKWALL_BANDSTOP, 20>() < 1e-12);
+            REQUIRE(compare_design<DH_IIR_BUTTERWORTH_LOWPASS, 1>() < 1e-12);
+            REQUIRE(compare_design<DH_IIR_BUTTERWORTH_LOWPASS, 7>() < 1e-12);
+            REQUIRE(compare_design<DH_IIR_BUTTERWORTH_HIGHPASS, 5>() < 1e-12);
+            REQUIRE(compare_design<DH_IIR_BUTTERWORTH_BANDPASS, 3>() < 1e-12);
+            REQUIRE(compare_design<DH_IIR_BUTTERWORTH_BANDSTOP, 4>() < 1e-12);
+            REQUIRE(compare_design<DH_IIR_CHEBYSHEV_LOWPASS, 6>() < 1e-12);
+            REQUIRE(compare_design<DH_IIR_CHEBYSHEV_HIGHPASS, 3>() < 1e-12);
+            REQUIRE(compare_design<DH_IIR_CHEBYSHEV_BANDPASS, 4>() < 1e-12);
+            REQUIRE(compare_design<DH_IIR_CHEBYSHEV_BANDSTOP, 2>() < 1e-12);
+            REQUIRE(compare_design<DH_IIR_CHEBYSHEV2_LOWPASS, 5>() < 1e-12);
+            REQUIRE(compare_design<DH_IIR_CHEBYSHEV2_HIGHPASS, 4>() < 1e-12);
+            REQUIRE(compare_design<DH_IIR_CHEBYSHEV2_BANDPASS, 3>() < 1e-12);
+            REQUIRE(compare_design<DH_IIR_CHEBYSHEV2_BANDSTOP, 4>() < 1e-12);
+        }
+    }
+
+    GIVEN( "Parameters that do not match the template arguments" ) {
+        THEN( "the design throws at runtime" ) {
+            REQUIRE_THROWS_AS((dh::design<DH_IIR_BUTTERWORTH_LOWPASS, 3>(create_parameters<DH_IIR_BUTTERWORTH_LOWPASS, 4>())), dh::filter_error);
+        }
+    }
+}
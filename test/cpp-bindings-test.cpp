@@ -2,7 +2,11 @@
 #include "catch2/catch_test_macros.hpp"
 #include "catch2/catch_approx.hpp"
 #include "dh/cpp/filter.hpp"
+#include "dh/cpp/static_filter.hpp"
 #include <cstring>
+#include <cmath>
+#include <type_traits>
+#include <vector>
 
 /**
  * This source code is licensed under the MIT license. See file "LICENSE" at the root of the repository.
@@ -11,7 +15,7 @@
 SCENARIO( "The cpp bindings can be used", "[filter]" ) {
 
     GIVEN( "An options structure filled with values for FIR exponential lowpass filters" ) {
-        dh_filter_parameters opts;
+        dh_filter_parameters opts{};
         opts.filter_type = DH_FIR_EXPONENTIAL_MOVING_AVERAGE_LOWPASS;
         opts.cutoff_frequency_low = 15;
         opts.cutoff_frequency_high = 25;
@@ -31,7 +35,7 @@ SCENARIO( "The cpp bindings can be used", "[filter]" ) {
     }
 
     GIVEN( "An options structure filled with values for FIR moving average lowpass filters" ) {
-        dh_filter_parameters opts;
+        dh_filter_parameters opts{};
         opts.filter_type = DH_FIR_MOVING_AVERAGE_LOWPASS;
         opts.cutoff_frequency_low = 15;
         opts.cutoff_frequency_high = 25;
@@ -53,7 +57,7 @@ SCENARIO( "The cpp bindings can be used", "[filter]" ) {
 
     
     GIVEN( "An options structure filled with values for FIR moving average highpass filters" ) {
-        dh_filter_parameters opts;
+        dh_filter_parameters opts{};
         opts.filter_type = DH_FIR_MOVING_AVERAGE_HIGHPASS;
         opts.cutoff_frequency_low = 15;
         opts.cutoff_frequency_high = 25;
@@ -71,7 +75,131 @@ SCENARIO( "The cpp bindings can be used", "[filter]" ) {
     }
 }
 
+SCENARIO( "The cpp bindings can filter blocks of values", "[filter]" ) {
+    GIVEN( "A chebyshev filter" ) {
+        dh_filter_parameters opts{};
+        opts.filter_type = DH_IIR_CHEBYSHEV_LOWPASS;
+        opts.cutoff_frequency_low = 10;
+        opts.sampling_frequency = 100;
+        opts.filter_order = 4;
+        opts.ripple = -3.0;
+        auto filt = dh::filter(opts);
+        auto reference = dh::filter(opts);
+        std::vector<double> input(100);
+        std::vector<double> expected(input.size());
+        for(size_t i=0; i<input.size(); ++i) {
+            input[i] = 1.0 + std::sin(0.3*static_cast<double>(i));
+            expected[i] = reference.update(input[i]);
+        }
+        WHEN( "a block is filtered" ) {
+            std::vector<double> output(input.size());
+            filt.update(input.data(), output.data(), input.size());
+            THEN( "the output is identical to filtering every value" ) {
+                for(size_t i=0; i<input.size(); ++i) {
+                    REQUIRE(output[i] == expected[i]);
+                }
+                REQUIRE(filt.current_value() == expected.back());
+            }
+        }
+    }
+}
 
+SCENARIO( "The cpp bindings can filter with single precision", "[filter]" ) {
+    GIVEN( "A butterworth filter with float samples" ) {
+        dh_filter_parameters opts{};
+        opts.filter_type = DH_IIR_BUTTERWORTH_LOWPASS;
+        opts.cutoff_frequency_low = 10;
+        opts.sampling_frequency = 100;
+        opts.filter_order = 6;
+        auto filt = dh::basic_filter<float>(opts);
+        auto reference = dh::filter(opts);
+        WHEN( "values are filtered" ) {
+            std::vector<float> output(200);
+            for(size_t i=0; i<output.size(); ++i) {
+                const double value = 1.0 + std::sin(0.3*static_cast<double>(i));
+                output[i] = filt.update(static_cast<float>(value));
+                const double expected = reference.update(value);
+                REQUIRE(std::fabs(static_cast<double>(output[i]) - expected) < 1e-4);
+            }
+            THEN( "copies continue with the same state" ) {
+                auto copy = filt;
+                REQUIRE(copy.update(0.5f) == filt.update(0.5f));
+                REQUIRE(copy.gain() == filt.gain());
+                REQUIRE(filt.feedback_coefficients().size() == 0);
+                REQUIRE(filt.compute_frequency_response(100).size() == 101);
+            }
+        }
+    }
+    GIVEN( "A filter that cannot be computed with single precision" ) {
+        dh_filter_parameters opts{};
+        opts.filter_type = DH_IIR_BUTTERWORTH_LOWPASS;
+        opts.cutoff_frequency_low = 10;
+        opts.sampling_frequency = 100;
+        opts.filter_order = 6;
+        opts.realization = DH_REALIZATION_DIRECT_FORM_1;
+        THEN( "the constructor throws" ) {
+            REQUIRE_THROWS_AS(dh::filter_f32(opts), dh::filter::error);
+        }
+    }
+}
+
+SCENARIO( "Filters with a fixed number of coefficients can be used", "[filter]" ) {
+    static_assert(std::is_trivially_copyable<dh::static_filter<5, 5>>::value, "static filters must be trivially copyable");
+    dh_filter_parameters opts{};
+    opts.filter_type = DH_IIR_BUTTERWORTH_BANDPASS;
+    opts.cutoff_frequency_low = 10;
+    opts.cutoff_frequency_high = 20;
+    opts.sampling_frequency = 100;
+    opts.filter_order = 2;
+    opts.ripple = -3.0;
+    std::vector<double> input(300);
+    for(size_t i=0; i<input.size(); ++i) {
+        input[i] = 1.0 + std::sin(0.3*static_cast<double>(i)) + (i%23 < 7 ? 0.5 : -0.5);
+    }
 
+    GIVEN( "An IIR filter" ) {
+        auto filt = dh::static_filter<5, 5>(opts);
+        opts.realization = DH_REALIZATION_DIRECT_FORM_1;
+        auto reference = dh::filter(opts);
+        WHEN( "a signal is filtered" ) {
+            std::vector<double> output(input.size());
+            filt.process(input.data(), output.data(), 100);
+            auto copy = filt;
+            std::vector<double> copy_output(input.size() - 100);
+            copy.process(input.data() + 100, copy_output.data(), copy_output.size());
+            for(size_t i=100; i<input.size(); ++i) {
+                output[i] = filt.update(input[i]);
+            }
+            THEN( "the outputs are identical to the direct form 1 of the C-API" ) {
+                for(size_t i=0; i<input.size(); ++i) {
+                    REQUIRE(output[i] == reference.update(input[i]));
+                }
+                for(size_t i=0; i<copy_output.size(); ++i) {
+                    REQUIRE(copy_output[i] == output[100 + i]);
+                }
+                REQUIRE(filt.current_value() == output.back());
+            }
+        }
+    }
 
+    GIVEN( "A FIR filter" ) {
+        opts.filter_type = DH_FIR_BRICKWALL_LOWPASS;
+        opts.filter_order = 20;
+        auto filt = dh::static_filter<21, 1>(opts);
+        auto reference = dh::filter(opts);
+        filt.set_gain(2.0);
+        reference.set_gain(2.0);
+        THEN( "the outputs are identical to the C-API" ) {
+            REQUIRE(filt.feedforward_coefficients()[10] == reference.feedforward_coefficients()[10]);
+            for(double value : input) {
+                REQUIRE(std::fabs(filt.update(value) - reference.update(value)) < 1e-12);
+            }
+        }
+    }
 
+    GIVEN( "Template parameters that do not match the order" ) {
+        THEN( "the filter cannot be created" ) {
+            REQUIRE_THROWS_AS((dh::static_filter<3, 3>(opts)), dh::filter_error);
+        }
+    }
+}
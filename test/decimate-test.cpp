@@ -0,0 +1,95 @@
+#include "catch2/catch_test_macros.hpp"
+#include "dh/filter.h"
+#include "test-helpers.hpp"
+#include <cmath>
+#include <string>
+#include <vector>
+
+/**
+ * This source code is licensed under the MIT license. See file "LICENSE" at the root of the repository.
+ */
+
+SCENARIO( "Decimating filters compute the same values as filtering and dropping outputs", "[filter]" ) {
+    struct test_case {
+        DH_FILTER_TYPE type;
+        size_t order;
+        DH_FILTER_REALIZATION realization;
+    };
+    const test_case cases[] = {
+        {DH_FIR_BRICKWALL_LOWPASS, 40, DH_REALIZATION_DEFAULT},
+        {DH_FIR_BRICKWALL_BANDPASS, 20, DH_REALIZATION_DIRECT_FORM_1_MIRRORED},
+        {DH_FIR_MOVING_AVERAGE_LOWPASS, 9, DH_REALIZATION_DEFAULT},
+        {DH_IIR_BUTTERWORTH_LOWPASS, 4, DH_REALIZATION_DEFAULT},
+        {DH_IIR_CHEBYSHEV_BANDPASS, 3, DH_REALIZATION_SECOND_ORDER_SECTIONS}
+    };
+    const size_t factors[] = {1, 3, 8};
+    const size_t block_sizes[] = {1, 2, 7, 300, 1000};
+    size_t count = 0;
+    for(size_t block : block_sizes) {
+        count += block;
+    }
+
+    for(const auto& current : cases) {
+        for(size_t factor : factors) {
+            GIVEN( "A filter of type " + std::to_string(static_cast<int>(current.type)) + " and the factor " + std::to_string(factor) ) {
+                auto opts = create_test_parameters(current.type, current.order, current.realization);
+                dh_filter_data reference;
+                dh_filter_data filter;
+                REQUIRE(dh_create_filter(&reference, &opts) == DH_FILTER_OK);
+                REQUIRE(dh_create_filter(&filter, &opts) == DH_FILTER_OK);
+                std::vector<double> expected;
+                for(size_t i=0; i<count; ++i) {
+                    double value = 0.0;
+                    REQUIRE(dh_filter(&reference, test_signal(i), &value) == DH_FILTER_OK);
+                    if (i % factor == 0) {
+                        expected.push_back(value);
+                    }
+                }
+
+                WHEN( "the signal is decimated in blocks of different lengths" ) {
+                    std::vector<double> output;
+                    size_t position = 0;
+                    for(size_t block : block_sizes) {
+                        std::vector<double> input(block);
+                        for(size_t i=0; i<block; ++i) {
+                            input[i] = test_signal(position + i);
+                        }
+                        std::vector<double> kept((block + factor - 1) / factor);
+                        size_t written = 0;
+                        REQUIRE(dh_filter_decimate(&filter, input.data(), block, factor, kept.data(), &written) == DH_FILTER_OK);
+                        REQUIRE(written <= kept.size());
+                        output.insert(output.end(), kept.begin(), kept.begin() + written);
+                        position += block;
+                    }
+                    THEN( "the kept outputs are identical" ) {
+                        REQUIRE(output == expected);
+                    }
+                    AND_THEN( "the filter continues with the same state" ) {
+                        for(size_t i=count; i<count+50; ++i) {
+                            double value = 0.0;
+                            double expected_value = 0.0;
+                            REQUIRE(dh_filter(&filter, test_signal(i), &value) == DH_FILTER_OK);
+                            REQUIRE(dh_filter(&reference, test_signal(i), &expected_value) == DH_FILTER_OK);
+                            REQUIRE(value == expected_value);
+                        }
+                    }
+                }
+                dh_free_filter(&reference);
+                dh_free_filter(&filter);
+            }
+        }
+    }
+
+    GIVEN( "Invalid arguments" ) {
+        auto opts = create_test_parameters(DH_FIR_BRICKWALL_LOWPASS, 10, DH_REALIZATION_DEFAULT);
+        dh_filter_data filter;
+        REQUIRE(dh_create_filter(&filter, &opts) == DH_FILTER_OK);
+        double input[4] = {1.0, 2.0, 3.0, 4.0};
+        double output[4];
+        THEN( "the call fails" ) {
+            REQUIRE(dh_filter_decimate(&filter, input, 4, 0, output, nullptr) == DH_FILTER_ERROR);
+            REQUIRE(dh_filter_decimate(&filter, nullptr, 4, 2, output, nullptr) == DH_FILTER_NO_DATA_STRUCTURE);
+        }
+        dh_free_filter(&filter);
+    }
+}
@@ -0,0 +1,153 @@
+#include "catch2/catch_test_macros.hpp"
+#include "dh/filter.h"
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+/**
+ * This source code is licensed under the MIT license. See file "LICENSE" at the root of the repository.
+ */
+
+/** Returns true if any past output or state variable of the filter is subnormal. */
+static bool has_subnormal_state(const dh_filter_data& filter) {
+    const bool state = filter.realization == DH_REALIZATION_SECOND_ORDER_SECTIONS || filter.realization == DH_REALIZATION_TRANSPOSED_DIRECT_FORM_2;
+    const double* values = state ? filter.state : filter.outputs;
+    const size_t length = state ? filter.state_length : filter.number_coefficients_out;
+    for(size_t k=0; k<length; ++k) {
+        if (std::fpclassify(values[k]) == FP_SUBNORMAL) {
+            return true;
+        }
+    }
+    return false;
+}
+
+SCENARIO( "The state of IIR filters can be kept free of subnormal numbers", "[filter]" ) {
+    const DH_FILTER_REALIZATION realizations[] = {
+        DH_REALIZATION_DIRECT_FORM_1,
+        DH_REALIZATION_SECOND_ORDER_SECTIONS,
+        DH_REALIZATION_TRANSPOSED_DIRECT_FORM_2
+    };
+    const size_t silence = 100000;
+
+    for(auto realization : realizations) {
+        GIVEN( "A butterworth filter with the realization " + std::to_string(static_cast<int>(realization)) ) {
+            dh_filter_parameters opts{};
+            opts.filter_type = DH_IIR_BUTTERWORTH_LOWPASS;
+            opts.filter_order = 2;
+            opts.cutoff_frequency_low = 5.0;
+            opts.sampling_frequency = 1000.0;
+            opts.realization = realization;
+            dh_filter_data plain;
+            REQUIRE(dh_create_filter(&plain, &opts) == DH_FILTER_OK);
+            opts.flush_denormals = true;
+            dh_filter_data flushed;
+            REQUIRE(dh_create_filter(&flushed, &opts) == DH_FILTER_OK);
+            REQUIRE(flushed.flush_denormals);
+            dh_initialize_filter(&plain, 1.0);
+            dh_initialize_filter(&flushed, 1.0);
+
+            WHEN( "the input becomes silent" ) {
+                bool plain_subnormal = false;
+                bool flushed_subnormal = false;
+                double max_difference = 0.0;
+                std::vector<double> zeros(100, 0.0);
+                std::vector<double> block(100);
+                for(size_t i=0; i<silence; ++i) {
+                    double a = 0.0;
+                    double b = 0.0;
+                    if (i % 2 == 0) {
+                        REQUIRE(dh_filter(&plain, 0.0, &a) == DH_FILTER_OK);
+                        REQUIRE(dh_filter(&flushed, 0.0, &b) == DH_FILTER_OK);
+                    } else {
+                        REQUIRE(dh_filter_block(&plain, zeros.data(), block.data(), 1) == DH_FILTER_OK);
+                        a = block[0];
+                        REQUIRE(dh_filter_block(&flushed, zeros.data(), block.data(), 1) == DH_FILTER_OK);
+                        b = block[0];
+                    }
+                    max_difference = std::fmax(max_difference, std::fabs(a - b));
+                    plain_subnormal = plain_subnormal || has_subnormal_state(plain);
+                    flushed_subnormal = flushed_subnormal || has_subnormal_state(flushed);
+                }
+                THEN( "only the filter without the option decays into subnormal numbers" ) {
+                    REQUIRE(plain_subnormal);
+                    REQUIRE_FALSE(flushed_subnormal);
+                    REQUIRE(max_difference < 1e10 * DH_FILTER_DENORMAL_THRESHOLD);
+                    REQUIRE(flushed.current_value == 0.0);
+                }
+            }
+
+            WHEN( "silent blocks are filtered" ) {
+                std::vector<double> data(silence, 0.0);
+                REQUIRE(dh_filter_block(&flushed, data.data(), data.data(), data.size()) == DH_FILTER_OK);
+                THEN( "no output is subnormal" ) {
+                    for(double value : data) {
+                        REQUIRE(std::fpclassify(value) != FP_SUBNORMAL);
+                    }
+                    REQUIRE_FALSE(has_subnormal_state(flushed));
+                }
+            }
+            dh_free_filter(&plain);
+            dh_free_filter(&flushed);
+        }
+    }
+}
+
+SCENARIO( "Filters with fast decaying poles are checked more often", "[filter]" ) {
+    const DH_FILTER_REALIZATION realizations[] = {
+        DH_REALIZATION_DIRECT_FORM_1,
+        DH_REALIZATION_SECOND_ORDER_SECTIONS,
+        DH_REALIZATION_TRANSPOSED_DIRECT_FORM_2
+    };
+
+    for(auto realization : realizations) {
+        GIVEN( "A first order butterworth lowpass with a pole close to zero and the realization " + std::to_string(static_cast<int>(realization)) ) {
+            dh_filter_parameters opts{};
+            opts.filter_type = DH_IIR_BUTTERWORTH_LOWPASS;
+            opts.filter_order = 1;
+            opts.cutoff_frequency_low = 24.99;
+            opts.sampling_frequency = 100.0;
+            opts.realization = realization;
+            opts.flush_denormals = true;
+            dh_filter_data filter;
+            REQUIRE(dh_create_filter(&filter, &opts) == DH_FILTER_OK);
+
+            THEN( "the state is checked before it can decay from the threshold into the subnormal range" ) {
+                REQUIRE(filter.denormal_check_interval >= 1);
+                REQUIRE(filter.denormal_check_interval < DH_FILTER_DENORMAL_CHECK_INTERVAL);
+            }
+
+            WHEN( "silent blocks follow the steady state of large values" ) {
+                std::vector<double> data(4096);
+                bool subnormal = false;
+                for(double start = 1e25; start < 1e300; start *= 1e25) {
+                    dh_initialize_filter(&filter, start);
+                    std::fill(data.begin(), data.end(), 0.0);
+                    REQUIRE(dh_filter_block(&filter, data.data(), data.data(), data.size()) == DH_FILTER_OK);
+                    for(double value : data) {
+                        subnormal = subnormal || std::fpclassify(value) == FP_SUBNORMAL;
+                    }
+                    subnormal = subnormal || has_subnormal_state(filter);
+                }
+                THEN( "no output and no state is subnormal" ) {
+                    REQUIRE_FALSE(subnormal);
+                }
+            }
+            dh_free_filter(&filter);
+        }
+    }
+
+    GIVEN( "A slow lowpass" ) {
+        dh_filter_parameters opts{};
+        opts.filter_type = DH_IIR_BUTTERWORTH_LOWPASS;
+        opts.filter_order = 2;
+        opts.cutoff_frequency_low = 5.0;
+        opts.sampling_frequency = 1000.0;
+        dh_filter_data filter;
+        REQUIRE(dh_create_filter(&filter, &opts) == DH_FILTER_OK);
+        THEN( "the longest interval is used" ) {
+            REQUIRE(filter.denormal_check_interval == DH_FILTER_DENORMAL_CHECK_INTERVAL);
+        }
+        dh_free_filter(&filter);
+    }
+}
@@ -0,0 +1,287 @@
+#include "catch2/catch_test_macros.hpp"
+#include "dh/filter.h"
+#include "dh/dot_product.h"
+#include <cfloat>
+#include <cmath>
+#include <string>
+#include <vector>
+
+/**
+ * This source code is licensed under the MIT license. See file "LICENSE" at the root of the repository.
+ */
+
+/**
+ * The vectorized versions sum the products in a different order than the scalar loop.
+ * Both results are within the standard error bound of a floating point summation,
+ * so they may differ by at most 2 * n * eps * sum(|c[i]*x[i]|).
+ */
+static double tolerance(const std::vector<double>& coefficients, const std::vector<double>& data, size_t count) {
+    double sum = 0.0;
+    for(size_t i=0; i<count; ++i) {
+        sum += std::fabs(coefficients[i] * data[i]);
+    }
+    return 2.0 * static_cast<double>(count + 1) * DBL_EPSILON * sum;
+}
+
+SCENARIO( "Vectorized dot products are equal to the scalar version", "[filter]" ) {
+    const DH_SIMD_INSTRUCTION_SET sets[] = { DH_SIMD_NONE, DH_SIMD_SSE2, DH_SIMD_AVX2, DH_SIMD_AVX512 };
+    std::vector<double> coefficients(1000);
+    std::vector<double> data(1000);
+    for(size_t i=0; i<coefficients.size(); ++i) {
+        double t = static_cast<double>(i);
+        coefficients[i] = std::sin(0.37*t) / (1.0 + 0.01*t);
+        data[i] = 1.5 + std::cos(0.11*t) - 0.3*std::sin(2.7*t);
+    }
+
+    for(auto set : sets) {
+        GIVEN( "The instruction set " + std::to_string(static_cast<int>(set)) ) {
+            auto function = dh_get_dot_product_function(set);
+            if (set <= dh_detect_simd_instruction_set()) {
+                REQUIRE(function != NULL);
+            } else {
+                REQUIRE(function == NULL);
+            }
+            if (function != NULL) {
+                THEN( "the results for all lengths are equal to the scalar version within the tolerance" ) {
+                    std::vector<size_t> lengths;
+                    for(size_t i=0; i<=100; ++i) {
+                        lengths.push_back(i);
+                    }
+                    lengths.push_back(999);
+                    lengths.push_back(1000);
+                    for(auto count : lengths) {
+                        const double expected = dh_dot_product_scalar(coefficients.data(), data.data(), count);
+                        const double result = function(coefficients.data(), data.data(), count);
+                        REQUIRE(std::fabs(result - expected) <= tolerance(coefficients, data, count));
+                    }
+                }
+            }
+        }
+    }
+}
+
+SCENARIO( "Vectorized single precision dot products are equal to the scalar version", "[filter]" ) {
+    const DH_SIMD_INSTRUCTION_SET sets[] = { DH_SIMD_NONE, DH_SIMD_SSE2, DH_SIMD_AVX2, DH_SIMD_AVX512 };
+    std::vector<float> coefficients(1000);
+    std::vector<float> data(1000);
+    for(size_t i=0; i<coefficients.size(); ++i) {
+        double t = static_cast<double>(i);
+        coefficients[i] = static_cast<float>(std::sin(0.37*t) / (1.0 + 0.01*t));
+        data[i] = static_cast<float>(1.5 + std::cos(0.11*t) - 0.3*std::sin(2.7*t));
+    }
+
+    for(auto set : sets) {
+        GIVEN( "The instruction set " + std::to_string(static_cast<int>(set)) ) {
+            auto function = dh_get_dot_product_function_f32(set);
+            if (set <= dh_detect_simd_instruction_set()) {
+                REQUIRE(function != NULL);
+            } else {
+                REQUIRE(function == NULL);
+            }
+            if (function != NULL) {
+                THEN( "the results for all lengths are equal to the scalar version within the tolerance" ) {
+                    for(size_t count=0; count<=1000; count+=(count < 100 ? 1 : 100)) {
+                        double sum = 0.0;
+                        for(size_t i=0; i<count; ++i) {
+                            sum += std::fabs(static_cast<double>(coefficients[i]) * static_cast<double>(data[i]));
+                        }
+                        const float expected = dh_dot_product_scalar_f32(coefficients.data(), data.data(), count);
+                        const float result = function(coefficients.data(), data.data(), count);
+                        REQUIRE(std::fabs(static_cast<double>(result) - static_cast<double>(expected)) <= 2.0 * static_cast<double>(count + 1) * FLT_EPSILON * sum);
+                    }
+                }
+            }
+        }
+    }
+}
+
+SCENARIO( "Long FIR filters use vectorized dot products", "[filter]" ) {
+    GIVEN( "A brickwall filter with many coefficients" ) {
+        dh_filter_parameters opts{};
+        opts.filter_type = DH_FIR_BRICKWALL_LOWPASS;
+        opts.filter_order = 400;
+        opts.cutoff_frequency_low = 10.0;
+        opts.sampling_frequency = 100.0;
+        opts.realization = DH_REALIZATION_DIRECT_FORM_1;
+        dh_filter_data filter;
+        REQUIRE(dh_create_filter(&filter, &opts) == DH_FILTER_OK);
+        dh_filter_data reference;
+        REQUIRE(dh_create_filter(&reference, &opts) == DH_FILTER_OK);
+        reference.dot_product = NULL;
+        reference.kernel = dh_select_filter_kernel(&reference);
+
+        THEN( "the dot product is selected depending on the processor" ) {
+            REQUIRE(filter.dot_product == dh_select_dot_product_function(filter.number_coefficients_in));
+        }
+
+        WHEN( "a signal is filtered" ) {
+            double max_difference = 0.0;
+            for(size_t i=0; i<2000; ++i) {
+                const double t = static_cast<double>(i);
+                const double value = 2.0 + std::sin(0.03*t) + (i%97 < 40 ? 1.0 : -1.0);
+                double output = 0.0;
+                double expected = 0.0;
+                REQUIRE(dh_filter(&filter, value, &output) == DH_FILTER_OK);
+                REQUIRE(dh_filter(&reference, value, &expected) == DH_FILTER_OK);
+                max_difference = std::fmax(max_difference, std::fabs(output - expected));
+            }
+            THEN( "the output is equal to the scalar loops within the tolerance" ) {
+                // the sum of |c[i]*x[i]| is below 4 * sum(|c[i]|), which is below 10 for this filter
+                REQUIRE(max_difference <= 2.0 * 402.0 * DBL_EPSILON * 40.0);
+            }
+        }
+
+        WHEN( "short filters are created" ) {
+            opts.filter_order = DH_FILTER_SIMD_MIN_COEFFICIENTS - 2;
+            dh_filter_data short_filter;
+            REQUIRE(dh_create_filter(&short_filter, &opts) == DH_FILTER_OK);
+            THEN( "the plain loops are used" ) {
+                REQUIRE(short_filter.dot_product == NULL);
+            }
+            dh_free_filter(&short_filter);
+        }
+        dh_free_filter(&reference);
+        dh_free_filter(&filter);
+    }
+}
+
+SCENARIO( "Folded dot products are equal to the dot product of the full coefficients", "[filter]" ) {
+    const DH_SIMD_INSTRUCTION_SET sets[] = { DH_SIMD_NONE, DH_SIMD_SSE2, DH_SIMD_AVX2, DH_SIMD_AVX512 };
+    const DH_FIR_SYMMETRY symmetries[] = { DH_FIR_SYMMETRIC, DH_FIR_ANTISYMMETRIC };
+    std::vector<double> data(1000);
+    for(size_t i=0; i<data.size(); ++i) {
+        double t = static_cast<double>(i);
+        data[i] = 1.5 + std::cos(0.11*t) - 0.3*std::sin(2.7*t);
+    }
+
+    for(auto set : sets) {
+        for(auto symmetry : symmetries) {
+            GIVEN( "The instruction set " + std::to_string(static_cast<int>(set)) + " and symmetry " + std::to_string(static_cast<int>(symmetry)) ) {
+                auto function = dh_get_folded_dot_product_function(set, symmetry);
+                if (set <= dh_detect_simd_instruction_set()) {
+                    REQUIRE(function != NULL);
+                } else {
+                    REQUIRE(function == NULL);
+                }
+                if (function != NULL) {
+                    THEN( "the results for all lengths are equal to the scalar version within the tolerance" ) {
+                        std::vector<size_t> lengths;
+                        for(size_t i=2; i<=100; ++i) {
+                            lengths.push_back(i);
+                        }
+                        lengths.push_back(999);
+                        lengths.push_back(1000);
+                        for(auto count : lengths) {
+                            std::vector<double> coefficients(count);
+                            for(size_t i=0; i<count; ++i) {
+                                const double t = static_cast<double>(i < count/2 ? i : count - 1 - i);
+                                coefficients[i] = std::sin(0.37*t + 0.2) / (1.0 + 0.01*t);
+                            }
+                            if (symmetry == DH_FIR_ANTISYMMETRIC) {
+                                for(size_t i=(count+1)/2; i<count; ++i) {
+                                    coefficients[i] = -coefficients[i];
+                                }
+                                if (count % 2 == 1) {
+                                    coefficients[count/2] = 0.0;
+                                }
+                            }
+                            REQUIRE(dh_detect_fir_symmetry(coefficients.data(), count) == symmetry);
+                            const double expected = dh_dot_product_scalar(coefficients.data(), data.data(), count);
+                            const double result = function(coefficients.data(), data.data(), count);
+                            REQUIRE(std::fabs(result - expected) <= 2.0 * tolerance(coefficients, data, count));
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    GIVEN( "Coefficients without symmetry" ) {
+        std::vector<double> coefficients = {1.0, 2.0, 3.0, 1.0};
+        THEN( "no symmetry is detected and no folded function is returned" ) {
+            REQUIRE(dh_detect_fir_symmetry(coefficients.data(), coefficients.size()) == DH_FIR_NOT_SYMMETRIC);
+            REQUIRE(coefficients[3] == 1.0);
+            REQUIRE(dh_get_folded_dot_product_function(DH_SIMD_NONE, DH_FIR_NOT_SYMMETRIC) == NULL);
+        }
+    }
+}
+
+SCENARIO( "Linear phase FIR filters use folded dot products", "[filter]" ) {
+    const DH_FILTER_TYPE types[] = { DH_FIR_BRICKWALL_LOWPASS, DH_FIR_BRICKWALL_HIGHPASS, DH_FIR_BRICKWALL_BANDPASS, DH_FIR_MOVING_AVERAGE_LOWPASS };
+    const size_t orders[] = { 10, 400 };
+    for(auto type : types) {
+        for(auto order : orders) {
+            GIVEN( "A filter of type " + std::to_string(static_cast<int>(type)) + " with order " + std::to_string(order) ) {
+                dh_filter_parameters opts{};
+                opts.filter_type = type;
+                opts.filter_order = order;
+                opts.cutoff_frequency_low = 10.0;
+                opts.cutoff_frequency_high = 20.0;
+                opts.sampling_frequency = 100.0;
+                opts.realization = DH_REALIZATION_DIRECT_FORM_1_MIRRORED;
+                dh_filter_data filter;
+                REQUIRE(dh_create_filter(&filter, &opts) == DH_FILTER_OK);
+                opts.realization = DH_REALIZATION_DIRECT_FORM_1;
+                dh_filter_data reference;
+                REQUIRE(dh_create_filter(&reference, &opts) == DH_FILTER_OK);
+
+                THEN( "the symmetry is detected" ) {
+                    REQUIRE(filter.symmetry == DH_FIR_SYMMETRIC);
+                    REQUIRE(reference.symmetry == DH_FIR_NOT_SYMMETRIC);
+                    REQUIRE(filter.dot_product == dh_select_folded_dot_product_function(filter.number_coefficients_in, DH_FIR_SYMMETRIC));
+                }
+
+                WHEN( "a signal is filtered" ) {
+                    double max_difference = 0.0;
+                    for(size_t i=0; i<2000; ++i) {
+                        const double t = static_cast<double>(i);
+                        const double value = 2.0 + std::sin(0.03*t) + (i%97 < 40 ? 1.0 : -1.0);
+                        double output = 0.0;
+                        double expected = 0.0;
+                        REQUIRE(dh_filter(&filter, value, &output) == DH_FILTER_OK);
+                        REQUIRE(dh_filter(&reference, value, &expected) == DH_FILTER_OK);
+                        max_difference = std::fmax(max_difference, std::fabs(output - expected));
+                    }
+                    THEN( "the output is equal to the direct form 1 within the tolerance" ) {
+                        REQUIRE(max_difference <= 1e-12);
+                    }
+                }
+                dh_free_filter(&reference);
+                dh_free_filter(&filter);
+            }
+        }
+    }
+
+    GIVEN( "A brickwall filter with the default realization" ) {
+        dh_filter_parameters opts{};
+        opts.filter_type = DH_FIR_BRICKWALL_BANDSTOP;
+        opts.filter_order = 100;
+        opts.cutoff_frequency_low = 10.0;
+        opts.cutoff_frequency_high = 20.0;
+        opts.sampling_frequency = 100.0;
+        dh_filter_data filter;
+        REQUIRE(dh_create_filter(&filter, &opts) == DH_FILTER_OK);
+        THEN( "the mirrored buffers are selected and the folded dot product is used" ) {
+            REQUIRE(filter.realization == DH_REALIZATION_DIRECT_FORM_1_MIRRORED);
+            REQUIRE(filter.symmetry == DH_FIR_SYMMETRIC);
+            REQUIRE(filter.dot_product == dh_select_folded_dot_product_function(filter.number_coefficients_in, DH_FIR_SYMMETRIC));
+        }
+        dh_free_filter(&filter);
+    }
+
+    GIVEN( "A filter without symmetry" ) {
+        dh_filter_parameters opts{};
+        opts.filter_type = DH_FIR_EXPONENTIAL_MOVING_AVERAGE_LOWPASS;
+        opts.filter_order = 40;
+        opts.cutoff_frequency_low = 10.0;
+        opts.sampling_frequency = 100.0;
+        opts.realization = DH_REALIZATION_DIRECT_FORM_1_MIRRORED;
+        dh_filter_data filter;
+        REQUIRE(dh_create_filter(&filter, &opts) == DH_FILTER_OK);
+        THEN( "the regular dot product is used" ) {
+            REQUIRE(filter.symmetry == DH_FIR_NOT_SYMMETRIC);
+            REQUIRE(filter.dot_product == dh_select_dot_product_function(filter.number_coefficients_in));
+        }
+        dh_free_filter(&filter);
+    }
+}
@@ -0,0 +1,89 @@
+#include "catch2/catch_test_macros.hpp"
+#include "dh/filter.h"
+#include "test-helpers.hpp"
+#include <cmath>
+#include <string>
+#include <vector>
+
+/**
+ * This source code is licensed under the MIT license. See file "LICENSE" at the root of the repository.
+ */
+
+SCENARIO( "Single precision filters compute the same values as double precision filters", "[filter]" ) {
+    struct test_case {
+        DH_FILTER_TYPE type;
+        size_t order;
+        DH_FILTER_REALIZATION realization;
+    };
+    const test_case cases[] = {
+        {DH_FIR_MOVING_AVERAGE_LOWPASS, 15, DH_REALIZATION_SECOND_ORDER_SECTIONS},
+        {DH_FIR_BRICKWALL_LOWPASS, 100, DH_REALIZATION_TRANSPOSED_DIRECT_FORM_2},
+        {DH_FIR_BRICKWALL_BANDSTOP, 60, DH_REALIZATION_RUNNING_SUM},
+        {DH_FIR_EXPONENTIAL_MOVING_AVERAGE_LOWPASS, 20, DH_REALIZATION_TRANSPOSED_DIRECT_FORM_2},
+        {DH_IIR_BUTTERWORTH_LOWPASS, 8, DH_REALIZATION_DIRECT_FORM_1},
+        {DH_IIR_BUTTERWORTH_BANDPASS, 6, DH_REALIZATION_TRANSPOSED_DIRECT_FORM_2},
+        {DH_IIR_CHEBYSHEV_HIGHPASS, 5, DH_REALIZATION_DIRECT_FORM_1_MIRRORED},
+        {DH_IIR_CHEBYSHEV2_BANDSTOP, 4, DH_REALIZATION_DIRECT_FORM_1}
+    };
+    const auto input = create_test_signal(3000);
+
+    for(const auto& current : cases) {
+        GIVEN( "A filter of type " + std::to_string(static_cast<int>(current.type)) ) {
+            auto opts = create_test_parameters(current.type, current.order);
+            dh_filter_data reference;
+            REQUIRE(dh_create_filter(&reference, &opts) == DH_FILTER_OK);
+            dh_filter_data_f32 filter;
+            REQUIRE(dh_create_filter_f32(&filter, &opts) == DH_FILTER_OK);
+            std::vector<float> input_f32(input.begin(), input.end());
+
+            THEN( "a numerically safe realization is used" ) {
+                if (filter.sections != NULL) {
+                    REQUIRE(filter.realization == DH_REALIZATION_SECOND_ORDER_SECTIONS);
+                    REQUIRE(filter.inputs == NULL);
+                } else {
+                    REQUIRE(filter.realization == DH_REALIZATION_DIRECT_FORM_1_MIRRORED);
+                    REQUIRE(filter.number_coefficients_in == reference.number_coefficients_in);
+                }
+            }
+
+            WHEN( "a signal is filtered with single values and blocks" ) {
+                dh_filter_data_f32 block_filter;
+                REQUIRE(dh_create_filter_f32(&block_filter, &opts) == DH_FILTER_OK);
+                std::vector<float> block_output(input_f32);
+                REQUIRE(dh_filter_block_inplace_f32(&block_filter, block_output.data(), block_output.size()) == DH_FILTER_OK);
+                double max_difference = 0.0;
+                for(size_t i=0; i<input.size(); ++i) {
+                    float output = 0.0f;
+                    double expected = 0.0;
+                    REQUIRE(dh_filter_f32(&filter, input_f32[i], &output) == DH_FILTER_OK);
+                    REQUIRE(dh_filter(&reference, input[i], &expected) == DH_FILTER_OK);
+                    REQUIRE(output == block_output[i]);
+                    max_difference = std::fmax(max_difference, std::fabs(static_cast<double>(output) - expected));
+                }
+                THEN( "the outputs are equal within the single precision tolerance" ) {
+                    REQUIRE(max_difference < 1e-4);
+                    REQUIRE(block_filter.current_value == block_output.back());
+                }
+                dh_free_filter_f32(&block_filter);
+            }
+
+            WHEN( "a realization is requested that is not safe for single precision" ) {
+                opts.realization = current.realization;
+                dh_filter_data_f32 unsafe_filter{};
+                THEN( "the filter is not created" ) {
+                    REQUIRE(dh_create_filter_f32(&unsafe_filter, &opts) == DH_FILTER_UNSUPPORTED_REALIZATION);
+                }
+            }
+            dh_free_filter_f32(&filter);
+            dh_free_filter(&reference);
+        }
+    }
+
+    GIVEN( "An IIR filter without second order sections" ) {
+        auto opts = create_test_parameters(DH_IIR_EXPONENTIAL_LOWPASS, 1);
+        dh_filter_data_f32 filter{};
+        THEN( "the filter is not created" ) {
+            REQUIRE(dh_create_filter_f32(&filter, &opts) == DH_FILTER_UNSUPPORTED_REALIZATION);
+        }
+    }
+}
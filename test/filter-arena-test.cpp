@@ -0,0 +1,92 @@
+#include "catch2/catch_test_macros.hpp"
+#include "dh/filter.h"
+#include "dh/filter_arena.h"
+#include "test-helpers.hpp"
+#include <cstdint>
+
+/**
+ * This source code is licensed under the MIT license. See file "LICENSE" at the root of the repository.
+ */
+
+SCENARIO( "Many filters can be created in one arena", "[filter]" ) {
+    GIVEN( "An arena with room for three butterworth filters and two bandpass filters" ) {
+        auto butterworth = create_test_parameters(DH_IIR_BUTTERWORTH_LOWPASS, 4, DH_REALIZATION_SECOND_ORDER_SECTIONS);
+        auto bandpass = create_test_parameters(DH_FIR_BRICKWALL_BANDPASS, 10, DH_REALIZATION_DEFAULT);
+        size_t size_butterworth = 0;
+        size_t size_bandpass = 0;
+        REQUIRE(dh_filter_arena_required_size(&butterworth, 3, &size_butterworth) == DH_FILTER_OK);
+        REQUIRE(dh_filter_arena_required_size(&bandpass, 2, &size_bandpass) == DH_FILTER_OK);
+        dh_filter_arena arena;
+        REQUIRE(dh_create_filter_arena(&arena, size_butterworth + size_bandpass) == DH_FILTER_OK);
+        REQUIRE(reinterpret_cast<std::uintptr_t>(arena.buffer) % DH_FILTER_ARENA_ALIGNMENT == 0);
+
+        WHEN( "The filters are created" ) {
+            dh_filter_data filters[5];
+            dh_filter_parameters* options[5] = {&butterworth, &butterworth, &butterworth, &bandpass, &bandpass};
+            for(size_t k=0; k<5; ++k) {
+                REQUIRE(dh_filter_arena_create_filter(&arena, &filters[k], options[k]) == DH_FILTER_OK);
+            }
+            THEN( "The buffers follow each other and start at a new cache line" ) {
+                REQUIRE(arena.number_filters == 5);
+                REQUIRE(arena.used <= arena.buffer_length);
+                REQUIRE(filters[0].buffer == arena.buffer);
+                for(size_t k=0; k<5; ++k) {
+                    REQUIRE(reinterpret_cast<std::uintptr_t>(filters[k].buffer) % DH_FILTER_ARENA_ALIGNMENT == 0);
+                    REQUIRE(!filters[k].buffer_needs_cleanup);
+                    if (k > 0) {
+                        REQUIRE(filters[k].buffer >= filters[k-1].buffer + filters[k-1].buffer_length);
+                        REQUIRE(filters[k].buffer < filters[k-1].buffer + filters[k-1].buffer_length + DH_FILTER_ARENA_ALIGNMENT);
+                    }
+                }
+                REQUIRE(arena.used == static_cast<size_t>(filters[4].buffer - arena.buffer) + filters[4].buffer_length);
+            }
+            THEN( "The filters compute the same values as filters created with dh_create_filter()" ) {
+                for(size_t k=0; k<5; ++k) {
+                    dh_filter_data reference;
+                    REQUIRE(dh_create_filter(&reference, options[k]) == DH_FILTER_OK);
+                    for(size_t i=0; i<300; ++i) {
+                        double value = 0.0;
+                        double expected = 0.0;
+                        REQUIRE(dh_filter(&filters[k], test_signal(i), &value) == DH_FILTER_OK);
+                        REQUIRE(dh_filter(&reference, test_signal(i), &expected) == DH_FILTER_OK);
+                        REQUIRE(value == expected);
+                    }
+                    dh_free_filter(&reference);
+                }
+            }
+            THEN( "There is no room for a filter that is larger than the free memory" ) {
+                auto large = create_test_parameters(DH_FIR_BRICKWALL_LOWPASS, 1000, DH_REALIZATION_DEFAULT);
+                size_t required = 0;
+                REQUIRE(dh_filter_required_size(&large, &required, nullptr) == DH_FILTER_OK);
+                REQUIRE(required > arena.buffer_length - arena.used);
+                dh_filter_data other;
+                REQUIRE(dh_filter_arena_create_filter(&arena, &other, &large) == DH_FILTER_ALLOCATION_FAILED);
+                REQUIRE(arena.number_filters == 5);
+            }
+            AND_WHEN( "The arena is reset" ) {
+                REQUIRE(dh_reset_filter_arena(&arena) == DH_FILTER_OK);
+                THEN( "The memory is used again for new filters" ) {
+                    REQUIRE(arena.used == 0);
+                    REQUIRE(arena.number_filters == 0);
+                    dh_filter_data other;
+                    REQUIRE(dh_filter_arena_create_filter(&arena, &other, &bandpass) == DH_FILTER_OK);
+                    REQUIRE(other.buffer == arena.buffer);
+                }
+            }
+        }
+        dh_free_filter_arena(&arena);
+        REQUIRE(arena.buffer == nullptr);
+    }
+
+    GIVEN( "An arena without slab" ) {
+        dh_filter_arena arena{};
+        auto opts = create_test_parameters(DH_FIR_MOVING_AVERAGE_LOWPASS, 4, DH_REALIZATION_DEFAULT);
+        dh_filter_data filter;
+        size_t size = 1;
+        THEN( "No filter can be created" ) {
+            REQUIRE(dh_filter_arena_create_filter(&arena, &filter, &opts) == DH_FILTER_DATA_STRUCTURE_NOT_INITIALIZED);
+            REQUIRE(dh_filter_arena_required_size(&opts, 0, &size) == DH_FILTER_OK);
+            REQUIRE(size == 0);
+        }
+    }
+}
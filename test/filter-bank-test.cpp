@@ -0,0 +1,132 @@
+#include "catch2/catch_test_macros.hpp"
+#include "dh/filter.h"
+#include "dh/filter_bank.h"
+#include "test-helpers.hpp"
+#include <cmath>
+#include <string>
+#include <vector>
+
+/**
+ * This source code is licensed under the MIT license. See file "LICENSE" at the root of the repository.
+ */
+
+/** Every channel has a different offset and a shifted copy of the test signal. */
+static double channel_input(size_t channel, size_t i) {
+    return static_cast<double>(channel) + test_signal(i + 13*channel);
+}
+
+SCENARIO( "A filter bank computes the same values as one filter per channel", "[filter]" ) {
+    struct test_case {
+        DH_FILTER_TYPE type;
+        size_t order;
+        size_t number_channels;
+    };
+    // 600 channels do not fit into the tile on the stack of dh_filter_bank_block()
+    const test_case cases[] = {
+        {DH_FIR_MOVING_AVERAGE_LOWPASS, 9, 13},
+        {DH_FIR_BRICKWALL_BANDPASS, 40, 13},
+        {DH_IIR_BUTTERWORTH_LOWPASS, 6, 13},
+        {DH_IIR_CHEBYSHEV_BANDSTOP, 4, 13},
+        {DH_FIR_MOVING_AVERAGE_LOWPASS, 5, 600},
+        {DH_IIR_BUTTERWORTH_LOWPASS, 4, 600}
+    };
+    const size_t count = 500;
+
+    for(const auto& current : cases) {
+        const size_t number_channels = current.number_channels;
+        GIVEN( "A filter bank of type " + std::to_string(static_cast<int>(current.type)) + " with " + std::to_string(number_channels) + " channels" ) {
+            auto opts = create_test_parameters(current.type, current.order);
+            dh_filter_bank bank;
+            REQUIRE(dh_create_filter_bank(&bank, &opts, number_channels) == DH_FILTER_OK);
+            opts.realization = bank.realization;
+            std::vector<dh_filter_data> references(number_channels);
+            std::vector<std::vector<double>> expected(number_channels, std::vector<double>(count));
+            for(size_t c=0; c<number_channels; ++c) {
+                REQUIRE(dh_create_filter(&references[c], &opts) == DH_FILTER_OK);
+                for(size_t i=0; i<count; ++i) {
+                    REQUIRE(dh_filter(&references[c], channel_input(c, i), &expected[c][i]) == DH_FILTER_OK);
+                }
+                dh_free_filter(&references[c]);
+            }
+
+            WHEN( "every channel is filtered one value at a time" ) {
+                std::vector<double> input(number_channels);
+                std::vector<double> output(number_channels);
+                double max_difference = 0.0;
+                for(size_t i=0; i<count; ++i) {
+                    for(size_t c=0; c<number_channels; ++c) {
+                        input[c] = channel_input(c, i);
+                    }
+                    REQUIRE(dh_filter_bank_tick(&bank, input.data(), output.data()) == DH_FILTER_OK);
+                    for(size_t c=0; c<number_channels; ++c) {
+                        max_difference = std::fmax(max_difference, std::fabs(output[c] - expected[c][i]));
+                    }
+                }
+                THEN( "the outputs are equal" ) {
+                    REQUIRE(max_difference < 1e-10);
+                }
+            }
+
+            WHEN( "every channel is filtered in blocks" ) {
+                const size_t block_sizes[] = {1, 7, 100, 392};
+                std::vector<double> output;
+                std::vector<std::vector<double>> outputs(number_channels);
+                size_t position = 0;
+                for(size_t block : block_sizes) {
+                    std::vector<double> data(number_channels * block);
+                    for(size_t c=0; c<number_channels; ++c) {
+                        for(size_t i=0; i<block; ++i) {
+                            data[c*block + i] = channel_input(c, position + i);
+                        }
+                    }
+                    REQUIRE(dh_filter_bank_block(&bank, data.data(), data.data(), block) == DH_FILTER_OK);
+                    for(size_t c=0; c<number_channels; ++c) {
+                        outputs[c].insert(outputs[c].end(), data.begin() + c*block, data.begin() + (c+1)*block);
+                    }
+                    position += block;
+                }
+                THEN( "the outputs are equal" ) {
+                    REQUIRE(position == count);
+                    double max_difference = 0.0;
+                    for(size_t c=0; c<number_channels; ++c) {
+                        for(size_t i=0; i<count; ++i) {
+                            max_difference = std::fmax(max_difference, std::fabs(outputs[c][i] - expected[c][i]));
+                        }
+                    }
+                    REQUIRE(max_difference < 1e-10);
+                }
+            }
+
+            WHEN( "interleaved frames are filtered in place" ) {
+                std::vector<double> frames(number_channels * count);
+                for(size_t i=0; i<count; ++i) {
+                    for(size_t c=0; c<number_channels; ++c) {
+                        frames[i*number_channels + c] = channel_input(c, i);
+                    }
+                }
+                REQUIRE(dh_filter_bank_frames(&bank, frames.data(), frames.data(), 123) == DH_FILTER_OK);
+                REQUIRE(dh_filter_bank_frames(&bank, frames.data() + 123*number_channels, frames.data() + 123*number_channels, count - 123) == DH_FILTER_OK);
+                THEN( "the outputs are equal" ) {
+                    double max_difference = 0.0;
+                    for(size_t c=0; c<number_channels; ++c) {
+                        for(size_t i=0; i<count; ++i) {
+                            max_difference = std::fmax(max_difference, std::fabs(frames[i*number_channels + c] - expected[c][i]));
+                        }
+                    }
+                    REQUIRE(max_difference < 1e-10);
+                }
+            }
+            dh_free_filter_bank(&bank);
+        }
+    }
+
+    GIVEN( "Invalid parameters" ) {
+        auto opts = create_test_parameters(DH_IIR_BUTTERWORTH_LOWPASS, 4);
+        dh_filter_bank bank{};
+        THEN( "the filter bank is not created" ) {
+            REQUIRE(dh_create_filter_bank(&bank, &opts, 0) == DH_FILTER_ERROR);
+            opts.realization = DH_REALIZATION_DIRECT_FORM_1;
+            REQUIRE(dh_create_filter_bank(&bank, &opts, 4) == DH_FILTER_UNSUPPORTED_REALIZATION);
+        }
+    }
+}
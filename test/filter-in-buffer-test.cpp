@@ -0,0 +1,119 @@
+#include "catch2/catch_test_macros.hpp"
+#include "dh/filter.h"
+#include "test-helpers.hpp"
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * This source code is licensed under the MIT license. See file "LICENSE" at the root of the repository.
+ */
+
+/** Returns a pointer into [storage] that is aligned to [alignment] bytes and followed by [size] bytes. */
+static char* aligned_pointer(std::vector<char>& storage, size_t size, size_t alignment) {
+    storage.resize(size + alignment);
+    void* pointer = storage.data();
+    size_t space = storage.size();
+    return static_cast<char*>(std::align(alignment, size, pointer, space));
+}
+
+SCENARIO( "Filters can be created in memory provided by the caller", "[filter]" ) {
+    struct test_case {
+        DH_FILTER_TYPE type;
+        size_t order;
+        DH_FILTER_REALIZATION realization;
+    };
+    const test_case cases[] = {
+        {DH_NO_FILTER, 3, DH_REALIZATION_DEFAULT},
+        {DH_FIR_MOVING_AVERAGE_LOWPASS, 9, DH_REALIZATION_DEFAULT},
+        {DH_FIR_EXPONENTIAL_MOVING_AVERAGE_LOWPASS, 12, DH_REALIZATION_DEFAULT},
+        {DH_IIR_EXPONENTIAL_LOWPASS, 1, DH_REALIZATION_DEFAULT},
+        {DH_FIR_BRICKWALL_LOWPASS, 200, DH_REALIZATION_DEFAULT},
+        {DH_FIR_BRICKWALL_BANDSTOP, 20, DH_REALIZATION_DIRECT_FORM_1_MIRRORED},
+        {DH_FIR_BRICKWALL_BANDPASS, 10, DH_REALIZATION_DEFAULT},
+        {DH_IIR_BUTTERWORTH_LOWPASS, 4, DH_REALIZATION_DEFAULT},
+        {DH_IIR_CHEBYSHEV_BANDPASS, 3, DH_REALIZATION_SECOND_ORDER_SECTIONS},
+        {DH_IIR_CHEBYSHEV2_HIGHPASS, 5, DH_REALIZATION_TRANSPOSED_DIRECT_FORM_2}
+    };
+    const size_t count = 600;
+
+    for(const auto& current : cases) {
+        GIVEN( "A filter of type " + std::to_string(static_cast<int>(current.type)) + " with the realization " + std::to_string(static_cast<int>(current.realization)) ) {
+            auto opts = create_test_parameters(current.type, current.order, current.realization);
+            size_t size = 0;
+            size_t alignment = 0;
+            REQUIRE(dh_filter_required_size(&opts, &size, &alignment) == DH_FILTER_OK);
+            REQUIRE(alignment == DH_FILTER_BUFFER_ALIGNMENT);
+            std::vector<char> storage;
+            char* buffer = aligned_pointer(storage, size, alignment);
+            REQUIRE(buffer != nullptr);
+
+            WHEN( "The filter is created in the buffer" ) {
+                dh_filter_data filter;
+                dh_filter_data reference;
+                REQUIRE(dh_create_filter_in_buffer(&filter, &opts, buffer, size) == DH_FILTER_OK);
+                REQUIRE(dh_create_filter(&reference, &opts) == DH_FILTER_OK);
+                THEN( "All arrays are in the buffer and the filter does not own it" ) {
+                    REQUIRE(filter.buffer == buffer);
+                    REQUIRE(filter.buffer_length <= size);
+                    REQUIRE(filter.buffer_length == reference.buffer_length);
+                    REQUIRE(!filter.buffer_needs_cleanup);
+                    REQUIRE(filter.coefficients_in >= reinterpret_cast<double*>(buffer));
+                    REQUIRE(filter.coefficients_in < reinterpret_cast<double*>(buffer + filter.buffer_length));
+                }
+                THEN( "The outputs are the same as for a filter created with dh_create_filter()" ) {
+                    for(size_t i=0; i<count; ++i) {
+                        double value = 0.0;
+                        double expected = 0.0;
+                        REQUIRE(dh_filter(&filter, test_signal(i), &value) == DH_FILTER_OK);
+                        REQUIRE(dh_filter(&reference, test_signal(i), &expected) == DH_FILTER_OK);
+                        REQUIRE(value == expected);
+                    }
+                    std::vector<double> block(count);
+                    std::vector<double> expected(count);
+                    REQUIRE(dh_filter_block(&filter, block.data(), block.data(), count) == DH_FILTER_OK);
+                    REQUIRE(dh_filter_block(&reference, expected.data(), expected.data(), count) == DH_FILTER_OK);
+                    for(size_t i=0; i<count; ++i) {
+                        REQUIRE(block[i] == expected[i]);
+                    }
+                }
+                THEN( "Freeing the filter resets it and keeps the buffer" ) {
+                    REQUIRE(dh_free_filter(&filter) == DH_FILTER_OK);
+                    REQUIRE(filter.buffer == nullptr);
+                    REQUIRE(filter.coefficients_in == nullptr);
+                }
+                dh_free_filter(&filter);
+                dh_free_filter(&reference);
+            }
+
+            WHEN( "The buffer is too small" ) {
+                dh_filter_data filter;
+                THEN( "The filter is not created" ) {
+                    REQUIRE(dh_create_filter_in_buffer(&filter, &opts, buffer, size - 1) == DH_FILTER_ALLOCATION_FAILED);
+                }
+            }
+
+            WHEN( "The buffer is not aligned" ) {
+                dh_filter_data filter;
+                std::vector<char> larger;
+                char* start = aligned_pointer(larger, size + alignment, alignment);
+                THEN( "The filter is not created" ) {
+                    REQUIRE(dh_create_filter_in_buffer(&filter, &opts, start + 8, size) == DH_FILTER_ALLOCATION_FAILED);
+                }
+            }
+        }
+    }
+
+    GIVEN( "Unsupported options" ) {
+        auto opts = create_test_parameters(DH_FIR_BRICKWALL_LOWPASS, 10, DH_REALIZATION_SECOND_ORDER_SECTIONS);
+        size_t size = 0;
+        THEN( "No size is computed" ) {
+            REQUIRE(dh_filter_required_size(&opts, &size, nullptr) == DH_FILTER_UNSUPPORTED_REALIZATION);
+            opts.realization = DH_REALIZATION_DEFAULT;
+            opts.filter_type = static_cast<DH_FILTER_TYPE>(1000);
+            REQUIRE(dh_filter_required_size(&opts, &size, nullptr) == DH_FILTER_UNKNOWN_FILTER_TYPE);
+        }
+    }
+}
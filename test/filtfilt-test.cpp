@@ -0,0 +1,191 @@
+#include "catch2/catch_test_macros.hpp"
+#include "dh/filter.h"
+#include "test-helpers.hpp"
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+/**
+ * This source code is licensed under the MIT license. See file "LICENSE" at the root of the repository.
+ */
+
+/**
+ * Pads the signal, filters it forwards and backwards one value at a time and removes the padding.
+ * Before each pass, the filter runs with the first value until the transients have decayed, so it is in the steady state.
+ */
+static std::vector<double> reference_filtfilt(dh_filter_data* filter, const std::vector<double>& signal, size_t edge) {
+    const size_t count = signal.size();
+    std::vector<double> padded;
+    for(size_t i=0; i<edge; ++i) {
+        padded.push_back(2.0*signal[0] - signal[edge - i]);
+    }
+    padded.insert(padded.end(), signal.begin(), signal.end());
+    for(size_t i=0; i<edge; ++i) {
+        padded.push_back(2.0*signal[count-1] - signal[count - 2 - i]);
+    }
+    for(int pass=0; pass<2; ++pass) {
+        REQUIRE(dh_initialize_filter(filter, padded[0]) == DH_FILTER_OK);
+        for(size_t i=0; i<20000; ++i) {
+            REQUIRE(dh_filter(filter, padded[0], nullptr) == DH_FILTER_OK);
+        }
+        for(auto& value : padded) {
+            REQUIRE(dh_filter(filter, value, &value) == DH_FILTER_OK);
+        }
+        std::reverse(padded.begin(), padded.end());
+    }
+    return std::vector<double>(padded.begin() + edge, padded.begin() + edge + count);
+}
+
+SCENARIO( "Zero-phase filtering computes the same values as filtering the padded signal twice", "[filter]" ) {
+    struct test_case {
+        DH_FILTER_TYPE type;
+        size_t order;
+        DH_FILTER_REALIZATION realization;
+        size_t edge;
+    };
+    const test_case cases[] = {
+        {DH_FIR_MOVING_AVERAGE_LOWPASS, 9, DH_REALIZATION_DIRECT_FORM_1, 30},
+        {DH_FIR_MOVING_AVERAGE_LOWPASS, 9, DH_REALIZATION_RUNNING_SUM, 30},
+        {DH_FIR_BRICKWALL_LOWPASS, 100, DH_REALIZATION_DIRECT_FORM_1_MIRRORED, 303},
+        {DH_IIR_BUTTERWORTH_LOWPASS, 6, DH_REALIZATION_SECOND_ORDER_SECTIONS, 21},
+        {DH_IIR_BUTTERWORTH_BANDSTOP, 4, DH_REALIZATION_TRANSPOSED_DIRECT_FORM_2, 27},
+        {DH_IIR_CHEBYSHEV_LOWPASS, 4, DH_REALIZATION_DIRECT_FORM_1, 15},
+        {DH_IIR_BUTTERWORTH_HIGHPASS, 4, DH_REALIZATION_DIRECT_FORM_1, 15},
+        {DH_IIR_CHEBYSHEV_BANDPASS, 4, DH_REALIZATION_DIRECT_FORM_1_MIRRORED, 27},
+        {DH_IIR_CHEBYSHEV2_HIGHPASS, 3, DH_REALIZATION_TRANSPOSED_DIRECT_FORM_2, 12},
+        {DH_IIR_BUTTERWORTH_BANDPASS, 3, DH_REALIZATION_SECOND_ORDER_SECTIONS, 21},
+        {DH_FIR_EXPONENTIAL_MOVING_AVERAGE_LOWPASS, 15, DH_REALIZATION_RECURSIVE_EXPONENTIAL, 48}
+    };
+    const auto signal = create_test_signal(1000);
+
+    for(const auto& current : cases) {
+        GIVEN( "A filter of type " + std::to_string(static_cast<int>(current.type)) + " with realization " + std::to_string(static_cast<int>(current.realization)) ) {
+            auto opts = create_test_parameters(current.type, current.order, current.realization);
+            dh_filter_data filter;
+            REQUIRE(dh_create_filter(&filter, &opts) == DH_FILTER_OK);
+            REQUIRE(filter.realization == current.realization);
+            const auto expected = reference_filtfilt(&filter, signal, current.edge);
+
+            WHEN( "the signal is filtered in place" ) {
+                auto data = signal;
+                REQUIRE(dh_filtfilt(&filter, data.data(), data.size()) == DH_FILTER_OK);
+                THEN( "the outputs are equal" ) {
+                    double max_difference = 0.0;
+                    for(size_t i=0; i<data.size(); ++i) {
+                        max_difference = std::fmax(max_difference, std::fabs(data[i] - expected[i]));
+                    }
+                    REQUIRE(max_difference < 1e-9);
+                }
+            }
+            dh_free_filter(&filter);
+        }
+    }
+}
+
+SCENARIO( "Zero-phase filtering does not shift the signal", "[filter]" ) {
+    GIVEN( "A butterworth lowpass" ) {
+        auto opts = create_test_parameters(DH_IIR_BUTTERWORTH_LOWPASS, 4, DH_REALIZATION_DEFAULT);
+        dh_filter_data filter;
+        REQUIRE(dh_create_filter(&filter, &opts) == DH_FILTER_OK);
+
+        WHEN( "a sine in the passband is filtered" ) {
+            const double omega = 2.0 * M_PI * 2.0 / 100.0;
+            std::vector<double> data(2000);
+            for(size_t i=0; i<data.size(); ++i) {
+                data[i] = std::sin(omega * static_cast<double>(i));
+            }
+            REQUIRE(dh_filtfilt(&filter, data.data(), data.size()) == DH_FILTER_OK);
+            THEN( "the output is in phase with the input" ) {
+                double max_difference = 0.0;
+                for(size_t i=0; i<data.size(); ++i) {
+                    max_difference = std::fmax(max_difference, std::fabs(data[i] - std::sin(omega * static_cast<double>(i))));
+                }
+                REQUIRE(max_difference < 1e-2);
+            }
+        }
+
+        WHEN( "a constant signal is filtered" ) {
+            std::vector<double> data(50, 4.5);
+            REQUIRE(dh_filtfilt(&filter, data.data(), data.size()) == DH_FILTER_OK);
+            THEN( "there are no transients at the edges" ) {
+                for(double value : data) {
+                    REQUIRE(std::fabs(value - 4.5) < 1e-9);
+                }
+            }
+        }
+
+        WHEN( "very short signals are filtered" ) {
+            double value = 2.0;
+            std::vector<double> two{1.0, 3.0};
+            THEN( "the filter runs without padding beyond the signal" ) {
+                REQUIRE(dh_filtfilt(&filter, &value, 1) == DH_FILTER_OK);
+                REQUIRE(std::fabs(value - 2.0) < 1e-9);
+                REQUIRE(dh_filtfilt(&filter, two.data(), two.size()) == DH_FILTER_OK);
+                REQUIRE(std::isfinite(two[0]));
+                REQUIRE(std::isfinite(two[1]));
+                REQUIRE(dh_filtfilt(&filter, nullptr, 0) == DH_FILTER_OK);
+                REQUIRE(dh_filtfilt(&filter, nullptr, 10) == DH_FILTER_NO_DATA_STRUCTURE);
+            }
+        }
+        dh_free_filter(&filter);
+    }
+}
+
+SCENARIO( "Zero-phase filtering starts highpass and bandpass filters in the steady state", "[filter]" ) {
+    struct test_case {
+        DH_FILTER_TYPE type;
+        DH_FILTER_REALIZATION realization;
+        double low;
+        double high;
+        double frequency;
+    };
+    const test_case cases[] = {
+        {DH_IIR_BUTTERWORTH_HIGHPASS, DH_REALIZATION_DIRECT_FORM_1, 10.0, 0.0, 25.0},
+        {DH_IIR_BUTTERWORTH_HIGHPASS, DH_REALIZATION_TRANSPOSED_DIRECT_FORM_2, 10.0, 0.0, 25.0},
+        {DH_IIR_CHEBYSHEV_BANDPASS, DH_REALIZATION_DIRECT_FORM_1, 10.0, 12.0, 11.0},
+        {DH_IIR_CHEBYSHEV_BANDPASS, DH_REALIZATION_DIRECT_FORM_1_MIRRORED, 10.0, 12.0, 11.0},
+        {DH_IIR_CHEBYSHEV_BANDPASS, DH_REALIZATION_SECOND_ORDER_SECTIONS, 10.0, 12.0, 11.0}
+    };
+    for(const auto& current : cases) {
+        GIVEN( "A filter of type " + std::to_string(static_cast<int>(current.type)) + " with realization " + std::to_string(static_cast<int>(current.realization)) ) {
+            auto opts = create_test_parameters(current.type, 4, current.realization);
+            opts.cutoff_frequency_low = current.low;
+            opts.cutoff_frequency_high = current.high;
+            dh_filter_data filter;
+            REQUIRE(dh_create_filter(&filter, &opts) == DH_FILTER_OK);
+
+            WHEN( "a constant signal is filtered" ) {
+                std::vector<double> data(300, 5.0);
+                REQUIRE(dh_filtfilt(&filter, data.data(), data.size()) == DH_FILTER_OK);
+                THEN( "the output is zero from the first value on" ) {
+                    for(double value : data) {
+                        REQUIRE(std::fabs(value) < 1e-9);
+                    }
+                }
+            }
+
+            WHEN( "a large offset with a small sine in the passband is filtered" ) {
+                const double omega = 2.0 * M_PI * current.frequency / opts.sampling_frequency;
+                std::vector<double> data(2001);
+                for(size_t i=0; i<data.size(); ++i) {
+                    data[i] = 5.0 + 0.1 * std::sin(omega * static_cast<double>(i));
+                }
+                REQUIRE(dh_filtfilt(&filter, data.data(), data.size()) == DH_FILTER_OK);
+                THEN( "only the sine is left and the edges stay in the range of the sine" ) {
+                    dh_frequency_response_t response;
+                    REQUIRE(dh_filter_get_gain_at(&filter, current.frequency/opts.sampling_frequency, &response) == DH_FILTER_OK);
+                    const double gain = response.gain * response.gain;
+                    for(size_t i=0; i<data.size(); ++i) {
+                        const double expected = gain * 0.1 * std::sin(omega * static_cast<double>(i));
+                        REQUIRE(std::fabs(data[i]) < 0.2);
+                        if (i >= 600 && i + 600 < data.size()) {
+                            REQUIRE(std::fabs(data[i] - expected) < 1e-3);
+                        }
+                    }
+                }
+            }
+            dh_free_filter(&filter);
+        }
+    }
+}
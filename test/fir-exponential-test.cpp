@@ -1,7 +1,9 @@
 #include "catch2/catch_test_macros.hpp"
 #include "catch2/catch_approx.hpp"
 #include "dh/filter.h"
+#include <cmath>
 #include <cstring>
+#include <string>
 
 /**
  * This source code is licensed under the MIT license. See file "LICENSE" at the root of the repository.
@@ -11,7 +13,7 @@ SCENARIO( "An FIR exponential lowpass filter can be used", "[filter]" ) {
 
     GIVEN( "An options structure filled with values for FIR exponential lowpass filters" ) {
         dh_filter_data filter_data;
-        dh_filter_parameters opts;
+        dh_filter_parameters opts{};
         opts.filter_type = DH_FIR_EXPONENTIAL_MOVING_AVERAGE_LOWPASS;
         opts.cutoff_frequency_low = 20;
         opts.sampling_frequency = 40;
@@ -75,3 +77,57 @@ SCENARIO( "An FIR exponential lowpass filter can be used", "[filter]" ) {
     }
 }
 
+
+
+SCENARIO( "FIR exponential lowpass filters are computed recursively", "[filter]" ) {
+    const double cutoffs[] = {20.0, 1.0, 0.05};
+    for(double cutoff : cutoffs) {
+        for(size_t order : {0, 15, 600}) {
+            GIVEN( "A filter with cutoff " + std::to_string(cutoff) + " and order " + std::to_string(order) ) {
+                dh_filter_parameters opts{};
+                opts.filter_type = DH_FIR_EXPONENTIAL_MOVING_AVERAGE_LOWPASS;
+                opts.cutoff_frequency_low = cutoff;
+                opts.sampling_frequency = 40;
+                opts.filter_order = order;
+                dh_filter_data filter;
+                REQUIRE(dh_create_filter(&filter, &opts) == DH_FILTER_OK);
+                opts.realization = DH_REALIZATION_DIRECT_FORM_1;
+                dh_filter_data reference;
+                REQUIRE(dh_create_filter(&reference, &opts) == DH_FILTER_OK);
+
+                THEN( "the recursion is selected by default" ) {
+                    REQUIRE(filter.realization == DH_REALIZATION_RECURSIVE_EXPONENTIAL);
+                }
+
+                WHEN( "a long signal is filtered" ) {
+                    double max_difference = 0.0;
+                    for(size_t i=0; i<20000; ++i) {
+                        const double t = static_cast<double>(i);
+                        const double value = 100.0 + 5.0*std::sin(0.01*t) + (i%97 < 30 ? 2.0 : -2.0);
+                        double output = 0.0;
+                        double expected = 0.0;
+                        REQUIRE(dh_filter(&filter, value, &output) == DH_FILTER_OK);
+                        REQUIRE(dh_filter(&reference, value, &expected) == DH_FILTER_OK);
+                        max_difference = std::fmax(max_difference, std::fabs(output - expected));
+                    }
+                    THEN( "the output is the same as for the FIR filter up to rounding errors" ) {
+                        REQUIRE(max_difference <= 1e-9);
+                    }
+                }
+                dh_free_filter(&reference);
+                dh_free_filter(&filter);
+            }
+        }
+    }
+
+    GIVEN( "A moving average with the recursive realization" ) {
+        dh_filter_parameters opts{};
+        opts.filter_type = DH_FIR_MOVING_AVERAGE_LOWPASS;
+        opts.filter_order = 4;
+        opts.realization = DH_REALIZATION_RECURSIVE_EXPONENTIAL;
+        dh_filter_data filter{};
+        THEN( "the filter cannot be created" ) {
+            REQUIRE(dh_create_filter(&filter, &opts) == DH_FILTER_UNSUPPORTED_REALIZATION);
+        }
+    }
+}
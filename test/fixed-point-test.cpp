@@ -0,0 +1,170 @@
+#include "catch2/catch_test_macros.hpp"
+#include "dh/filter.h"
+#include "dh/fixed_point.h"
+#include "test-helpers.hpp"
+#include <cmath>
+#include <string>
+#include <vector>
+
+/**
+ * This source code is licensed under the MIT license. See file "LICENSE" at the root of the repository.
+ */
+
+SCENARIO( "Fixed point filters compute the same values as double precision filters", "[filter]" ) {
+    struct test_case {
+        DH_FILTER_TYPE type;
+        size_t order;
+    };
+    const test_case cases[] = {
+        {DH_FIR_MOVING_AVERAGE_LOWPASS, 15},
+        {DH_FIR_BRICKWALL_LOWPASS, 100},
+        {DH_FIR_BRICKWALL_BANDSTOP, 60},
+        {DH_IIR_BUTTERWORTH_LOWPASS, 6},
+        {DH_IIR_BUTTERWORTH_BANDPASS, 4},
+        {DH_IIR_CHEBYSHEV_HIGHPASS, 5},
+        {DH_IIR_CHEBYSHEV2_BANDSTOP, 4}
+    };
+    // the signal stays within [-0.5,0.5], so that the outputs of the filters do not saturate
+    std::vector<double> input(3000);
+    for(size_t i=0; i<input.size(); ++i) {
+        const double t = static_cast<double>(i);
+        input[i] = 0.2*std::sin(0.05*t) + 0.1*std::sin(1.9*t) + (i%211 < 70 ? 0.15 : -0.15);
+    }
+
+    for(const auto& current : cases) {
+        GIVEN( "A filter of type " + std::to_string(static_cast<int>(current.type)) ) {
+            auto opts = create_test_parameters(current.type, current.order);
+            dh_filter_data reference;
+            REQUIRE(dh_create_filter(&reference, &opts) == DH_FILTER_OK);
+            REQUIRE(dh_initialize_filter(&reference, 0.0) == DH_FILTER_OK);
+
+            WHEN( "a signal is filtered with Q15 values" ) {
+                dh_filter_data_q15 filter;
+                dh_fixed_point_report report;
+                REQUIRE(dh_create_filter_q15(&filter, &opts, &report) == DH_FILTER_OK);
+                REQUIRE(dh_initialize_filter_q15(&filter, 0) == DH_FILTER_OK);
+                dh_filter_data_q15 block_filter;
+                REQUIRE(dh_create_filter_q15(&block_filter, &opts, nullptr) == DH_FILTER_OK);
+                REQUIRE(dh_initialize_filter_q15(&block_filter, 0) == DH_FILTER_OK);
+                std::vector<int16_t> block_output(input.size());
+                for(size_t i=0; i<input.size(); ++i) {
+                    block_output[i] = static_cast<int16_t>(std::lround(input[i] * 32768.0));
+                }
+                REQUIRE(dh_filter_block_q15(&block_filter, block_output.data(), block_output.data(), block_output.size()) == DH_FILTER_OK);
+                double max_difference = 0.0;
+                for(size_t i=0; i<input.size(); ++i) {
+                    int16_t output = 0;
+                    double expected = 0.0;
+                    REQUIRE(dh_filter_q15(&filter, static_cast<int16_t>(std::lround(input[i] * 32768.0)), &output) == DH_FILTER_OK);
+                    REQUIRE(dh_filter(&reference, input[i], &expected) == DH_FILTER_OK);
+                    REQUIRE(output == block_output[i]);
+                    max_difference = std::fmax(max_difference, std::fabs(output / 32768.0 - expected));
+                }
+                THEN( "the outputs are equal within the Q15 tolerance" ) {
+                    REQUIRE(max_difference < 5e-3);
+                    REQUIRE(report.max_coefficient_error <= std::ldexp(1.0, static_cast<int>(report.coefficient_shift) - 16) + 1e-12);
+                    REQUIRE(report.max_response_error < 1e-2);
+                    REQUIRE(report.pole_radius_margin > 0.0);
+                    REQUIRE(report.pole_radius_margin <= 1.0);
+                }
+                dh_free_filter_q15(&block_filter);
+                dh_free_filter_q15(&filter);
+            }
+
+            WHEN( "a signal is filtered with Q31 values" ) {
+                dh_filter_data_q31 filter;
+                dh_fixed_point_report report;
+                REQUIRE(dh_create_filter_q31(&filter, &opts, &report) == DH_FILTER_OK);
+                REQUIRE(dh_initialize_filter_q31(&filter, 0) == DH_FILTER_OK);
+                dh_filter_data_q31 block_filter;
+                REQUIRE(dh_create_filter_q31(&block_filter, &opts, nullptr) == DH_FILTER_OK);
+                REQUIRE(dh_initialize_filter_q31(&block_filter, 0) == DH_FILTER_OK);
+                std::vector<int32_t> block_output(input.size());
+                for(size_t i=0; i<input.size(); ++i) {
+                    block_output[i] = static_cast<int32_t>(std::llround(input[i] * 2147483648.0));
+                }
+                REQUIRE(dh_filter_block_q31(&block_filter, block_output.data(), block_output.data(), block_output.size()) == DH_FILTER_OK);
+                double max_difference = 0.0;
+                for(size_t i=0; i<input.size(); ++i) {
+                    int32_t output = 0;
+                    double expected = 0.0;
+                    REQUIRE(dh_filter_q31(&filter, static_cast<int32_t>(std::llround(input[i] * 2147483648.0)), &output) == DH_FILTER_OK);
+                    REQUIRE(dh_filter(&reference, input[i], &expected) == DH_FILTER_OK);
+                    REQUIRE(output == block_output[i]);
+                    max_difference = std::fmax(max_difference, std::fabs(output / 2147483648.0 - expected));
+                }
+                THEN( "the outputs are equal within the Q31 tolerance" ) {
+                    REQUIRE(max_difference < 1e-6);
+                    REQUIRE(report.max_response_error < 1e-6);
+                    REQUIRE(report.pole_radius_margin > 0.0);
+                }
+                dh_free_filter_q31(&block_filter);
+                dh_free_filter_q31(&filter);
+            }
+            dh_free_filter(&reference);
+        }
+    }
+}
+
+SCENARIO( "Fixed point filters report the quantization and saturate", "[filter]" ) {
+    GIVEN( "A FIR filter" ) {
+        auto opts = create_test_parameters(DH_FIR_BRICKWALL_LOWPASS, 40);
+        dh_filter_data_q15 filter;
+        dh_fixed_point_report report;
+        REQUIRE(dh_create_filter_q15(&filter, &opts, &report) == DH_FILTER_OK);
+        THEN( "the filter has no poles" ) {
+            REQUIRE(report.max_pole_radius == 0.0);
+            REQUIRE(report.pole_radius_margin == 1.0);
+            REQUIRE(filter.realization == DH_REALIZATION_DIRECT_FORM_1_MIRRORED);
+            REQUIRE(filter.sections == nullptr);
+        }
+        dh_free_filter_q15(&filter);
+    }
+
+    GIVEN( "An IIR filter with poles close to the unit circle" ) {
+        auto opts = create_test_parameters(DH_IIR_CHEBYSHEV_LOWPASS, 6);
+        opts.cutoff_frequency_low = 2.0;
+        dh_filter_data_q15 filter;
+        dh_fixed_point_report report;
+        REQUIRE(dh_create_filter_q15(&filter, &opts, &report) == DH_FILTER_OK);
+        THEN( "the margin of the poles is reported" ) {
+            REQUIRE(filter.realization == DH_REALIZATION_SECOND_ORDER_SECTIONS);
+            REQUIRE(report.coefficient_shift == 1);
+            REQUIRE(report.max_pole_radius > 0.9);
+            REQUIRE(report.pole_radius_margin > 0.0);
+            REQUIRE(report.pole_radius_margin < 0.1);
+        }
+        WHEN( "a step with the largest value is filtered" ) {
+            REQUIRE(dh_initialize_filter_q15(&filter, 0) == DH_FILTER_OK);
+            int16_t minimum = 0;
+            int16_t maximum = 0;
+            for(size_t i=0; i<500; ++i) {
+                int16_t output = 0;
+                REQUIRE(dh_filter_q15(&filter, INT16_MAX, &output) == DH_FILTER_OK);
+                minimum = std::min(minimum, output);
+                maximum = std::max(maximum, output);
+            }
+            THEN( "the overshoot saturates instead of wrapping around" ) {
+                REQUIRE(minimum >= 0);
+                REQUIRE(maximum > 32000);
+                REQUIRE(filter.current_value > 32000);
+            }
+        }
+        dh_free_filter_q15(&filter);
+    }
+
+    GIVEN( "Filters that cannot be computed with fixed point numbers" ) {
+        auto opts = create_test_parameters(DH_IIR_EXPONENTIAL_LOWPASS, 1);
+        dh_filter_data_q15 filter{};
+        dh_filter_data_q31 filter31{};
+        THEN( "the filters are not created" ) {
+            REQUIRE(dh_create_filter_q15(&filter, &opts, nullptr) == DH_FILTER_UNSUPPORTED_REALIZATION);
+            opts = create_test_parameters(DH_IIR_BUTTERWORTH_LOWPASS, 4);
+            opts.realization = DH_REALIZATION_DIRECT_FORM_1;
+            REQUIRE(dh_create_filter_q31(&filter31, &opts, nullptr) == DH_FILTER_UNSUPPORTED_REALIZATION);
+            opts = create_test_parameters(DH_FIR_MOVING_AVERAGE_LOWPASS, 4);
+            opts.realization = DH_REALIZATION_RUNNING_SUM;
+            REQUIRE(dh_create_filter_q15(&filter, &opts, nullptr) == DH_FILTER_UNSUPPORTED_REALIZATION);
+        }
+    }
+}
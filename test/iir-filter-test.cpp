@@ -8,7 +8,7 @@
 
 SCENARIO( "The coefficients are used in correct order", "[filter]" ) {
     GIVEN( "A filter struct is manually created with different input parameters" ) {
-        dh_filter_data filter_data;
+        dh_filter_data filter_data{};
         filter_data.initialized = true;
         filter_data.current_input_index = 0;
         filter_data.number_coefficients_in = 4;
@@ -64,7 +64,7 @@ SCENARIO( "The coefficients are used in correct order", "[filter]" ) {
     }
 
     GIVEN( "A filter struct is manually created with different output parameters and the last output is set to 1" ) {
-        dh_filter_data filter_data;
+        dh_filter_data filter_data{};
         filter_data.initialized = true;
         filter_data.current_input_index = 0;
         filter_data.number_coefficients_in = 1;
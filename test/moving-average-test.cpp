@@ -1,6 +1,8 @@
 #include "catch2/catch_test_macros.hpp"
 #include "dh/filter.h"
+#include <cmath>
 #include <cstring>
+#include <string>
 
 /**
  * This source code is licensed under the MIT license. See file "LICENSE" at the root of the repository.
@@ -10,7 +12,7 @@ SCENARIO( "A moving average filter can be created", "[filter]" ) {
 
     GIVEN( "An options structure filled with values for moving average filters" ) {
         dh_filter_data moving_avg;
-        dh_filter_parameters opts;
+        dh_filter_parameters opts{};
         opts.filter_type = DH_FIR_MOVING_AVERAGE_LOWPASS;
         opts.filter_order = 15;
 
@@ -58,7 +60,7 @@ SCENARIO( "A moving average filter can be created", "[filter]" ) {
 SCENARIO( "A moving average filter can be used", "[filter]" ) {
 
     GIVEN( "A moving average filter struct is manually created" ) {
-        dh_filter_data moving_avg;
+        dh_filter_data moving_avg{};
         moving_avg.initialized = true;
         moving_avg.current_input_index = 0;
         moving_avg.number_coefficients_in = 4;
@@ -140,7 +142,7 @@ SCENARIO( "A moving average highpass filter can be used", "[filter]" ) {
 
     GIVEN( "An options structure filled with values for moving average filters" ) {
         dh_filter_data moving_avg;
-        dh_filter_parameters opts;
+        dh_filter_parameters opts{};
         opts.filter_type = DH_FIR_MOVING_AVERAGE_HIGHPASS;
         opts.filter_order = 15;
 
@@ -195,3 +197,59 @@ SCENARIO( "A moving average highpass filter can be used", "[filter]" ) {
     }
 }
 
+
+
+SCENARIO( "Moving averages use a running sum", "[filter]" ) {
+    const DH_FILTER_TYPE types[] = { DH_FIR_MOVING_AVERAGE_LOWPASS, DH_FIR_MOVING_AVERAGE_HIGHPASS };
+    for(auto type : types) {
+        for(size_t order : {0, 9, 1000}) {
+            GIVEN( "A moving average of type " + std::to_string(static_cast<int>(type)) + " with order " + std::to_string(order) ) {
+                dh_filter_parameters opts{};
+                opts.filter_type = type;
+                opts.filter_order = order;
+                dh_filter_data filter;
+                REQUIRE(dh_create_filter(&filter, &opts) == DH_FILTER_OK);
+                opts.realization = DH_REALIZATION_DIRECT_FORM_1;
+                dh_filter_data reference;
+                REQUIRE(dh_create_filter(&reference, &opts) == DH_FILTER_OK);
+
+                THEN( "the running sum is selected by default" ) {
+                    REQUIRE(filter.realization == DH_REALIZATION_RUNNING_SUM);
+                    REQUIRE(reference.realization == DH_REALIZATION_DIRECT_FORM_1);
+                }
+
+                WHEN( "a long signal with a large offset is filtered" ) {
+                    double max_difference = 0.0;
+                    for(size_t i=0; i<50000; ++i) {
+                        const double t = static_cast<double>(i);
+                        const double value = 1.0e4 + 3.0*std::sin(0.013*t) + (i%211 < 70 ? 0.1 : -0.1) + 1.0e-3*std::cos(1.7*t);
+                        double output = 0.0;
+                        double expected = 0.0;
+                        REQUIRE(dh_filter(&filter, value, &output) == DH_FILTER_OK);
+                        REQUIRE(dh_filter(&reference, value, &expected) == DH_FILTER_OK);
+                        max_difference = std::fmax(max_difference, std::fabs(output - expected));
+                    }
+                    THEN( "the output does not drift away from the direct form" ) {
+                        // both forms have a rounding error of about (N+1) * eps * 1e4
+                        REQUIRE(max_difference <= 2.0 * static_cast<double>(order + 2) * 2.3e-16 * 1.0e4);
+                    }
+                }
+                dh_free_filter(&reference);
+                dh_free_filter(&filter);
+            }
+        }
+    }
+
+    GIVEN( "A butterworth filter with a running sum" ) {
+        dh_filter_parameters opts{};
+        opts.filter_type = DH_IIR_BUTTERWORTH_LOWPASS;
+        opts.filter_order = 2;
+        opts.cutoff_frequency_low = 10.0;
+        opts.sampling_frequency = 100.0;
+        opts.realization = DH_REALIZATION_RUNNING_SUM;
+        dh_filter_data filter{};
+        THEN( "the filter cannot be created" ) {
+            REQUIRE(dh_create_filter(&filter, &opts) == DH_FILTER_UNSUPPORTED_REALIZATION);
+        }
+    }
+}
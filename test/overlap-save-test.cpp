@@ -0,0 +1,187 @@
+#include "catch2/catch_test_macros.hpp"
+#include "dh/filter.h"
+#include "dh/fft.h"
+#include "dh/overlap_save.h"
+#include "test-helpers.hpp"
+#define _USE_MATH_DEFINES
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+/**
+ * This source code is licensed under the MIT license. See file "LICENSE" at the root of the repository.
+ */
+
+SCENARIO( "The FFT computes the discrete fourier transform", "[filter]" ) {
+    for(size_t length : {4, 8, 64, 512}) {
+        GIVEN( "A real signal with " + std::to_string(length) + " values" ) {
+            std::vector<double> signal(length);
+            for(size_t i=0; i<length; ++i) {
+                signal[i] = std::sin(1.3*static_cast<double>(i)) + 0.01*static_cast<double>(i);
+            }
+            std::vector<double> twiddles(length);
+            dh_fft_compute_twiddles(twiddles.data(), length);
+            std::vector<double> data(signal);
+            data.resize(length+2);
+
+            WHEN( "the signal is transformed" ) {
+                dh_fft_real_forward(data.data(), length, twiddles.data());
+                THEN( "the result is equal to the discrete fourier transform" ) {
+                    for(size_t k=0; k<=length/2; ++k) {
+                        double re = 0.0;
+                        double im = 0.0;
+                        for(size_t t=0; t<length; ++t) {
+                            const double phi = 2.0*M_PI*static_cast<double>(k*t % length)/static_cast<double>(length);
+                            re += signal[t]*std::cos(phi);
+                            im -= signal[t]*std::sin(phi);
+                        }
+                        REQUIRE(std::fabs(data[2*k] - re) < 1e-10);
+                        REQUIRE(std::fabs(data[2*k+1] - im) < 1e-10);
+                    }
+                }
+                AND_WHEN( "the spectrum is transformed back" ) {
+                    dh_fft_real_inverse(data.data(), length, twiddles.data());
+                    THEN( "the signal is restored after scaling" ) {
+                        for(size_t i=0; i<length; ++i) {
+                            REQUIRE(std::fabs(data[i]*2.0/static_cast<double>(length) - signal[i]) < 1e-12);
+                        }
+                    }
+                }
+            }
+        }
+    }
+    GIVEN( "Invalid lengths" ) {
+        THEN( "they are rejected" ) {
+            REQUIRE(dh_fft_is_valid_length(0) == false);
+            REQUIRE(dh_fft_is_valid_length(2) == false);
+            REQUIRE(dh_fft_is_valid_length(96) == false);
+            REQUIRE(dh_fft_is_valid_length(128) == true);
+        }
+    }
+}
+
+SCENARIO( "Long FIR filters can use the overlap-save convolution for blocks", "[filter]" ) {
+    struct test_case {
+        DH_FILTER_TYPE type;
+        size_t order;
+        DH_FILTER_REALIZATION realization;
+    };
+    const test_case cases[] = {
+        {DH_FIR_BRICKWALL_LOWPASS, 1000, DH_REALIZATION_OVERLAP_SAVE},
+        {DH_FIR_BRICKWALL_HIGHPASS, 200, DH_REALIZATION_OVERLAP_SAVE},
+        {DH_FIR_BRICKWALL_BANDPASS, 300, DH_REALIZATION_OVERLAP_SAVE},
+        {DH_FIR_BRICKWALL_BANDSTOP, DH_FILTER_FFT_MIN_COEFFICIENTS - 1, DH_REALIZATION_OVERLAP_SAVE}
+    };
+    std::vector<double> input(20000);
+    for(size_t i=0; i<input.size(); ++i) {
+        const double t = static_cast<double>(i);
+        input[i] = 1.0 + std::sin(0.05*t) + 0.5*std::sin(2.1*t) + (i%301 < 100 ? 1.0 : -1.0);
+    }
+
+    for(const auto& current : cases) {
+        GIVEN( "A filter of type " + std::to_string(static_cast<int>(current.type)) + " with order " + std::to_string(current.order) ) {
+            auto opts = create_test_parameters(current.type, current.order, current.realization);
+            dh_filter_data filter;
+            REQUIRE(dh_create_filter(&filter, &opts) == DH_FILTER_OK);
+            auto reference_opts = opts;
+            reference_opts.realization = DH_REALIZATION_DIRECT_FORM_1;
+            dh_filter_data reference;
+            REQUIRE(dh_create_filter(&reference, &reference_opts) == DH_FILTER_OK);
+            std::vector<double> expected(input.size());
+            for(size_t i=0; i<input.size(); ++i) {
+                REQUIRE(dh_filter(&reference, input[i], &expected[i]) == DH_FILTER_OK);
+            }
+            double sum_coefficients = 0.0;
+            for(size_t i=0; i<filter.number_coefficients_in; ++i) {
+                sum_coefficients += std::fabs(filter.coefficients_in[i]);
+            }
+            // the inputs are below 3.0, the FFT has a relative error of about log2(N)*eps
+            const double tolerance = 3.0 * sum_coefficients * 1e-13;
+
+            const bool uses_fft = filter.number_coefficients_in >= DH_FILTER_FFT_MIN_COEFFICIENTS;
+
+            THEN( "the overlap-save convolution is only prepared for filters with enough coefficients" ) {
+                REQUIRE(filter.realization == DH_REALIZATION_DIRECT_FORM_1);
+                if (uses_fft) {
+                    REQUIRE(filter.overlap_save.fft_length >= 2*filter.number_coefficients_in);
+                    REQUIRE(dh_fft_is_valid_length(filter.overlap_save.fft_length));
+                    REQUIRE(filter.buffer_length > reference.buffer_length);
+                } else {
+                    REQUIRE(filter.overlap_save.fft_length == 0);
+                    REQUIRE(filter.buffer_length == reference.buffer_length);
+                }
+            }
+
+            WHEN( "the signal is filtered in blocks of different sizes" ) {
+                std::vector<double> output(input);
+                size_t position = 0;
+                size_t block = 1;
+                while(position < output.size()) {
+                    const size_t count = std::min(block, output.size()-position);
+                    REQUIRE(dh_filter_block_inplace(&filter, output.data()+position, count) == DH_FILTER_OK);
+                    position += count;
+                    block = (block*7)%9001 + 1;
+                }
+                THEN( "the output is equal to the direct convolution within the tolerance" ) {
+                    for(size_t i=0; i<input.size(); ++i) {
+                        REQUIRE(std::fabs(output[i] - expected[i]) <= tolerance);
+                        if (!uses_fft) {
+                            REQUIRE(output[i] == expected[i]);
+                        }
+                    }
+                    REQUIRE(filter.current_value == output.back());
+                }
+                AND_WHEN( "single values are filtered afterwards" ) {
+                    double value = 0.0;
+                    double expected_value = 0.0;
+                    for(size_t i=0; i<100; ++i) {
+                        REQUIRE(dh_filter(&filter, input[i], &value) == DH_FILTER_OK);
+                        REQUIRE(dh_filter(&reference, input[i], &expected_value) == DH_FILTER_OK);
+                        REQUIRE(std::fabs(value - expected_value) <= tolerance);
+                    }
+                }
+            }
+            dh_free_filter(&reference);
+            dh_free_filter(&filter);
+        }
+    }
+
+    for(size_t order : {size_t(DH_FILTER_FFT_MIN_COEFFICIENTS - 2), size_t(1000)}) {
+        GIVEN( "A FIR filter with order " + std::to_string(order) + " and the default realization" ) {
+            auto opts = create_test_parameters(DH_FIR_BRICKWALL_LOWPASS, order, DH_REALIZATION_DEFAULT);
+            dh_filter_data filter;
+            dh_filter_data reference;
+            REQUIRE(dh_create_filter(&filter, &opts) == DH_FILTER_OK);
+            REQUIRE(dh_create_filter(&reference, &opts) == DH_FILTER_OK);
+            THEN( "no memory is reserved for the overlap-save convolution" ) {
+                REQUIRE(filter.overlap_save.fft_length == 0);
+                const size_t history_factor = filter.realization == DH_REALIZATION_DIRECT_FORM_1_MIRRORED ? 2 : 1;
+                REQUIRE(filter.buffer_length == (1 + history_factor)*(filter.number_coefficients_in + filter.number_coefficients_out)*sizeof(double));
+            }
+            WHEN( "the signal is filtered in blocks" ) {
+                std::vector<double> output(input);
+                for(size_t position=0; position<output.size(); position+=5000) {
+                    REQUIRE(dh_filter_block_inplace(&filter, output.data()+position, 5000) == DH_FILTER_OK);
+                }
+                THEN( "the outputs are identical to filtering every value with dh_filter()" ) {
+                    for(size_t i=0; i<input.size(); ++i) {
+                        double expected = 0.0;
+                        REQUIRE(dh_filter(&reference, input[i], &expected) == DH_FILTER_OK);
+                        REQUIRE(output[i] == expected);
+                    }
+                }
+            }
+            dh_free_filter(&reference);
+            dh_free_filter(&filter);
+        }
+    }
+
+    GIVEN( "An IIR filter" ) {
+        auto opts = create_test_parameters(DH_IIR_BUTTERWORTH_LOWPASS, 4, DH_REALIZATION_OVERLAP_SAVE);
+        dh_filter_data filter{};
+        THEN( "the overlap-save convolution cannot be requested" ) {
+            REQUIRE(dh_create_filter(&filter, &opts) == DH_FILTER_UNSUPPORTED_REALIZATION);
+        }
+    }
+}
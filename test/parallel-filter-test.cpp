@@ -0,0 +1,138 @@
+#include "catch2/catch_test_macros.hpp"
+#include "dh/filter.h"
+#include "test-helpers.hpp"
+#include <cmath>
+#include <string>
+#include <vector>
+
+/**
+ * This source code is licensed under the MIT license. See file "LICENSE" at the root of the repository.
+ */
+
+SCENARIO( "Long signals can be filtered with several threads", "[filter]" ) {
+    struct test_case {
+        DH_FILTER_TYPE type;
+        size_t order;
+        DH_FILTER_REALIZATION realization;
+    };
+    const test_case cases[] = {
+        {DH_IIR_BUTTERWORTH_LOWPASS, 6, DH_REALIZATION_SECOND_ORDER_SECTIONS},
+        {DH_IIR_CHEBYSHEV_BANDPASS, 4, DH_REALIZATION_SECOND_ORDER_SECTIONS},
+        {DH_IIR_CHEBYSHEV2_HIGHPASS, 3, DH_REALIZATION_TRANSPOSED_DIRECT_FORM_2},
+        {DH_IIR_BUTTERWORTH_BANDSTOP, 2, DH_REALIZATION_TRANSPOSED_DIRECT_FORM_2},
+        {DH_IIR_CHEBYSHEV_LOWPASS, 5, DH_REALIZATION_DEFAULT},
+        {DH_IIR_BUTTERWORTH_BANDPASS, 2, DH_REALIZATION_DIRECT_FORM_1_MIRRORED},
+        {DH_IIR_EXPONENTIAL_LOWPASS, 1, DH_REALIZATION_DIRECT_FORM_1},
+        {DH_FIR_BRICKWALL_LOWPASS, 1500, DH_REALIZATION_DEFAULT}
+    };
+    const size_t count = 30011;
+    const size_t thread_counts[] = {1, 2, 3, 8};
+
+    for(const auto& current : cases) {
+        for(size_t threads : thread_counts) {
+            GIVEN( "A filter of type " + std::to_string(static_cast<int>(current.type)) + " and " + std::to_string(threads) + " threads" ) {
+                auto opts = create_test_parameters(current.type, current.order, current.realization);
+                dh_filter_data reference;
+                dh_filter_data filter;
+                REQUIRE(dh_create_filter(&reference, &opts) == DH_FILTER_OK);
+                REQUIRE(dh_create_filter(&filter, &opts) == DH_FILTER_OK);
+                std::vector<double> input(count + 500);
+                for(size_t i=0; i<input.size(); ++i) {
+                    input[i] = test_signal(i);
+                }
+                std::vector<double> expected(input.size());
+                REQUIRE(dh_filter_block(&reference, input.data(), expected.data(), input.size()) == DH_FILTER_OK);
+
+                WHEN( "the signal is filtered in parallel" ) {
+                    std::vector<double> output(input.size());
+                    REQUIRE(dh_filter_block_parallel(&filter, input.data(), output.data(), count, threads) == DH_FILTER_OK);
+                    THEN( "the outputs are the same as for a single thread up to rounding errors" ) {
+                        double max_difference = 0.0;
+                        for(size_t i=0; i<count; ++i) {
+                            max_difference = std::fmax(max_difference, std::fabs(output[i] - expected[i]));
+                        }
+                        REQUIRE(max_difference < 1e-10);
+                        REQUIRE(std::fabs(filter.current_value - expected[count - 1]) < 1e-10);
+                    }
+                    AND_THEN( "the filter continues with the correct state" ) {
+                        double max_difference = 0.0;
+                        for(size_t i=count; i<input.size(); ++i) {
+                            REQUIRE(dh_filter(&filter, input[i], &output[i]) == DH_FILTER_OK);
+                            max_difference = std::fmax(max_difference, std::fabs(output[i] - expected[i]));
+                        }
+                        REQUIRE(max_difference < 1e-10);
+                    }
+                }
+
+                WHEN( "the signal is filtered in place" ) {
+                    std::vector<double> data(input.begin(), input.begin() + count);
+                    REQUIRE(dh_filter_block_parallel(&filter, data.data(), data.data(), count, threads) == DH_FILTER_OK);
+                    THEN( "the outputs are the same as for a single thread up to rounding errors" ) {
+                        double max_difference = 0.0;
+                        for(size_t i=0; i<count; ++i) {
+                            max_difference = std::fmax(max_difference, std::fabs(data[i] - expected[i]));
+                        }
+                        REQUIRE(max_difference < 1e-10);
+                    }
+                }
+                dh_free_filter(&reference);
+                dh_free_filter(&filter);
+            }
+        }
+    }
+
+    GIVEN( "A filter in direct form 1 that was created with the default realization" ) {
+        auto opts = create_test_parameters(DH_IIR_BUTTERWORTH_LOWPASS, 4);
+        dh_filter_data filter;
+        dh_filter_data reference;
+        REQUIRE(dh_create_filter(&filter, &opts) == DH_FILTER_OK);
+        REQUIRE(dh_create_filter(&reference, &opts) == DH_FILTER_OK);
+        REQUIRE(filter.realization == DH_REALIZATION_DIRECT_FORM_1);
+        auto data = create_test_signal(5000);
+        std::vector<double> expected(data.size());
+        REQUIRE(dh_filter_block(&reference, data.data(), expected.data(), data.size()) == DH_FILTER_OK);
+        THEN( "the outputs and the past values are the same as for a single thread up to rounding errors" ) {
+            REQUIRE(dh_filter_block_parallel(&filter, data.data(), data.data(), data.size(), 4) == DH_FILTER_OK);
+            for(size_t i=0; i<data.size(); ++i) {
+                REQUIRE(std::fabs(data[i] - expected[i]) < 1e-10);
+            }
+            // the circular buffers may start at different positions, so the past inputs are compared by their age
+            const size_t n = filter.number_coefficients_in;
+            for(size_t k=0; k<n; ++k) {
+                REQUIRE(filter.inputs[(filter.current_input_index + k) % n] == reference.inputs[(reference.current_input_index + k) % n]);
+            }
+        }
+        dh_free_filter(&reference);
+        dh_free_filter(&filter);
+    }
+
+    GIVEN( "A FIR filter that is longer than the chunks" ) {
+        auto opts = create_test_parameters(DH_FIR_BRICKWALL_LOWPASS, 3000);
+        dh_filter_data filter;
+        dh_filter_data reference;
+        REQUIRE(dh_create_filter(&filter, &opts) == DH_FILTER_OK);
+        REQUIRE(dh_create_filter(&reference, &opts) == DH_FILTER_OK);
+        auto data = create_test_signal(5000);
+        std::vector<double> expected(data.size());
+        REQUIRE(dh_filter_block(&reference, data.data(), expected.data(), data.size()) == DH_FILTER_OK);
+        THEN( "the past inputs of the later chunks reach back to the values before the signal" ) {
+            REQUIRE(dh_filter_block_parallel(&filter, data.data(), data.data(), data.size(), 4) == DH_FILTER_OK);
+            for(size_t i=0; i<data.size(); ++i) {
+                REQUIRE(std::fabs(data[i] - expected[i]) < 1e-10);
+            }
+        }
+        dh_free_filter(&reference);
+        dh_free_filter(&filter);
+    }
+
+    GIVEN( "A moving average with a running sum" ) {
+        auto opts = create_test_parameters(DH_FIR_MOVING_AVERAGE_LOWPASS, 10, DH_REALIZATION_RUNNING_SUM);
+        dh_filter_data filter;
+        REQUIRE(dh_create_filter(&filter, &opts) == DH_FILTER_OK);
+        std::vector<double> data(5000, 1.0);
+        THEN( "the realization is not supported" ) {
+            REQUIRE(dh_filter_block_parallel(&filter, data.data(), data.data(), data.size(), 4) == DH_FILTER_UNSUPPORTED_REALIZATION);
+        }
+        dh_free_filter(&filter);
+    }
+}
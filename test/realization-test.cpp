@@ -0,0 +1,340 @@
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/catch_approx.hpp"
+#include "dh/filter.h"
+#include "test-helpers.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <vector>
+
+/**
+ * This source code is licensed under the MIT license. See file "LICENSE" at the root of the repository.
+ */
+
+static std::vector<double> filter_signal(dh_filter_parameters opts, const std::vector<double>& input) {
+    dh_filter_data filter;
+    REQUIRE(dh_create_filter(&filter, &opts) == DH_FILTER_OK);
+    std::vector<double> rv(input.size());
+    for(size_t i=0; i<input.size(); ++i) {
+        REQUIRE(dh_filter(&filter, input[i], &rv[i]) == DH_FILTER_OK);
+    }
+    dh_free_filter(&filter);
+    return rv;
+}
+
+SCENARIO( "Filters can use mirrored buffers", "[filter]" ) {
+    const DH_FILTER_TYPE types[] = {
+        DH_NO_FILTER,
+        DH_FIR_MOVING_AVERAGE_HIGHPASS,
+        DH_FIR_EXPONENTIAL_MOVING_AVERAGE_LOWPASS,
+        DH_FIR_BRICKWALL_LOWPASS,
+        DH_FIR_BRICKWALL_BANDPASS,
+        DH_FIR_BRICKWALL_BANDSTOP,
+        DH_IIR_EXPONENTIAL_LOWPASS,
+        DH_IIR_BUTTERWORTH_LOWPASS,
+        DH_IIR_CHEBYSHEV_BANDSTOP,
+        DH_IIR_CHEBYSHEV2_HIGHPASS
+    };
+    const auto input = create_test_signal(400);
+
+    for(auto type : types) {
+        GIVEN( "A filter of type " + std::to_string(static_cast<int>(type)) + " with mirrored buffers" ) {
+            auto opts = create_test_parameters(type, 5, DH_REALIZATION_DIRECT_FORM_1_MIRRORED);
+            dh_filter_data filter;
+            REQUIRE(dh_create_filter(&filter, &opts) == DH_FILTER_OK);
+
+            THEN( "the buffers for the past values have twice the length of the coefficient arrays" ) {
+                REQUIRE(filter.realization == DH_REALIZATION_DIRECT_FORM_1_MIRRORED);
+                REQUIRE(filter.inputs + 2*filter.number_coefficients_in <= filter.coefficients_out);
+                REQUIRE(filter.outputs + 2*filter.number_coefficients_out <= (double*)(filter.buffer + filter.buffer_length));
+            }
+
+            WHEN( "a signal is filtered" ) {
+                const auto expected = filter_signal(create_test_parameters(type, 5, DH_REALIZATION_DIRECT_FORM_1), input);
+                std::vector<double> output(input.size());
+                REQUIRE(dh_filter_block(&filter, input.data(), output.data(), 150) == DH_FILTER_OK);
+                for(size_t i=150; i<input.size(); ++i) {
+                    REQUIRE(dh_filter(&filter, input[i], &output[i]) == DH_FILTER_OK);
+                }
+                THEN( "the output is identical to a filter with circular buffers" ) {
+                    for(size_t i=0; i<input.size(); ++i) {
+                        REQUIRE(output[i] == expected[i]);
+                    }
+                }
+            }
+            dh_free_filter(&filter);
+        }
+    }
+}
+
+SCENARIO( "Butterworth and Chebyshev filters can use second order sections", "[filter]" ) {
+    const DH_FILTER_TYPE types[] = {
+        DH_IIR_BUTTERWORTH_LOWPASS,
+        DH_IIR_BUTTERWORTH_HIGHPASS,
+        DH_IIR_BUTTERWORTH_BANDPASS,
+        DH_IIR_BUTTERWORTH_BANDSTOP,
+        DH_IIR_CHEBYSHEV_LOWPASS,
+        DH_IIR_CHEBYSHEV_BANDPASS,
+        DH_IIR_CHEBYSHEV2_HIGHPASS,
+        DH_IIR_CHEBYSHEV2_BANDSTOP
+    };
+    const auto input = create_test_signal(400);
+
+    for(auto type : types) {
+        for(size_t order : {3, 4}) {
+            GIVEN( "A filter of type " + std::to_string(static_cast<int>(type)) + " with order " + std::to_string(order) + " and second order sections" ) {
+                auto opts = create_test_parameters(type, order, DH_REALIZATION_SECOND_ORDER_SECTIONS);
+                dh_filter_data filter;
+                REQUIRE(dh_create_filter(&filter, &opts) == DH_FILTER_OK);
+                auto reference_opts = create_test_parameters(type, order, DH_REALIZATION_DIRECT_FORM_1);
+                dh_filter_data reference;
+                REQUIRE(dh_create_filter(&reference, &reference_opts) == DH_FILTER_OK);
+
+                THEN( "the filter has one section for every two poles and no direct form buffers" ) {
+                    REQUIRE(filter.realization == DH_REALIZATION_SECOND_ORDER_SECTIONS);
+                    REQUIRE(filter.number_sections == filter.number_coefficients_out/2);
+                    REQUIRE(filter.state_length == 2*filter.number_sections);
+                    REQUIRE(filter.inputs == NULL);
+                    REQUIRE(filter.outputs == NULL);
+                }
+
+                THEN( "the frequency response is the same as for the direct form" ) {
+                    for(double frequency : {0.0, 5.0, 10.0, 17.5, 25.0, 40.0, 50.0}) {
+                        dh_frequency_response_t expected;
+                        dh_frequency_response_t response;
+                        REQUIRE(dh_filter_get_gain_at(&reference, frequency/opts.sampling_frequency, &expected) == DH_FILTER_OK);
+                        REQUIRE(dh_filter_get_gain_at(&filter, frequency/opts.sampling_frequency, &response) == DH_FILTER_OK);
+                        REQUIRE(response.gain == Catch::Approx(expected.gain).margin(1e-9));
+                    }
+                }
+
+                WHEN( "a signal is filtered" ) {
+                    const auto expected = filter_signal(reference_opts, input);
+                    std::vector<double> output(input.size());
+                    REQUIRE(dh_filter_block(&filter, input.data(), output.data(), 150) == DH_FILTER_OK);
+                    for(size_t i=150; i<input.size(); ++i) {
+                        REQUIRE(dh_filter(&filter, input[i], &output[i]) == DH_FILTER_OK);
+                    }
+                    THEN( "the output is the same as for the direct form within rounding errors" ) {
+                        for(size_t i=0; i<input.size(); ++i) {
+                            REQUIRE(output[i] == Catch::Approx(expected[i]).margin(1e-9));
+                        }
+                    }
+                }
+                dh_free_filter(&reference);
+                dh_free_filter(&filter);
+            }
+        }
+    }
+
+    GIVEN( "A narrow bandpass with a high order" ) {
+        auto opts = create_test_parameters(DH_IIR_BUTTERWORTH_BANDPASS, 12, DH_REALIZATION_SECOND_ORDER_SECTIONS);
+        opts.cutoff_frequency_low = 4.8;
+        opts.cutoff_frequency_high = 5.2;
+        dh_filter_data filter;
+        REQUIRE(dh_create_filter(&filter, &opts) == DH_FILTER_OK);
+        WHEN( "a sine at the center frequency is filtered" ) {
+            double sum_squares = 0.0;
+            for(size_t i=0; i<20000; ++i) {
+                double output = 0.0;
+                REQUIRE(dh_filter(&filter, std::sin(2.0*M_PI*5.0*static_cast<double>(i)/opts.sampling_frequency), &output) == DH_FILTER_OK);
+                if (i >= 16000) {
+                    sum_squares += output*output;
+                }
+            }
+            THEN( "the filter is stable and passes the sine" ) {
+                const double amplitude = std::sqrt(2.0*sum_squares/4000.0);
+                REQUIRE(amplitude == Catch::Approx(1.0).margin(0.01));
+            }
+        }
+        dh_free_filter(&filter);
+    }
+}
+
+SCENARIO( "Filters can use the transposed direct form 2", "[filter]" ) {
+    const DH_FILTER_TYPE types[] = {
+        DH_NO_FILTER,
+        DH_FIR_MOVING_AVERAGE_LOWPASS,
+        DH_FIR_MOVING_AVERAGE_HIGHPASS,
+        DH_FIR_EXPONENTIAL_MOVING_AVERAGE_LOWPASS,
+        DH_FIR_BRICKWALL_HIGHPASS,
+        DH_FIR_BRICKWALL_BANDPASS,
+        DH_FIR_BRICKWALL_BANDSTOP,
+        DH_IIR_EXPONENTIAL_LOWPASS,
+        DH_IIR_BUTTERWORTH_LOWPASS,
+        DH_IIR_BUTTERWORTH_BANDPASS,
+        DH_IIR_CHEBYSHEV_HIGHPASS,
+        DH_IIR_CHEBYSHEV2_BANDSTOP
+    };
+    const auto input = create_test_signal(400);
+
+    for(auto type : types) {
+        GIVEN( "A filter of type " + std::to_string(static_cast<int>(type)) + " in transposed direct form 2" ) {
+            auto opts = create_test_parameters(type, 4, DH_REALIZATION_TRANSPOSED_DIRECT_FORM_2);
+            dh_filter_data filter;
+            REQUIRE(dh_create_filter(&filter, &opts) == DH_FILTER_OK);
+
+            THEN( "the filter has a single state array" ) {
+                const size_t length = std::max(filter.number_coefficients_in, filter.number_coefficients_out) - 1;
+                REQUIRE(filter.realization == DH_REALIZATION_TRANSPOSED_DIRECT_FORM_2);
+                REQUIRE(filter.state_length >= length);
+                REQUIRE(filter.inputs == NULL);
+                REQUIRE(filter.outputs == NULL);
+                if (type != DH_FIR_BRICKWALL_BANDSTOP) {
+                    REQUIRE(filter.state_length == length);
+                }
+            }
+
+            WHEN( "a signal is filtered" ) {
+                const auto expected = filter_signal(create_test_parameters(type, 4, DH_REALIZATION_DIRECT_FORM_1), input);
+                std::vector<double> output(input.size());
+                REQUIRE(dh_filter_block(&filter, input.data(), output.data(), 150) == DH_FILTER_OK);
+                for(size_t i=150; i<input.size(); ++i) {
+                    REQUIRE(dh_filter(&filter, input[i], &output[i]) == DH_FILTER_OK);
+                }
+                THEN( "the output is the same as for the direct form 1 within rounding errors" ) {
+                    for(size_t i=0; i<input.size(); ++i) {
+                        REQUIRE(output[i] == Catch::Approx(expected[i]).margin(1e-9));
+                    }
+                }
+            }
+            dh_free_filter(&filter);
+        }
+    }
+}
+
+SCENARIO( "The realization is validated", "[filter]" ) {
+    GIVEN( "Parameters with the default realization" ) {
+        auto opts = create_test_parameters(DH_IIR_BUTTERWORTH_LOWPASS, 3, DH_REALIZATION_DEFAULT);
+        dh_filter_data filter;
+        WHEN( "the filter is created" ) {
+            REQUIRE(dh_create_filter(&filter, &opts) == DH_FILTER_OK);
+            THEN( "the filter uses circular buffers" ) {
+                REQUIRE(filter.realization == DH_REALIZATION_DIRECT_FORM_1);
+                REQUIRE(filter.buffer_length == 4*4*sizeof(double));
+            }
+            dh_free_filter(&filter);
+        }
+    }
+
+    GIVEN( "Parameters that were not zero initialized" ) {
+        dh_filter_parameters opts;
+        std::memset(&opts, 0xA5, sizeof(opts));
+        REQUIRE(dh_filter_parameters_init(&opts) == DH_FILTER_OK);
+        opts.filter_type = DH_IIR_BUTTERWORTH_LOWPASS;
+        opts.filter_order = 3;
+        opts.cutoff_frequency_low = 10.0;
+        opts.sampling_frequency = 100.0;
+        dh_filter_data filter;
+        WHEN( "the filter is created" ) {
+            REQUIRE(dh_create_filter(&filter, &opts) == DH_FILTER_OK);
+            THEN( "dh_filter_parameters_init() selected the defaults of the new options" ) {
+                REQUIRE(opts.realization == DH_REALIZATION_DEFAULT);
+                REQUIRE(!opts.flush_denormals);
+                REQUIRE(filter.realization == DH_REALIZATION_DIRECT_FORM_1);
+                REQUIRE(!filter.flush_denormals);
+            }
+            dh_free_filter(&filter);
+        }
+    }
+
+    GIVEN( "Parameters with an invalid realization" ) {
+        auto opts = create_test_parameters(DH_IIR_BUTTERWORTH_LOWPASS, 3, static_cast<DH_FILTER_REALIZATION>(1000));
+        dh_filter_data filter{};
+        THEN( "the filter cannot be created" ) {
+            REQUIRE(dh_create_filter(&filter, &opts) == DH_FILTER_UNSUPPORTED_REALIZATION);
+        }
+    }
+
+    GIVEN( "A FIR filter with second order sections" ) {
+        auto opts = create_test_parameters(DH_FIR_BRICKWALL_LOWPASS, 3, DH_REALIZATION_SECOND_ORDER_SECTIONS);
+        dh_filter_data filter{};
+        THEN( "the filter cannot be created" ) {
+            REQUIRE(dh_create_filter(&filter, &opts) == DH_FILTER_UNSUPPORTED_REALIZATION);
+        }
+    }
+}
+
+SCENARIO( "Specialized kernels compute the same values as the general kernels", "[filter]" ) {
+    struct test_case {
+        DH_FILTER_TYPE type;
+        size_t order;
+        DH_FILTER_REALIZATION realization;
+    };
+    const test_case cases[] = {
+        {DH_FIR_BRICKWALL_LOWPASS, 20, DH_REALIZATION_DIRECT_FORM_1},
+        {DH_FIR_BRICKWALL_BANDPASS, 24, DH_REALIZATION_DIRECT_FORM_1_MIRRORED},
+        {DH_FIR_BRICKWALL_HIGHPASS, 5, DH_REALIZATION_DIRECT_FORM_1},
+        {DH_FIR_MOVING_AVERAGE_LOWPASS, 6, DH_REALIZATION_DIRECT_FORM_1_MIRRORED},
+        {DH_IIR_EXPONENTIAL_LOWPASS, 1, DH_REALIZATION_DEFAULT},
+        {DH_IIR_BUTTERWORTH_LOWPASS, 1, DH_REALIZATION_DEFAULT},
+        {DH_IIR_BUTTERWORTH_HIGHPASS, 3, DH_REALIZATION_DEFAULT},
+        {DH_IIR_CHEBYSHEV_BANDPASS, 2, DH_REALIZATION_DEFAULT},
+        {DH_IIR_BUTTERWORTH_LOWPASS, 8, DH_REALIZATION_DEFAULT},
+        {DH_IIR_CHEBYSHEV2_BANDSTOP, 4, DH_REALIZATION_DEFAULT},
+        {DH_IIR_BUTTERWORTH_LOWPASS, 10, DH_REALIZATION_DEFAULT}
+    };
+    const auto input = create_test_signal(1000);
+
+    for(const auto& current : cases) {
+        GIVEN( "A filter of type " + std::to_string(static_cast<int>(current.type)) + " and order " + std::to_string(current.order) ) {
+            auto opts = create_test_parameters(current.type, current.order, current.realization);
+            dh_filter_data filter;
+            REQUIRE(dh_create_filter(&filter, &opts) == DH_FILTER_OK);
+            dh_filter_data reference;
+            REQUIRE(dh_create_filter(&reference, &opts) == DH_FILTER_OK);
+            reference.kernel = NULL;
+
+            THEN( "a kernel is selected" ) {
+                REQUIRE(filter.kernel != NULL);
+                REQUIRE(filter.kernel == dh_select_filter_kernel(&filter));
+            }
+
+            WHEN( "the filter has no dot product" ) {
+                filter.dot_product = NULL;
+                filter.kernel = dh_select_filter_kernel(&filter);
+                reference.dot_product = NULL;
+                std::vector<double> output(input.size());
+                std::vector<double> expected(input.size());
+                REQUIRE(dh_filter_block(&filter, input.data(), output.data(), input.size()) == DH_FILTER_OK);
+                REQUIRE(dh_filter_block(&reference, input.data(), expected.data(), input.size()) == DH_FILTER_OK);
+                THEN( "a kernel is still selected and the outputs are identical" ) {
+                    REQUIRE(filter.kernel != NULL);
+                    REQUIRE(output == expected);
+                }
+            }
+
+            WHEN( "the buffers of a filter with a kernel are removed" ) {
+                double* inputs = filter.inputs;
+                filter.inputs = NULL;
+                THEN( "the filter is rejected instead of running the kernel" ) {
+                    double output = 0.0;
+                    REQUIRE(filter.kernel != NULL);
+                    REQUIRE(dh_filter(&filter, 1.0, &output) == DH_FILTER_DATA_STRUCTURE_NOT_INITIALIZED);
+                }
+                filter.inputs = inputs;
+            }
+
+            WHEN( "the gain is changed and a signal is filtered in blocks" ) {
+                std::vector<double> output(input.size());
+                std::vector<double> expected(input.size());
+                REQUIRE(dh_filter_block(&filter, input.data(), output.data(), 333) == DH_FILTER_OK);
+                REQUIRE(dh_filter_block(&reference, input.data(), expected.data(), 333) == DH_FILTER_OK);
+                REQUIRE(dh_filter_set_gain(&filter, 2.5) == DH_FILTER_OK);
+                REQUIRE(dh_filter_set_gain(&reference, 2.5) == DH_FILTER_OK);
+                for(size_t i=333; i<input.size(); ++i) {
+                    REQUIRE(dh_filter(&filter, input[i], &output[i]) == DH_FILTER_OK);
+                    REQUIRE(dh_filter(&reference, input[i], &expected[i]) == DH_FILTER_OK);
+                }
+                THEN( "the outputs are identical" ) {
+                    REQUIRE(output == expected);
+                    REQUIRE(filter.current_input_index == reference.current_input_index);
+                    REQUIRE(filter.current_output_index == reference.current_output_index);
+                }
+            }
+            dh_free_filter(&reference);
+            dh_free_filter(&filter);
+        }
+    }
+}
@@ -0,0 +1,173 @@
+#include "catch2/catch_test_macros.hpp"
+#include "dh/resampler.h"
+#define _USE_MATH_DEFINES
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+/**
+ * This source code is licensed under the MIT license. See file "LICENSE" at the root of the repository.
+ */
+
+/** Inserts zeros, filters with the full anti-aliasing filter and keeps every M-th value. */
+static std::vector<double> resample_reference(const dh_resampler_data& resampler, const std::vector<double>& input)
+{
+    const size_t interpolation = resampler.interpolation;
+    const size_t taps = resampler.taps_per_phase;
+    std::vector<double> prototype(interpolation * taps);
+    for (size_t p=0; p<interpolation; ++p) {
+        for (size_t t=0; t<taps; ++t) {
+            prototype[p + t*interpolation] = resampler.coefficients[p*taps + t];
+        }
+    }
+    std::vector<double> upsampled(input.size() * interpolation, 0.0);
+    for (size_t i=0; i<input.size(); ++i) {
+        upsampled[i*interpolation] = input[i];
+    }
+    std::vector<double> output;
+    for (size_t n=0; n<upsampled.size(); n+=resampler.decimation) {
+        double sum = 0.0;
+        for (size_t k=0; k<prototype.size() && k<=n; ++k) {
+            sum += prototype[k] * upsampled[n-k];
+        }
+        output.push_back(sum);
+    }
+    return output;
+}
+
+SCENARIO( "A polyphase resampler computes the same values as filtering the upsampled signal", "[filter]" ) {
+    const size_t ratios[][2] = {{1, 10}, {3, 2}, {2, 3}, {4, 1}, {5, 7}};
+    std::vector<double> input(997);
+    for (size_t i=0; i<input.size(); ++i) {
+        const double t = static_cast<double>(i);
+        input[i] = std::sin(0.03*t) + 0.3*std::sin(1.1*t) + (i%50 < 10 ? 0.5 : 0.0);
+    }
+
+    for (const auto& ratio : ratios) {
+        GIVEN( "A resampler with ratio " + std::to_string(ratio[0]) + "/" + std::to_string(ratio[1]) ) {
+            dh_resampler_parameters opts{};
+            opts.interpolation = ratio[0];
+            opts.decimation = ratio[1];
+            opts.taps_per_phase = 24;
+            opts.bandwidth = 0.9;
+            dh_resampler_data resampler;
+            REQUIRE(dh_create_resampler(&resampler, &opts) == DH_FILTER_OK);
+            REQUIRE(resampler.initialized == false);
+            REQUIRE(dh_initialize_resampler(&resampler, 0.0) == DH_FILTER_OK);
+            const auto expected = resample_reference(resampler, input);
+
+            WHEN( "the signal is resampled in blocks of different lengths" ) {
+                REQUIRE(dh_resampler_output_count(&resampler, input.size()) == expected.size());
+                std::vector<double> output;
+                size_t position = 0;
+                size_t block = 1;
+                while (position < input.size()) {
+                    const size_t count = std::min(block, input.size() - position);
+                    const size_t expected_count = dh_resampler_output_count(&resampler, count);
+                    std::vector<double> chunk(expected_count + 1);
+                    size_t written = 0;
+                    REQUIRE(dh_resample(&resampler, input.data() + position, count, chunk.data(), &written) == DH_FILTER_OK);
+                    REQUIRE(written == expected_count);
+                    output.insert(output.end(), chunk.begin(), chunk.begin() + written);
+                    position += count;
+                    block = (block * 5) % 97 + 1;
+                }
+                THEN( "the outputs are equal to the reference" ) {
+                    REQUIRE(output.size() == expected.size());
+                    for (size_t i=0; i<output.size(); ++i) {
+                        REQUIRE(std::fabs(output[i] - expected[i]) < 1e-12);
+                    }
+                }
+            }
+            dh_free_resampler(&resampler);
+        }
+    }
+}
+
+SCENARIO( "A polyphase resampler keeps low frequencies", "[filter]" ) {
+    GIVEN( "A resampler that decimates by 10" ) {
+        dh_resampler_parameters opts{};
+        opts.interpolation = 1;
+        opts.decimation = 10;
+        opts.taps_per_phase = 200;
+        opts.bandwidth = 0.9;
+        dh_resampler_data resampler;
+        REQUIRE(dh_create_resampler(&resampler, &opts) == DH_FILTER_OK);
+
+        WHEN( "a constant signal is resampled" ) {
+            std::vector<double> input(1000, 3.0);
+            std::vector<double> output(dh_resampler_output_count(&resampler, input.size()));
+            REQUIRE(output.size() == 100);
+            REQUIRE(dh_resample(&resampler, input.data(), input.size(), output.data(), nullptr) == DH_FILTER_OK);
+            THEN( "the resampler starts in the steady state" ) {
+                for (double value : output) {
+                    REQUIRE(std::fabs(value - 3.0) < 1e-12);
+                }
+            }
+        }
+        WHEN( "a signal above the new nyquist frequency is resampled" ) {
+            std::vector<double> input(10000);
+            for (size_t i=0; i<input.size(); ++i) {
+                input[i] = std::sin(2.0*M_PI*0.3*static_cast<double>(i));
+            }
+            std::vector<double> output(dh_resampler_output_count(&resampler, input.size()));
+            REQUIRE(dh_resample(&resampler, input.data(), input.size(), output.data(), nullptr) == DH_FILTER_OK);
+            THEN( "it is removed" ) {
+                for (size_t i=50; i<output.size(); ++i) {
+                    REQUIRE(std::fabs(output[i]) < 0.05);
+                }
+            }
+        }
+        dh_free_resampler(&resampler);
+    }
+
+    GIVEN( "A ratio with a common factor" ) {
+        dh_resampler_parameters opts{};
+        opts.interpolation = 4;
+        opts.decimation = 6;
+        opts.taps_per_phase = 16;
+        opts.bandwidth = 0.9;
+        auto reduced_opts = opts;
+        reduced_opts.interpolation = 2;
+        reduced_opts.decimation = 3;
+        dh_resampler_data resampler;
+        dh_resampler_data reduced;
+        REQUIRE(dh_create_resampler(&resampler, &opts) == DH_FILTER_OK);
+        REQUIRE(dh_create_resampler(&reduced, &reduced_opts) == DH_FILTER_OK);
+        THEN( "the factors are reduced and the resampler is the same as for the reduced ratio" ) {
+            REQUIRE(resampler.interpolation == 2);
+            REQUIRE(resampler.decimation == 3);
+            REQUIRE(resampler.buffer_length == reduced.buffer_length);
+            for (size_t i=0; i<resampler.interpolation*resampler.taps_per_phase; ++i) {
+                REQUIRE(resampler.coefficients[i] == reduced.coefficients[i]);
+            }
+        }
+        WHEN( "an empty block is resampled" ) {
+            size_t written = 1;
+            REQUIRE(dh_resample(&resampler, nullptr, 0, nullptr, &written) == DH_FILTER_OK);
+            THEN( "nothing is written and the resampler is unchanged" ) {
+                REQUIRE(written == 0);
+                REQUIRE(resampler.initialized == false);
+                REQUIRE(resampler.phase == 0);
+            }
+        }
+        dh_free_resampler(&reduced);
+        dh_free_resampler(&resampler);
+    }
+
+    GIVEN( "Invalid parameters" ) {
+        dh_resampler_parameters opts{};
+        opts.interpolation = 2;
+        opts.decimation = 0;
+        opts.taps_per_phase = 8;
+        opts.bandwidth = 0.9;
+        dh_resampler_data resampler{};
+        THEN( "the resampler is not created" ) {
+            REQUIRE(dh_create_resampler(&resampler, &opts) == DH_FILTER_ERROR);
+            opts.decimation = 1;
+            opts.bandwidth = 0.0;
+            REQUIRE(dh_create_resampler(&resampler, &opts) == DH_FILTER_ERROR);
+        }
+    }
+}
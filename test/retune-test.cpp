@@ -0,0 +1,156 @@
+#include "catch2/catch_test_macros.hpp"
+#include "dh/filter.h"
+#include "test-helpers.hpp"
+#include <cmath>
+#include <string>
+#include <vector>
+
+/**
+ * This source code is licensed under the MIT license. See file "LICENSE" at the root of the repository.
+ */
+
+SCENARIO( "Filters can be retuned without allocations", "[filter]" ) {
+    struct test_case {
+        DH_FILTER_TYPE type;
+        DH_FILTER_TYPE new_type;
+        size_t order;
+        DH_FILTER_REALIZATION realization;
+    };
+    const test_case cases[] = {
+        {DH_IIR_BUTTERWORTH_LOWPASS, DH_IIR_CHEBYSHEV_LOWPASS, 4, DH_REALIZATION_DEFAULT},
+        {DH_IIR_CHEBYSHEV_BANDPASS, DH_IIR_CHEBYSHEV_BANDPASS, 3, DH_REALIZATION_SECOND_ORDER_SECTIONS},
+        {DH_IIR_CHEBYSHEV2_HIGHPASS, DH_IIR_CHEBYSHEV2_HIGHPASS, 5, DH_REALIZATION_TRANSPOSED_DIRECT_FORM_2},
+        {DH_FIR_BRICKWALL_BANDSTOP, DH_FIR_BRICKWALL_BANDSTOP, 20, DH_REALIZATION_DIRECT_FORM_1_MIRRORED},
+        {DH_FIR_BRICKWALL_BANDPASS, DH_FIR_BRICKWALL_BANDPASS, 10, DH_REALIZATION_DEFAULT},
+        {DH_FIR_BRICKWALL_LOWPASS, DH_FIR_BRICKWALL_LOWPASS, 200, DH_REALIZATION_DEFAULT},
+        {DH_FIR_MOVING_AVERAGE_LOWPASS, DH_FIR_MOVING_AVERAGE_LOWPASS, 33, DH_REALIZATION_RUNNING_SUM},
+        {DH_FIR_MOVING_AVERAGE_HIGHPASS, DH_FIR_MOVING_AVERAGE_HIGHPASS, 12, DH_REALIZATION_RUNNING_SUM},
+        {DH_FIR_EXPONENTIAL_MOVING_AVERAGE_LOWPASS, DH_FIR_EXPONENTIAL_MOVING_AVERAGE_LOWPASS, 33, DH_REALIZATION_RECURSIVE_EXPONENTIAL}
+    };
+    const size_t count = 500;
+
+    for(const auto& current : cases) {
+        GIVEN( "A filter of type " + std::to_string(static_cast<int>(current.type)) + " with the realization " + std::to_string(static_cast<int>(current.realization)) ) {
+            auto opts = create_test_parameters(current.type, current.order, current.realization);
+            auto new_opts = create_test_parameters(current.new_type, current.order, current.realization);
+            new_opts.cutoff_frequency_low = 15.0;
+            new_opts.cutoff_frequency_high = 30.0;
+            dh_filter_data filter;
+            dh_filter_data reference;
+            REQUIRE(dh_create_filter(&filter, &opts) == DH_FILTER_OK);
+            REQUIRE(dh_create_filter(&reference, &opts) == DH_FILTER_OK);
+            std::vector<char> workspace(dh_filter_retune_workspace_size(&new_opts) + 1);
+            for(size_t i=0; i<count; ++i) {
+                double value = 0.0;
+                REQUIRE(dh_filter(&filter, test_signal(i), &value) == DH_FILTER_OK);
+                REQUIRE(dh_filter(&reference, test_signal(i), &value) == DH_FILTER_OK);
+            }
+
+            WHEN( "The filter is retuned with the same options" ) {
+                REQUIRE(dh_filter_retune(&filter, &opts, workspace.data(), workspace.size()) == DH_FILTER_OK);
+                THEN( "The outputs continue as if nothing happened" ) {
+                    // the sums of the recursive realizations are recomputed and only equal up to rounding
+                    const bool recomputed = current.realization == DH_REALIZATION_RUNNING_SUM || current.realization == DH_REALIZATION_RECURSIVE_EXPONENTIAL;
+                    for(size_t i=count; i<2*count; ++i) {
+                        double value = 0.0;
+                        double expected = 0.0;
+                        REQUIRE(dh_filter(&filter, test_signal(i), &value) == DH_FILTER_OK);
+                        REQUIRE(dh_filter(&reference, test_signal(i), &expected) == DH_FILTER_OK);
+                        if (recomputed) {
+                            REQUIRE(std::fabs(value - expected) < 1e-12);
+                        } else {
+                            REQUIRE(value == expected);
+                        }
+                    }
+                }
+            }
+
+            WHEN( "A FIR filter is retuned with new cutoff frequencies" ) {
+                REQUIRE(dh_filter_retune(&filter, &new_opts, workspace.data(), workspace.size()) == DH_FILTER_OK);
+                dh_filter_data designed;
+                REQUIRE(dh_create_filter(&designed, &new_opts) == DH_FILTER_OK);
+                for(size_t i=0; i<count; ++i) {
+                    REQUIRE(dh_filter(&designed, test_signal(i), nullptr) == DH_FILTER_OK);
+                }
+                THEN( "The outputs are the same as for a new filter that has seen the same inputs" ) {
+                    if (filter.number_coefficients_out <= 1) {
+                        for(size_t i=count; i<2*count; ++i) {
+                            double value = 0.0;
+                            double expected = 0.0;
+                            REQUIRE(dh_filter(&filter, test_signal(i), &value) == DH_FILTER_OK);
+                            REQUIRE(dh_filter(&designed, test_signal(i), &expected) == DH_FILTER_OK);
+                            REQUIRE(std::fabs(value - expected) < 1e-12);
+                        }
+                    }
+                }
+                dh_free_filter(&designed);
+            }
+
+            WHEN( "The filter is retuned with new cutoff frequencies" ) {
+                const double* buffer = filter.coefficients_in;
+                REQUIRE(dh_filter_retune(&filter, &new_opts, workspace.data(), workspace.size()) == DH_FILTER_OK);
+                dh_filter_data designed;
+                REQUIRE(dh_create_filter(&designed, &new_opts) == DH_FILTER_OK);
+                THEN( "The coefficients are the same as for a new filter and the buffer is not changed" ) {
+                    REQUIRE(filter.coefficients_in == buffer);
+                    REQUIRE(filter.number_coefficients_in == designed.number_coefficients_in);
+                    for(size_t k=0; k<designed.number_coefficients_in; ++k) {
+                        REQUIRE(filter.coefficients_in[k] == designed.coefficients_in[k]);
+                    }
+                    for(size_t k=0; k<designed.number_coefficients_out; ++k) {
+                        REQUIRE(filter.coefficients_out[k] == designed.coefficients_out[k]);
+                    }
+                    for(size_t k=0; k<5*designed.number_sections; ++k) {
+                        REQUIRE(filter.sections[k] == designed.sections[k]);
+                    }
+                }
+                THEN( "The outputs start from the old state and converge to the outputs of the new filter" ) {
+                    double first = 0.0;
+                    REQUIRE(dh_filter(&filter, test_signal(count), &first) == DH_FILTER_OK);
+                    REQUIRE(std::fabs(first - reference.current_value) < 5.0);
+                    for(size_t i=0; i<count; ++i) {
+                        double value = 0.0;
+                        double expected = 0.0;
+                        REQUIRE(dh_filter(&filter, test_signal(i), &value) == DH_FILTER_OK);
+                        REQUIRE(dh_filter(&designed, test_signal(i), &expected) == DH_FILTER_OK);
+                        if (i > count / 2) {
+                            REQUIRE(std::fabs(value - expected) < 1e-6);
+                        }
+                    }
+                }
+                dh_free_filter(&designed);
+            }
+
+            WHEN( "The order of the filter changes" ) {
+                auto other = new_opts;
+                other.filter_order += 1;
+                std::vector<char> larger(dh_filter_retune_workspace_size(&other) + 1);
+                THEN( "The filter is not changed" ) {
+                    REQUIRE(dh_filter_retune(&filter, &other, larger.data(), larger.size()) == DH_FILTER_ERROR);
+                }
+            }
+
+            WHEN( "The realization changes" ) {
+                auto other = new_opts;
+                other.realization = current.realization == DH_REALIZATION_TRANSPOSED_DIRECT_FORM_2 ? DH_REALIZATION_DIRECT_FORM_1 : DH_REALIZATION_TRANSPOSED_DIRECT_FORM_2;
+                THEN( "The filter is not changed" ) {
+                    REQUIRE(dh_filter_retune(&filter, &other, workspace.data(), workspace.size()) == DH_FILTER_UNSUPPORTED_REALIZATION);
+                }
+            }
+
+            WHEN( "The workspace is too small" ) {
+                const size_t required = dh_filter_retune_workspace_size(&new_opts);
+                THEN( "The filters that need temporary values are not changed" ) {
+                    if (required > 0) {
+                        REQUIRE(dh_filter_retune(&filter, &new_opts, workspace.data(), required - 1) == DH_FILTER_ALLOCATION_FAILED);
+                        REQUIRE(dh_filter_retune(&filter, &new_opts, nullptr, 0) == DH_FILTER_ALLOCATION_FAILED);
+                    } else {
+                        REQUIRE(dh_filter_retune(&filter, &new_opts, nullptr, 0) == DH_FILTER_OK);
+                    }
+                }
+            }
+            dh_free_filter(&filter);
+            dh_free_filter(&reference);
+        }
+    }
+}
@@ -0,0 +1,49 @@
+#ifndef DH_FILTER_TEST_HELPERS_INCLUDED
+#define DH_FILTER_TEST_HELPERS_INCLUDED
+
+/** @file
+ * @brief Options and input signals that are shared by the tests of the different filter APIs.
+ *
+ * This source code is licensed under the MIT license. See file "LICENSE" at the root of the repository.
+ */
+
+#include "dh/filter.h"
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+/**
+ * Returns the options for a filter with the cutoff frequencies 10 Hz and 20 Hz at a sampling frequency of 100 Hz.
+ * The passband ripple of chebyshev filters is 1 dB.
+ */
+inline dh_filter_parameters create_test_parameters(DH_FILTER_TYPE type, size_t order, DH_FILTER_REALIZATION realization = DH_REALIZATION_DEFAULT) {
+    dh_filter_parameters opts{};
+    opts.filter_type = type;
+    opts.filter_order = order;
+    opts.cutoff_frequency_low = 10.0;
+    opts.cutoff_frequency_high = 20.0;
+    opts.sampling_frequency = 100.0;
+    opts.ripple = -1.0;
+    opts.realization = realization;
+    return opts;
+}
+
+/**
+ * Returns value [i] of a test signal: an offset, a slow and a fast sine wave and a rectangular wave.
+ * The signal has components in the passband and in the stopband of the filters and steps that excite all frequencies.
+ */
+inline double test_signal(size_t i) {
+    const double t = static_cast<double>(i);
+    return 2.0 + std::sin(0.05*t) + 0.5*std::sin(1.3*t) + (i%37 < 10 ? 1.0 : -1.0);
+}
+
+/** Returns the first [count] values of test_signal(). */
+inline std::vector<double> create_test_signal(size_t count) {
+    std::vector<double> rv(count);
+    for(size_t i=0; i<count; ++i) {
+        rv[i] = test_signal(i);
+    }
+    return rv;
+}
+
+#endif /* DH_FILTER_TEST_HELPERS_INCLUDED */